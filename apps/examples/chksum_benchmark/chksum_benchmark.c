@@ -0,0 +1,259 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/// @file chksum_benchmark.c
+
+/// @brief Measure the throughput of the lwIP Internet checksum.
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "lwip/opt.h"
+#include "lwip/def.h"
+#include "lwip/inet_chksum.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define CB_MAXSIZE      CONFIG_EXAMPLES_CHKSUM_BENCHMARK_MAXSIZE
+#define CB_BYTES        CONFIG_EXAMPLES_CHKSUM_BENCHMARK_BYTES
+#define CB_MINLOOPS     16
+#define CB_MINSIZE      16
+
+/* Extra bytes for the unaligned cases */
+
+#define CB_GUARD        8
+
+#if defined(CONFIG_NET_LWIP_CHKSUM_HALFWORD)
+#define CB_CHKSUM_NAME  "16-bit"
+#elif defined(CONFIG_NET_LWIP_CHKSUM_UNROLLED)
+#define CB_CHKSUM_NAME  "32-bit unrolled"
+#elif defined(CONFIG_NET_LWIP_CHKSUM_WORD)
+#define CB_CHKSUM_NAME  "32-bit add-with-carry"
+#else
+#define CB_CHKSUM_NAME  "default"
+#endif
+
+enum cb_op_e {
+	CB_CHKSUM,					/* Aligned buffer */
+	CB_CHKSUM_UNALIGNED,		/* Buffer one byte past an aligned address */
+	CB_COPY_THEN_CHKSUM,		/* memcpy(), then checksum of the copy */
+#if LWIP_CHECKSUM_ON_COPY
+	CB_COPY_CHKSUM,				/* LWIP_CHKSUM_COPY() as used by TCP output */
+#endif
+	CB_NOPS
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const char *g_opnames[CB_NOPS] = {
+	"chksum", "chksum+1", "copy,sum",
+#if LWIP_CHECKSUM_ON_COPY
+	"copysum",
+#endif
+};
+
+static volatile u16_t g_sink;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint32_t cb_elapsed_us(struct timespec *start, struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1000000 + (end->tv_nsec - start->tv_nsec) / 1000;
+}
+
+/* RFC 1071 one octet at a time, in network order */
+
+static u16_t cb_reference(const u8_t *data, int len)
+{
+	u32_t acc = 0;
+
+	while (len > 1) {
+		acc += (data[0] << 8) | data[1];
+		data += 2;
+		len -= 2;
+	}
+	if (len > 0) {
+		acc += data[0] << 8;
+	}
+	while ((acc >> 16) != 0) {
+		acc = (acc >> 16) + (acc & 0xffff);
+	}
+
+	return (u16_t)~lwip_htons((u16_t)acc);
+}
+
+/* Check the results against the reference for all small sizes and
+ * alignments, so that a broken implementation is not benchmarked.
+ */
+
+static int cb_check(u8_t *src, u8_t *dest)
+{
+	int soff;
+	int n;
+	int i;
+
+	for (i = 0; i < 128 + CB_GUARD; i++) {
+		src[i] = (u8_t)(i * 151 + 7);
+	}
+
+	for (soff = 0; soff < 4; soff++) {
+		for (n = 0; n < 128; n++) {
+			if (inet_chksum(src + soff, n) != cb_reference(src + soff, n)) {
+				printf("inet_chksum failed: offset %d, size %d\n", soff, n);
+				return -1;
+			}
+#if LWIP_CHECKSUM_ON_COPY
+			{
+				int doff;
+
+				for (doff = 0; doff < 4; doff++) {
+					memset(dest, 0xaa, 128 + CB_GUARD);
+					if ((u16_t)~LWIP_CHKSUM_COPY(dest + doff, src + soff, n) != cb_reference(src + soff, n) || memcmp(dest + doff, src + soff, n) != 0 || (n + doff < 128 + CB_GUARD && dest[n + doff] != 0xaa)) {
+						printf("LWIP_CHKSUM_COPY failed: source offset %d, destination offset %d, size %d\n", soff, doff, n);
+						return -1;
+					}
+				}
+			}
+#endif
+		}
+	}
+
+	return 0;
+}
+
+static uint32_t cb_run(enum cb_op_e op, u8_t *src, u8_t *dest, u16_t size)
+{
+	struct timespec start;
+	struct timespec end;
+	uint32_t loops;
+	uint32_t i;
+	u16_t sum = 0;
+
+	loops = CB_BYTES / size;
+	if (loops < CB_MINLOOPS) {
+		loops = CB_MINLOOPS;
+	}
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	switch (op) {
+	case CB_CHKSUM:
+		for (i = 0; i < loops; i++) {
+			sum += inet_chksum(src, size);
+		}
+		break;
+
+	case CB_CHKSUM_UNALIGNED:
+		for (i = 0; i < loops; i++) {
+			sum += inet_chksum(src + 1, size);
+		}
+		break;
+
+	case CB_COPY_THEN_CHKSUM:
+		for (i = 0; i < loops; i++) {
+			memcpy(dest, src, size);
+			sum += inet_chksum(dest, size);
+		}
+		break;
+
+#if LWIP_CHECKSUM_ON_COPY
+	case CB_COPY_CHKSUM:
+		for (i = 0; i < loops; i++) {
+			sum += LWIP_CHKSUM_COPY(dest, src, size);
+		}
+		break;
+#endif
+
+	default:
+		break;
+	}
+	clock_gettime(CLOCK_REALTIME, &end);
+	g_sink = sum;
+
+	/* Report KB/s, which is the same as bytes per ms */
+
+	i = cb_elapsed_us(&start, &end);
+	if (i == 0) {
+		i = 1;
+	}
+
+	return (uint32_t)(((uint64_t)loops * size * 1000) / i);
+}
+
+/****************************************************************************
+ * chksum_bench_main
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int chksum_bench_main(int argc, char *argv[])
+#endif
+{
+	u8_t *src;
+	u8_t *dest;
+	u32_t size;
+	int op;
+
+	src = (u8_t *)malloc(CB_MAXSIZE + CB_GUARD);
+	dest = (u8_t *)malloc(CB_MAXSIZE + CB_GUARD);
+	if (src == NULL || dest == NULL) {
+		printf("Failed to allocate 2 x %d bytes\n", CB_MAXSIZE + CB_GUARD);
+		goto errout;
+	}
+
+	if (cb_check(src, dest) < 0) {
+		goto errout;
+	}
+
+	for (size = 0; size < CB_MAXSIZE + CB_GUARD; size++) {
+		src[size] = (u8_t)rand();
+	}
+
+	printf("Checksum algorithm: %s, throughput in KB/s\n", CB_CHKSUM_NAME);
+	printf("%8s", "size");
+	for (op = 0; op < CB_NOPS; op++) {
+		printf(" %10s", g_opnames[op]);
+	}
+	printf("\n");
+
+	for (size = CB_MINSIZE; size <= CB_MAXSIZE && size <= 0xffff; size <<= 1) {
+		printf("%8u", (unsigned int)size);
+		for (op = 0; op < CB_NOPS; op++) {
+			printf(" %10u", cb_run((enum cb_op_e)op, src, dest, (u16_t)size));
+		}
+		printf("\n");
+	}
+
+errout:
+	free(src);
+	free(dest);
+	return 0;
+}
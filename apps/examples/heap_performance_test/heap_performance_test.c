@@ -26,11 +26,14 @@
 #include <tinyara/config.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
+#include "heap_performance_test.h"
+
 #define NUM_ALLOC 100
 
-static int heap_performance_test(int argc, char *argv[])
+static int heap_loop_test(int argc, char *argv[])
 {
 	struct timespec ts1, ts2;
 	int repeat = NUM_ALLOC;
@@ -61,6 +64,13 @@ static int heap_performance_test(int argc, char *argv[])
 		printf("	param1 is the interval between tests each of which handles a different size.\n");
 		printf("	param2 is the number of repetition of one experiment.\n");
 		printf("	In one experiment, param1-sized memory is allocated a hundred times and then released.\n\n");
+		printf("	%s replay [trace] replays the trace file, or the built-in trace,\n", argv[1]);
+		printf("	and reports the latency and fragmentation of the heap.\n");
+		printf("	%s dump <trace> writes the built-in trace to a file.\n", argv[1]);
+#ifdef CONFIG_DEBUG_MM_HEAPTRACE
+		printf("	%s capture <trace> [seconds] records the heap operations to a file.\n", argv[1]);
+#endif
+		printf("\n");
 		printf("At this time, %s will be performed with default values.\n\n", argv[1]);
 	}
 
@@ -108,6 +118,25 @@ static int heap_performance_test(int argc, char *argv[])
 	return 0;
 }
 
+static int heap_performance_test(int argc, char *argv[])
+{
+	if (argc >= 3 && strcmp(argv[2], "replay") == 0) {
+		return heap_trace_replay(argc >= 4 ? argv[3] : NULL);
+	}
+
+	if (argc == 4 && strcmp(argv[2], "dump") == 0) {
+		return heap_trace_dump(argv[3]);
+	}
+
+#ifdef CONFIG_DEBUG_MM_HEAPTRACE
+	if (argc >= 4 && strcmp(argv[2], "capture") == 0) {
+		return heap_trace_capture(argv[3], argc >= 5 ? atoi(argv[4]) : 10);
+	}
+#endif
+
+	return heap_loop_test(argc, argv);
+}
+
 #ifdef CONFIG_BUILD_KERNEL
 int main(int argc, FAR char *argv[])
 #else
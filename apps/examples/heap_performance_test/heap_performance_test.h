@@ -0,0 +1,51 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __APPS_EXAMPLES_HEAP_PERFORMANCE_TEST_HEAP_PERFORMANCE_TEST_H
+#define __APPS_EXAMPLES_HEAP_PERFORMANCE_TEST_HEAP_PERFORMANCE_TEST_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* Replay the trace in the file 'path', or the built-in trace if 'path' is
+ * NULL, and print the latency and fragmentation report.
+ */
+
+int heap_trace_replay(const char *path);
+
+/* Write the built-in trace to 'path' in the trace file format */
+
+int heap_trace_dump(const char *path);
+
+#ifdef CONFIG_DEBUG_MM_HEAPTRACE
+/* Record the heap operations of all threads for 'seconds' and write them
+ * to 'path' in the trace file format, with the caller of each operation
+ */
+
+int heap_trace_capture(const char *path, int seconds);
+#endif
+
+#endif /* __APPS_EXAMPLES_HEAP_PERFORMANCE_TEST_HEAP_PERFORMANCE_TEST_H */
@@ -0,0 +1,745 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/// @file heap_trace.c
+
+/// @brief Replay an allocation trace and report heap latency and fragmentation.
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#ifdef CONFIG_DEBUG_MM_HEAPTRACE
+#include <tinyara/mm/mm.h>
+#endif
+
+#include "heap_performance_test.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define HT_SLOTS        CONFIG_EXAMPLES_HEAP_PERFORMANCE_TEST_SLOTS
+#define HT_SAMPLES      CONFIG_EXAMPLES_HEAP_PERFORMANCE_TEST_SAMPLES
+#define HT_INTERVAL     CONFIG_EXAMPLES_HEAP_PERFORMANCE_TEST_INTERVAL
+#define HT_SYNTH_OPS    CONFIG_EXAMPLES_HEAP_PERFORMANCE_TEST_SYNTH_OPS
+#define HT_CALLERS      16
+#define HT_CAPTURE_RECORDS CONFIG_EXAMPLES_HEAP_PERFORMANCE_TEST_CAPTURE_RECORDS
+
+/* The built-in trace uses at most HT_SYNTH_SLOTS live allocations, which
+ * keeps its footprint around 20KB.
+ */
+
+#define HT_SYNTH_SLOTS  (HT_SLOTS < 64 ? HT_SLOTS : 64)
+#define HT_SEED         1
+
+#define HT_LINE_LEN     64
+
+#if defined(CONFIG_EXAMPLES_HEAP_PERFORMANCE_TEST_CLOCK_DWT)
+#define HT_UNIT         "cycles"
+#define HT_DEMCR        (*(volatile uint32_t *)0xe000edfc)
+#define HT_DEMCR_TRCENA (1 << 24)
+#define HT_DWT_CTRL     (*(volatile uint32_t *)0xe0001000)
+#define HT_DWT_CYCCNTENA (1 << 0)
+#define HT_DWT_CYCCNT   (*(volatile uint32_t *)0xe0001004)
+#elif defined(CONFIG_EXAMPLES_HEAP_PERFORMANCE_TEST_CLOCK_SYSTICK)
+#define HT_UNIT         "cycles"
+#define HT_SYSTICK_RELOAD  (*(volatile uint32_t *)0xe000e014)
+#define HT_SYSTICK_CURRENT (*(volatile uint32_t *)0xe000e018)
+#define HT_SYSTICK_MASK    0x00ffffff
+#else
+#define HT_UNIT         "ns"
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+enum ht_optype_e {
+	HT_MALLOC = 0,
+	HT_FREE,
+	HT_REALLOC,
+	HT_NOPS
+};
+
+struct ht_op_s {
+	int type;
+	int id;
+	size_t size;
+	unsigned long caller;		/* 0 if the trace has no caller column */
+};
+
+struct ht_stat_s {
+	uint32_t sample[HT_SAMPLES];
+	uint32_t count;				/* Number of measured operations */
+	uint32_t max;
+	uint32_t failed;
+};
+
+struct ht_caller_s {
+	unsigned long caller;
+	uint32_t count;
+	uint32_t max;
+	uint64_t total;
+};
+
+#ifdef CONFIG_DEBUG_MM_HEAPTRACE
+struct ht_rec_s {
+	uint8_t type;
+	FAR void *oldmem;
+	FAR void *mem;
+	size_t size;
+	mmaddress_t caller;
+};
+#endif
+
+struct ht_synth_s {
+	uint32_t seed;
+	int nops;
+	int drain;
+	bool live[HT_SYNTH_SLOTS];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const char *const g_ht_opname[HT_NOPS] = { "malloc", "free", "realloc" };
+static const char g_ht_opchar[HT_NOPS] = { 'm', 'f', 'r' };
+
+static void *g_ht_slot[HT_SLOTS];
+static struct ht_stat_s g_ht_stat[HT_NOPS];
+static uint32_t g_ht_seed;
+static struct ht_caller_s g_ht_caller[HT_CALLERS];
+static uint32_t g_ht_nocaller;
+
+#ifdef CONFIG_DEBUG_MM_HEAPTRACE
+static struct ht_rec_s *g_ht_rec;
+static int g_ht_nrec;
+static uint32_t g_ht_lost;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint32_t ht_rand(uint32_t *seed)
+{
+	*seed = *seed * 1103515245 + 12345;
+	return (*seed >> 16) & 0x7fff;
+}
+
+static void ht_clock_init(void)
+{
+#if defined(CONFIG_EXAMPLES_HEAP_PERFORMANCE_TEST_CLOCK_DWT)
+	HT_DEMCR |= HT_DEMCR_TRCENA;
+	HT_DWT_CYCCNT = 0;
+	HT_DWT_CTRL |= HT_DWT_CYCCNTENA;
+#endif
+}
+
+static uint32_t ht_now(void)
+{
+#if defined(CONFIG_EXAMPLES_HEAP_PERFORMANCE_TEST_CLOCK_DWT)
+	return HT_DWT_CYCCNT;
+#elif defined(CONFIG_EXAMPLES_HEAP_PERFORMANCE_TEST_CLOCK_SYSTICK)
+	uint32_t reload = HT_SYSTICK_RELOAD & HT_SYSTICK_MASK;
+	uint32_t current;
+	clock_t tick;
+
+	/* Read again if the tick count changed in between */
+
+	do {
+		tick = clock();
+		current = HT_SYSTICK_CURRENT & HT_SYSTICK_MASK;
+	} while (tick != clock());
+
+	return (uint32_t)tick * (reload + 1) + (reload - current);
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	return (uint32_t)ts.tv_sec * 1000000000 + (uint32_t)ts.tv_nsec;
+#endif
+}
+
+static void ht_record(int type, uint32_t start, uint32_t end)
+{
+	struct ht_stat_s *stat = &g_ht_stat[type];
+	uint32_t elapsed = end - start;
+	uint32_t ndx;
+
+	/* A tick which is still pending can make the SysTick time go back */
+
+	if ((int32_t)elapsed < 0) {
+		elapsed = 0;
+	}
+
+	if (elapsed > stat->max) {
+		stat->max = elapsed;
+	}
+
+	/* Keep a uniform sample of all the latencies (reservoir sampling) */
+
+	if (stat->count < HT_SAMPLES) {
+		stat->sample[stat->count] = elapsed;
+	} else {
+		ndx = ((ht_rand(&g_ht_seed) << 15) | ht_rand(&g_ht_seed)) % (stat->count + 1);
+		if (ndx < HT_SAMPLES) {
+			stat->sample[ndx] = elapsed;
+		}
+	}
+
+	stat->count++;
+}
+
+static void ht_record_caller(unsigned long caller, uint32_t start, uint32_t end)
+{
+	struct ht_caller_s *entry;
+	uint32_t elapsed = end - start;
+	int i;
+
+	if ((int32_t)elapsed < 0) {
+		elapsed = 0;
+	}
+
+	for (i = 0; i < HT_CALLERS; i++) {
+		entry = &g_ht_caller[i];
+		if (entry->caller == caller || entry->count == 0) {
+			entry->caller = caller;
+			entry->count++;
+			entry->total += elapsed;
+			if (elapsed > entry->max) {
+				entry->max = elapsed;
+			}
+			return;
+		}
+	}
+
+	g_ht_nocaller++;
+}
+
+static int ht_compare_caller(const void *a, const void *b)
+{
+	const struct ht_caller_s *x = (const struct ht_caller_s *)a;
+	const struct ht_caller_s *y = (const struct ht_caller_s *)b;
+
+	/* Unused entries go last */
+
+	if (x->count == 0 || y->count == 0) {
+		return (x->count == 0) - (y->count == 0);
+	}
+
+	return x->total > y->total ? -1 : (x->total < y->total ? 1 : 0);
+}
+
+static void ht_report_caller(void)
+{
+	struct ht_caller_s *entry;
+	int i;
+
+	if (g_ht_caller[0].count == 0) {
+		return;
+	}
+
+	qsort(g_ht_caller, HT_CALLERS, sizeof(struct ht_caller_s), ht_compare_caller);
+
+	printf("\nLatency per caller in %s, by total time\n", HT_UNIT);
+	printf(" Caller     |  Count |        mean |         max |       total\n");
+	printf("------------|--------|-------------|-------------|-------------\n");
+	for (i = 0; i < HT_CALLERS; i++) {
+		entry = &g_ht_caller[i];
+		if (entry->count == 0) {
+			break;
+		}
+		printf(" 0x%08lx | %6u | %11u | %11u | %11llu\n", entry->caller, entry->count, (uint32_t)(entry->total / entry->count), entry->max, (unsigned long long)entry->total);
+	}
+
+	if (g_ht_nocaller > 0) {
+		printf("Operations of further callers not shown: %u\n", g_ht_nocaller);
+	}
+}
+
+static int ht_compare(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+static void ht_report_latency(void)
+{
+	struct ht_stat_s *stat;
+	uint32_t n;
+	int type;
+
+	printf("\nLatency in %s\n", HT_UNIT);
+	printf(" Op      |  Count | Failed |         p50 |         p99 |         max\n");
+	printf("---------|--------|--------|-------------|-------------|-------------\n");
+
+	for (type = 0; type < HT_NOPS; type++) {
+		stat = &g_ht_stat[type];
+		n = stat->count < HT_SAMPLES ? stat->count : HT_SAMPLES;
+		if (n == 0) {
+			printf(" %-7s | %6u | %6u | %11s | %11s | %11s\n", g_ht_opname[type], 0, stat->failed, "-", "-", "-");
+			continue;
+		}
+
+		qsort(stat->sample, n, sizeof(uint32_t), ht_compare);
+		printf(" %-7s | %6u | %6u | %11u | %11u | %11u\n", g_ht_opname[type], stat->count, stat->failed, stat->sample[(n * 50) / 100], stat->sample[(n * 99) / 100], stat->max);
+	}
+}
+
+/* The fragmentation index is the part of the free memory, in 1/1000, which
+ * cannot be handed out by a single allocation.
+ */
+
+static int ht_fragmentation(const struct mallinfo *info)
+{
+	if (info->fordblks <= 0) {
+		return 0;
+	}
+
+	return 1000 - (int)(((long long)info->mxordblk * 1000) / info->fordblks);
+}
+
+static void ht_heapinfo(struct mallinfo *info)
+{
+#ifdef CONFIG_CAN_PASS_STRUCTS
+	*info = mallinfo();
+#else
+	mallinfo(info);
+#endif
+}
+
+/* Parse one line of a trace file:
+ *
+ *   m <id> <size> [caller]   malloc(size) into slot id
+ *   r <id> <size> [caller]   realloc(slot id, size)
+ *   f <id> [caller]          free(slot id)
+ *
+ * Empty lines and lines starting with '#' are skipped.
+ */
+
+static int ht_parse(char *line, struct ht_op_s *op)
+{
+	char *ptr;
+	int type;
+
+	for (type = 0; type < HT_NOPS; type++) {
+		if (line[0] == g_ht_opchar[type]) {
+			break;
+		}
+	}
+
+	if (type == HT_NOPS || line[1] != ' ') {
+		return line[0] == '#' || line[0] == '\n' || line[0] == '\0' ? 0 : -1;
+	}
+
+	op->type = type;
+	op->id = (int)strtol(&line[2], &ptr, 10);
+	op->size = 0;
+	if (op->id < 0 || op->id >= HT_SLOTS) {
+		return -1;
+	}
+
+	if (type != HT_FREE) {
+		op->size = (size_t)strtoul(ptr, &ptr, 10);
+	}
+
+	op->caller = strtoul(ptr, &ptr, 0);
+
+	return 1;
+}
+
+static size_t ht_synth_size(uint32_t *seed)
+{
+	uint32_t ratio = ht_rand(seed) % 100;
+
+	/* Mostly small control blocks and strings, some messages and packets,
+	 * and a few large buffers.
+	 */
+
+	if (ratio < 70) {
+		return 16 + ht_rand(seed) % 241;
+	} else if (ratio < 95) {
+		return 256 + ht_rand(seed) % 1793;
+	}
+
+	return 2048 + ht_rand(seed) % 6145;
+}
+
+static void ht_synth_init(struct ht_synth_s *synth)
+{
+	memset(synth, 0, sizeof(struct ht_synth_s));
+	synth->seed = HT_SEED;
+}
+
+static bool ht_synth_next(struct ht_synth_s *synth, struct ht_op_s *op)
+{
+	/* Free all the live allocations at the end of the trace */
+
+	if (synth->nops >= HT_SYNTH_OPS) {
+		while (synth->drain < HT_SYNTH_SLOTS && !synth->live[synth->drain]) {
+			synth->drain++;
+		}
+
+		if (synth->drain == HT_SYNTH_SLOTS) {
+			return false;
+		}
+
+		op->type = HT_FREE;
+		op->id = synth->drain;
+		op->size = 0;
+		op->caller = 0;
+		synth->live[synth->drain] = false;
+		return true;
+	}
+
+	synth->nops++;
+	op->caller = 0;
+	op->id = ht_rand(&synth->seed) % HT_SYNTH_SLOTS;
+	if (!synth->live[op->id]) {
+		op->type = HT_MALLOC;
+		op->size = ht_synth_size(&synth->seed);
+		synth->live[op->id] = true;
+	} else if (ht_rand(&synth->seed) % 100 < 85) {
+		op->type = HT_FREE;
+		op->size = 0;
+		synth->live[op->id] = false;
+	} else {
+		op->type = HT_REALLOC;
+		op->size = ht_synth_size(&synth->seed);
+	}
+
+	return true;
+}
+
+static void ht_run(struct ht_op_s *op)
+{
+	void *ptr;
+	uint32_t start;
+	uint32_t end;
+
+	switch (op->type) {
+	case HT_MALLOC:
+		if (g_ht_slot[op->id]) {
+			/* The trace reuses a live id.  Release the old allocation. */
+
+			free(g_ht_slot[op->id]);
+		}
+
+		start = ht_now();
+		ptr = malloc(op->size);
+		end = ht_now();
+		break;
+
+	case HT_REALLOC:
+		start = ht_now();
+		ptr = realloc(g_ht_slot[op->id], op->size);
+		end = ht_now();
+		if (!ptr) {
+			/* realloc() keeps the old allocation on failure */
+
+			ptr = g_ht_slot[op->id];
+			g_ht_stat[op->type].failed++;
+		}
+		break;
+
+	case HT_FREE:
+	default:
+		if (!g_ht_slot[op->id]) {
+			return;
+		}
+
+		start = ht_now();
+		free(g_ht_slot[op->id]);
+		end = ht_now();
+		ptr = NULL;
+		break;
+	}
+
+	if (op->type == HT_MALLOC && !ptr) {
+		g_ht_stat[op->type].failed++;
+	}
+
+	g_ht_slot[op->id] = ptr;
+	ht_record(op->type, start, end);
+	if (op->caller != 0) {
+		ht_record_caller(op->caller, start, end);
+	}
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int heap_trace_replay(const char *path)
+{
+	struct ht_synth_s *synth = NULL;
+	struct mallinfo info;
+	struct ht_op_s op;
+	char line[HT_LINE_LEN];
+	FILE *stream = NULL;
+	uint32_t nops = 0;
+	int min_largest = -1;
+	int max_frag = 0;
+	int frag;
+	int leaked = 0;
+	int ret;
+	int i;
+
+	if (path) {
+		stream = fopen(path, "r");
+		if (!stream) {
+			printf("Cannot open trace %s\n", path);
+			return ERROR;
+		}
+	} else {
+		synth = (struct ht_synth_s *)malloc(sizeof(struct ht_synth_s));
+		if (!synth) {
+			printf("Cannot allocate the trace generator\n");
+			return ERROR;
+		}
+		ht_synth_init(synth);
+	}
+
+	memset(g_ht_slot, 0, sizeof(g_ht_slot));
+	memset(g_ht_stat, 0, sizeof(g_ht_stat));
+	memset(g_ht_caller, 0, sizeof(g_ht_caller));
+	g_ht_nocaller = 0;
+	g_ht_seed = HT_SEED;
+	ht_clock_init();
+
+	ht_heapinfo(&info);
+	printf("\nReplaying %s trace, heap free %d, largest %d\n", path ? path : "built-in", info.fordblks, info.mxordblk);
+	printf("\n     Ops |  Used (B) |  Free (B) | Largest (B) | Frag (%%)\n");
+	printf("---------|-----------|-----------|-------------|---------\n");
+
+	while (1) {
+		if (stream) {
+			if (!fgets(line, HT_LINE_LEN, stream)) {
+				break;
+			}
+
+			ret = ht_parse(line, &op);
+			if (ret < 0) {
+				printf("Invalid trace line: %s", line);
+				continue;
+			} else if (ret == 0) {
+				continue;
+			}
+		} else if (!ht_synth_next(synth, &op)) {
+			break;
+		}
+
+		ht_run(&op);
+
+		if (++nops % HT_INTERVAL == 0) {
+			ht_heapinfo(&info);
+			frag = ht_fragmentation(&info);
+			if (min_largest < 0 || info.mxordblk < min_largest) {
+				min_largest = info.mxordblk;
+			}
+
+			if (frag > max_frag) {
+				max_frag = frag;
+			}
+
+			printf(" %7u | %9d | %9d | %11d | %4d.%d\n", nops, info.uordblks, info.fordblks, info.mxordblk, frag / 10, frag % 10);
+		}
+	}
+
+	/* Release what the trace left allocated */
+
+	for (i = 0; i < HT_SLOTS; i++) {
+		if (g_ht_slot[i]) {
+			free(g_ht_slot[i]);
+			g_ht_slot[i] = NULL;
+			leaked++;
+		}
+	}
+
+	if (stream) {
+		fclose(stream);
+	} else {
+		free(synth);
+	}
+
+	ht_report_latency();
+	ht_report_caller();
+
+	printf("\nOperations %u, left allocated by the trace %d\n", nops, leaked);
+	printf("Smallest largest free chunk %d bytes, worst fragmentation %d.%d%%\n", min_largest, max_frag / 10, max_frag % 10);
+
+	return OK;
+}
+
+int heap_trace_dump(const char *path)
+{
+	struct ht_synth_s *synth;
+	struct ht_op_s op;
+	FILE *stream;
+
+	synth = (struct ht_synth_s *)malloc(sizeof(struct ht_synth_s));
+	if (!synth) {
+		printf("Cannot allocate the trace generator\n");
+		return ERROR;
+	}
+
+	stream = fopen(path, "w");
+	if (!stream) {
+		printf("Cannot open trace %s\n", path);
+		free(synth);
+		return ERROR;
+	}
+
+	ht_synth_init(synth);
+	fprintf(stream, "# heap_performance_test built-in trace, seed %d\n", HT_SEED);
+	while (ht_synth_next(synth, &op)) {
+		if (op.type == HT_FREE) {
+			fprintf(stream, "%c %d\n", g_ht_opchar[op.type], op.id);
+		} else {
+			fprintf(stream, "%c %d %u\n", g_ht_opchar[op.type], op.id, op.size);
+		}
+	}
+
+	fclose(stream);
+	free(synth);
+
+	return OK;
+}
+
+#ifdef CONFIG_DEBUG_MM_HEAPTRACE
+/* Called by malloc(), realloc() and free() of every thread while a capture
+ * runs.  The records are only converted to a trace once the hook is
+ * removed, as writing the file would use the heap.
+ */
+
+static void ht_capture_hook(int op, FAR void *oldmem, FAR void *mem, size_t size, mmaddress_t caller)
+{
+	struct ht_rec_s *rec;
+
+	sched_lock();
+	if (g_ht_nrec < HT_CAPTURE_RECORDS) {
+		rec = &g_ht_rec[g_ht_nrec++];
+		rec->type = (uint8_t)op;
+		rec->oldmem = oldmem;
+		rec->mem = mem;
+		rec->size = size;
+		rec->caller = caller;
+	} else {
+		g_ht_lost++;
+	}
+	sched_unlock();
+}
+
+static int ht_capture_find(FAR void *mem)
+{
+	int id;
+
+	for (id = 0; id < HT_SLOTS; id++) {
+		if (g_ht_slot[id] == mem) {
+			return id;
+		}
+	}
+
+	return -1;
+}
+
+int heap_trace_capture(const char *path, int seconds)
+{
+	struct ht_rec_s *rec;
+	FILE *stream;
+	uint32_t skipped = 0;
+	int nrec;
+	int id;
+	int i;
+
+	g_ht_rec = (struct ht_rec_s *)malloc(HT_CAPTURE_RECORDS * sizeof(struct ht_rec_s));
+	if (!g_ht_rec) {
+		printf("Cannot allocate %d trace records\n", HT_CAPTURE_RECORDS);
+		return ERROR;
+	}
+
+	stream = fopen(path, "w");
+	if (!stream) {
+		printf("Cannot open trace %s\n", path);
+		free(g_ht_rec);
+		return ERROR;
+	}
+
+	printf("Capturing heap operations for %d seconds\n", seconds);
+	g_ht_nrec = 0;
+	g_ht_lost = 0;
+	mm_set_trace_hook(ht_capture_hook);
+	sleep(seconds);
+	mm_set_trace_hook(NULL);
+
+	/* Give each chunk which is live in the capture a slot id.  Chunks
+	 * allocated before the capture are unknown to the replay, so their
+	 * frees are left out and their reallocs become mallocs.
+	 */
+
+	memset(g_ht_slot, 0, sizeof(g_ht_slot));
+	nrec = g_ht_nrec;
+	fprintf(stream, "# heap_performance_test capture, %d seconds\n", seconds);
+	for (i = 0; i < nrec; i++) {
+		rec = &g_ht_rec[i];
+		id = rec->oldmem == NULL ? -1 : ht_capture_find(rec->oldmem);
+		if (rec->type == MM_TRACE_FREE) {
+			if (id < 0) {
+				skipped++;
+				continue;
+			}
+			fprintf(stream, "f %d 0x%08lx\n", id, (unsigned long)rec->caller);
+			g_ht_slot[id] = NULL;
+			continue;
+		}
+
+		if (id < 0) {
+			id = ht_capture_find(NULL);
+			if (id < 0) {
+				skipped++;
+				continue;
+			}
+			fprintf(stream, "m %d %u 0x%08lx\n", id, (unsigned int)rec->size, (unsigned long)rec->caller);
+		} else {
+			fprintf(stream, "r %d %u 0x%08lx\n", id, (unsigned int)rec->size, (unsigned long)rec->caller);
+		}
+		g_ht_slot[id] = rec->mem;
+	}
+
+	fclose(stream);
+	free(g_ht_rec);
+	g_ht_rec = NULL;
+	memset(g_ht_slot, 0, sizeof(g_ht_slot));
+
+	printf("Captured %d operations, %u not recorded, %u left out\n", nrec, g_ht_lost, skipped);
+	return OK;
+}
+#endif
@@ -0,0 +1,223 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/// @file memcpy_benchmark.c
+
+/// @brief Measure the throughput of memcpy(), memmove() and memset().
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MB_MAXSIZE      CONFIG_EXAMPLES_MEMCPY_BENCHMARK_MAXSIZE
+#define MB_BYTES        CONFIG_EXAMPLES_MEMCPY_BENCHMARK_BYTES
+#define MB_MINLOOPS     16
+
+/* Extra bytes around the buffers, for the unaligned cases and to detect
+ * writes past the end.
+ */
+
+#define MB_GUARD        8
+
+#if defined(CONFIG_ARCH_MEMCPY)
+#define MB_MEMCPY_NAME  "arch"
+#elif defined(CONFIG_MEMCPY_VIK)
+#define MB_MEMCPY_NAME  "vik"
+#elif defined(CONFIG_MEMCPY_OPTSPEED)
+#define MB_MEMCPY_NAME  "optspeed"
+#else
+#define MB_MEMCPY_NAME  "byte"
+#endif
+
+enum mb_op_e {
+	MB_MEMCPY,					/* Both buffers aligned */
+	MB_MEMCPY_UNALIGNED,		/* Source one byte past an aligned address */
+	MB_MEMMOVE,					/* Destination overlaps the source by one byte */
+	MB_MEMSET,
+	MB_NOPS
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const char *g_opnames[MB_NOPS] = {
+	"memcpy", "memcpy+1", "memmove", "memset"
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint32_t mb_elapsed_us(struct timespec *start, struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1000000 + (end->tv_nsec - start->tv_nsec) / 1000;
+}
+
+/* Check the results against a byte by byte copy for all small sizes and
+ * alignments, so that a broken implementation is not benchmarked.
+ */
+
+static int mb_check(uint8_t *src, uint8_t *dest)
+{
+	int soff;
+	int doff;
+	int n;
+	int i;
+
+	for (soff = 0; soff < 4; soff++) {
+		for (doff = 0; doff < 4; doff++) {
+			for (n = 0; n < 64; n++) {
+				for (i = 0; i < 64 + MB_GUARD; i++) {
+					src[i] = (uint8_t)(i * 7 + n);
+					dest[i] = 0xaa;
+				}
+
+				memcpy(dest + doff, src + soff, n);
+				for (i = 0; i < 64 + MB_GUARD; i++) {
+					if (dest[i] != ((i >= doff && i < doff + n) ? src[i - doff + soff] : 0xaa)) {
+						printf("memcpy failed: source offset %d, destination offset %d, size %d\n", soff, doff, n);
+						return -1;
+					}
+				}
+
+				memset(dest + doff, soff, n);
+				for (i = 0; i < 64 + MB_GUARD; i++) {
+					if (dest[i] != ((i >= doff && i < doff + n) ? soff : 0xaa)) {
+						printf("memset failed: offset %d, size %d\n", doff, n);
+						return -1;
+					}
+				}
+			}
+		}
+	}
+
+	return 0;
+}
+
+static uint32_t mb_run(enum mb_op_e op, uint8_t *src, uint8_t *dest, size_t size)
+{
+	struct timespec start;
+	struct timespec end;
+	uint32_t loops;
+	uint32_t i;
+
+	loops = MB_BYTES / size;
+	if (loops < MB_MINLOOPS) {
+		loops = MB_MINLOOPS;
+	}
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	switch (op) {
+	case MB_MEMCPY:
+		for (i = 0; i < loops; i++) {
+			memcpy(dest, src, size);
+		}
+		break;
+
+	case MB_MEMCPY_UNALIGNED:
+		for (i = 0; i < loops; i++) {
+			memcpy(dest, src + 1, size);
+		}
+		break;
+
+	case MB_MEMMOVE:
+		for (i = 0; i < loops; i++) {
+			memmove(dest + 1, dest, size);
+		}
+		break;
+
+	case MB_MEMSET:
+		for (i = 0; i < loops; i++) {
+			memset(dest, (int)i, size);
+		}
+		break;
+
+	default:
+		break;
+	}
+	clock_gettime(CLOCK_REALTIME, &end);
+
+	/* Report KB/s, which is the same as bytes per ms */
+
+	i = mb_elapsed_us(&start, &end);
+	if (i == 0) {
+		i = 1;
+	}
+
+	return (uint32_t)(((uint64_t)loops * size * 1000) / i);
+}
+
+/****************************************************************************
+ * memcpy_bench_main
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int memcpy_bench_main(int argc, char *argv[])
+#endif
+{
+	uint8_t *src;
+	uint8_t *dest;
+	size_t size;
+	int op;
+
+	src = (uint8_t *)malloc(MB_MAXSIZE + MB_GUARD);
+	dest = (uint8_t *)malloc(MB_MAXSIZE + MB_GUARD);
+	if (src == NULL || dest == NULL) {
+		printf("Failed to allocate 2 x %d bytes\n", MB_MAXSIZE + MB_GUARD);
+		goto errout;
+	}
+
+	if (mb_check(src, dest) < 0) {
+		goto errout;
+	}
+
+	memset(src, 0x5a, MB_MAXSIZE + MB_GUARD);
+
+	printf("memcpy() implementation: %s, throughput in KB/s\n", MB_MEMCPY_NAME);
+	printf("%8s", "size");
+	for (op = 0; op < MB_NOPS; op++) {
+		printf(" %10s", g_opnames[op]);
+	}
+	printf("\n");
+
+	for (size = 1; size <= MB_MAXSIZE; size <<= 1) {
+		printf("%8u", (unsigned int)size);
+		for (op = 0; op < MB_NOPS; op++) {
+			printf(" %10u", mb_run((enum mb_op_e)op, src, dest, size));
+		}
+		printf("\n");
+	}
+
+errout:
+	free(src);
+	free(dest);
+	return 0;
+}
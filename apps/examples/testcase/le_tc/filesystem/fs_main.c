@@ -6081,6 +6081,9 @@ int tc_filesystem_main(int argc, char *argv[])
 #ifdef CONFIG_TC_FS_MOPS
 	tc_fs_mops_main();
 #endif
+#ifdef CONFIG_TC_FS_SMART_CHECKPOINT
+	tc_fs_smart_checkpoint_main();
+#endif
 #if defined(CONFIG_MTD_CONFIG)
 	tc_driver_mtd_config_ops();
 #endif
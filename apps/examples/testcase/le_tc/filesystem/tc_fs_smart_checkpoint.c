@@ -0,0 +1,304 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/// @file tc_fs_smart_checkpoint.c
+
+/// @brief Test Case for the mount checkpoint of the SMART MTD
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <sys/mount.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/mtd.h>
+#include <tinyara/fs/mksmartfs.h>
+#include "tc_common.h"
+#include "tc_internal.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+#ifndef CONFIG_RAMMTD_ERASESIZE
+#define CONFIG_RAMMTD_ERASESIZE 4096
+#endif
+
+#ifndef CONFIG_RAMMTD_ERASESTATE
+#define CONFIG_RAMMTD_ERASESTATE 0xff
+#endif
+
+#define SMART_CP_TEST_IMAGESIZE  (CONFIG_RAMMTD_ERASESIZE * CONFIG_TC_FS_SMART_CHECKPOINT_NEBLOCKS)
+#define SMART_CP_TEST_NFILES     CONFIG_TC_FS_SMART_CHECKPOINT_NFILES
+#define SMART_CP_TEST_FILESIZE   300
+#define SMART_CP_TEST_MINOR      8
+#define SMART_CP_TEST_NDEVS      3
+#define SMART_CP_TEST_MOUNTPOINT "/smartcp"
+#define SMART_CP_TEST_MAGIC      "SMCP"
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+static FAR uint8_t *g_cp_image;
+static FAR struct mtd_dev_s *g_cp_mtd;
+static int g_cp_ndevs;
+static long g_cp_usec_checkpoint;
+static long g_cp_usec_fullscan;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+static void smart_cp_devpath(int ndx, FAR char *path, size_t size)
+{
+	snprintf(path, size, "/dev/smart%d", SMART_CP_TEST_MINOR + ndx);
+}
+
+/* Create a new SMART device on the RAM MTD.  The SMART driver scans the
+ * device when it is created, so this is the part of the mount which the
+ * checkpoint makes shorter.
+ */
+
+static int smart_cp_attach(FAR char *path, size_t size, FAR long *usec)
+{
+	struct timespec start;
+	struct timespec end;
+	int ret;
+
+	if (g_cp_ndevs >= SMART_CP_TEST_NDEVS) {
+		return ERROR;
+	}
+
+	smart_cp_devpath(g_cp_ndevs, path, size);
+	clock_gettime(CLOCK_REALTIME, &start);
+	ret = smart_initialize(SMART_CP_TEST_MINOR + g_cp_ndevs, g_cp_mtd, NULL);
+	clock_gettime(CLOCK_REALTIME, &end);
+	if (ret != OK) {
+		return ret;
+	}
+
+	g_cp_ndevs++;
+	*usec = (end.tv_sec - start.tv_sec) * 1000000L + (end.tv_nsec - start.tv_nsec) / 1000;
+	return OK;
+}
+
+static void smart_cp_fill(int file, FAR uint8_t *buf)
+{
+	int i;
+
+	for (i = 0; i < SMART_CP_TEST_FILESIZE; i++) {
+		buf[i] = (uint8_t)(file * 31 + i);
+	}
+}
+
+static int smart_cp_verify(void)
+{
+	uint8_t expect[SMART_CP_TEST_FILESIZE];
+	uint8_t buf[SMART_CP_TEST_FILESIZE + 1];
+	char name[32];
+	ssize_t nread;
+	int fd;
+	int i;
+
+	for (i = 0; i < SMART_CP_TEST_NFILES; i++) {
+		snprintf(name, sizeof(name), SMART_CP_TEST_MOUNTPOINT"/file%d", i);
+		fd = open(name, O_RDONLY);
+		if (fd < 0) {
+			return ERROR;
+		}
+
+		nread = read(fd, buf, sizeof(buf));
+		close(fd);
+
+		smart_cp_fill(i, expect);
+		if (nread != SMART_CP_TEST_FILESIZE || memcmp(buf, expect, SMART_CP_TEST_FILESIZE) != 0) {
+			return ERROR;
+		}
+	}
+
+	return OK;
+}
+
+static void smart_cp_cleanup(void)
+{
+	char path[16];
+
+	umount(SMART_CP_TEST_MOUNTPOINT);
+
+	/* The SMART and the RAM MTD drivers cannot be uninitialized.  Removing
+	 * the device nodes makes sure that nothing reaches the image any more.
+	 */
+
+	while (g_cp_ndevs > 0) {
+		smart_cp_devpath(--g_cp_ndevs, path, sizeof(path));
+		unregister_blockdriver(path);
+	}
+
+	TC_FREE_MEMORY(g_cp_image);
+	g_cp_mtd = NULL;
+}
+
+/**
+* @testcase         tc_fs_smart_checkpoint_format_p
+* @brief            Format a RAM MTD with SmartFS and write files to it
+* @scenario         Create a SMART device on a RAM MTD, format and mount it,
+*                   write files and unmount it, which saves the checkpoint
+* @apicovered       smart_initialize, mksmartfs, mount, write, umount
+* @precondition     NA
+* @postcondition    NA
+*/
+static void tc_fs_smart_checkpoint_format_p(void)
+{
+	uint8_t buf[SMART_CP_TEST_FILESIZE];
+	char path[16];
+	char name[32];
+	long usec;
+	ssize_t nwritten;
+	int ret;
+	int fd;
+	int i;
+
+	g_cp_image = (FAR uint8_t *)malloc(SMART_CP_TEST_IMAGESIZE);
+	TC_ASSERT_NEQ("malloc", g_cp_image, NULL);
+
+	g_cp_mtd = rammtd_initialize(g_cp_image, SMART_CP_TEST_IMAGESIZE);
+	TC_ASSERT_NEQ_CLEANUP("rammtd_initialize", g_cp_mtd, NULL, smart_cp_cleanup());
+
+	ret = smart_cp_attach(path, sizeof(path), &usec);
+	TC_ASSERT_EQ_CLEANUP("smart_initialize", ret, OK, smart_cp_cleanup());
+
+	ret = mksmartfs(path, true);
+	TC_ASSERT_EQ_CLEANUP("mksmartfs", ret, OK, smart_cp_cleanup());
+
+	ret = mount(path, SMART_CP_TEST_MOUNTPOINT, "smartfs", 0, NULL);
+	TC_ASSERT_EQ_CLEANUP("mount", ret, OK, smart_cp_cleanup());
+
+	for (i = 0; i < SMART_CP_TEST_NFILES; i++) {
+		snprintf(name, sizeof(name), SMART_CP_TEST_MOUNTPOINT"/file%d", i);
+		fd = open(name, O_WRONLY | O_CREAT | O_TRUNC);
+		TC_ASSERT_GEQ_CLEANUP("open", fd, 0, smart_cp_cleanup());
+
+		smart_cp_fill(i, buf);
+		nwritten = write(fd, buf, SMART_CP_TEST_FILESIZE);
+		close(fd);
+		TC_ASSERT_EQ_CLEANUP("write", nwritten, SMART_CP_TEST_FILESIZE, smart_cp_cleanup());
+	}
+
+	ret = umount(SMART_CP_TEST_MOUNTPOINT);
+	TC_ASSERT_EQ_CLEANUP("umount", ret, OK, smart_cp_cleanup());
+
+	TC_SUCCESS_RESULT();
+}
+
+/**
+* @testcase         tc_fs_smart_checkpoint_mount_p
+* @brief            Mount the volume again from the checkpoint
+* @scenario         Create a second SMART device on the same RAM MTD, which
+*                   loads the checkpoint, then mount it and check the files
+* @apicovered       smart_initialize, mount, read, umount
+* @precondition     tc_fs_smart_checkpoint_format_p passed
+* @postcondition    NA
+*/
+static void tc_fs_smart_checkpoint_mount_p(void)
+{
+	char path[16];
+	int ret;
+
+	ret = smart_cp_attach(path, sizeof(path), &g_cp_usec_checkpoint);
+	TC_ASSERT_EQ_CLEANUP("smart_initialize", ret, OK, smart_cp_cleanup());
+
+	ret = mount(path, SMART_CP_TEST_MOUNTPOINT, "smartfs", 0, NULL);
+	TC_ASSERT_EQ_CLEANUP("mount", ret, OK, smart_cp_cleanup());
+
+	ret = smart_cp_verify();
+	TC_ASSERT_EQ_CLEANUP("smart_cp_verify", ret, OK, smart_cp_cleanup());
+
+	ret = umount(SMART_CP_TEST_MOUNTPOINT);
+	TC_ASSERT_EQ_CLEANUP("umount", ret, OK, smart_cp_cleanup());
+
+	TC_SUCCESS_RESULT();
+}
+
+/**
+* @testcase         tc_fs_smart_checkpoint_fullscan_p
+* @brief            Mount the volume again with a full scan
+* @scenario         Erase the checkpoint headers in the image, so that a new
+*                   SMART device has to scan every sector, then mount it,
+*                   check the files and compare the time of both scans
+* @apicovered       smart_initialize, mount, read, umount
+* @precondition     tc_fs_smart_checkpoint_mount_p passed
+* @postcondition    NA
+*/
+static void tc_fs_smart_checkpoint_fullscan_p(void)
+{
+	char path[16];
+	FAR uint8_t *block;
+	int nheaders;
+	int ret;
+	int i;
+
+	/* The unmounts above must have left a checkpoint behind.  Its slots
+	 * start on an erase block with the checkpoint magic.
+	 */
+
+	nheaders = 0;
+	for (i = 0; i < CONFIG_TC_FS_SMART_CHECKPOINT_NEBLOCKS; i++) {
+		block = g_cp_image + i * CONFIG_RAMMTD_ERASESIZE;
+		if (memcmp(block, SMART_CP_TEST_MAGIC, 4) == 0) {
+			memset(block, CONFIG_RAMMTD_ERASESTATE, CONFIG_RAMMTD_ERASESIZE);
+			nheaders++;
+		}
+	}
+	TC_ASSERT_GT_CLEANUP("checkpoint", nheaders, 0, smart_cp_cleanup());
+
+	ret = smart_cp_attach(path, sizeof(path), &g_cp_usec_fullscan);
+	TC_ASSERT_EQ_CLEANUP("smart_initialize", ret, OK, smart_cp_cleanup());
+
+	ret = mount(path, SMART_CP_TEST_MOUNTPOINT, "smartfs", 0, NULL);
+	TC_ASSERT_EQ_CLEANUP("mount", ret, OK, smart_cp_cleanup());
+
+	ret = smart_cp_verify();
+	TC_ASSERT_EQ_CLEANUP("smart_cp_verify", ret, OK, smart_cp_cleanup());
+
+	printf("SMART scan of %d erase blocks: %ld us with the checkpoint, %ld us without\n", CONFIG_TC_FS_SMART_CHECKPOINT_NEBLOCKS, g_cp_usec_checkpoint, g_cp_usec_fullscan);
+
+	smart_cp_cleanup();
+	TC_SUCCESS_RESULT();
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+void tc_fs_smart_checkpoint_main(void)
+{
+	tc_fs_smart_checkpoint_format_p();
+	if (g_cp_mtd == NULL) {
+		return;
+	}
+
+	tc_fs_smart_checkpoint_mount_p();
+	if (g_cp_mtd == NULL) {
+		return;
+	}
+
+	tc_fs_smart_checkpoint_fullscan_p();
+}
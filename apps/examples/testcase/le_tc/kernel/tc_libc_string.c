@@ -31,6 +31,7 @@
 #include <string.h>
 #include <strings.h>
 #include <signal.h>
+#include <time.h>
 
 #include <tinyara/float.h>
 #include <tinyara/math.h>
@@ -39,6 +40,9 @@
 
 #define BUFF_SIZE 5
 #define BUFF_SIZE_10 10
+#define BUFF_SIZE_48 48
+#define SCAN_BUFF_SIZE 1024
+#define SCAN_LOOPS 256
 
 #define EBUSY_STR_SIZE (sizeof(EBUSY_STR))
 
@@ -62,11 +66,39 @@ static void tc_libc_string_memcpy(void)
 	char sz_dest[BUFF_SIZE] = "aaaa";
 	char *res_ptr = NULL;
 
+	char src[BUFF_SIZE_48];
+	char dest[BUFF_SIZE_48];
+	int soff;
+	int doff;
+	int len;
+	int i;
+
 	res_ptr = (char *)memcpy(sz_dest, sz_src, BUFF_SIZE);
 	TC_ASSERT_NEQ("memcpy", res_ptr, NULL);
 	TC_ASSERT_EQ("memcpy", strncmp(sz_dest, res_ptr, BUFF_SIZE), 0);
 	TC_ASSERT_EQ("memcpy", strncmp(sz_dest, sz_src, BUFF_SIZE), 0);
 
+	/* Copy every size up to 40 bytes between all alignments */
+
+	for (i = 0; i < BUFF_SIZE_48; i++) {
+		src[i] = (char)(i + 1);
+	}
+
+	for (soff = 0; soff < 4; soff++) {
+		for (doff = 0; doff < 4; doff++) {
+			for (len = 0; len <= 40; len++) {
+				memset(dest, 0, BUFF_SIZE_48);
+				res_ptr = (char *)memcpy(dest + doff, src + soff, len);
+				TC_ASSERT_EQ("memcpy", res_ptr, dest + doff);
+				TC_ASSERT_EQ("memcpy", memcmp(dest + doff, src + soff, len), 0);
+				TC_ASSERT_EQ("memcpy", dest[doff + len], 0);
+				if (doff > 0) {
+					TC_ASSERT_EQ("memcpy", dest[doff - 1], 0);
+				}
+			}
+		}
+	}
+
 	TC_SUCCESS_RESULT();
 }
 
@@ -85,11 +117,29 @@ static void tc_libc_string_memset(void)
 	char ctarget[BUFF_SIZE] = "aaaa";
 	char *res_ptr = NULL;
 
+	char dest[BUFF_SIZE_48];
+	int off;
+	int len;
+	int i;
+
 	res_ptr = (char *)memset(buffer, 'a', BUFF_SIZE - 1);
 	TC_ASSERT_NEQ("memset", res_ptr, NULL);
 	TC_ASSERT_EQ("memset", strncmp(res_ptr, ctarget, BUFF_SIZE), 0);
 	TC_ASSERT_EQ("memset", strncmp(ctarget, buffer, BUFF_SIZE), 0);
 
+	/* Set every size up to 40 bytes at all alignments */
+
+	for (off = 0; off < 4; off++) {
+		for (len = 0; len <= 40; len++) {
+			memset(dest, 0, BUFF_SIZE_48);
+			res_ptr = (char *)memset(dest + off, 'a', len);
+			TC_ASSERT_EQ("memset", res_ptr, dest + off);
+			for (i = 0; i < BUFF_SIZE_48; i++) {
+				TC_ASSERT_EQ("memset", dest[i], (i >= off && i < off + len) ? 'a' : 0);
+			}
+		}
+	}
+
 	TC_SUCCESS_RESULT();
 }
 
@@ -160,6 +210,12 @@ static void tc_libc_string_memmove(void)
 	char buffer1[BUFF_SIZE] = "test";
 	char buffer2[BUFF_SIZE] = "abcd";
 	char *res_ptr = NULL;
+	char buffer[BUFF_SIZE_48];
+	char expected[BUFF_SIZE_48];
+	int soff;
+	int doff;
+	int len;
+	int i;
 
 	res_ptr = (char *)memmove(buffer1, buffer2, sizeof(buffer1));
 	TC_ASSERT_NEQ("memmove", res_ptr, NULL);
@@ -171,6 +227,22 @@ static void tc_libc_string_memmove(void)
 	TC_ASSERT_EQ("memmove", strncmp(res_ptr, buffer1, BUFF_SIZE), 0);
 	TC_ASSERT_EQ("memmove", strncmp(buffer2, buffer1, BUFF_SIZE), 0);
 
+	/* Move overlapping blocks forward and backward at all alignments */
+
+	for (soff = 0; soff < 8; soff++) {
+		for (doff = 0; doff < 8; doff++) {
+			for (len = 0; len <= 40; len++) {
+				for (i = 0; i < BUFF_SIZE_48; i++) {
+					buffer[i] = (char)(i + 1);
+				}
+				memcpy(expected, buffer + soff, len);
+				res_ptr = (char *)memmove(buffer + doff, buffer + soff, len);
+				TC_ASSERT_EQ("memmove", res_ptr, buffer + doff);
+				TC_ASSERT_EQ("memmove", memcmp(buffer + doff, expected, len), 0);
+			}
+		}
+	}
+
 	TC_SUCCESS_RESULT();
 }
 
@@ -995,6 +1067,98 @@ static void tc_libc_string_strsignal(void)
 }
 #endif
 
+/**
+* @fn                   :tc_libc_string_scan
+* @brief                :Checks strlen, strcmp, strchr and memchr at all alignments and reports their throughput.
+* @Scenario             :Strings of every length up to 40 bytes start at each offset of a word, with the\
+*                        searched character or the first difference at every position.  Then a 1KB string\
+*                        is scanned repeatedly and the throughput is printed.
+* API's covered         :strlen, strcmp, strchr, memchr
+* Preconditions         :none
+* Postconditions        :none
+* @return               :void
+*/
+static void tc_libc_string_scan(void)
+{
+	static char str1[SCAN_BUFF_SIZE];
+	static char str2[SCAN_BUFF_SIZE];
+	struct timespec start;
+	struct timespec end;
+	uint32_t elapsed;
+	size_t total;
+	int off;
+	int len;
+	int pos;
+	int i;
+
+	for (off = 0; off < 8; off++) {
+		for (len = 0; len <= 40; len++) {
+			memset(str1, 'x', BUFF_SIZE_48 + 8);
+			for (i = 0; i < len; i++) {
+				str1[off + i] = 'a' + (i % 16);
+			}
+			str1[off + len] = '\0';
+
+			TC_ASSERT_EQ("strlen", strlen(str1 + off), len);
+			TC_ASSERT_EQ("strchr", strchr(str1 + off, '\0'), str1 + off + len);
+			TC_ASSERT_EQ("strchr", strchr(str1 + off, 'z'), NULL);
+			TC_ASSERT_EQ("memchr", memchr(str1 + off, 'z', len), NULL);
+
+			for (pos = 0; pos < len; pos++) {
+				/* Put a unique character at pos */
+
+				str1[off + pos] = 'z';
+				TC_ASSERT_EQ("strchr", strchr(str1 + off, 'z'), str1 + off + pos);
+				TC_ASSERT_EQ("memchr", memchr(str1 + off, 'z', len), str1 + off + pos);
+				TC_ASSERT_EQ("memchr", memchr(str1 + off, 'z', pos), NULL);
+				str1[off + pos] = 'a' + (pos % 16);
+			}
+
+			for (i = 0; i < 8; i++) {
+				memcpy(str2 + i, str1 + off, len + 1);
+				TC_ASSERT_EQ("strcmp", strcmp(str1 + off, str2 + i), 0);
+				for (pos = 0; pos < len; pos++) {
+					str2[i + pos] = 'A';
+					TC_ASSERT_GT("strcmp", strcmp(str1 + off, str2 + i), 0);
+					TC_ASSERT_LT("strcmp", strcmp(str2 + i, str1 + off), 0);
+					str2[i + pos] = '\0';
+					TC_ASSERT_GT("strcmp", strcmp(str1 + off, str2 + i), 0);
+					str2[i + pos] = str1[off + pos];
+				}
+			}
+		}
+	}
+
+	/* Throughput on a long string, in KB/s */
+
+	memset(str1, 'a', SCAN_BUFF_SIZE - 1);
+	str1[SCAN_BUFF_SIZE - 1] = '\0';
+	memcpy(str2, str1, SCAN_BUFF_SIZE);
+
+	/* Start at a different offset each time, so that the calls can not be
+	 * hoisted out of the loop.
+	 */
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (total = 0, i = 0; i < SCAN_LOOPS; i++) {
+		off = i & 7;
+		total += strlen(str1 + off) + off;
+		total += (size_t)(strchr(str1 + off, 'z') == NULL);
+		total += (size_t)(memchr(str1 + off, 'z', SCAN_BUFF_SIZE - off) == NULL);
+		total += (size_t)strcmp(str1 + off, str2 + off);
+	}
+	clock_gettime(CLOCK_REALTIME, &end);
+	TC_ASSERT_EQ("strlen", total, (size_t)SCAN_LOOPS * (SCAN_BUFF_SIZE + 1));
+
+	elapsed = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
+	if (elapsed == 0) {
+		elapsed = 1;
+	}
+	printf("strlen/strchr/memchr/strcmp: %u KB/s\n", (unsigned int)((uint64_t)SCAN_LOOPS * SCAN_BUFF_SIZE * 5 * 1000 / elapsed));
+
+	TC_SUCCESS_RESULT();
+}
+
 /****************************************************************************
  * Name: libc_string
  ****************************************************************************/
@@ -1039,6 +1203,7 @@ int libc_string_main(void)
 	tc_libc_string_strlcpy();
 	tc_libc_string_strtof();
 	tc_libc_string_strtold();
+	tc_libc_string_scan();
 
 	return 0;
 }
@@ -38,6 +38,7 @@
 #define TEST_TIMES 100
 #define ALL_FREE 0
 #define TOTAL_ALLOC_SIZE (MM_ALIGN_UP((sizeof(int) * ALLOC_SIZE_VAL) + SIZEOF_MM_ALLOCNODE)) * ALLOC_FREE_TIMES
+#define IN_PLACE_SIZE 64
 /****************************************************************************
  * Definitions
  ****************************************************************************/
@@ -296,6 +297,76 @@ static void tc_umm_heap_zalloc(void)
 	TC_SUCCESS_RESULT();
 }
 
+static void in_place_cleanup(char *mem, char *next)
+{
+	free(mem);
+	free(next);
+}
+
+/**
+* @fn                   :tc_umm_heap_realloc_in_place
+* @brief                :Resize memory through realloc_in_place without moving it.
+* @scenario             :Allocate two neighbouring blocks\n
+*                        Grow the first one while the second one is in use\n
+*                        Free the second one and grow the first one into it\n
+*                        Shrink the first one back
+* @API's covered        :malloc, realloc_in_place, free
+* @passcase             :When growing fails with the neighbour in use and succeeds in place once it is free.
+* @failcase             :When the block moves, or its size or data change on failure.
+* @Preconditions        :malloc
+*/
+static void tc_umm_heap_realloc_in_place(void)
+{
+	struct mm_allocnode_s *node;
+	mmsize_t oldsize;
+	char *mem;
+	char *next;
+	char *ret;
+	int idx;
+
+	mem = (char *)malloc(IN_PLACE_SIZE);
+	TC_ASSERT_NEQ("malloc", mem, NULL);
+	next = (char *)malloc(IN_PLACE_SIZE);
+	TC_ASSERT_NEQ_CLEANUP("malloc", next, NULL, free(mem));
+
+	/* The test needs the second block right after the first one */
+
+	node = (struct mm_allocnode_s *)(mem - SIZEOF_MM_ALLOCNODE);
+	oldsize = node->size;
+	TC_ASSERT_EQ_CLEANUP("malloc", (char *)node + oldsize, next - SIZEOF_MM_ALLOCNODE, in_place_cleanup(mem, next));
+	memset(mem, 0x5a, IN_PLACE_SIZE);
+
+	/* The neighbour is in use, so the block can neither grow nor move */
+
+	ret = (char *)realloc_in_place(mem, 2 * IN_PLACE_SIZE);
+	TC_ASSERT_EQ_CLEANUP("realloc_in_place", ret, NULL, in_place_cleanup(mem, next));
+	TC_ASSERT_EQ_CLEANUP("realloc_in_place", node->size, oldsize, in_place_cleanup(mem, next));
+	for (idx = 0; idx < IN_PLACE_SIZE; idx++) {
+		TC_ASSERT_EQ_CLEANUP("realloc_in_place", mem[idx], 0x5a, in_place_cleanup(mem, next));
+	}
+
+#ifndef CONFIG_REALLOC_DISABLE_NEIGHBOR_EXTENSION
+	/* Once the neighbour is free, the block grows into it */
+
+	free(next);
+	next = NULL;
+	ret = (char *)realloc_in_place(mem, 2 * IN_PLACE_SIZE);
+	TC_ASSERT_EQ_CLEANUP("realloc_in_place", ret, mem, free(mem));
+	TC_ASSERT_GEQ_CLEANUP("realloc_in_place", node->size, MM_ALIGN_UP(2 * IN_PLACE_SIZE + SIZEOF_MM_ALLOCNODE), free(mem));
+	for (idx = 0; idx < IN_PLACE_SIZE; idx++) {
+		TC_ASSERT_EQ_CLEANUP("realloc_in_place", mem[idx], 0x5a, free(mem));
+	}
+	memset(mem, 0xa5, 2 * IN_PLACE_SIZE);
+#endif
+
+	ret = (char *)realloc_in_place(mem, IN_PLACE_SIZE / 2);
+	TC_ASSERT_EQ_CLEANUP("realloc_in_place", ret, mem, in_place_cleanup(mem, next));
+	TC_ASSERT_LEQ_CLEANUP("realloc_in_place", node->size, oldsize, in_place_cleanup(mem, next));
+
+	in_place_cleanup(mem, next);
+	TC_SUCCESS_RESULT();
+}
+
 static int umm_task(int argc, char *argv[])
 {
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
@@ -307,6 +378,7 @@ static int umm_task(int argc, char *argv[])
 #endif
 	tc_umm_heap_mallinfo();
 	tc_umm_heap_zalloc();
+	tc_umm_heap_realloc_in_place();
 
 	task_delete(0);
 	return 0;
@@ -88,6 +88,18 @@ int tc_network_main(int argc, char *argv[])
 #ifdef CONFIG_TC_NET_SHUTDOWN
 	net_shutdown_main();
 #endif
+#ifdef CONFIG_TC_NET_EPOLL
+	net_epoll_main();
+#endif
+#ifdef CONFIG_TC_NET_ZEROCOPY
+	net_zerocopy_main();
+#endif
+#ifdef CONFIG_TC_NET_SENDFILE
+	net_sendfile_main();
+#endif
+#ifdef CONFIG_TC_NET_MEMP
+	net_memp_main();
+#endif
 #ifdef CONFIG_TC_NET_DHCPC
 	net_dhcpc_main();
 #endif
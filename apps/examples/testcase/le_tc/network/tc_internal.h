@@ -24,6 +24,23 @@
 
 #include "tc_common.h"
 
+/**********************************************************
+* TC Helper Declarations
+**********************************************************/
+
+#if defined(CONFIG_TC_NET_EPOLL) || defined(CONFIG_TC_NET_ZEROCOPY) || defined(CONFIG_TC_NET_SENDFILE)
+/* A TCP connection over the loopback interface, in tc_net_loopback.c */
+
+struct tc_loopback_s {
+	int listenfd;
+	int clientfd;
+	int serverfd;
+};
+
+int tc_net_loopback_connect(struct tc_loopback_s *lo, int port);
+void tc_net_loopback_close(struct tc_loopback_s *lo);
+#endif
+
 /**********************************************************
 * TC Function Declarations
 **********************************************************/
@@ -82,6 +99,18 @@ int net_shutdown_main(void);
 #ifdef CONFIG_TC_NET_SELECT
 int net_select_main(void);
 #endif
+#ifdef CONFIG_TC_NET_EPOLL
+int net_epoll_main(void);
+#endif
+#ifdef CONFIG_TC_NET_ZEROCOPY
+int net_zerocopy_main(void);
+#endif
+#ifdef CONFIG_TC_NET_SENDFILE
+int net_sendfile_main(void);
+#endif
+#ifdef CONFIG_TC_NET_MEMP
+int net_memp_main(void);
+#endif
 #ifdef CONFIG_TC_NET_DHCPC
 int net_dhcpc_main(void);
 #endif
@@ -0,0 +1,284 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+// @file tc_net_epoll.c
+// @brief Test Case Example for epoll_create1(), epoll_ctl() and epoll_wait() API
+#include <tinyara/config.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include "tc_internal.h"
+
+#define PORTNUM 1116
+#define EPOLL_WAIT_MS 1000
+#define EPOLL_IDLE_MS 100
+
+static int g_epfd = -1;
+static struct tc_loopback_s g_lo;
+
+static void epoll_cleanup(void)
+{
+	if (g_epfd >= 0) {
+		close(g_epfd);
+		g_epfd = -1;
+	}
+	tc_net_loopback_close(&g_lo);
+}
+
+/* Read everything queued on the server socket */
+
+static void epoll_drain(void)
+{
+	char buf[16];
+
+	while (recv(g_lo.serverfd, buf, sizeof(buf), MSG_DONTWAIT) > 0) {
+	}
+}
+
+/**
+   * @testcase		   :tc_net_epoll_create_p
+   * @brief		   :create an epoll instance and watch a connected socket
+   * @scenario		   :
+   * @apicovered	   :epoll_create1(), epoll_ctl()
+   * @precondition	   :
+   * @postcondition	   :
+   */
+static void tc_net_epoll_create_p(void)
+{
+	struct epoll_event ev;
+	int ret;
+
+	g_epfd = epoll_create1(0);
+	TC_ASSERT_GEQ("epoll_create1", g_epfd, 0);
+
+	ev.events = EPOLLIN;
+	ev.data.fd = g_lo.serverfd;
+	ret = epoll_ctl(g_epfd, EPOLL_CTL_ADD, g_lo.serverfd, &ev);
+	TC_ASSERT_EQ("epoll_ctl", ret, OK);
+
+	ret = epoll_ctl(g_epfd, EPOLL_CTL_ADD, g_lo.serverfd, &ev);
+	TC_ASSERT_EQ("epoll_ctl", ret, ERROR);
+	TC_ASSERT_EQ("epoll_ctl", errno, EEXIST);
+
+	TC_SUCCESS_RESULT();
+}
+
+/**
+   * @testcase		   :tc_net_epoll_level_p
+   * @brief		   :a level triggered socket is reported until it is read
+   * @scenario		   :
+   * @apicovered	   :epoll_wait()
+   * @precondition	   :the server socket is watched for EPOLLIN
+   * @postcondition	   :
+   */
+static void tc_net_epoll_level_p(void)
+{
+	struct epoll_event ev;
+	int ret;
+
+	ret = epoll_wait(g_epfd, &ev, 1, 0);
+	TC_ASSERT_EQ("epoll_wait", ret, 0);
+
+	ret = send(g_lo.clientfd, "a", 1, 0);
+	TC_ASSERT_EQ("send", ret, 1);
+
+	ret = epoll_wait(g_epfd, &ev, 1, EPOLL_WAIT_MS);
+	TC_ASSERT_EQ("epoll_wait", ret, 1);
+	TC_ASSERT_EQ("epoll_wait", ev.data.fd, g_lo.serverfd);
+	TC_ASSERT_NEQ("epoll_wait", ev.events & EPOLLIN, 0);
+
+	/* Nothing was read, the socket must have been queued again */
+
+	ret = epoll_wait(g_epfd, &ev, 1, 0);
+	TC_ASSERT_EQ("epoll_wait", ret, 1);
+	TC_ASSERT_EQ("epoll_wait", ev.data.fd, g_lo.serverfd);
+
+	epoll_drain();
+	ret = epoll_wait(g_epfd, &ev, 1, 0);
+	TC_ASSERT_EQ("epoll_wait", ret, 0);
+
+	TC_SUCCESS_RESULT();
+}
+
+/**
+   * @testcase		   :tc_net_epoll_edge_p
+   * @brief		   :an edge triggered socket is reported once per arrival
+   * @scenario		   :
+   * @apicovered	   :epoll_ctl(), epoll_wait()
+   * @precondition	   :the server socket is watched and has no data
+   * @postcondition	   :
+   */
+static void tc_net_epoll_edge_p(void)
+{
+	struct epoll_event ev;
+	int ret;
+
+	ev.events = EPOLLIN | EPOLLET;
+	ev.data.fd = g_lo.serverfd;
+	ret = epoll_ctl(g_epfd, EPOLL_CTL_MOD, g_lo.serverfd, &ev);
+	TC_ASSERT_EQ("epoll_ctl", ret, OK);
+
+	ret = send(g_lo.clientfd, "b", 1, 0);
+	TC_ASSERT_EQ("send", ret, 1);
+
+	ret = epoll_wait(g_epfd, &ev, 1, EPOLL_WAIT_MS);
+	TC_ASSERT_EQ("epoll_wait", ret, 1);
+	TC_ASSERT_NEQ("epoll_wait", ev.events & EPOLLIN, 0);
+
+	/* The data is still there, but there was no new arrival */
+
+	ret = epoll_wait(g_epfd, &ev, 1, EPOLL_IDLE_MS);
+	TC_ASSERT_EQ("epoll_wait", ret, 0);
+
+	ret = send(g_lo.clientfd, "c", 1, 0);
+	TC_ASSERT_EQ("send", ret, 1);
+
+	ret = epoll_wait(g_epfd, &ev, 1, EPOLL_WAIT_MS);
+	TC_ASSERT_EQ("epoll_wait", ret, 1);
+
+	epoll_drain();
+	TC_SUCCESS_RESULT();
+}
+
+/**
+   * @testcase		   :tc_net_epoll_oneshot_p
+   * @brief		   :a one shot socket is disabled until it is modified
+   * @scenario		   :
+   * @apicovered	   :epoll_ctl(), epoll_wait()
+   * @precondition	   :the server socket is watched and has no data
+   * @postcondition	   :
+   */
+static void tc_net_epoll_oneshot_p(void)
+{
+	struct epoll_event ev;
+	int ret;
+
+	ev.events = EPOLLIN | EPOLLONESHOT;
+	ev.data.fd = g_lo.serverfd;
+	ret = epoll_ctl(g_epfd, EPOLL_CTL_MOD, g_lo.serverfd, &ev);
+	TC_ASSERT_EQ("epoll_ctl", ret, OK);
+
+	ret = send(g_lo.clientfd, "d", 1, 0);
+	TC_ASSERT_EQ("send", ret, 1);
+
+	ret = epoll_wait(g_epfd, &ev, 1, EPOLL_WAIT_MS);
+	TC_ASSERT_EQ("epoll_wait", ret, 1);
+
+	ret = send(g_lo.clientfd, "e", 1, 0);
+	TC_ASSERT_EQ("send", ret, 1);
+
+	ret = epoll_wait(g_epfd, &ev, 1, EPOLL_IDLE_MS);
+	TC_ASSERT_EQ("epoll_wait", ret, 0);
+
+	/* Arm it again, the pending data is reported at once */
+
+	ev.events = EPOLLIN;
+	ev.data.fd = g_lo.serverfd;
+	ret = epoll_ctl(g_epfd, EPOLL_CTL_MOD, g_lo.serverfd, &ev);
+	TC_ASSERT_EQ("epoll_ctl", ret, OK);
+
+	ret = epoll_wait(g_epfd, &ev, 1, EPOLL_WAIT_MS);
+	TC_ASSERT_EQ("epoll_wait", ret, 1);
+
+	epoll_drain();
+	TC_SUCCESS_RESULT();
+}
+
+/**
+   * @testcase		   :tc_net_epoll_del_p
+   * @brief		   :a removed socket is not reported any more
+   * @scenario		   :
+   * @apicovered	   :epoll_ctl(), epoll_wait()
+   * @precondition	   :the server socket is watched and has no data
+   * @postcondition	   :the server socket is watched again
+   */
+static void tc_net_epoll_del_p(void)
+{
+	struct epoll_event ev;
+	int ret;
+
+	ret = epoll_ctl(g_epfd, EPOLL_CTL_DEL, g_lo.serverfd, NULL);
+	TC_ASSERT_EQ("epoll_ctl", ret, OK);
+
+	ret = send(g_lo.clientfd, "f", 1, 0);
+	TC_ASSERT_EQ("send", ret, 1);
+
+	ret = epoll_wait(g_epfd, &ev, 1, EPOLL_IDLE_MS);
+	TC_ASSERT_EQ("epoll_wait", ret, 0);
+
+	ret = epoll_ctl(g_epfd, EPOLL_CTL_DEL, g_lo.serverfd, NULL);
+	TC_ASSERT_EQ("epoll_ctl", ret, ERROR);
+	TC_ASSERT_EQ("epoll_ctl", errno, ENOENT);
+
+	epoll_drain();
+
+	ev.events = EPOLLIN;
+	ev.data.fd = g_lo.serverfd;
+	ret = epoll_ctl(g_epfd, EPOLL_CTL_ADD, g_lo.serverfd, &ev);
+	TC_ASSERT_EQ("epoll_ctl", ret, OK);
+
+	TC_SUCCESS_RESULT();
+}
+
+/**
+   * @testcase		   :tc_net_epoll_hup_p
+   * @brief		   :a socket closed in both directions reports EPOLLHUP
+   * @scenario		   :
+   * @apicovered	   :shutdown(), epoll_wait()
+   * @precondition	   :the server socket is watched for EPOLLIN only
+   * @postcondition	   :
+   */
+static void tc_net_epoll_hup_p(void)
+{
+	struct epoll_event ev;
+	int ret;
+
+	ret = shutdown(g_lo.serverfd, SHUT_RDWR);
+	TC_ASSERT_EQ("shutdown", ret, OK);
+
+	ret = epoll_wait(g_epfd, &ev, 1, EPOLL_WAIT_MS);
+	TC_ASSERT_EQ("epoll_wait", ret, 1);
+	TC_ASSERT_NEQ("epoll_wait", ev.events & EPOLLHUP, 0);
+
+	TC_SUCCESS_RESULT();
+}
+
+/****************************************************************************
+ * Name: epoll()
+ ****************************************************************************/
+int net_epoll_main(void)
+{
+	if (tc_net_loopback_connect(&g_lo, PORTNUM) != OK) {
+		printf("loopback connection failed %s:%d:%d\n", __FUNCTION__, __LINE__, errno);
+		epoll_cleanup();
+		return ERROR;
+	}
+
+	tc_net_epoll_create_p();
+	tc_net_epoll_level_p();
+	tc_net_epoll_edge_p();
+	tc_net_epoll_oneshot_p();
+	tc_net_epoll_del_p();
+	tc_net_epoll_hup_p();
+
+	epoll_cleanup();
+	return 0;
+}
@@ -0,0 +1,99 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+// @file tc_net_loopback.c
+// @brief TCP connection over the loopback interface shared by the test cases
+#include <tinyara/config.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include "tc_internal.h"
+
+/**
+   * @fn                   :tc_net_loopback_connect
+   * @brief                :connect a TCP socket pair over the loopback interface
+   * @scenario             :the client socket has TCP_NODELAY set, so that
+   *                        small sends leave at once instead of waiting for
+   *                        an ACK
+   * API's covered         :socket,setsockopt,bind,listen,connect,accept
+   * Preconditions         :
+   * Postconditions        :tc_net_loopback_close() closes the sockets, also
+   *                        on failure
+   * @return               :int
+   */
+int tc_net_loopback_connect(struct tc_loopback_s *lo, int port)
+{
+	struct sockaddr_in sa;
+	int on = 1;
+
+	lo->listenfd = -1;
+	lo->clientfd = -1;
+	lo->serverfd = -1;
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sin_family = AF_INET;
+	sa.sin_port = htons(port);
+	sa.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+	lo->listenfd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (lo->listenfd < 0) {
+		return ERROR;
+	}
+
+	setsockopt(lo->listenfd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+	if (bind(lo->listenfd, (struct sockaddr *)&sa, sizeof(sa)) < 0 || listen(lo->listenfd, 1) < 0) {
+		return ERROR;
+	}
+
+	/* The stack completes the handshake with the backlog of the listener,
+	 * so connect() returns before accept() is called.
+	 */
+
+	lo->clientfd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (lo->clientfd < 0 || connect(lo->clientfd, (struct sockaddr *)&sa, sizeof(sa)) < 0) {
+		return ERROR;
+	}
+
+	setsockopt(lo->clientfd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+	lo->serverfd = accept(lo->listenfd, NULL, NULL);
+	if (lo->serverfd < 0) {
+		return ERROR;
+	}
+
+	return OK;
+}
+
+void tc_net_loopback_close(struct tc_loopback_s *lo)
+{
+	if (lo->serverfd >= 0) {
+		close(lo->serverfd);
+		lo->serverfd = -1;
+	}
+	if (lo->clientfd >= 0) {
+		close(lo->clientfd);
+		lo->clientfd = -1;
+	}
+	if (lo->listenfd >= 0) {
+		close(lo->listenfd);
+		lo->listenfd = -1;
+	}
+}
@@ -0,0 +1,186 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+// @file tc_net_memp.c
+// @brief Test Case Example for the growth of the lwIP memory pools
+#include <tinyara/config.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <net/if.h>
+#include <netutils/netlib.h>
+#include "lwip/memp.h"
+#include "tc_internal.h"
+
+/* NETBUF elements are only taken for a received datagram, so the pool
+ * stays quiet while the test owns most of it.
+ */
+#define MEMP_TEST_POOL MEMP_NETBUF
+#define MEMP_TEST_SLAB CONFIG_NET_MEMP_GROW_SLAB
+#define MEMP_TEST_GROWTH (CONFIG_NET_MEMP_GROW_SLAB * CONFIG_NET_MEMP_GROW_MAXSLABS)
+
+static struct netmon_memp_stats g_pools[MEMP_MAX];
+
+static int memp_get_stats(struct netmon_memp_stats *stats)
+{
+	struct netmon_memp memp;
+
+	memp.npools = MEMP_TEST_POOL + 1;
+	memp.pools = g_pools;
+	if (netlib_netmon_mempstats(&memp) != OK) {
+		return ERROR;
+	}
+
+	*stats = g_pools[MEMP_TEST_POOL];
+	return OK;
+}
+
+static void memp_release(void **elems, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++) {
+		memp_free(MEMP_TEST_POOL, elems[i]);
+	}
+	free(elems);
+}
+
+/**
+   * @testcase		   :tc_net_memp_stats_short_p
+   * @brief		   :SIOCGMEMPSTATS fills in only the entries it is given
+   * @scenario		   :ask for the number of pools, then pass a buffer
+   *			    for a single pool and check that the next entry is
+   *			    untouched and the number of pools is reported
+   * @apicovered	   :netlib_netmon_mempstats()
+   * @precondition	   :
+   * @postcondition	   :
+   */
+static void tc_net_memp_stats_short_p(void)
+{
+	struct netmon_memp memp;
+	int ret;
+
+	memp.npools = 0;
+	memp.pools = NULL;
+	ret = netlib_netmon_mempstats(&memp);
+	TC_ASSERT_EQ("netlib_netmon_mempstats", ret, OK);
+	TC_ASSERT_EQ("netlib_netmon_mempstats", memp.npools, MEMP_MAX);
+
+	memset(g_pools, 0xa5, 2 * sizeof(struct netmon_memp_stats));
+	memp.npools = 1;
+	memp.pools = g_pools;
+	ret = netlib_netmon_mempstats(&memp);
+	TC_ASSERT_EQ("netlib_netmon_mempstats", ret, OK);
+	TC_ASSERT_EQ("netlib_netmon_mempstats", memp.npools, MEMP_MAX);
+	TC_ASSERT_LT("netlib_netmon_mempstats", strnlen(g_pools[0].name, NETMON_MEMP_NAMELEN), NETMON_MEMP_NAMELEN);
+	TC_ASSERT_GT("netlib_netmon_mempstats", g_pools[0].limit, 0);
+	TC_ASSERT_EQ("netlib_netmon_mempstats", g_pools[1].size, 0xa5a5);
+	TC_ASSERT_EQ("netlib_netmon_mempstats", g_pools[1].limit, 0xa5a5a5a5);
+
+	TC_SUCCESS_RESULT();
+}
+
+/**
+   * @testcase		   :tc_net_memp_stats_n
+   * @brief		   :SIOCGMEMPSTATS rejects entries without a buffer
+   * @scenario		   :
+   * @apicovered	   :netlib_netmon_mempstats()
+   * @precondition	   :
+   * @postcondition	   :
+   */
+static void tc_net_memp_stats_n(void)
+{
+	struct netmon_memp memp;
+	int ret;
+
+	memp.npools = 1;
+	memp.pools = NULL;
+	ret = netlib_netmon_mempstats(&memp);
+	TC_ASSERT_EQ("netlib_netmon_mempstats", ret, ERROR);
+
+	TC_SUCCESS_RESULT();
+}
+
+/**
+   * @testcase		   :tc_net_memp_grow_p
+   * @brief		   :a pool grows past its size and shrinks again
+   * @scenario		   :take two slabs more than the static pool holds,
+   *			    check that the pool grew, free everything and check
+   *			    that at most one unused slab is kept
+   * @apicovered	   :memp_malloc(), memp_free(), netlib_netmon_mempstats()
+   * @precondition	   :
+   * @postcondition	   :
+   */
+static void tc_net_memp_grow_p(void)
+{
+	struct netmon_memp_stats stats;
+	void **elems;
+	u32_t num;
+	int count;
+	int ret;
+	int n;
+
+	ret = memp_get_stats(&stats);
+	TC_ASSERT_EQ("memp_get_stats", ret, OK);
+	num = stats.limit - MEMP_TEST_GROWTH;
+	TC_ASSERT_LEQ("memp_get_stats", stats.avail, num + MEMP_TEST_SLAB);
+
+	count = (int)num + 2 * MEMP_TEST_SLAB;
+	if (count > (int)stats.limit) {
+		count = (int)stats.limit;
+	}
+	elems = (void **)malloc(count * sizeof(void *));
+	TC_ASSERT_NEQ("malloc", elems, NULL);
+
+	for (n = 0; n < count; n++) {
+		elems[n] = memp_malloc(MEMP_TEST_POOL);
+		if (elems[n] == NULL) {
+			break;
+		}
+	}
+
+	ret = memp_get_stats(&stats);
+	TC_ASSERT_EQ_CLEANUP("memp_get_stats", ret, OK, memp_release(elems, n));
+	TC_ASSERT_GT_CLEANUP("memp_malloc", n, (int)num, memp_release(elems, n));
+	TC_ASSERT_GT_CLEANUP("memp_malloc", stats.avail, num, memp_release(elems, n));
+	TC_ASSERT_GEQ_CLEANUP("memp_malloc", stats.used, (u32_t)n, memp_release(elems, n));
+	TC_ASSERT_LEQ_CLEANUP("memp_malloc", stats.avail, stats.limit, memp_release(elems, n));
+
+	memp_release(elems, n);
+
+	/* Only one unused slab stays with the pool */
+
+	ret = memp_get_stats(&stats);
+	TC_ASSERT_EQ("memp_get_stats", ret, OK);
+	TC_ASSERT_GEQ("memp_free", stats.avail, num);
+	TC_ASSERT_LEQ("memp_free", stats.avail, num + MEMP_TEST_SLAB);
+
+	TC_SUCCESS_RESULT();
+}
+
+/****************************************************************************
+ * Name: memp()
+ ****************************************************************************/
+int net_memp_main(void)
+{
+	tc_net_memp_stats_short_p();
+	tc_net_memp_stats_n();
+	tc_net_memp_grow_p();
+	return 0;
+}
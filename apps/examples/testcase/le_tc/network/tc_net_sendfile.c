@@ -0,0 +1,255 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+// @file tc_net_sendfile.c
+// @brief Test Case Example for sendfile() to sockets
+#include <tinyara/config.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include "tc_internal.h"
+
+#define PORTNUM 1118
+#define SF_FILE_PATH "/mnt/tc_net_sendfile"
+
+/* More than the buffers of one call can hold, and not a multiple of them */
+
+#define SF_FILELEN (2 * CONFIG_NET_SENDFILE_CHUNKSIZE * CONFIG_NET_SENDFILE_NCHUNKS + 123)
+
+/* The file position set before sendfile() with an offset */
+
+#define SF_FILEPOS 7
+#define SF_UDPLEN 100
+
+static struct tc_loopback_s g_lo;
+static uint8_t *g_sfrxbuf;
+static volatile size_t g_sfrxlen;
+
+static uint8_t sf_pattern(int i)
+{
+	return (uint8_t)(i * 13 + (i >> 8));
+}
+
+/**
+   * @fn                   :sf_make_file
+   * @brief                :write SF_FILELEN bytes of a known pattern
+   * @scenario             :
+   * API's covered         :open,write,close
+   * Preconditions         :
+   * Postconditions        :
+   * @return               :int
+   */
+static int sf_make_file(void)
+{
+	uint8_t buf[64];
+	int fd;
+	int ret;
+	int i;
+	int j;
+
+	fd = open(SF_FILE_PATH, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if (fd < 0) {
+		return ERROR;
+	}
+
+	for (i = 0; i < SF_FILELEN; i += j) {
+		for (j = 0; j < (int)sizeof(buf) && i + j < SF_FILELEN; j++) {
+			buf[j] = sf_pattern(i + j);
+		}
+
+		ret = write(fd, buf, j);
+		if (ret != j) {
+			close(fd);
+			return ERROR;
+		}
+	}
+
+	close(fd);
+	return OK;
+}
+
+/* Reads the file on the server socket while sendfile() waits for ACKs */
+
+static void *sf_receiver(void *arg)
+{
+	ssize_t ret;
+
+	while (g_sfrxlen < SF_FILELEN) {
+		ret = recv(g_lo.serverfd, g_sfrxbuf + g_sfrxlen, SF_FILELEN - g_sfrxlen, 0);
+		if (ret <= 0) {
+			break;
+		}
+		g_sfrxlen += ret;
+	}
+
+	return NULL;
+}
+
+static void sf_cleanup(int fd)
+{
+	close(fd);
+	free(g_sfrxbuf);
+	g_sfrxbuf = NULL;
+}
+
+/**
+   * @testcase		   :tc_net_sendfile_tcp_p
+   * @brief		   :send a file to a TCP socket with an offset
+   * @scenario		   :the file is larger than the buffers of one call.
+   *			    The received data must match the file, *offset must
+   *			    advance by what was sent and the file position must
+   *			    stay where it was.
+   * @apicovered	   :sendfile()
+   * @precondition	   :
+   * @postcondition	   :
+   */
+static void tc_net_sendfile_tcp_p(void)
+{
+	pthread_t receiver;
+	off_t offset;
+	off_t pos;
+	ssize_t ret;
+	int fd;
+	int i;
+
+	fd = open(SF_FILE_PATH, O_RDONLY);
+	TC_ASSERT_GEQ("open", fd, 0);
+
+	g_sfrxbuf = (uint8_t *)malloc(SF_FILELEN);
+	TC_ASSERT_NEQ_CLEANUP("malloc", g_sfrxbuf, NULL, close(fd));
+	g_sfrxlen = 0;
+
+	pos = lseek(fd, SF_FILEPOS, SEEK_SET);
+	TC_ASSERT_EQ_CLEANUP("lseek", pos, SF_FILEPOS, sf_cleanup(fd));
+
+	ret = pthread_create(&receiver, NULL, sf_receiver, NULL);
+	TC_ASSERT_EQ_CLEANUP("pthread_create", ret, 0, sf_cleanup(fd));
+
+	/* A partial transfer is continued from the updated offset */
+
+	offset = 0;
+	while (offset < SF_FILELEN) {
+		ret = sendfile(g_lo.clientfd, fd, &offset, SF_FILELEN - offset);
+		if (ret <= 0) {
+			break;
+		}
+	}
+
+	/* Let the receiver see the end of the data if sendfile() failed */
+
+	if (offset < SF_FILELEN) {
+		shutdown(g_lo.clientfd, SHUT_RDWR);
+	}
+
+	pthread_join(receiver, NULL);
+	TC_ASSERT_EQ_CLEANUP("sendfile", offset, SF_FILELEN, sf_cleanup(fd));
+	TC_ASSERT_EQ_CLEANUP("sendfile", g_sfrxlen, SF_FILELEN, sf_cleanup(fd));
+	for (i = 0; i < SF_FILELEN; i++) {
+		TC_ASSERT_EQ_CLEANUP("sendfile", g_sfrxbuf[i], sf_pattern(i), sf_cleanup(fd));
+	}
+
+	pos = lseek(fd, 0, SEEK_CUR);
+	TC_ASSERT_EQ_CLEANUP("sendfile", pos, SF_FILEPOS, sf_cleanup(fd));
+
+	sf_cleanup(fd);
+	TC_SUCCESS_RESULT();
+}
+
+/**
+   * @testcase		   :tc_net_sendfile_udp_p
+   * @brief		   :sendfile() to a UDP socket copies the data
+   * @scenario		   :the network stack only sends files to TCP sockets,
+   *			    a UDP socket falls back to reading and writing the
+   *			    file, which sends it as a datagram
+   * @apicovered	   :sendfile()
+   * @precondition	   :
+   * @postcondition	   :
+   */
+static void tc_net_sendfile_udp_p(void)
+{
+	struct sockaddr_in sa;
+	uint8_t buf[SF_UDPLEN];
+	off_t offset;
+	int sock;
+	int fd;
+	int ret;
+	int i;
+
+	fd = open(SF_FILE_PATH, O_RDONLY);
+	TC_ASSERT_GEQ("open", fd, 0);
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	TC_ASSERT_GEQ_CLEANUP("socket", sock, 0, close(fd));
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sin_family = AF_INET;
+	sa.sin_port = htons(PORTNUM);
+	sa.sin_addr.s_addr = inet_addr("127.0.0.1");
+	ret = bind(sock, (struct sockaddr *)&sa, sizeof(sa));
+	TC_ASSERT_EQ_CLEANUP("bind", ret, OK, close(sock); close(fd));
+	ret = connect(sock, (struct sockaddr *)&sa, sizeof(sa));
+	TC_ASSERT_EQ_CLEANUP("connect", ret, OK, close(sock); close(fd));
+
+	offset = SF_FILEPOS;
+	ret = sendfile(sock, fd, &offset, SF_UDPLEN);
+	TC_ASSERT_EQ_CLEANUP("sendfile", ret, SF_UDPLEN, close(sock); close(fd));
+	TC_ASSERT_EQ_CLEANUP("sendfile", offset, SF_FILEPOS + SF_UDPLEN, close(sock); close(fd));
+
+	ret = recv(sock, buf, sizeof(buf), 0);
+	TC_ASSERT_EQ_CLEANUP("recv", ret, SF_UDPLEN, close(sock); close(fd));
+	for (i = 0; i < SF_UDPLEN; i++) {
+		TC_ASSERT_EQ_CLEANUP("sendfile", buf[i], sf_pattern(SF_FILEPOS + i), close(sock); close(fd));
+	}
+
+	close(sock);
+	close(fd);
+	TC_SUCCESS_RESULT();
+}
+
+/****************************************************************************
+ * Name: sendfile()
+ ****************************************************************************/
+int net_sendfile_main(void)
+{
+	if (sf_make_file() != OK) {
+		printf("cannot write %s %s:%d:%d\n", SF_FILE_PATH, __FUNCTION__, __LINE__, errno);
+		return ERROR;
+	}
+
+	if (tc_net_loopback_connect(&g_lo, PORTNUM) != OK) {
+		printf("loopback connection failed %s:%d:%d\n", __FUNCTION__, __LINE__, errno);
+		tc_net_loopback_close(&g_lo);
+		unlink(SF_FILE_PATH);
+		return ERROR;
+	}
+
+	tc_net_sendfile_tcp_p();
+	tc_net_loopback_close(&g_lo);
+
+	tc_net_sendfile_udp_p();
+	unlink(SF_FILE_PATH);
+	return 0;
+}
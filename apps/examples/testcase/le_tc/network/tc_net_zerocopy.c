@@ -0,0 +1,191 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+// @file tc_net_zerocopy.c
+// @brief Test Case Example for recv_zc() and send_zc() API
+#include <tinyara/config.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "tc_internal.h"
+
+#define PORTNUM 1117
+#define ZC_DATALEN 4096
+#define ZC_WAIT_MS 1000
+
+static struct tc_loopback_s g_lo;
+
+static uint8_t g_zcdata[ZC_DATALEN];
+static volatile int g_zcreleased;
+static void *volatile g_zcbuf;
+static void *volatile g_zcarg;
+
+/* Runs in the network thread once TCP freed the last segment of the data */
+
+static void zc_release(void *buf, void *arg)
+{
+	g_zcbuf = buf;
+	g_zcarg = arg;
+	g_zcreleased++;
+}
+
+/**
+   * @testcase		   :tc_net_zerocopy_tcp_p
+   * @brief		   :send and receive a buffer without copies
+   * @scenario		   :the data is sent with send_zc() and received with
+   *			    recv_zc(), then compared with the original. The
+   *			    buffer must be released exactly once, after the
+   *			    peer acknowledged it.
+   * @apicovered	   :send_zc(), recv_zc(), recv_zc_release()
+   * @precondition	   :
+   * @postcondition	   :
+   */
+static void tc_net_zerocopy_tcp_p(void)
+{
+	struct zc_rbuf zb;
+	size_t total;
+	int ret;
+	int i;
+
+	for (i = 0; i < ZC_DATALEN; i++) {
+		g_zcdata[i] = (uint8_t)(i * 7 + (i >> 8));
+	}
+	g_zcreleased = 0;
+
+	ret = send_zc(g_lo.clientfd, g_zcdata, ZC_DATALEN, 0, zc_release, (void *)&g_zcreleased);
+	TC_ASSERT_EQ("send_zc", ret, ZC_DATALEN);
+
+	total = 0;
+	while (total < ZC_DATALEN) {
+		ret = recv_zc(g_lo.serverfd, &zb, ZC_DATALEN - total, 0);
+		TC_ASSERT_GT("recv_zc", ret, 0);
+
+		for (i = 0; i < zb.nseg; i++) {
+			if (total + zb.seg[i].iov_len > ZC_DATALEN || memcmp(zb.seg[i].iov_base, g_zcdata + total, zb.seg[i].iov_len) != 0) {
+				recv_zc_release(&zb);
+				TC_ASSERT("recv_zc", false);
+			}
+			total += zb.seg[i].iov_len;
+		}
+		recv_zc_release(&zb);
+	}
+	TC_ASSERT_EQ("recv_zc", total, ZC_DATALEN);
+
+	/* The ACK of the last segment frees it in the network thread */
+
+	for (i = 0; i < ZC_WAIT_MS / 10 && g_zcreleased == 0; i++) {
+		usleep(10000);
+	}
+	TC_ASSERT_EQ("send_zc", g_zcreleased, 1);
+	TC_ASSERT_EQ("send_zc", g_zcbuf, (void *)g_zcdata);
+	TC_ASSERT_EQ("send_zc", g_zcarg, (void *)&g_zcreleased);
+
+	TC_SUCCESS_RESULT();
+}
+
+/**
+   * @testcase		   :tc_net_zerocopy_len_n
+   * @brief		   :recv_zc() rejects a zero length and keeps the data
+   * @scenario		   :
+   * @apicovered	   :recv_zc(), recv_zc_release()
+   * @precondition	   :
+   * @postcondition	   :
+   */
+static void tc_net_zerocopy_len_n(void)
+{
+	struct zc_rbuf zb;
+	int ret;
+
+	ret = send(g_lo.clientfd, "z", 1, 0);
+	TC_ASSERT_EQ("send", ret, 1);
+
+	ret = recv_zc(g_lo.serverfd, &zb, 0, 0);
+	TC_ASSERT_EQ("recv_zc", ret, -1);
+	TC_ASSERT_EQ("recv_zc", errno, EINVAL);
+
+	ret = recv_zc(g_lo.serverfd, &zb, 16, 0);
+	TC_ASSERT_EQ("recv_zc", ret, 1);
+	TC_ASSERT_EQ_CLEANUP("recv_zc", *(char *)zb.seg[0].iov_base, 'z', recv_zc_release(&zb));
+	recv_zc_release(&zb);
+
+	TC_SUCCESS_RESULT();
+}
+
+/**
+   * @testcase		   :tc_net_zerocopy_udp_len_n
+   * @brief		   :a zero length recv_zc() does not drop a datagram
+   * @scenario		   :
+   * @apicovered	   :recv_zc(), recv_zc_release()
+   * @precondition	   :
+   * @postcondition	   :
+   */
+static void tc_net_zerocopy_udp_len_n(void)
+{
+	struct sockaddr_in sa;
+	struct zc_rbuf zb;
+	int fd;
+	int ret;
+
+	fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	TC_ASSERT_GEQ("socket", fd, 0);
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sin_family = AF_INET;
+	sa.sin_port = htons(PORTNUM);
+	sa.sin_addr.s_addr = inet_addr("127.0.0.1");
+	ret = bind(fd, (struct sockaddr *)&sa, sizeof(sa));
+	TC_ASSERT_EQ_CLEANUP("bind", ret, OK, close(fd));
+
+	ret = sendto(fd, "datagram", 8, 0, (struct sockaddr *)&sa, sizeof(sa));
+	TC_ASSERT_EQ_CLEANUP("sendto", ret, 8, close(fd));
+
+	ret = recv_zc(fd, &zb, 0, 0);
+	TC_ASSERT_EQ_CLEANUP("recv_zc", ret, -1, close(fd));
+
+	ret = recv_zc(fd, &zb, 64, 0);
+	TC_ASSERT_EQ_CLEANUP("recv_zc", ret, 8, close(fd));
+	TC_ASSERT_EQ_CLEANUP("recv_zc", memcmp(zb.seg[0].iov_base, "datagram", 8), 0, recv_zc_release(&zb); close(fd));
+	recv_zc_release(&zb);
+
+	close(fd);
+	TC_SUCCESS_RESULT();
+}
+
+/****************************************************************************
+ * Name: zerocopy()
+ ****************************************************************************/
+int net_zerocopy_main(void)
+{
+	if (tc_net_loopback_connect(&g_lo, PORTNUM) != OK) {
+		printf("loopback connection failed %s:%d:%d\n", __FUNCTION__, __LINE__, errno);
+		tc_net_loopback_close(&g_lo);
+		return ERROR;
+	}
+
+	tc_net_zerocopy_tcp_p();
+	tc_net_zerocopy_len_n();
+	tc_net_loopback_close(&g_lo);
+
+	tc_net_zerocopy_udp_len_n();
+	return 0;
+}
@@ -371,6 +371,91 @@ static void utc_arastorage_db_exec_n(void)
 	TC_SUCCESS_RESULT();
 }
 
+/**
+* @testcase         utc_arastorage_db_batch_commit_p
+* @brief            Insert tuples with the batched insert API
+* @scenario         Begin a batch, bind and append tuples, commit and select them
+* @apicovered       db_batch_begin, db_batch_bind_int, db_batch_bind_long, db_batch_append, db_batch_commit
+* @precondition     utc_arastorage_db_exec_p should be passed
+* @postcondition    none
+*/
+static void utc_arastorage_db_batch_commit_p(void)
+{
+	db_result_t res;
+	db_batch_t *batch;
+	char query[QUERY_LENGTH];
+	int i;
+
+	batch = db_batch_begin(RELATION_NAME2);
+	TC_ASSERT_NEQ("db_batch_begin", batch, NULL);
+
+	for (i = 0; i < DATA_SET_NUM * 10; i++) {
+		res = db_batch_bind_int(batch, 0, DATA_SET_NUM * 10 + i);
+		TC_ASSERT_EQ_CLEANUP("db_batch_bind_int", DB_SUCCESS(res), true, db_batch_commit(batch));
+		res = db_batch_bind_long(batch, 1, rand() % 10000);
+		TC_ASSERT_EQ_CLEANUP("db_batch_bind_long", DB_SUCCESS(res), true, db_batch_commit(batch));
+		res = db_batch_append(batch);
+		TC_ASSERT_EQ_CLEANUP("db_batch_append", DB_SUCCESS(res), true, db_batch_commit(batch));
+	}
+
+	res = db_batch_commit(batch);
+	TC_ASSERT_EQ("db_batch_commit", DB_SUCCESS(res), true);
+
+	/* Select the batched tuples over the bplus-tree index */
+	snprintf(query, QUERY_LENGTH, "SELECT id, date FROM %s WHERE date < 5000;", RELATION_NAME2);
+	check_query_result(query);
+
+	TC_SUCCESS_RESULT();
+}
+
+/**
+* @testcase         utc_arastorage_db_batch_commit_n
+* @brief            Use the batched insert API with invalid argument
+* @scenario         Begin a batch on invalid relation, bind a wrong domain, append an incomplete tuple
+* @apicovered       db_batch_begin, db_batch_bind_int, db_batch_bind_string, db_batch_append, db_batch_commit
+* @precondition     none
+* @postcondition    none
+*/
+static void utc_arastorage_db_batch_commit_n(void)
+{
+	db_result_t res;
+	db_batch_t *batch;
+
+	batch = db_batch_begin("BAD_RELATION");
+	TC_ASSERT_EQ("db_batch_begin", batch, NULL);
+
+	batch = db_batch_begin(NULL);
+	TC_ASSERT_EQ("db_batch_begin", batch, NULL);
+
+	res = db_batch_append(NULL);
+	TC_ASSERT_EQ("db_batch_append", DB_ERROR(res), true);
+
+	res = db_batch_commit(NULL);
+	TC_ASSERT_EQ("db_batch_commit", DB_ERROR(res), true);
+
+	batch = db_batch_begin(RELATION_NAME2);
+	TC_ASSERT_NEQ("db_batch_begin", batch, NULL);
+
+	/* Attribute index out of range */
+	res = db_batch_bind_int(batch, 100, 0);
+	TC_ASSERT_EQ_CLEANUP("db_batch_bind_int", DB_ERROR(res), true, db_batch_commit(batch));
+
+	/* String value for a long attribute */
+	res = db_batch_bind_string(batch, 1, (unsigned char *)"apple");
+	TC_ASSERT_EQ_CLEANUP("db_batch_bind_string", DB_ERROR(res), true, db_batch_commit(batch));
+
+	/* The second attribute has no value */
+	res = db_batch_bind_int(batch, 0, 0);
+	TC_ASSERT_EQ_CLEANUP("db_batch_bind_int", DB_SUCCESS(res), true, db_batch_commit(batch));
+	res = db_batch_append(batch);
+	TC_ASSERT_EQ_CLEANUP("db_batch_append", DB_ERROR(res), true, db_batch_commit(batch));
+
+	res = db_batch_commit(batch);
+	TC_ASSERT_EQ("db_batch_commit", DB_SUCCESS(res), true);
+
+	TC_SUCCESS_RESULT();
+}
+
 /**
 * @testcase         utc_arastorage_db_query_p
 * @brief            Query a database
@@ -1526,6 +1611,7 @@ int utc_arastorage_main(int argc, char *argv[])
 	/* Positive TCs */
 	utc_arastorage_db_init_p();
 	utc_arastorage_db_exec_p();
+	utc_arastorage_db_batch_commit_p();
 	utc_arastorage_db_query_p();
 	utc_arastorage_db_get_result_message_p();
 	utc_arastorage_db_print_header_p();
@@ -1556,6 +1642,7 @@ int utc_arastorage_main(int argc, char *argv[])
 
 	/* Negative TCs */
 	utc_arastorage_db_exec_n();
+	utc_arastorage_db_batch_commit_n();
 	utc_arastorage_db_query_n();
 	utc_arastorage_db_get_result_message_n();
 	utc_arastorage_db_print_header_n();
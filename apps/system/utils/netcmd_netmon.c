@@ -26,6 +26,7 @@
 #include <sys/ioctl.h>
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <errno.h>
 #include <stdint.h>
 #include <unistd.h>
@@ -50,6 +51,8 @@
 	"       netmon sock\n"						\
 	"\n WiFi Manager stats:\n"					\
 	"       netmon wifi\n"						\
+	"\n Memory pool stats:\n"					\
+	"       netmon memp\n"						\
 	"\n Net device stats:\n"					\
 	"       netmon [devname]\n\n"
 
@@ -290,6 +293,46 @@ static void print_devstats(struct netmon_netdev_stats *stats)
 }
 #endif							/* CONFIG_NET_STATS */
 
+#ifdef CONFIG_NET_MEMP_STATS
+/**
+ * Print the usage of the network stack memory pools.
+ */
+static int print_memp(void)
+{
+	struct netmon_memp memp = {0, NULL};
+	int i;
+
+	/* Ask for the number of pools first */
+	if (netlib_netmon_mempstats(&memp) != OK) {
+		printf("Failed to fetch memory pool stats.\n");
+		return ERROR;
+	}
+	memp.pools = (struct netmon_memp_stats *)malloc(memp.npools * sizeof(struct netmon_memp_stats));
+	if (!memp.pools) {
+		printf("Failed to allocate memory.\n");
+		return ERROR;
+	}
+	if (netlib_netmon_mempstats(&memp) != OK) {
+		printf("Failed to fetch memory pool stats.\n");
+		free(memp.pools);
+		return ERROR;
+	}
+
+	printf("\n=====================================================================\n");
+	printf("POOL             SIZE   AVAIL   LIMIT   USED    MAX     ERR\n");
+	printf("---------------------------------------------------------------------\n");
+	for (i = 0; i < memp.npools; i++) {
+		struct netmon_memp_stats *st = &memp.pools[i];
+		printf("%-17s%-7u%-8u%-8u", st->name, st->size, (unsigned int)st->avail, (unsigned int)st->limit);
+		printf("%-8u%-8u%u\n", (unsigned int)st->used, (unsigned int)st->max, (unsigned int)st->err);
+	}
+	printf("=====================================================================\n");
+
+	free(memp.pools);
+	return OK;
+}
+#endif							/* CONFIG_NET_MEMP_STATS */
+
 static inline int _print_wifi_info(void)
 {
 #ifdef CONFIG_WIFI_MANAGER
@@ -378,6 +421,13 @@ int cmd_netmon(int argc, char **argv)
 		}
 	} else if (!(strncmp(argv[1], "wifi", strlen("wifi") + 1))) {
 		return _print_wifi_info();
+	} else if (!(strncmp(argv[1], "memp", strlen("memp") + 1))) {
+#ifdef CONFIG_NET_MEMP_STATS
+		return print_memp();
+#else
+		printf("Memory pool stats are not enabled\n");
+		return ERROR;
+#endif
 	} else {
 #ifdef CONFIG_NET_STATS
 		struct netmon_netdev_stats stats = {{0,}, 0, 0, 0, 0};
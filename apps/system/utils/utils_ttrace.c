@@ -52,6 +52,7 @@ int is_overwritable = 0;
 static void show_help(void);
 void wait_ttrace_dump(void);
 
+#ifndef CONFIG_TTRACE_COMPACT
 static int print_uid_packet(struct trace_packet *packet)
 {
 	int8_t uid = packet->codelen & ~TTRACE_CODE_UNIQUE;
@@ -101,6 +102,103 @@ static int print_packet(struct trace_packet *packet)
 		return print_message_packet(packet);
 	}
 }
+#endif
+
+#ifdef CONFIG_TTRACE_COMPACT
+static const char *find_task_name(const char **names, int16_t *pids, int ntasks, int16_t pid)
+{
+	int i;
+
+	/* The latest name of a pid wins, pids are reused */
+	for (i = ntasks - 1; i >= 0; i--) {
+		if (pids[i] == pid) {
+			return names[i];
+		}
+	}
+	return "?";
+}
+
+/* Print compact records in the same text format as trace packets */
+static void print_compact(char *buffer, int len)
+{
+	const char *strs[CONFIG_TTRACE_STRTAB_SIZE];
+	const char *task_names[CONFIG_TTRACE_STRTAB_SIZE];
+	int16_t task_pids[CONFIG_TTRACE_STRTAB_SIZE];
+	struct ttrace_dump_hdr_s *hdr = (struct ttrace_dump_hdr_s *)buffer;
+	struct ttrace_rec_s *rec;
+	struct ttrace_rec_sched_s *srec;
+	struct ttrace_rec_str_s *strrec;
+	uint32_t usec = 0;
+	int ntasks = 0;
+	int offset;
+
+	if (len < sizeof(struct ttrace_dump_hdr_s) || memcmp(hdr->magic, TTRACE_DUMP_MAGIC, sizeof(hdr->magic)) != 0) {
+		printf("Invalid trace dump\r\n");
+		return;
+	}
+
+	if (hdr->dropped > 0) {
+		printf("%u records were dropped, buffer was full\r\n", hdr->dropped);
+	}
+
+	memset(strs, 0, sizeof(strs));
+	offset = sizeof(struct ttrace_dump_hdr_s);
+	while (offset + sizeof(struct ttrace_rec_s) <= len) {
+		rec = (struct ttrace_rec_s *)(buffer + offset);
+		usec += rec->delta;
+		switch (rec->type) {
+		case TTRACE_REC_STR:
+			strrec = (struct ttrace_rec_str_s *)rec;
+			if (strrec->pid < 0 && strrec->id < CONFIG_TTRACE_STRTAB_SIZE) {
+				strs[strrec->id] = strrec->str;
+			} else if (strrec->pid >= 0 && ntasks < CONFIG_TTRACE_STRTAB_SIZE) {
+				task_names[ntasks] = strrec->str;
+				task_pids[ntasks++] = strrec->pid;
+			}
+			offset += sizeof(struct ttrace_rec_str_s) + ((strrec->len + 4) & ~3);
+			continue;
+		case TTRACE_REC_TIME:
+			usec = ((struct ttrace_rec_time_s *)rec)->usec;
+			break;
+		case TTRACE_REC_BEGIN:
+			printf("[%06d:%06d] %03d: b|%s\r\n", usec / USEC_PER_SEC, usec % USEC_PER_SEC, rec->pid,
+				   (rec->arg < CONFIG_TTRACE_STRTAB_SIZE && strs[rec->arg] != NULL) ? strs[rec->arg] : "?");
+			break;
+		case TTRACE_REC_BEGIN_UID:
+		case TTRACE_REC_END:
+			printf("[%06d:%06d] %03d: %c|%u\r\n", usec / USEC_PER_SEC, usec % USEC_PER_SEC, rec->pid,
+				   rec->type == TTRACE_REC_END ? 'e' : 'b', rec->extra);
+			break;
+		case TTRACE_REC_SCHED:
+			srec = (struct ttrace_rec_sched_s *)rec;
+			printf("[%06d:%06d] %03d: s|prev_comm=%s prev_pid=%u prev_prio=%u prev_state=%u ==> next_comm=%s next_pid=%u next_prio=%u\r\n",
+				   usec / USEC_PER_SEC, usec % USEC_PER_SEC, srec->prev_pid,
+				   find_task_name(task_names, task_pids, ntasks, srec->prev_pid),
+				   srec->prev_pid, srec->prev_prio, srec->prev_state,
+				   find_task_name(task_names, task_pids, ntasks, srec->next_pid),
+				   srec->next_pid, srec->next_prio);
+			offset += sizeof(struct ttrace_rec_sched_s);
+			continue;
+		default:
+			printf("Invalid record type %d\r\n", rec->type);
+			return;
+		}
+		offset += sizeof(struct ttrace_rec_s);
+	}
+}
+
+/* Print the raw dump for tools/ttrace_parser/ttrace_export.py */
+static void print_hexdump(char *buffer, int len)
+{
+	int i;
+
+	printf("TTRACE DUMP size=%d\r\n", len);
+	for (i = 0; i < len; i++) {
+		printf((i % 32) == 31 ? "%02x\r\n" : "%02x", (uint8_t)buffer[i]);
+	}
+	printf("\r\nTTRACE DUMP END\r\n");
+}
+#endif
 
 static void show_help()
 {
@@ -112,6 +210,10 @@ static void show_help()
 	printf("    -i     Show information(state, available/selected/TP used tags, bufsize)\r\n");
 	printf("    -d     Dump trace buffer, It should be run after finish\r\n");
 	printf("    -p     Print trace buffer, It should be run after finish\r\n");
+#ifdef CONFIG_TTRACE_COMPACT
+	printf("           With compact records, it can also be run while tracing\r\n");
+	printf("    -x     Print trace buffer in hex for ttrace_export.py\r\n");
+#endif
 }
 
 static int assign_tag(char *name)
@@ -143,10 +245,11 @@ static int parse_args(int argc, char **args)
 	 * -g : TTRACE_FUNC_TAG, TP's tag(hidden to user)
 	 * -d : TTRACE_DUMP, dump mode(hang), It should be run after finish.
 	 * -p : TTRACE_PRINT, print traces, It should be run after finish.
+	 * -x : TTRACE_HEXDUMP, print traces in hex, with compact records.
 	 */
 	while (1) {
 		optarg = NULL;
-		ret = getopt(argc, args, "sofidpb:");
+		ret = getopt(argc, args, "sofidpxb:");
 		if (ret == '?') {
 			show_help();
 			return TTRACE_INVALID;
@@ -231,11 +334,13 @@ static void free_tracebuffer(char *buffer)
 	return;
 }
 
-static int read_tracebuffer(FILE *file, int bufsize)
+static int read_tracebuffer(FILE *file, int bufsize, int cmd)
 {
 	char *buffer = NULL;
 	int read_len = 0;
+#ifndef CONFIG_TTRACE_COMPACT
 	int offset = 0;
+#endif
 
 	buffer = alloc_tracebuffer(bufsize);
 	if (buffer == NULL) {
@@ -247,9 +352,17 @@ static int read_tracebuffer(FILE *file, int bufsize)
 		return TTRACE_INVALID;
 	}
 
+#ifdef CONFIG_TTRACE_COMPACT
+	if (cmd == TTRACE_HEXDUMP) {
+		print_hexdump(buffer, read_len);
+	} else {
+		print_compact(buffer, read_len);
+	}
+#else
 	while (offset < read_len) {
 		offset += print_packet((struct trace_packet *)(buffer + offset));
 	}
+#endif
 
 	free_tracebuffer(buffer);
 	return TTRACE_VALID;
@@ -279,12 +392,12 @@ static int send_cmds(FILE *file, int cmd)
 	} else if (cmd == TTRACE_FINISH) {
 		ret = run_cmd(file, TTRACE_OVERWRITE, 0);
 		bufsize = run_cmd(file, TTRACE_USED_BUFSIZE, param);
-	} else if (cmd == TTRACE_PRINT) {
+	} else if (cmd == TTRACE_PRINT || cmd == TTRACE_HEXDUMP) {
 		bufsize = run_cmd(file, TTRACE_USED_BUFSIZE, param);
 		if (bufsize <= 0) {
 			return TTRACE_NODATA;
 		}
-		ret = read_tracebuffer(file, bufsize);
+		ret = read_tracebuffer(file, bufsize, cmd);
 		return ret;
 	}
 
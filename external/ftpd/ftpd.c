@@ -66,6 +66,9 @@
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/select.h>
+#ifdef CONFIG_NET_SENDFILE
+#include <sys/sendfile.h>
+#endif
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -1591,6 +1594,32 @@ static int ftpd_stream(FAR struct ftpd_session_s *session, int cmdtype)
 		goto errout_with_session;
 	}
 
+#ifdef CONFIG_NET_SENDFILE
+	/* Binary downloads need no conversion, so let sendfile() move the file
+	 * to the data connection without copying it through session->data.buffer.
+	 */
+
+	if (cmdtype == 0 && session->type != FTPD_SESSIONTYPE_A) {
+		do {
+			wrbytes = sendfile(session->data.sd, session->fd, NULL, CONFIG_NET_SENDFILE_CHUNKSIZE * CONFIG_NET_SENDFILE_NCHUNKS);
+			if (wrbytes > 0) {
+				pos += (off_t)wrbytes;
+			}
+		} while (wrbytes > 0);
+
+		if (wrbytes < 0) {
+			errval = errno;
+			ndbg("sendfile failed: %d\n", errval);
+			(void)ftpd_response(session->cmd.sd, session->txtimeout, g_respfmt1, 550, ' ', "Data send error !");
+			ret = -errval;
+		} else {
+			(void)ftpd_response(session->cmd.sd, session->txtimeout, g_respfmt1, 226, ' ', "Transfer complete");
+			ret = 0;
+		}
+		goto errout_with_session;
+	}
+#endif
+
 	for (;;) {
 		/* Read from the source (file or TCP connection) */
 
@@ -150,6 +150,9 @@ void netlib_prefix2ipv6netmask(uint8_t preflen, FAR struct in6_addr *netmask);
 
 #ifdef CONFIG_NET_NETMON
 int netlib_netmon_sock(void *arg);
+#ifdef CONFIG_NET_MEMP_STATS
+int netlib_netmon_mempstats(void *arg);
+#endif
 #endif
 
 /* HTTP support */
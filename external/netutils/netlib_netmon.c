@@ -97,4 +97,32 @@ int netlib_netmon_devstats(void *arg)
     return ret;
 }
 #endif							/* CONFIG_NET_STATS */
+
+#ifdef CONFIG_NET_MEMP_STATS
+/****************************************************************************
+ * Name: netlib_netmon_mempstats
+ *
+ * Description:
+ *   Get the usage of the network stack memory pools
+
+ * Parameters:
+ *   arg   struct netmon_memp to fill in
+ *
+ * Return:
+ *   0 on success; -1 on failure
+ *
+ ****************************************************************************/
+
+int netlib_netmon_mempstats(void *arg)
+{
+	int ret = ERROR;
+	/* Get memory pool stats */
+	int sockfd = socket(AF_INET, NETLIB_SOCK_IOCTL, 0);
+	if (sockfd >= 0) {
+		ret = ioctl(sockfd, SIOCGMEMPSTATS, (unsigned long)arg);
+		close(sockfd);
+	}
+	return ret;
+}
+#endif							/* CONFIG_NET_MEMP_STATS */
 #endif							/* CONFIG_NET && CONFIG_NSOCKET_DESCRIPTORS */
@@ -17,6 +17,8 @@
  ****************************************************************************/
 
 #include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/sendfile.h>
 #include <protocols/webserver/http_err.h>
 #include <protocols/webserver/http_keyvalue_list.h>
 #include <protocols/webclient.h>
@@ -564,6 +566,53 @@ errout:
 	return HTTP_ERROR;
 }
 
+#ifdef CONFIG_NET_SENDFILE
+/* Send the whole file as the body.  The file is handed to the network
+ * stack, which is why a TLS connection cannot use this.
+ */
+static int http_send_file(struct http_client_t *client, const char *url)
+{
+	char header[128];
+	struct stat st;
+	off_t offset = 0;
+	ssize_t ret;
+	int len;
+	int fd;
+
+	fd = open(url, O_RDONLY);
+	if (fd < 0) {
+		return http_send_response(client, 404, HTTP_ERROR_404, NULL);
+	}
+	if (fstat(fd, &st) < 0) {
+		close(fd);
+		return http_send_response(client, 500, HTTP_ERROR_500, NULL);
+	}
+
+	len = snprintf(header, sizeof(header),
+				   "HTTP/1.1 200 OK\r\n"
+				   "Content-type: text/html\r\n"
+				   "Connection: close\r\n"
+				   "Content-Length: %ld\r\n"
+				   "\r\n",
+				   (long)st.st_size);
+	if (send(client->client_fd, header, len, 0) != len) {
+		close(fd);
+		return HTTP_ERROR;
+	}
+
+	while (offset < st.st_size) {
+		ret = sendfile(client->client_fd, fd, &offset, st.st_size - offset);
+		if (ret <= 0) {
+			close(fd);
+			return HTTP_ERROR;
+		}
+	}
+
+	close(fd);
+	return HTTP_OK;
+}
+#endif
+
 void http_handle_file(struct http_client_t *client, int method, const char *url, char *entity)
 {
 	FILE *f;
@@ -573,6 +622,17 @@ void http_handle_file(struct http_client_t *client, int method, const char *url,
 
 	switch (method) {
 	case HTTP_METHOD_GET:
+#ifdef CONFIG_NET_SENDFILE
+#ifdef CONFIG_NET_SECURITY_TLS
+		if (!client->server->tls_init)
+#endif
+		{
+			if (http_send_file(client, url) == HTTP_ERROR) {
+				HTTP_LOGE("Error: Fail to send file\n");
+			}
+			break;
+		}
+#endif
 		if ((f = fopen(url, "r")) != NULL) {
 			fgets(entity, HTTP_CONF_MAX_ENTITY_LENGTH, f);
 			if (http_send_response(client, 200, entity, NULL) == HTTP_ERROR) {
@@ -172,6 +172,9 @@ typedef struct _db_handle_s db_handle_t;
 struct _db_cursor_s;
 typedef struct _db_cursor_s db_cursor_t;
 
+struct _db_batch_s;
+typedef struct _db_batch_s db_batch_t;
+
 typedef int db_storage_id_t;
 
 typedef uint32_t cursor_row_t;
@@ -180,6 +183,20 @@ typedef uint32_t tuple_id_t;
 
 typedef uint8_t attribute_id_t;
 
+/**
+ * @brief Counters of the page buffer pool shared by relations and indexes
+ */
+struct db_buffer_stats_s {
+	uint32_t hits;			/* Page requests served from the pool */
+	uint32_t misses;		/* Page requests which read the storage */
+	uint32_t evictions;		/* Pages dropped to make room for others */
+	uint32_t writebacks;	/* Dirty pages written to the storage */
+	uint16_t pages;			/* Number of pages in the pool */
+	uint16_t page_size;		/* Size of a page in bytes */
+};
+
+typedef struct db_buffer_stats_s db_buffer_stats_t;
+
 /****************************************************************************
 * Public Variables
 ****************************************************************************/
@@ -211,6 +228,16 @@ db_result_t db_init(void);
 */
 db_result_t db_deinit(void);
 
+/**
+* @brief get the hit, miss, eviction and write back counts of the buffer pool
+*
+* @details @b #include <arastorage/arastorage.h>
+* @param[out] stats a pointer to the structure filled with the counters
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_get_buffer_stats(db_buffer_stats_t *stats);
+
 /**
 * @brief create or remove relations, attributes and indexes in arastorage
 *
@@ -232,6 +259,92 @@ db_result_t db_exec(char *format);
 */
 db_cursor_t *db_query(char *format);
 
+/**
+* @brief start inserting many tuples into a relation without parsing a query per tuple
+*
+* @details @b #include <arastorage/arastorage.h>
+* The relation and its indexes are loaded once for the whole batch. Values are bound
+* with db_batch_bind_*() and each db_batch_append() stores one tuple. Index entries
+* are kept in memory and inserted in key order by db_batch_commit().
+* @param[in] relation_name name of the relation
+* @return On success, a pointer to db_batch_t is returned. On failure, a NULL is returned.
+* @since TizenRT v3.1
+*/
+db_batch_t *db_batch_begin(char *relation_name);
+
+/**
+* @brief set the value of an attribute of type DOMAIN_INT or DOMAIN_LONG for the next appended tuple
+*
+* @details @b #include <arastorage/arastorage.h>
+* @param[in] batch a pointer to batch
+* @param[in] attr_index index of attribute(column) in relation
+* @param[in] value value of the attribute
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_batch_bind_int(db_batch_t *batch, int attr_index, int value);
+
+/**
+* @brief set the value of an attribute of type DOMAIN_LONG for the next appended tuple
+*
+* @details @b #include <arastorage/arastorage.h>
+* @param[in] batch a pointer to batch
+* @param[in] attr_index index of attribute(column) in relation
+* @param[in] value value of the attribute
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_batch_bind_long(db_batch_t *batch, int attr_index, long value);
+
+#ifdef CONFIG_ARCH_FLOAT_H
+/**
+* @brief set the value of an attribute of type DOMAIN_DOUBLE for the next appended tuple
+*
+* @details @b #include <arastorage/arastorage.h>
+* @param[in] batch a pointer to batch
+* @param[in] attr_index index of attribute(column) in relation
+* @param[in] value value of the attribute
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_batch_bind_double(db_batch_t *batch, int attr_index, double value);
+#endif
+
+/**
+* @brief set the value of an attribute of type DOMAIN_STRING for the next appended tuple
+*
+* @details @b #include <arastorage/arastorage.h>
+* The string is not copied, it must stay valid until db_batch_append() is called.
+* @param[in] batch a pointer to batch
+* @param[in] attr_index index of attribute(column) in relation
+* @param[in] value value of the attribute
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_batch_bind_string(db_batch_t *batch, int attr_index, unsigned char *value);
+
+/**
+* @brief store a tuple made of the values bound to the batch
+*
+* @details @b #include <arastorage/arastorage.h>
+* Bound values are kept, so only the attributes which change need to be bound again.
+* @param[in] batch a pointer to batch
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_batch_append(db_batch_t *batch);
+
+/**
+* @brief write the appended tuples to storage, update the indexes and free the batch
+*
+* @details @b #include <arastorage/arastorage.h>
+* The batch is freed even if the commit fails.
+* @param[in] batch a pointer to batch
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_batch_commit(db_batch_t *batch);
+
 /**
 * @brief free allocated cursor data, it should be called before application terminated
 *
@@ -65,6 +65,7 @@
 #include "db_debug.h"
 #include "result.h"
 #include "aql.h"
+#include "buffer_pool.h"
 #include <arastorage/arastorage.h>
 
 /****************************************************************************
@@ -73,6 +74,10 @@
 db_result_t db_init(void)
 {
 	db_result_t res;
+	res = buffer_pool_init();
+	if (res != DB_OK) {
+		return res;
+	}
 	res = relation_init();
 	if (res != DB_OK) {
 		return res;
@@ -97,6 +102,16 @@ db_result_t db_deinit()
 #endif
 	relation_deinit();
 	index_deinit();
+	buffer_pool_deinit();
+	return DB_OK;
+}
+
+db_result_t db_get_buffer_stats(db_buffer_stats_t *stats)
+{
+	if (stats == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+	buffer_pool_get_stats(stats);
 	return DB_OK;
 }
 
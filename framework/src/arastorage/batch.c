@@ -0,0 +1,369 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "db_options.h"
+#include "db_debug.h"
+#include "result.h"
+#include "storage.h"
+#include "relation.h"
+#include "index.h"
+
+/****************************************************************************
+* Pre-processor Definitions
+****************************************************************************/
+#define BATCH_KEYS_INITIAL 16
+
+/****************************************************************************
+* Private Types
+****************************************************************************/
+
+/* An index entry whose insertion is deferred to the commit */
+struct batch_key_s {
+	long key;
+	tuple_id_t tuple_id;
+};
+
+struct batch_index_s {
+	struct batch_key_s *keys;
+	tuple_id_t count;
+	tuple_id_t size;
+};
+
+struct _db_batch_s {
+	relation_t *rel;
+	unsigned char *record;
+	uint32_t bound;				/* Attributes which have a value */
+	uint32_t required;			/* Attributes which need a value */
+	attribute_t *attrs[AQL_ATTRIBUTE_LIMIT];
+	attribute_value_t values[AQL_ATTRIBUTE_LIMIT];
+	struct batch_index_s pending[AQL_ATTRIBUTE_LIMIT];
+};
+
+/****************************************************************************
+* Private Functions
+****************************************************************************/
+static int batch_key_compare(const void *p1, const void *p2)
+{
+	const struct batch_key_s *k1 = (const struct batch_key_s *)p1;
+	const struct batch_key_s *k2 = (const struct batch_key_s *)p2;
+
+	if (k1->key != k2->key) {
+		return k1->key < k2->key ? -1 : 1;
+	}
+	if (k1->tuple_id != k2->tuple_id) {
+		return k1->tuple_id < k2->tuple_id ? -1 : 1;
+	}
+	return 0;
+}
+
+static attribute_value_t *batch_get_value(db_batch_t *batch, int attr_index, domain_t domain)
+{
+	attribute_t *attr;
+
+	if (batch == NULL || attr_index < 0 || attr_index >= batch->rel->attribute_count) {
+		return NULL;
+	}
+
+	/* INT values may be promoted to LONG attributes as in db_exec() */
+	attr = batch->attrs[attr_index];
+	if (attr->domain != domain && !(attr->domain == DOMAIN_LONG && domain == DOMAIN_INT)) {
+		DB_LOG_E("DB: The value domain %d does not match the domain %d of attribute %s\n", domain, attr->domain, attr->name);
+		return NULL;
+	}
+
+	batch->bound |= 1u << attr_index;
+	batch->values[attr_index].domain = domain;
+	return &batch->values[attr_index];
+}
+
+static db_result_t batch_push_key(struct batch_index_s *pending, long key, tuple_id_t tuple_id)
+{
+	struct batch_key_s *keys;
+	tuple_id_t size;
+
+	if (pending->count == pending->size) {
+		size = pending->size == 0 ? BATCH_KEYS_INITIAL : pending->size * 2;
+		keys = (struct batch_key_s *)realloc(pending->keys, size * sizeof(struct batch_key_s));
+		if (keys == NULL) {
+			return DB_ALLOCATION_ERROR;
+		}
+		pending->keys = keys;
+		pending->size = size;
+	}
+
+	pending->keys[pending->count].key = key;
+	pending->keys[pending->count].tuple_id = tuple_id;
+	pending->count++;
+	return DB_OK;
+}
+
+/****************************************************************************
+ * Name: batch_index_pending
+ *
+ * Description: Inserts the deferred index entries of every indexed
+ *              attribute.  The entries are sorted by key first, so that
+ *              consecutive insertions walk down the same path of the tree
+ *              and fill one bucket after another.
+ *
+ ****************************************************************************/
+static db_result_t batch_index_pending(db_batch_t *batch)
+{
+	struct batch_index_s *pending;
+	attribute_value_t value;
+	tuple_id_t i;
+	int ndx;
+
+	for (ndx = 0; ndx < batch->rel->attribute_count; ndx++) {
+		pending = &batch->pending[ndx];
+		if (pending->count == 0) {
+			continue;
+		}
+
+		qsort(pending->keys, pending->count, sizeof(struct batch_key_s), batch_key_compare);
+
+		value.domain = batch->attrs[ndx]->domain;
+		for (i = 0; i < pending->count; i++) {
+			if (value.domain == DOMAIN_INT) {
+				VALUE_INT(&value) = (int)pending->keys[i].key;
+			} else {
+				VALUE_LONG(&value) = pending->keys[i].key;
+			}
+			if (DB_ERROR(index_insert(batch->attrs[ndx]->index, &value, pending->keys[i].tuple_id))) {
+				DB_LOG_E("DB: Failed to index tuple %lu of %s\n", (unsigned long)pending->keys[i].tuple_id, batch->rel->name);
+				return DB_INDEX_ERROR;
+			}
+		}
+		pending->count = 0;
+	}
+
+	return DB_OK;
+}
+
+static void batch_free(db_batch_t *batch)
+{
+	int ndx;
+
+	for (ndx = 0; ndx < AQL_ATTRIBUTE_LIMIT; ndx++) {
+		if (batch->pending[ndx].keys != NULL) {
+			free(batch->pending[ndx].keys);
+		}
+	}
+	if (batch->record != NULL) {
+		free(batch->record);
+	}
+	relation_release(batch->rel);
+	free(batch);
+}
+
+/****************************************************************************
+* Public Functions
+****************************************************************************/
+db_batch_t *db_batch_begin(char *relation_name)
+{
+	db_batch_t *batch;
+	attribute_t *attr;
+	relation_t *rel;
+	int ndx;
+
+	if (relation_name == NULL) {
+		return NULL;
+	}
+
+	rel = relation_load(relation_name);
+	if (rel == NULL) {
+		DB_LOG_E("DB: Failed to load relation %s\n", relation_name);
+		return NULL;
+	}
+
+	if (rel->attribute_count == 0 || rel->attribute_count > AQL_ATTRIBUTE_LIMIT) {
+		DB_LOG_E("DB: Relation %s has %d attributes\n", relation_name, rel->attribute_count);
+		relation_release(rel);
+		return NULL;
+	}
+
+	batch = (db_batch_t *)malloc(sizeof(db_batch_t));
+	if (batch == NULL) {
+		relation_release(rel);
+		return NULL;
+	}
+	memset(batch, 0, sizeof(db_batch_t));
+	batch->rel = rel;
+
+	batch->record = (unsigned char *)malloc(rel->row_length);
+	if (batch->record == NULL) {
+		batch_free(batch);
+		return NULL;
+	}
+
+	/* Indexes are loaded once here instead of once per inserted tuple */
+	ndx = 0;
+	for (attr = list_head(rel->attributes); attr != NULL; attr = attr->next, ndx++) {
+		batch->attrs[ndx] = attr;
+		batch->values[ndx].domain = attr->domain;
+		if (attr->flags & ATTRIBUTE_FLAG_INVALID) {
+			continue;
+		}
+		batch->required |= 1u << ndx;
+		if (attr->index == NULL) {
+			index_load(rel, attr);
+		}
+	}
+
+	return batch;
+}
+
+db_result_t db_batch_bind_int(db_batch_t *batch, int attr_index, int value)
+{
+	attribute_value_t *bind;
+
+	bind = batch_get_value(batch, attr_index, DOMAIN_INT);
+	if (bind == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+	VALUE_INT(bind) = value;
+	return DB_OK;
+}
+
+db_result_t db_batch_bind_long(db_batch_t *batch, int attr_index, long value)
+{
+	attribute_value_t *bind;
+
+	bind = batch_get_value(batch, attr_index, DOMAIN_LONG);
+	if (bind == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+	VALUE_LONG(bind) = value;
+	return DB_OK;
+}
+
+#ifdef CONFIG_ARCH_FLOAT_H
+db_result_t db_batch_bind_double(db_batch_t *batch, int attr_index, double value)
+{
+	attribute_value_t *bind;
+
+	bind = batch_get_value(batch, attr_index, DOMAIN_DOUBLE);
+	if (bind == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+	VALUE_DOUBLE(bind) = value;
+	return DB_OK;
+}
+#endif
+
+db_result_t db_batch_bind_string(db_batch_t *batch, int attr_index, unsigned char *value)
+{
+	attribute_value_t *bind;
+
+	if (value == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+	bind = batch_get_value(batch, attr_index, DOMAIN_STRING);
+	if (bind == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+	VALUE_STRING(bind) = value;
+	return DB_OK;
+}
+
+db_result_t db_batch_append(db_batch_t *batch)
+{
+	relation_t *rel;
+	attribute_t *attr;
+	db_result_t result;
+	int ndx;
+
+	if (batch == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+	rel = batch->rel;
+
+	if ((batch->bound & batch->required) != batch->required) {
+		DB_LOG_E("DB: Not every attribute of %s has a value\n", rel->name);
+		return DB_ARGUMENT_ERROR;
+	}
+
+	if (relation_cardinality(rel) >= DB_TUPLE_LIMIT) {
+		return DB_LIMIT_ERROR;
+	}
+
+	result = relation_encode_tuple(rel, batch->values, batch->record);
+	if (DB_ERROR(result)) {
+		return result;
+	}
+
+	for (ndx = 0; ndx < rel->attribute_count; ndx++) {
+		attr = batch->attrs[ndx];
+		if ((batch->required & (1u << ndx)) && attr->index != NULL) {
+			if (DB_ERROR(batch_push_key(&batch->pending[ndx], db_value_to_long(&batch->values[ndx]), rel->next_row))) {
+				goto errout;
+			}
+		}
+	}
+
+	result = storage_put_row(rel, batch->record, FALSE);
+	if (DB_ERROR(result)) {
+		goto errout;
+	}
+
+#ifdef CONFIG_ARASTORAGE_ENABLE_FLUSHING
+	/* Flushing an index renumbers the tuples it keeps, so tuples must not
+	 * wait for the commit to be indexed.
+	 */
+	return batch_index_pending(batch);
+#else
+	return DB_OK;
+#endif
+
+errout:
+	/* Drop the entries of this tuple which were already queued */
+	while (--ndx >= 0) {
+		if (batch->pending[ndx].count > 0 && batch->pending[ndx].keys[batch->pending[ndx].count - 1].tuple_id == rel->next_row) {
+			batch->pending[ndx].count--;
+		}
+	}
+	return DB_ERROR(result) ? result : DB_ALLOCATION_ERROR;
+}
+
+db_result_t db_batch_commit(db_batch_t *batch)
+{
+	db_result_t result;
+
+	if (batch == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+#ifdef CONFIG_ARASTORAGE_ENABLE_WRITE_BUFFER
+	result = storage_flush_insert_buffer();
+	if (DB_ERROR(result)) {
+		batch_free(batch);
+		return result;
+	}
+#endif
+
+	result = batch_index_pending(batch);
+	batch_free(batch);
+	return result;
+}
@@ -0,0 +1,543 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/types.h>
+
+#include "db_options.h"
+#include "db_debug.h"
+#include "storage.h"
+#include "buffer_pool.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+#define BUFFER_PAGE_VALID      0x01
+#define BUFFER_PAGE_PINNED     0x02
+#define BUFFER_PAGE_DIRTY      0x04
+#define BUFFER_PAGE_REFERENCED 0x08
+
+/* Frames are kept word aligned so that callers can map structures on them */
+#define BUFFER_FRAME_SIZE      ((DB_BUFFER_POOL_PAGE_SIZE + 7) & ~7)
+
+#define BUFFER_FRAME(ndx)      (g_buffer_pool.frames + (size_t)(ndx) * BUFFER_FRAME_SIZE)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+struct buffer_page_s {
+	db_storage_id_t storage;	/* The storage the page belongs to */
+	unsigned long offset;		/* Offset of the page in the storage */
+	uint16_t length;			/* Length of the page */
+	uint16_t valid;				/* Number of bytes which exist in the storage */
+	uint8_t state;				/* BUFFER_PAGE_* flags */
+};
+
+struct buffer_pool_s {
+	struct buffer_page_s page[DB_BUFFER_POOL_PAGES];
+	unsigned char *frames;		/* DB_BUFFER_POOL_PAGES frames of BUFFER_FRAME_SIZE bytes */
+	int hand;					/* The clock hand, next page considered for eviction */
+	pthread_mutex_t lock;
+	db_buffer_stats_t stats;
+};
+
+/****************************************************************************
+ * Private Variables
+ ****************************************************************************/
+static struct buffer_pool_s g_buffer_pool = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: buffer_pool_find
+ *
+ * Description: Returns the index of the page cached for the given storage
+ *              and offset, or -1 if the page is not cached.
+ *
+ ****************************************************************************/
+static int buffer_pool_find(db_storage_id_t storage, unsigned long offset)
+{
+	int ndx;
+
+	for (ndx = 0; ndx < DB_BUFFER_POOL_PAGES; ndx++) {
+		struct buffer_page_s *page = &g_buffer_pool.page[ndx];
+		if ((page->state & BUFFER_PAGE_VALID) && page->storage == storage && page->offset == offset) {
+			return ndx;
+		}
+	}
+	return -1;
+}
+
+/****************************************************************************
+ * Name: buffer_pool_writeback
+ *
+ * Description: Writes a dirty page back to its storage.
+ *
+ ****************************************************************************/
+static db_result_t buffer_pool_writeback(int ndx)
+{
+	struct buffer_page_s *page = &g_buffer_pool.page[ndx];
+
+	if (DB_ERROR(storage_write_to(page->storage, BUFFER_FRAME(ndx), page->offset, page->length))) {
+		DB_LOG_E("DB: Failed to write back page at %lu of storage %d\n", page->offset, page->storage);
+		return DB_STORAGE_ERROR;
+	}
+	page->state &= ~BUFFER_PAGE_DIRTY;
+	g_buffer_pool.stats.writebacks++;
+	return DB_OK;
+}
+
+/****************************************************************************
+ * Name: buffer_pool_victim
+ *
+ * Description: Finds a free frame, evicting a page with the clock algorithm
+ *              if all frames are in use.  A page which was used since the
+ *              hand last passed it gets a second chance, pinned pages are
+ *              skipped and dirty pages are written back before eviction.
+ *              Returns -1 if every page is pinned.
+ *
+ ****************************************************************************/
+static int buffer_pool_victim(void)
+{
+	int count;
+	int ndx;
+
+	for (count = 0; count < 2 * DB_BUFFER_POOL_PAGES; count++) {
+		struct buffer_page_s *page;
+
+		ndx = g_buffer_pool.hand;
+		page = &g_buffer_pool.page[ndx];
+		if (++g_buffer_pool.hand == DB_BUFFER_POOL_PAGES) {
+			g_buffer_pool.hand = 0;
+		}
+
+		if (!(page->state & BUFFER_PAGE_VALID)) {
+			return ndx;
+		}
+		if (page->state & BUFFER_PAGE_PINNED) {
+			continue;
+		}
+		if (page->state & BUFFER_PAGE_REFERENCED) {
+			page->state &= ~BUFFER_PAGE_REFERENCED;
+			continue;
+		}
+		if ((page->state & BUFFER_PAGE_DIRTY) && DB_ERROR(buffer_pool_writeback(ndx))) {
+			continue;
+		}
+		page->state = 0;
+		g_buffer_pool.stats.evictions++;
+		return ndx;
+	}
+
+	DB_LOG_E("DB: No page available in the buffer pool\n");
+	return -1;
+}
+
+/****************************************************************************
+ * Name: buffer_pool_load
+ *
+ * Description: Reads a page from its storage into a frame.  A page at the
+ *              end of the storage may be shorter than requested, the rest
+ *              of the frame is then cleared.
+ *
+ ****************************************************************************/
+static db_result_t buffer_pool_load(int ndx, db_storage_id_t storage, unsigned long offset, unsigned length)
+{
+	struct buffer_page_s *page = &g_buffer_pool.page[ndx];
+	unsigned char *frame = BUFFER_FRAME(ndx);
+	ssize_t r;
+
+	page->state = 0;
+	if (storage_seek(storage, offset, SEEK_SET) == (off_t)-1) {
+		return DB_STORAGE_ERROR;
+	}
+	r = storage_read(storage, frame, length);
+	if (r <= 0) {
+		DB_LOG_E("DB: Failed to read page at %lu of storage %d\n", offset, storage);
+		return DB_STORAGE_ERROR;
+	}
+	if (r < length) {
+		memset(frame + r, 0, length - r);
+	}
+
+	page->storage = storage;
+	page->offset = offset;
+	page->length = length;
+	page->valid = r;
+	page->state = BUFFER_PAGE_VALID | BUFFER_PAGE_REFERENCED;
+	return DB_OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: buffer_pool_init
+ *
+ * Description: Allocates the page frames of the buffer pool.
+ *
+ ****************************************************************************/
+db_result_t buffer_pool_init(void)
+{
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	if (g_buffer_pool.frames == NULL) {
+		g_buffer_pool.frames = (unsigned char *)malloc(DB_BUFFER_POOL_PAGES * BUFFER_FRAME_SIZE);
+		if (g_buffer_pool.frames == NULL) {
+			pthread_mutex_unlock(&g_buffer_pool.lock);
+			DB_LOG_E("DB: Failed to allocate the buffer pool\n");
+			return DB_ALLOCATION_ERROR;
+		}
+		memset(g_buffer_pool.page, 0, sizeof(g_buffer_pool.page));
+		memset(&g_buffer_pool.stats, 0, sizeof(g_buffer_pool.stats));
+		g_buffer_pool.hand = 0;
+	}
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+	return DB_OK;
+}
+
+/****************************************************************************
+ * Name: buffer_pool_deinit
+ *
+ * Description: Writes back the remaining dirty pages and frees the frames.
+ *
+ ****************************************************************************/
+void buffer_pool_deinit(void)
+{
+	int ndx;
+
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	if (g_buffer_pool.frames != NULL) {
+		for (ndx = 0; ndx < DB_BUFFER_POOL_PAGES; ndx++) {
+			if ((g_buffer_pool.page[ndx].state & (BUFFER_PAGE_VALID | BUFFER_PAGE_DIRTY)) == (BUFFER_PAGE_VALID | BUFFER_PAGE_DIRTY)) {
+				buffer_pool_writeback(ndx);
+			}
+			g_buffer_pool.page[ndx].state = 0;
+		}
+		DB_LOG_D("DB: Buffer pool hits %u misses %u evictions %u writebacks %u\n", g_buffer_pool.stats.hits, g_buffer_pool.stats.misses, g_buffer_pool.stats.evictions, g_buffer_pool.stats.writebacks);
+		free(g_buffer_pool.frames);
+		g_buffer_pool.frames = NULL;
+	}
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+}
+
+/****************************************************************************
+ * Name: buffer_pool_pin
+ *
+ * Description: Returns the page at 'offset' of 'storage', reading it from
+ *              the storage if it is not cached, and pins it.  Returns NULL
+ *              if the page is already pinned, if every page is pinned or
+ *              if the read fails.
+ *
+ ****************************************************************************/
+void *buffer_pool_pin(db_storage_id_t storage, unsigned long offset, unsigned length)
+{
+	struct buffer_page_s *page;
+	int ndx;
+
+	if (length > DB_BUFFER_POOL_PAGE_SIZE) {
+		return NULL;
+	}
+
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	if (g_buffer_pool.frames == NULL) {
+		pthread_mutex_unlock(&g_buffer_pool.lock);
+		return NULL;
+	}
+
+	ndx = buffer_pool_find(storage, offset);
+	if (ndx >= 0) {
+		page = &g_buffer_pool.page[ndx];
+		if (page->state & BUFFER_PAGE_PINNED) {
+			pthread_mutex_unlock(&g_buffer_pool.lock);
+			return NULL;
+		}
+		g_buffer_pool.stats.hits++;
+	} else {
+		g_buffer_pool.stats.misses++;
+		ndx = buffer_pool_victim();
+		if (ndx < 0 || DB_ERROR(buffer_pool_load(ndx, storage, offset, length))) {
+			pthread_mutex_unlock(&g_buffer_pool.lock);
+			return NULL;
+		}
+		page = &g_buffer_pool.page[ndx];
+	}
+
+	page->state |= BUFFER_PAGE_PINNED | BUFFER_PAGE_REFERENCED;
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+	return BUFFER_FRAME(ndx);
+}
+
+/****************************************************************************
+ * Name: buffer_pool_unpin
+ *
+ * Description: Releases a page pinned by buffer_pool_pin().
+ *
+ ****************************************************************************/
+db_result_t buffer_pool_unpin(db_storage_id_t storage, unsigned long offset)
+{
+	int ndx;
+
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	ndx = buffer_pool_find(storage, offset);
+	if (ndx >= 0) {
+		g_buffer_pool.page[ndx].state &= ~BUFFER_PAGE_PINNED;
+	}
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+	return ndx >= 0 ? DB_OK : DB_ARGUMENT_ERROR;
+}
+
+/****************************************************************************
+ * Name: buffer_pool_mark_dirty
+ *
+ * Description: Marks a cached page as modified so that it is written back
+ *              to its storage before it is evicted.
+ *
+ ****************************************************************************/
+db_result_t buffer_pool_mark_dirty(db_storage_id_t storage, unsigned long offset)
+{
+	int ndx;
+
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	ndx = buffer_pool_find(storage, offset);
+	if (ndx >= 0) {
+		g_buffer_pool.page[ndx].state |= BUFFER_PAGE_DIRTY;
+	}
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+	return ndx >= 0 ? DB_OK : DB_ARGUMENT_ERROR;
+}
+
+/****************************************************************************
+ * Name: buffer_pool_update
+ *
+ * Description: Replaces the contents of a page pinned by the caller, marks
+ *              it dirty and unpins it.
+ *
+ ****************************************************************************/
+db_result_t buffer_pool_update(db_storage_id_t storage, unsigned long offset, void *data, unsigned length)
+{
+	struct buffer_page_s *page;
+	int ndx;
+
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	ndx = buffer_pool_find(storage, offset);
+	if (ndx < 0 || !(g_buffer_pool.page[ndx].state & BUFFER_PAGE_PINNED) || length > g_buffer_pool.page[ndx].length) {
+		pthread_mutex_unlock(&g_buffer_pool.lock);
+		return DB_ARGUMENT_ERROR;
+	}
+
+	page = &g_buffer_pool.page[ndx];
+	memmove(BUFFER_FRAME(ndx), data, length);
+	page->state &= ~BUFFER_PAGE_PINNED;
+	page->state |= BUFFER_PAGE_DIRTY | BUFFER_PAGE_REFERENCED;
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+	return DB_OK;
+}
+
+/****************************************************************************
+ * Name: buffer_pool_put
+ *
+ * Description: Caches new contents for a page without reading it from the
+ *              storage first.  The page is written back on eviction.
+ *
+ ****************************************************************************/
+db_result_t buffer_pool_put(db_storage_id_t storage, unsigned long offset, void *data, unsigned length)
+{
+	struct buffer_page_s *page;
+	int ndx;
+
+	if (length > DB_BUFFER_POOL_PAGE_SIZE) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	if (g_buffer_pool.frames == NULL) {
+		pthread_mutex_unlock(&g_buffer_pool.lock);
+		return DB_ALLOCATION_ERROR;
+	}
+
+	ndx = buffer_pool_find(storage, offset);
+	if (ndx < 0) {
+		ndx = buffer_pool_victim();
+		if (ndx < 0) {
+			pthread_mutex_unlock(&g_buffer_pool.lock);
+			return DB_LIMIT_ERROR;
+		}
+		g_buffer_pool.page[ndx].state = 0;
+	}
+
+	/* The data may be the stale contents of this very frame */
+
+	page = &g_buffer_pool.page[ndx];
+	memmove(BUFFER_FRAME(ndx), data, length);
+	page->storage = storage;
+	page->offset = offset;
+	page->length = length;
+	page->valid = length;
+	page->state |= BUFFER_PAGE_VALID | BUFFER_PAGE_DIRTY | BUFFER_PAGE_REFERENCED;
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+	return DB_OK;
+}
+
+/****************************************************************************
+ * Name: buffer_pool_discard
+ *
+ * Description: Drops a cached page without writing it back, whether it is
+ *              pinned or not.
+ *
+ ****************************************************************************/
+db_result_t buffer_pool_discard(db_storage_id_t storage, unsigned long offset)
+{
+	int ndx;
+
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	ndx = buffer_pool_find(storage, offset);
+	if (ndx >= 0) {
+		g_buffer_pool.page[ndx].state = 0;
+	}
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+	return ndx >= 0 ? DB_OK : DB_ARGUMENT_ERROR;
+}
+
+/****************************************************************************
+ * Name: buffer_pool_read
+ *
+ * Description: Copies 'size' bytes at 'start' of the page of 'length' bytes
+ *              at 'offset' of 'storage' into 'buffer'.  This is meant for
+ *              storages which are only appended to: a cached page which
+ *              does not cover the requested bytes yet is read again.
+ *
+ ****************************************************************************/
+db_result_t buffer_pool_read(db_storage_id_t storage, unsigned long offset, unsigned length, void *buffer, unsigned start, unsigned size)
+{
+	struct buffer_page_s *page;
+	int ndx;
+
+	if (length > DB_BUFFER_POOL_PAGE_SIZE || start + size > length) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	if (g_buffer_pool.frames == NULL) {
+		pthread_mutex_unlock(&g_buffer_pool.lock);
+		return DB_ALLOCATION_ERROR;
+	}
+
+	ndx = buffer_pool_find(storage, offset);
+	if (ndx >= 0 && g_buffer_pool.page[ndx].valid >= start + size) {
+		g_buffer_pool.stats.hits++;
+		g_buffer_pool.page[ndx].state |= BUFFER_PAGE_REFERENCED;
+	} else {
+		g_buffer_pool.stats.misses++;
+		if (ndx < 0) {
+			ndx = buffer_pool_victim();
+		} else if (g_buffer_pool.page[ndx].state & (BUFFER_PAGE_PINNED | BUFFER_PAGE_DIRTY)) {
+			/* Never read over a page somebody is working on */
+
+			ndx = -1;
+		}
+		if (ndx < 0 || DB_ERROR(buffer_pool_load(ndx, storage, offset, length))) {
+			pthread_mutex_unlock(&g_buffer_pool.lock);
+			return DB_STORAGE_ERROR;
+		}
+	}
+
+	page = &g_buffer_pool.page[ndx];
+	if (page->valid < start + size) {
+		pthread_mutex_unlock(&g_buffer_pool.lock);
+		return DB_STORAGE_ERROR;
+	}
+	memcpy(buffer, BUFFER_FRAME(ndx) + start, size);
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+	return DB_OK;
+}
+
+/****************************************************************************
+ * Name: buffer_pool_flush
+ *
+ * Description: Writes back every dirty page of 'storage'.
+ *
+ ****************************************************************************/
+db_result_t buffer_pool_flush(db_storage_id_t storage)
+{
+	db_result_t result = DB_OK;
+	int ndx;
+
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	for (ndx = 0; ndx < DB_BUFFER_POOL_PAGES; ndx++) {
+		struct buffer_page_s *page = &g_buffer_pool.page[ndx];
+		if ((page->state & (BUFFER_PAGE_VALID | BUFFER_PAGE_DIRTY)) == (BUFFER_PAGE_VALID | BUFFER_PAGE_DIRTY) && page->storage == storage) {
+			if (DB_ERROR(buffer_pool_writeback(ndx))) {
+				result = DB_STORAGE_ERROR;
+			}
+		}
+	}
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+	return result;
+}
+
+/****************************************************************************
+ * Name: buffer_pool_release
+ *
+ * Description: Writes back and drops every page of 'storage'.  This must be
+ *              done before the storage is closed, since its id may be given
+ *              to another file afterwards.
+ *
+ ****************************************************************************/
+void buffer_pool_release(db_storage_id_t storage)
+{
+	int ndx;
+
+	buffer_pool_flush(storage);
+
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	for (ndx = 0; ndx < DB_BUFFER_POOL_PAGES; ndx++) {
+		if (g_buffer_pool.page[ndx].storage == storage) {
+			g_buffer_pool.page[ndx].state = 0;
+		}
+	}
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+}
+
+/****************************************************************************
+ * Name: buffer_pool_get_stats
+ *
+ * Description: Returns the hit, miss, eviction and write back counts of the
+ *              buffer pool.
+ *
+ ****************************************************************************/
+void buffer_pool_get_stats(db_buffer_stats_t *stats)
+{
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	memcpy(stats, &g_buffer_pool.stats, sizeof(*stats));
+	stats->pages = DB_BUFFER_POOL_PAGES;
+	stats->page_size = DB_BUFFER_POOL_PAGE_SIZE;
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+}
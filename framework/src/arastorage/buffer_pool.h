@@ -0,0 +1,67 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __BUFFER_POOL_H__
+#define __BUFFER_POOL_H__
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <arastorage/arastorage.h>
+
+/****************************************************************************
+* Pre-processor Definitions
+****************************************************************************/
+#ifdef CONFIG_ARASTORAGE_BUFFER_POOL_PAGES
+#define DB_BUFFER_POOL_PAGES CONFIG_ARASTORAGE_BUFFER_POOL_PAGES
+#else
+#define DB_BUFFER_POOL_PAGES 16
+#endif
+
+#ifdef CONFIG_ARASTORAGE_BUFFER_POOL_PAGE_SIZE
+#define DB_BUFFER_POOL_PAGE_SIZE CONFIG_ARASTORAGE_BUFFER_POOL_PAGE_SIZE
+#else
+#define DB_BUFFER_POOL_PAGE_SIZE 512
+#endif
+
+/****************************************************************************
+* Global Function Prototypes
+****************************************************************************/
+
+/* A page is identified by the storage it belongs to and its offset in that
+ * storage.  Its length is chosen by the caller and must not exceed
+ * DB_BUFFER_POOL_PAGE_SIZE.
+ *
+ * A pinned page is held exclusively by one user: it is never evicted and
+ * buffer_pool_pin() refuses to hand it out a second time.
+ */
+db_result_t buffer_pool_init(void);
+void buffer_pool_deinit(void);
+
+void *buffer_pool_pin(db_storage_id_t, unsigned long, unsigned);
+db_result_t buffer_pool_unpin(db_storage_id_t, unsigned long);
+db_result_t buffer_pool_mark_dirty(db_storage_id_t, unsigned long);
+db_result_t buffer_pool_update(db_storage_id_t, unsigned long, void *, unsigned);
+db_result_t buffer_pool_put(db_storage_id_t, unsigned long, void *, unsigned);
+db_result_t buffer_pool_discard(db_storage_id_t, unsigned long);
+db_result_t buffer_pool_read(db_storage_id_t, unsigned long, unsigned, void *, unsigned, unsigned);
+
+db_result_t buffer_pool_flush(db_storage_id_t);
+void buffer_pool_release(db_storage_id_t);
+void buffer_pool_get_stats(db_buffer_stats_t *);
+
+#endif							/* __BUFFER_POOL_H__ */
@@ -221,15 +221,6 @@
 #define DB_HEAP_INDEX_LIMIT             1
 #endif							/* DB_HEAP_INDEX_LIMIT */
 
-/* The maximum number of buckets cached in the MaxHeap index. */
-#ifndef DB_HEAP_CACHE_LIMIT
-#define DB_HEAP_CACHE_LIMIT             6
-#endif							/* DB_HEAP_CACHE_LIMIT */
-
-#ifndef DB_TREE_CACHE_LIMIT
-#define DB_TREE_CACHE_LIMIT             10
-#endif
-
 #ifdef DB_WIP
 #undef DB_WIP						/* DB WORK IN PROGRESS */
 #endif
@@ -61,6 +61,7 @@
 #include "db_options.h"
 #include "db_debug.h"
 #include "storage.h"
+#include "buffer_pool.h"
 #include "random.h"
 #include "rw_locks.h"
 
@@ -76,13 +77,7 @@
 #define EMPTY_NODE(node)        (node)->val[BRANCH_FACTOR-1] == 0
 #define KEY_MAX INT_MAX
 #define ROW_XOR 0xf6U
-#define NODE_STATE_VALID 1
-#define NODE_STATE_LOCK 2
-#define NODE_STATE_DIRTY 4
 #define ROOT_NODE_PARENT 255
-
-/* The total number of states possible of a node */
-#define NODE_STATES 255
 #define CONFIG_VACUUM_THRESHOLD 40
 
 #ifdef CONFIG_ARASTORAGE_ENABLE_VACUUM
@@ -92,37 +87,9 @@
 #define max(a, b) ({ __typeof__(a) _a = (a);  __typeof__(b) _b = (b); _a > _b ? _a : _b; })
 #define min(a, b) ({ __typeof__(a) _a = (a);  __typeof__(b) _b = (b); _a < _b ? _a : _b; })
 
-#define SET_NODE_STATE(node, type) \
-	do { \
-		node->node_state |= type; \
-	} while (0)
-
-#define UNSET_NODE_STATE(node, type) \
-	do { \
-		node->node_state &= ((type) ^ NODE_STATES); \
-	} while (0)
-
-#define REMOVE_ENTRY(node) \
-	do { \
-		node->prev->next = node->next; \
-		node->next->prev = node->prev; \
-	} while (0)
-
-#define PLACE_AT_HEAD(node, cache_type) \
-	do { \
-		cache_type->in_cache.head->next->prev = node; \
-		node->next = cache_type->in_cache.head->next; \
-		node->prev = cache_type->in_cache.head; \
-		cache_type->in_cache.head->next = node; \
-	} while (0)
-
-#define PLACE_AT_TAIL(node, cache_type) \
-	do { \
-		cache_type->in_cache.tail->prev->next = node; \
-		node->next = cache_type->in_cache.tail; \
-		node->prev = cache_type->in_cache.tail->prev; \
-		cache_type->in_cache.tail->prev = node; \
-	} while (0)
+/* Location of nodes and buckets in the tree and bucket storages */
+#define NODE_OFFSET(id)   (base_offset + (unsigned long)(id) * sizeof(tree_node_t))
+#define BUCKET_OFFSET(id) ((unsigned long)(id) * sizeof(bucket_t))
 
 /****************************************************************************
  * Private Types
@@ -147,44 +114,9 @@ struct bucket_s {
 };
 typedef struct bucket_s bucket_t;
 
-struct qnode_s {
-	struct qnode_s *next;
-	struct qnode_s *prev;
-	uint8_t id;
-	uint8_t pos;
-	uint8_t node_state;
-};
-
-typedef struct qnode_s qnode_t;
-struct queue_s {
-	qnode_t *head;
-	qnode_t *tail;
-};
-typedef struct queue_s queue_t;
-
-/* A Bucket Cache Entry */
-struct bucket_cache_s {
-	bucket_t bucket;
-};
-
-/* A Tree Cache Entry */
-struct tree_cache_s {
-	tree_node_t node;
-};
-
-/* Bucket Cache Structure */
-typedef struct {
-	struct bucket_cache_s cache_t[DB_HEAP_CACHE_LIMIT];
-	queue_t in_cache;
-	uint8_t num;
-} bucket_cache_t;
-
-/* Tree Cache Structure */
-typedef struct {
-	struct tree_cache_s cache_t[DB_TREE_CACHE_LIMIT];
-	queue_t in_cache;
-	uint8_t num;
-} tree_cache_t;
+/* Nodes and buckets are cached as single buffer pool pages */
+typedef char node_fits_in_page_t[(sizeof(tree_node_t) <= DB_BUFFER_POOL_PAGE_SIZE) ? 1 : -1];
+typedef char bucket_fits_in_page_t[(sizeof(bucket_t) <= DB_BUFFER_POOL_PAGE_SIZE) ? 1 : -1];
 
 typedef enum {
 	NODE = 0,
@@ -240,10 +172,8 @@ struct tree_s {
 	uint16_t inserted;			/*  Count of total number of tuples inserted  */
 	uint16_t deleted;			/*    Count of total number of tuples deleted  */
 	uint8_t levels;				/*  The depth of the bplus-tree including the buckets  */
-	tree_cache_t *node_cache;	/*  Structure to maintain node cache  */
-	bucket_cache_t *buck_cache;	/*   Structure to maintain bucket cache  */
-	pthread_mutex_t node_cache_lock;	/*  Maintains concurrency control over Node Cache  */
-	pthread_mutex_t buck_cache_lock;	/*  Maintains concurrency control over Bucket Cache  */
+	void *reserved[2];			/*  Unused, keeps the layout of the tree header saved on flash  */
+	pthread_mutex_t reserved_lock[2];	/*  Unused, keeps the layout of the tree header saved on flash  */
 	pthread_mutex_t bucket_lock;	/*  Maintains serialisability over in RAM Tree Structure  */
 	struct rw_lock_s tree_lock;	/*  A Reader Writer Lock used to maintain consistency in tree structure */
 };
@@ -259,13 +189,11 @@ static int base_offset = 0;
  ****************************************************************************/
 static int transform_key(int);
 static tree_node_t *tree_read(tree_t *, int);
-static int tree_write(tree_t *, int, tree_node_t *);
 static tree_result_t tree_insert(tree_t *, int);
 static pair_t *tree_find(tree_t *, int key);
 tree_result_t insert_item_btree(tree_t *, int, int);
 
 static bucket_t *bucket_read(tree_t *, int);
-static int bucket_write(tree_t *, int, bucket_t *);
 static bsplit_status_t bucket_split(tree_t *, int, int, pair_t *);
 static cache_result_t cache_bucket_append(tree_t *, int, pair_t *);
 static cache_result_t cache_write_bucket(tree_t *, int, bucket_t *);
@@ -350,7 +278,6 @@ static db_result_t create(index_t *index)
 	size_t buck_size = 0;
 	int offset = 0;
 	db_result_t result;
-	uint8_t success = 0;
 	int curtime;
 
 	curtime = time(NULL);
@@ -437,87 +364,11 @@ static db_result_t create(index_t *index)
 	/* Initialize the tree metadata. */
 	memset(&tree->lock_buckets, 0, sizeof(tree->lock_buckets));
 
-	/* Allocating node cache and initialising it */
-	tree->node_cache = bptree_malloc(sizeof(tree_cache_t));
-	if (tree->node_cache != NULL) {
-		success |= 1;
-		qnode_t *head = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-		if (head != NULL) {
-			success |= 2;
-			tree->node_cache->in_cache.head = head;
-			qnode_t *end = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-			if (end != NULL) {
-				success |= 4;
-				head->prev = NULL;
-				end->next = NULL;
-				head->next = end;
-				end->prev = head;
-				tree->node_cache->in_cache.tail = end;
-				tree->node_cache->num = 0;
-			}
-		}
-	}
-	if (success != 7) {
-		DB_LOG_E("FAILED TO ALLOCATE NODE CACHE\n");
-		result = DB_ALLOCATION_ERROR;
-		storage_remove(tree_filename);
-		storage_remove(bucket_filename);
-		if (success & 1) {
-			if (success & 2) {
-				free(tree->node_cache->in_cache.head);
-			}
-			free(tree->node_cache);
-		}
-		free(tree);
-		return result;
-	}
-
-	/* Allocating bucket cache and initialising it */
-	tree->buck_cache = bptree_malloc(sizeof(bucket_cache_t));
-	success = 0;
-	if (tree->buck_cache != NULL) {
-		success |= 1;
-		qnode_t *head = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-		if (head != NULL) {
-			success |= 2;
-			tree->buck_cache->in_cache.head = head;
-			qnode_t *end = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-			if (end != NULL) {
-				success |= 4;
-				head->prev = NULL;
-				end->next = NULL;
-				head->next = end;
-				end->prev = head;
-				tree->buck_cache->in_cache.tail = end;
-				tree->buck_cache->num = 0;
-			}
-		}
-	}
-	if (success != 7) {
-		DB_LOG_E("FAILED TO ALLOCATE BUCKET CACHE\n");
-		result = DB_ALLOCATION_ERROR;
-		free(tree->node_cache->in_cache.tail);
-		free(tree->node_cache->in_cache.head);
-		free(tree->node_cache);
-		storage_remove(tree_filename);
-		storage_remove(bucket_filename);
-		if (success & 1) {
-			if (success & 2) {
-				free(tree->buck_cache->in_cache.head);
-			}
-			free(tree->buck_cache);
-		}
-		free(tree);
-		return result;
-	}
-
 	tree->inserted = 0;
 	tree->deleted = 0;
 
 	/* Initialising Locks for concurrency control */
-	pthread_mutex_init(&(tree->node_cache_lock), NULL);
 	pthread_mutex_init(&(tree->bucket_lock), NULL);
-	pthread_mutex_init(&(tree->buck_cache_lock), NULL);
 	rw_init(&(tree->tree_lock));
 
 	tree->off_nodes = tree->off_buckets = 0;
@@ -562,8 +413,6 @@ static db_result_t load(index_t *index)
 	tree_t *tree;
 	db_storage_id_t fd;
 	char bucket_file[DB_MAX_FILENAME_LENGTH];
-	db_result_t result;
-	uint8_t success = 0;
 
 	index->opaque_data = tree = bptree_malloc(sizeof(tree_t));
 	if (tree == NULL) {
@@ -592,75 +441,6 @@ static db_result_t load(index_t *index)
 	}
 	storage_close(fd);
 
-	tree->node_cache = bptree_malloc(sizeof(tree_cache_t));
-	if (tree->node_cache != NULL) {
-		success |= 1;
-		qnode_t *head = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-		if (head != NULL) {
-			success |= 2;
-			tree->node_cache->in_cache.head = head;
-			qnode_t *end = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-			if (end != NULL) {
-				success |= 4;
-				head->prev = NULL;
-				end->next = NULL;
-				head->next = end;
-				end->prev = head;
-				tree->node_cache->in_cache.tail = end;
-				tree->node_cache->num = 0;
-			}
-		}
-	}
-	if (success != 7) {
-		DB_LOG_E("FAILED TO ALLOCATE NODE CACHE\n");
-		result = DB_ALLOCATION_ERROR;
-		if (success & 1) {
-			if (success & 2) {
-				free(tree->node_cache->in_cache.head);
-			}
-			free(tree->node_cache);
-		}
-		free(tree);
-		return result;
-	}
-
-	/* Allocating bucket cache and initialising it  */
-	tree->buck_cache = bptree_malloc(sizeof(bucket_cache_t));
-	success = 0;
-	if (tree->buck_cache != NULL) {
-		success |= 1;
-		qnode_t *head = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-		if (head != NULL) {
-			success |= 2;
-			tree->buck_cache->in_cache.head = head;
-			qnode_t *end = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-			if (end != NULL) {
-				success |= 4;
-				head->prev = NULL;
-				end->next = NULL;
-				head->next = end;
-				end->prev = head;
-				tree->buck_cache->in_cache.tail = end;
-				tree->buck_cache->num = 0;
-			}
-		}
-	}
-	if (success != 7) {
-		DB_LOG_E("FAILED TO ALLOCATE BUCKET CACHE\n");
-		result = DB_ALLOCATION_ERROR;
-		free(tree->node_cache->in_cache.tail);
-		free(tree->node_cache->in_cache.head);
-		free(tree->node_cache);
-		if (success & 1) {
-			if (success & 2) {
-				free(tree->buck_cache->in_cache.head);
-			}
-			free(tree->buck_cache);
-		}
-		free(tree);
-		return result;
-	}
-
 	base_offset = sizeof(tree_t) + sizeof(bucket_file);
 	tree->tree_storage = storage_open(index->descriptor_file, O_RDWR);
 	tree->bucket_storage = storage_open(bucket_file, O_RDWR);
@@ -674,52 +454,17 @@ static db_result_t load(index_t *index)
 static db_result_t release(index_t *index)
 {
 	tree_t *tree;
-	qnode_t *tmp_node;
 
 	tree = index->opaque_data;
 	if (tree == NULL) {
 		return DB_ALLOCATION_ERROR;
 	}
-	if (tree->node_cache == NULL || tree->buck_cache == NULL) {
-		return DB_ALLOCATION_ERROR;
-	}
-	if ((tree->node_cache->in_cache.tail == NULL) || (tree->node_cache->in_cache.head == NULL)) {
-		return DB_ALLOCATION_ERROR;
-	}
-	if ((tree->buck_cache->in_cache.tail == NULL) || (tree->buck_cache->in_cache.head == NULL)) {
-		return DB_ALLOCATION_ERROR;
-	}
 	storage_write_to(tree->tree_storage, tree, 0, sizeof(tree_t));
-	/* Bucket Cache being flushed */
-	tmp_node = tree->buck_cache->in_cache.head->next;
-	free(tmp_node->prev);
-	while (tmp_node != tree->buck_cache->in_cache.tail) {
-		if ((tmp_node->node_state & NODE_STATE_DIRTY) && (tmp_node->node_state & NODE_STATE_VALID)) {
-			bucket_write(tree, tmp_node->id, &(tree->buck_cache->cache_t[tmp_node->pos].bucket));
-		}
-		tmp_node = tmp_node->next;
-		if (tmp_node->prev) {
-			free(tmp_node->prev);
-		}
-	}
-	free(tree->buck_cache->in_cache.tail);
-	tmp_node = tree->node_cache->in_cache.head->next;
-	free(tmp_node->prev);
-	while (tmp_node != tree->node_cache->in_cache.tail) {
-		if ((tmp_node->node_state & NODE_STATE_DIRTY) && (tmp_node->node_state & NODE_STATE_VALID)) {
-			tree_write(tree, tmp_node->id, &(tree->node_cache->cache_t[tmp_node->pos].node));
-		}
-		tmp_node = tmp_node->next;
-		if (tmp_node->prev) {
-			free(tmp_node->prev);
-		}
-	}
-	free(tree->node_cache->in_cache.tail);
+
+	/* Closing the storages writes back their dirty nodes and buckets */
 	storage_close(tree->bucket_storage);
 	storage_close(tree->tree_storage);
 
-	free(tree->node_cache);
-	free(tree->buck_cache);
 	free(tree);
 	return DB_OK;
 }
@@ -757,27 +502,9 @@ static db_result_t insert(index_t *index, attribute_value_t *key, tuple_id_t val
 	 *	and write back is preferred.
 	 ***************************************************************************************/
 #ifdef DB_WIP
-	qnode_t *tmp_node;
 	storage_write_to(tree->tree_storage, tree, 0, sizeof(tree_t));
-
-	/* Bucket Cache being flushed */
-
-	tmp_node = tree->buck_cache->in_cache.head->next;
-	while (tmp_node != tree->buck_cache->in_cache.tail) {
-		if ((tmp_node->node_state & NODE_STATE_DIRTY) && (tmp_node->node_state & NODE_STATE_VALID)) {
-			bucket_write(tree, tmp_node->id, &(tree->buck_cache->cache_t[tmp_node->pos].bucket));
-			UNSET_NODE_STATE(tmp_node, NODE_STATE_DIRTY);
-		}
-		tmp_node = tmp_node->next;
-	}
-	tmp_node = tree->node_cache->in_cache.head->next;
-	while (tmp_node != tree->node_cache->in_cache.tail) {
-		if ((tmp_node->node_state & NODE_STATE_DIRTY) && (tmp_node->node_state & NODE_STATE_VALID)) {
-			tree_write(tree, tmp_node->id, &(tree->node_cache->cache_t[tmp_node->pos].node));
-			UNSET_NODE_STATE(tmp_node, NODE_STATE_DIRTY);
-		}
-		tmp_node = tmp_node->next;
-	}
+	buffer_pool_flush(tree->bucket_storage);
+	buffer_pool_flush(tree->tree_storage);
 #endif
 	return DB_OK;
 }
@@ -1050,44 +777,27 @@ static db_result_t vacuum(tree_t *tree, relation_t *rel)
  ****************************************************************************/
 static cache_result_t modify_cache(tree_t *tree, int id, cache_type_t cache, op_type_t op)
 {
-	qnode_t *temp;
-	qnode_t *end;
+	db_storage_id_t storage;
+	unsigned long offset;
+	db_result_t result;
+
 	if (cache == NODE) {
-		pthread_mutex_lock(&(tree->node_cache_lock));
-		temp = tree->node_cache->in_cache.tail->prev;
-		end = tree->node_cache->in_cache.head;
+		storage = tree->tree_storage;
+		offset = NODE_OFFSET(id);
 	} else {
-		pthread_mutex_lock(&(tree->buck_cache_lock));
-		temp = tree->buck_cache->in_cache.tail->prev;
-		end = tree->buck_cache->in_cache.head;
-	}
-	while (temp != end) {
-		if ((temp->id == id) && (temp->node_state & NODE_STATE_VALID)) {
-			if (op == UNLOCK) {
-				UNSET_NODE_STATE(temp, NODE_STATE_LOCK);
-			} else if (op == DIRTY) {
-				SET_NODE_STATE(temp, NODE_STATE_DIRTY);
-			} else {
-				UNSET_NODE_STATE(temp, NODE_STATE_VALID | NODE_STATE_DIRTY | NODE_STATE_LOCK);
-				REMOVE_ENTRY(temp);
-				if (cache == NODE) {
-					PLACE_AT_HEAD(temp, tree->node_cache);
-				} else {
-					PLACE_AT_HEAD(temp, tree->buck_cache);
-				}
-			}
-			break;
-		}
-		temp = temp->prev;
+		storage = tree->bucket_storage;
+		offset = BUCKET_OFFSET(id);
 	}
 
-	if (cache == NODE) {
-		pthread_mutex_unlock(&(tree->node_cache_lock));
+	if (op == UNLOCK) {
+		result = buffer_pool_unpin(storage, offset);
+	} else if (op == DIRTY) {
+		result = buffer_pool_mark_dirty(storage, offset);
 	} else {
-		pthread_mutex_unlock(&(tree->buck_cache_lock));
+		result = buffer_pool_discard(storage, offset);
 	}
 
-	if (temp == end) {
+	if (DB_ERROR(result)) {
 		DB_LOG_E("PANIC CACHE OPERATION FOR A NON EXISTENT ENTRY\n");
 		return CACHE_NOT_EXIST;
 	}
@@ -1104,50 +814,11 @@ static cache_result_t modify_cache(tree_t *tree, int id, cache_type_t cache, op_
  ****************************************************************************/
 static cache_result_t cache_write_node(tree_t *tree, int id, tree_node_t *node)
 {
-	pthread_mutex_lock(&(tree->node_cache_lock));
-
-	qnode_t *new_node = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-	if (new_node == NULL) {
-		DB_LOG_E("Failed allocation of node\n");
-		pthread_mutex_unlock(&(tree->node_cache_lock));
-		return CACHE_ALLOCATION_ERROR;
+	if (DB_ERROR(buffer_pool_put(tree->tree_storage, NODE_OFFSET(id), node, sizeof(tree_node_t)))) {
+		DB_LOG_E("NO SLOT AVAIABLE IN CACHE\n");
+		return CACHE_FULL;
 	}
 
-	if (tree->node_cache->num < DB_TREE_CACHE_LIMIT) {
-		new_node->pos = tree->node_cache->num++;
-	} else {
-		qnode_t *iter_node;
-		iter_node = tree->node_cache->in_cache.head->next;
-		while ((iter_node->node_state & NODE_STATE_LOCK) && iter_node != tree->node_cache->in_cache.tail) {
-			iter_node = iter_node->next;
-		}
-		if (iter_node == tree->node_cache->in_cache.tail) {
-			free(new_node);
-			DB_LOG_E("NO SLOT AVAIABLE IN CACHE\n");
-			pthread_mutex_unlock(&(tree->node_cache_lock));
-			return CACHE_FULL;
-		}
-		if ((iter_node->node_state & NODE_STATE_DIRTY) && (iter_node->node_state & NODE_STATE_DIRTY)) {
-			tree_write(tree, iter_node->id, &(tree->node_cache->cache_t[iter_node->pos].node));
-		}
-		new_node->pos = iter_node->pos;
-		/* iter_node is the node which has to be evicted from cache.
-		 * It is removed the queue maintaining the LRU status.
-		 */
-		REMOVE_ENTRY(iter_node);
-		free(iter_node);
-	}
-
-	PLACE_AT_TAIL(new_node, tree->node_cache);
-	new_node->id = id;
-	UNSET_NODE_STATE(new_node, NODE_STATE_LOCK);
-	SET_NODE_STATE(new_node, NODE_STATE_VALID);
-	SET_NODE_STATE(new_node, NODE_STATE_DIRTY);
-
-	memcpy(&(tree->node_cache->cache_t[new_node->pos].node), node, sizeof(tree_node_t));
-
-	pthread_mutex_unlock(&(tree->node_cache_lock));
-
 	return CACHE_OK;
 }
 
@@ -1160,25 +831,10 @@ static cache_result_t cache_write_node(tree_t *tree, int id, tree_node_t *node)
  ****************************************************************************/
 static cache_result_t cache_replace_node(tree_t *tree, int id, tree_node_t *node)
 {
-	pthread_mutex_lock(&(tree->node_cache_lock));
-
-	qnode_t *replace_node;
-	replace_node = tree->node_cache->in_cache.head->next;
-
-	while ((replace_node->id != id) && (replace_node != tree->node_cache->in_cache.tail)) {
-		replace_node = replace_node->next;
-	}
-	if (replace_node == tree->node_cache->in_cache.tail || !(replace_node->node_state & NODE_STATE_LOCK)) {
+	if (DB_ERROR(buffer_pool_update(tree->tree_storage, NODE_OFFSET(id), node, sizeof(tree_node_t)))) {
 		DB_LOG_E("PANIC REPLACE FOR NON_EXISTENT OR NON_LOCKED ENTRY\n");
-		pthread_mutex_unlock(&(tree->node_cache_lock));
 		return CACHE_NOT_EXIST;
 	}
-	UNSET_NODE_STATE(replace_node, NODE_STATE_LOCK);
-	SET_NODE_STATE(replace_node, NODE_STATE_VALID | NODE_STATE_DIRTY);
-
-	memcpy(&(tree->node_cache->cache_t[replace_node->pos].node), node, sizeof(tree_node_t));
-
-	pthread_mutex_unlock(&(tree->node_cache_lock));
 
 	return CACHE_OK;
 }
@@ -1192,44 +848,10 @@ static cache_result_t cache_replace_node(tree_t *tree, int id, tree_node_t *node
  ****************************************************************************/
 static cache_result_t cache_write_bucket(tree_t *tree, int id, bucket_t *bucket)
 {
-	pthread_mutex_lock(&(tree->buck_cache_lock));
-
-	qnode_t *new_node = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-	if (new_node == NULL) {
-		pthread_mutex_unlock(&(tree->buck_cache_lock));
-		return CACHE_ALLOCATION_ERROR;
-	}
-
-	if (tree->buck_cache->num < DB_HEAP_CACHE_LIMIT) {
-		new_node->pos = tree->buck_cache->num++;
-	} else {
-		qnode_t *iter_node;
-		iter_node = tree->buck_cache->in_cache.head->next;
-		while ((iter_node->node_state & NODE_STATE_LOCK) && (iter_node != tree->buck_cache->in_cache.tail)) {
-			iter_node = iter_node->next;
-		}
-		if (iter_node == tree->buck_cache->in_cache.tail) {
-			free(new_node);
-			DB_LOG_E("NO SLOT AVAILABLE IN CACHE bucket\n");
-			pthread_mutex_unlock(&(tree->buck_cache_lock));
-			return CACHE_FULL;
-		}
-
-		if ((iter_node->node_state & NODE_STATE_DIRTY) && (iter_node->node_state & NODE_STATE_VALID)) {
-			bucket_write(tree, iter_node->id, &(tree->buck_cache->cache_t[iter_node->pos].bucket));
-		}
-		new_node->pos = iter_node->pos;
-		REMOVE_ENTRY(iter_node);
-		free(iter_node);
+	if (DB_ERROR(buffer_pool_put(tree->bucket_storage, BUCKET_OFFSET(id), bucket, sizeof(bucket_t)))) {
+		DB_LOG_E("NO SLOT AVAILABLE IN CACHE bucket\n");
+		return CACHE_FULL;
 	}
-	PLACE_AT_TAIL(new_node, tree->buck_cache);
-	new_node->id = id;
-	UNSET_NODE_STATE(new_node, NODE_STATE_LOCK);
-	SET_NODE_STATE(new_node, NODE_STATE_DIRTY | NODE_STATE_VALID);
-
-	memcpy(&(tree->buck_cache->cache_t[new_node->pos].bucket), bucket, sizeof(bucket_t));
-
-	pthread_mutex_unlock(&(tree->buck_cache_lock));
 
 	return CACHE_OK;
 }
@@ -1250,110 +872,25 @@ static int transform_key(int key)
 /****************************************************************************
  * Name: tree_read
  *
- * Description: Fetches nodes from the flash and suitably evicts the nodes
- *              from cache, in case the cache is full
+ * Description: Fetches a node through the buffer pool and locks it.
+ *              Returns NULL if the node is already locked or cannot be read.
  *
  ****************************************************************************/
 static tree_node_t *tree_read(tree_t *tree, int bucket_id)
 {
-	pthread_mutex_lock(&(tree->node_cache_lock));
-
-	bool found = false;
-	qnode_t *iter = (tree->node_cache->in_cache.tail)->prev;
-
-	while (iter != (tree->node_cache->in_cache.head)) {
-		if (bucket_id == iter->id && (iter->node_state & NODE_STATE_VALID)) {
-			found = true;
-			break;
-		}
-		iter = iter->prev;
-	}
-	if (found) {
-		/* Case when node is found in the cache */
-		if (iter->node_state & NODE_STATE_LOCK) {
-			pthread_mutex_unlock(&(tree->node_cache_lock));
-			return NULL;
-		}
-		SET_NODE_STATE(iter, NODE_STATE_LOCK);
-		REMOVE_ENTRY(iter);
-		PLACE_AT_TAIL(iter, tree->node_cache);
-		pthread_mutex_unlock(&(tree->node_cache_lock));
-		return &(tree->node_cache->cache_t[iter->pos].node);
-	} else {
-		qnode_t *new_node = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-		if (new_node == NULL) {
-			pthread_mutex_unlock(&(tree->node_cache_lock));
-			return NULL;
-		}
-		if (tree->node_cache->num < DB_TREE_CACHE_LIMIT) {
-			new_node->pos = tree->node_cache->num++;
-		} else {
-			/* Case when the least recently used node needs to be evicted to make place for new node */
-			qnode_t *replace_node = tree->node_cache->in_cache.head->next;
-			while ((replace_node->node_state & NODE_STATE_LOCK) && replace_node != tree->node_cache->in_cache.tail) {
-				replace_node = replace_node->next;
-			}
-			if (replace_node == tree->node_cache->in_cache.tail) {
-				free(new_node);
-				pthread_mutex_unlock(&(tree->node_cache_lock));
-				return NULL;
-			}
-			if ((replace_node->node_state & NODE_STATE_DIRTY) && (replace_node->node_state & NODE_STATE_VALID)) {
-				tree_write(tree, replace_node->id, &(tree->node_cache->cache_t[replace_node->pos].node));
-			}
-			new_node->pos = replace_node->pos;
-			REMOVE_ENTRY(replace_node);
-			free(replace_node);
-		}
-		/* Adjusting the pointers */
-		PLACE_AT_TAIL(new_node, tree->node_cache);
-		new_node->id = bucket_id;
-		SET_NODE_STATE(new_node, NODE_STATE_LOCK | NODE_STATE_VALID | NODE_STATE_DIRTY);
-
-		/* Reading from flash */
-		if (DB_ERROR(storage_read_from(tree->tree_storage, &(tree->node_cache->cache_t[new_node->pos].node), base_offset + (unsigned long)bucket_id * sizeof(tree_node_t), sizeof(tree_node_t)))) {
-			DB_LOG_E("PANIC TREE READ FAILED AT NODE ID %d\n", new_node->id);
-			UNSET_NODE_STATE(new_node, NODE_STATE_LOCK | NODE_STATE_VALID);
-			pthread_mutex_unlock(&(tree->node_cache_lock));
-			return NULL;
-		}
-
-		pthread_mutex_unlock(&(tree->node_cache_lock));
+	tree_node_t *node;
 
-		return &(tree->node_cache->cache_t[new_node->pos].node);
+	node = (tree_node_t *)buffer_pool_pin(tree->tree_storage, NODE_OFFSET(bucket_id), sizeof(tree_node_t));
+	if (node == NULL) {
+		return NULL;
 	}
-}
 
-/****************************************************************************
- * Name: tree_write
- *
- * Description: Routine to issue a flash write of node in the tree.
- *              Required while evicting dirty cache entries
- *
- ****************************************************************************/
-static int tree_write(tree_t *tree, int offset, tree_node_t *node)
-{
-	if (DB_ERROR(storage_write_to(tree->tree_storage, node, base_offset + (unsigned long)offset * sizeof(*node), sizeof(*node)))) {
-		DB_LOG_E("TREE WRITE FAILED AT NODE ID %d\n", offset);
-		return 0;
-	}
-	return 1;
-}
+	/* Nodes are written back whenever they leave the cache, some updates
+	 * of the tree rely on this instead of marking the node dirty.
+	 */
+	buffer_pool_mark_dirty(tree->tree_storage, NODE_OFFSET(bucket_id));
 
-/****************************************************************************
- * Name: bucket_write
- *
- * Description: Routine to issue a flash write of bucket in the tree.
- *              Required while evicting dirty cache entries
- *
- ****************************************************************************/
-static int bucket_write(tree_t *tree, int pos, bucket_t *bucket)
-{
-	if (DB_ERROR(storage_write_to(tree->bucket_storage, bucket, (unsigned long)pos * sizeof(bucket_t), sizeof(bucket_t)))) {
-		DB_LOG_E("BUCKET WRITE FAILED AT BUCKET ID %d\n", pos);
-		return 0;
-	}
-	return 1;
+	return node;
 }
 
 /****************************************************************************
@@ -1522,80 +1059,14 @@ void tree_print(tree_t *tree, int id)
 /****************************************************************************
  * Name: bucket_read
  *
- * Description: Reads buckets from the cache and fetches them from flash
- *              when the entry does not exist in cache.
- *              Also evicts the suitable entries from cache when cache is full
+ * Description: Fetches a bucket through the buffer pool and locks it.
+ *              Returns NULL if the bucket is already locked or cannot be
+ *              read.
  *
  ****************************************************************************/
 static bucket_t *bucket_read(tree_t *tree, int bucket_id)
 {
-	pthread_mutex_lock(&(tree->buck_cache_lock));
-
-	bool found = false;
-	qnode_t *iter = (tree->buck_cache->in_cache.tail)->prev;
-
-	while (iter != (tree->buck_cache->in_cache.head)) {
-		if (bucket_id == iter->id && (iter->node_state & NODE_STATE_VALID)) {
-			found = true;
-			break;
-		}
-		iter = iter->prev;
-	}
-	if (found) {
-		/* If the bucket is found in the cache */
-		if (iter->node_state & NODE_STATE_LOCK) {
-			pthread_mutex_unlock(&(tree->buck_cache_lock));
-			return NULL;
-		}
-		SET_NODE_STATE(iter, NODE_STATE_LOCK);
-		REMOVE_ENTRY(iter);
-		PLACE_AT_TAIL(iter, tree->buck_cache);
-		pthread_mutex_unlock(&(tree->buck_cache_lock));
-		return &(tree->buck_cache->cache_t[iter->pos].bucket);
-	} else {
-		/* Bucket has to be read from flash into the cache */
-		qnode_t *new_node = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-		if (new_node == NULL) {
-			pthread_mutex_unlock(&(tree->buck_cache_lock));
-			return NULL;
-		}
-		if (tree->buck_cache->num < DB_HEAP_CACHE_LIMIT) {
-			new_node->pos = tree->buck_cache->num++;
-		} else {
-			/* Cache doesn't have enough space and the least recently used bucket needs to be evicted */
-			qnode_t *replace_node = tree->buck_cache->in_cache.head->next;
-			while ((replace_node->node_state & NODE_STATE_LOCK) && (replace_node != tree->buck_cache->in_cache.tail)) {
-				replace_node = replace_node->next;
-			}
-			if (replace_node == tree->buck_cache->in_cache.tail) {
-				free(new_node);
-				pthread_mutex_unlock(&(tree->buck_cache_lock));
-				return NULL;
-			}
-			if ((replace_node->node_state & NODE_STATE_DIRTY) && (replace_node->node_state & NODE_STATE_VALID)) {
-				bucket_write(tree, replace_node->id, &(tree->buck_cache->cache_t[replace_node->pos].bucket));
-			}
-			new_node->pos = replace_node->pos;
-			REMOVE_ENTRY(replace_node);
-			free(replace_node);
-		}
-
-		/* Adjust the pointers */
-		PLACE_AT_TAIL(new_node, tree->buck_cache);
-		new_node->id = bucket_id;
-		SET_NODE_STATE(new_node, NODE_STATE_LOCK | NODE_STATE_VALID);
-		UNSET_NODE_STATE(new_node, NODE_STATE_DIRTY);
-
-		/* Read from flash */
-		if (DB_ERROR(storage_read_from(tree->bucket_storage, (void *)&(tree->buck_cache->cache_t[new_node->pos].bucket), (unsigned long)bucket_id * sizeof(bucket_t), sizeof(bucket_t)))) {
-			DB_LOG_E("PANIC BUCKET READ FAILED AT ID %d\n", bucket_id);
-			UNSET_NODE_STATE(new_node, (NODE_STATE_LOCK | NODE_STATE_VALID));
-			pthread_mutex_unlock(&(tree->buck_cache_lock));
-			return NULL;
-		}
-		pthread_mutex_unlock(&(tree->buck_cache_lock));
-		return &(tree->buck_cache->cache_t[new_node->pos].bucket);
-	}
+	return (bucket_t *)buffer_pool_pin(tree->bucket_storage, BUCKET_OFFSET(bucket_id), sizeof(bucket_t));
 }
 
 /****************************************************************************
@@ -508,10 +508,9 @@ db_result_t relation_remove(relation_t *rel, int remove_tuples)
 	return result;
 }
 
-db_result_t relation_insert(relation_t *rel, attribute_value_t *values)
+db_result_t relation_encode_tuple(relation_t *rel, attribute_value_t *values, unsigned char *record)
 {
 	attribute_t *attr;
-	unsigned char record[rel->row_length];
 	unsigned char *ptr;
 	attribute_value_t *value;
 	db_result_t result;
@@ -523,8 +522,7 @@ db_result_t relation_insert(relation_t *rel, attribute_value_t *values)
 
 	DB_LOG_V("DB: Insert (");
 
-	attr = list_head(rel->attributes);
-	while (attr != NULL) {
+	for (attr = list_head(rel->attributes); attr != NULL; attr = attr->next, value++) {
 		/* Verify that the value is in the expected domain. An exception
 		   to this rule is that INT may be promoted to LONG. */
 		if (attr->domain != value->domain && !(attr->domain == DOMAIN_LONG && value->domain == DOMAIN_INT)) {
@@ -563,21 +561,41 @@ db_result_t relation_insert(relation_t *rel, attribute_value_t *values)
 			DB_LOG_V(", ");
 		}
 #endif              /* DEBUG */
+		ptr += attr->element_size;
+	}
+
+	DB_LOG_V(")\n");
+
+	return DB_OK;
+}
+
+db_result_t relation_insert(relation_t *rel, attribute_value_t *values)
+{
+	attribute_t *attr;
+	unsigned char record[rel->row_length];
+	attribute_value_t *value;
+	db_result_t result;
+
+	result = relation_encode_tuple(rel, values, record);
+	if (DB_ERROR(result)) {
+		return result;
+	}
+
+	value = values;
+	for (attr = list_head(rel->attributes); attr != NULL; attr = attr->next, value++) {
+		if (attr->flags & ATTRIBUTE_FLAG_INVALID) {
+			continue;
+		}
 		if (attr->index == NULL) {
 			index_load(rel, attr);
 		}
-		ptr += attr->element_size;
 		if (attr->index != NULL) {
 			if (DB_ERROR(index_insert(attr->index, value, rel->next_row))) {
 				return DB_INDEX_ERROR;
 			}
 		}
-		attr = attr->next;
-		value++;
 	}
 
-	DB_LOG_V(")\n");
-
 	return storage_put_row(rel, record, FALSE);
 }
 
@@ -191,6 +191,7 @@ db_result_t relation_get_value(relation_t *, attribute_t *, unsigned char *, att
 db_result_t relation_attribute_remove(relation_t *, char *);
 db_result_t relation_set_primary_key(relation_t *, char *);
 db_result_t relation_remove(relation_t *, int);
+db_result_t relation_encode_tuple(relation_t *, attribute_value_t *, unsigned char *);
 db_result_t relation_insert(relation_t *, attribute_value_t *);
 db_result_t relation_select(db_handle_t **, relation_t *, void *);
 tuple_id_t relation_cardinality(relation_t *);
@@ -67,6 +67,7 @@
 #include "db_debug.h"
 #include "random.h"
 #include "storage.h"
+#include "buffer_pool.h"
 
 /****************************************************************************
 * Private Types
@@ -500,6 +501,7 @@ db_result_t storage_get_row(relation_t *rel, tuple_id_t *tuple_id, storage_row_t
 {
 	ssize_t r;
 	tuple_id_t nrows;
+	unsigned rows_per_page;
 
 	if (DB_ERROR(storage_get_row_amount(rel, &nrows))) {
 		return DB_STORAGE_ERROR;
@@ -510,6 +512,19 @@ db_result_t storage_get_row(relation_t *rel, tuple_id_t *tuple_id, storage_row_t
 		return DB_FINISHED;
 	}
 
+	/* Rows are cached by pages of as many rows as fit in a buffer pool page.
+	 * Tuple files are only appended to, so cached rows never become stale.
+	 */
+	rows_per_page = DB_BUFFER_POOL_PAGE_SIZE / rel->row_length;
+	if (rows_per_page > 0) {
+		if (DB_ERROR(buffer_pool_read(rel->tuple_storage, (unsigned long)(*tuple_id / rows_per_page) * rows_per_page * rel->row_length, rows_per_page * rel->row_length, row, (*tuple_id % rows_per_page) * rel->row_length, rel->row_length))) {
+			DB_LOG_E("DB: Reading failed on fd %d\n", rel->tuple_storage);
+			return DB_STORAGE_ERROR;
+		}
+		DB_LOG_D("DB: Read %d bytes from relation %s\n", rel->row_length, rel->name);
+		return DB_OK;
+	}
+
 	if (storage_seek(rel->tuple_storage, *tuple_id * rel->row_length, SEEK_SET) == (off_t)-1) {
 		return DB_STORAGE_ERROR;
 	}
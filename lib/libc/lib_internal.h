@@ -137,6 +137,16 @@
 
 #define LIB_BUFLEN_UNKNOWN INT_MAX
 
+/* Word at a time string scanning (CONFIG_STRING_OPTSPEED).  LIB_HASZERO()
+ * is non-zero if any byte of the 32-bit word 'w' is zero.  Only aligned
+ * words are read, and an aligned word never spans two pages or MPU
+ * regions, so the bytes read past the end of a string are always mapped.
+ */
+
+#define LIB_WORD_ONES      0x01010101ul
+#define LIB_WORD_HIGHS     0x80808080ul
+#define LIB_HASZERO(w)     (((w) - LIB_WORD_ONES) & ~(w) & LIB_WORD_HIGHS)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -62,6 +62,10 @@
 #include <unistd.h>
 #include <errno.h>
 
+#ifdef CONFIG_NET_SENDFILE
+#include <tinyara/fs/fs.h>
+#endif
+
 #include "lib_internal.h"
 
 #if CONFIG_NSOCKET_DESCRIPTORS > 0 || CONFIG_NFILE_DESCRIPTORS > 0
@@ -130,7 +134,11 @@
  *
  ************************************************************************/
 
+#ifdef CONFIG_NET_SENDFILE
+ssize_t lib_sendfile(int outfd, int infd, off_t *offset, size_t count)
+#else
 ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
+#endif
 {
 	FAR uint8_t *iobuffer;
 	FAR uint8_t *wrbuffer;
@@ -56,8 +56,11 @@
 
 #include <tinyara/config.h>
 
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_internal.h"
+
 /****************************************************************************
  * Global Functions
  ****************************************************************************/
@@ -81,6 +84,26 @@ FAR void *memchr(FAR const void *s, int c, size_t n)
 	FAR const unsigned char *p = (FAR const unsigned char *)s;
 
 	if (s) {
+#ifdef CONFIG_STRING_OPTSPEED
+		FAR const uint32_t *w;
+		uint32_t mask = (unsigned char)c * LIB_WORD_ONES;
+
+		/* Check single bytes up to a word boundary, then skip the words
+		 * that do not hold 'c'.
+		 */
+
+		for (; n > 0 && ((uintptr_t)p & 3) != 0; n--, p++) {
+			if (*p == (unsigned char)c) {
+				return (FAR void *)p;
+			}
+		}
+
+		for (w = (FAR const uint32_t *)p; n >= 4 && !LIB_HASZERO(*w ^ mask); n -= 4) {
+			w++;
+		}
+
+		p = (FAR const unsigned char *)w;
+#endif
 		while (n--) {
 			if (*p == (unsigned char)c) {
 				return (FAR void *)p;
@@ -60,8 +60,25 @@
 
 #include <tinyara/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_MEMCPY_OPTSPEED
+/* Merge two aligned source words into the destination word that starts
+ * 'shift' bits into the first one.
+ */
+
+#ifdef CONFIG_ENDIAN_BIG
+#define MERGE(w0, w1, shift) (((w0) << (shift)) | ((w1) >> (32 - (shift))))
+#else
+#define MERGE(w0, w1, shift) (((w0) >> (shift)) | ((w1) << (32 - (shift))))
+#endif
+#endif
+
 /****************************************************************************
  * Global Functions
  ****************************************************************************/
@@ -75,6 +92,83 @@ FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
 {
 	FAR unsigned char *pout = (FAR unsigned char *)dest;
 	FAR unsigned char *pin = (FAR unsigned char *)src;
+
+#ifdef CONFIG_MEMCPY_OPTSPEED
+	/* This version copies 32-bit words once the destination is aligned */
+
+	if (n >= 8) {
+		FAR uint32_t *wout;
+		FAR const uint32_t *win;
+		uint32_t w0;
+		uint32_t w1;
+		unsigned int shift;
+
+		/* Align the destination to a 32-bit boundary */
+
+		while (((uintptr_t)pout & 3) != 0) {
+			*pout++ = *pin++;
+			n--;
+		}
+
+		wout = (FAR uint32_t *)pout;
+		shift = ((uintptr_t)pin & 3) << 3;
+		if (shift == 0) {
+			/* Both are aligned.  Copy 16 bytes per iteration, which the
+			 * compiler can turn into a pair of LDM/STM on ARM.
+			 */
+
+			win = (FAR const uint32_t *)pin;
+			while (n >= 16) {
+				uint32_t w2;
+				uint32_t w3;
+
+				w0 = win[0];
+				w1 = win[1];
+				w2 = win[2];
+				w3 = win[3];
+				wout[0] = w0;
+				wout[1] = w1;
+				wout[2] = w2;
+				wout[3] = w3;
+				win += 4;
+				wout += 4;
+				n -= 16;
+			}
+
+			while (n >= 4) {
+				*wout++ = *win++;
+				n -= 4;
+			}
+		} else {
+			/* The source is not aligned.  Read aligned words and shift
+			 * them into place.  Only words holding at least one byte of the
+			 * source are read.
+			 */
+
+			win = (FAR const uint32_t *)(pin - (shift >> 3));
+			w0 = *win++;
+			while (n >= 8) {
+				w1 = *win++;
+				*wout++ = MERGE(w0, w1, shift);
+				w0 = *win++;
+				*wout++ = MERGE(w1, w0, shift);
+				n -= 8;
+			}
+
+			if (n >= 4) {
+				w1 = *win++;
+				*wout++ = MERGE(w0, w1, shift);
+				n -= 4;
+			}
+
+			win--;
+		}
+
+		pin = (FAR unsigned char *)win + (shift >> 3);
+		pout = (FAR unsigned char *)wout;
+	}
+#endif
+
 	while (n-- > 0) {
 		*pout++ = *pin++;
 	}
@@ -60,6 +60,7 @@
 
 #include <tinyara/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
 /************************************************************
@@ -70,15 +71,58 @@
 FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
 {
 	char *tmp, *s;
+
+#ifdef CONFIG_MEMMOVE_OPTSPEED
+	/* Buffers that do not overlap are copied by memcpy() */
+
+	if ((char *)dest + count <= (char *)src || (char *)src + count <= (char *)dest) {
+		return memcpy(dest, src, count);
+	}
+#endif
+
 	if (dest <= src) {
 		tmp = (char *)dest;
 		s = (char *)src;
+#ifdef CONFIG_MEMMOVE_OPTSPEED
+		/* Copy words forward if both buffers have the same alignment */
+
+		if ((((uintptr_t)tmp ^ (uintptr_t)s) & 3) == 0) {
+			while (count > 0 && ((uintptr_t)tmp & 3) != 0) {
+				*tmp++ = *s++;
+				count--;
+			}
+
+			while (count >= 4) {
+				*(uint32_t *)tmp = *(uint32_t *)s;
+				tmp += 4;
+				s += 4;
+				count -= 4;
+			}
+		}
+#endif
 		while (count--) {
 			*tmp++ = *s++;
 		}
 	} else {
 		tmp = (char *)dest + count;
 		s = (char *)src + count;
+#ifdef CONFIG_MEMMOVE_OPTSPEED
+		/* Copy words backward if both buffers have the same alignment */
+
+		if ((((uintptr_t)tmp ^ (uintptr_t)s) & 3) == 0) {
+			while (count > 0 && ((uintptr_t)tmp & 3) != 0) {
+				*--tmp = *--s;
+				count--;
+			}
+
+			while (count >= 4) {
+				tmp -= 4;
+				s -= 4;
+				*(uint32_t *)tmp = *(uint32_t *)s;
+				count -= 4;
+			}
+		}
+#endif
 		while (count--) {
 			*--tmp = *--s;
 		}
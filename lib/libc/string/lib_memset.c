@@ -119,6 +119,17 @@ void *memset(void *s, int c, size_t n)
 				n -= 2;
 			}
 #ifndef CONFIG_MEMSET_64BIT
+			/* Write 16 bytes per iteration while possible */
+
+			while (n >= 16) {
+				((uint32_t *)addr)[0] = val32;
+				((uint32_t *)addr)[1] = val32;
+				((uint32_t *)addr)[2] = val32;
+				((uint32_t *)addr)[3] = val32;
+				addr += 16;
+				n -= 16;
+			}
+
 			/* Loop while there are at least 32-bits left to be written */
 
 			while (n >= 4) {
@@ -56,8 +56,11 @@
 
 #include <tinyara/config.h>
 
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_internal.h"
+
 /****************************************************************************
  * Global Functions
  ****************************************************************************/
@@ -80,6 +83,27 @@
 FAR char *strchr(FAR const char *s, int c)
 {
 	if (s) {
+#ifdef CONFIG_STRING_OPTSPEED
+		FAR const uint32_t *w;
+		uint32_t mask = (unsigned char)c * LIB_WORD_ONES;
+
+		/* Check single bytes up to a word boundary, then skip the words
+		 * that hold neither 'c' nor the terminator.
+		 */
+
+		for (; ((uintptr_t)s & 3) != 0; s++) {
+			if (*s == c) {
+				return (FAR char *)s;
+			}
+
+			if (!*s) {
+				return NULL;
+			}
+		}
+
+		for (w = (FAR const uint32_t *)s; !LIB_HASZERO(*w) && !LIB_HASZERO(*w ^ mask); w++);
+		s = (FAR const char *)w;
+#endif
 		for (;; s++) {
 			if (*s == c) {
 				return (FAR char *)s;
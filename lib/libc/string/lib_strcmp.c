@@ -56,8 +56,11 @@
 
 #include <tinyara/config.h>
 
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_internal.h"
+
 /****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -66,6 +69,34 @@
 int strcmp(const char *cs, const char *ct)
 {
 	register signed char result;
+
+#ifdef CONFIG_STRING_OPTSPEED
+	/* If both strings have the same alignment, skip the words that are
+	 * equal and have no terminator.  The byte loop finds the difference.
+	 */
+
+	if ((((uintptr_t)cs ^ (uintptr_t)ct) & 3) == 0) {
+		FAR const uint32_t *w1;
+		FAR const uint32_t *w2;
+
+		for (; ((uintptr_t)cs & 3) != 0; cs++, ct++) {
+			if ((result = *cs - *ct) != 0 || !*cs) {
+				return result;
+			}
+		}
+
+		w1 = (FAR const uint32_t *)cs;
+		w2 = (FAR const uint32_t *)ct;
+		while (*w1 == *w2 && !LIB_HASZERO(*w1)) {
+			w1++;
+			w2++;
+		}
+
+		cs = (const char *)w1;
+		ct = (const char *)w2;
+	}
+#endif
+
 	for (;;) {
 		if ((result = *cs - *ct++) != 0 || !*cs++) {
 			break;
@@ -56,8 +56,11 @@
 
 #include <tinyara/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_internal.h"
+
 /****************************************************************************
  * Global Functions
  ****************************************************************************/
@@ -66,7 +69,23 @@
 size_t strlen(const char *s)
 {
 	const char *sc;
-	for (sc = s; *sc != '\0'; ++sc);
+#ifdef CONFIG_STRING_OPTSPEED
+	FAR const uint32_t *w;
+
+	/* Check single bytes up to a word boundary, then whole words */
+
+	for (sc = s; ((uintptr_t)sc & 3) != 0; ++sc) {
+		if (*sc == '\0') {
+			return sc - s;
+		}
+	}
+
+	for (w = (FAR const uint32_t *)sc; !LIB_HASZERO(*w); w++);
+	sc = (const char *)w;
+#else
+	sc = s;
+#endif
+	for (; *sc != '\0'; ++sc);
 	return sc - s;
 }
 #endif
@@ -422,28 +422,46 @@ struct block_cache_s {
 };
 typedef struct block_cache_s block_cache_t;
 
+/* Block cache of one ELF file, allocated by elf_cache_init */
+struct elf_cache_s {
+	unsigned int number_blocks_caching;	/* Number of blocks to be caching */
+	unsigned int cache_blocks_size;		/* Size of each blocks for caching */
+	unsigned int file_len;				/* Length of file w/o binary header */
+	unsigned int number_of_blocks;		/* Number of blocks of the file */
+	block_cache_t *blockcache;			/* List to be used for holding ELF blocks */
+	block_cache_t *head;				/* Pointer to least priority block for caching */
+	block_cache_t *tail;				/* Pointer to highest priority block for caching */
+	block_cache_t *most_accessed;		/* Pointer to most accessed block for quick access */
+	unsigned int max_accessed_count;	/* Number of requests for the most accessed block */
+	unsigned int elf_compress_type;		/* Compression Type of the file */
+#ifdef CONFIG_COMPRESSED_BINARY
+	FAR struct compress_ctx_s *compctx;	/* Decompression state of the file */
+#endif
+};
+
 /****************************************************************************
  * Name: elf_cache_uninit
  *
  * Description:
- *   Release cache buffers initialized during elf_cache_init
+ *   Release the cache of 'loadinfo' allocated by elf_cache_init
  *
  * Returned Value:
  *   None
  ****************************************************************************/
-void elf_cache_uninit(void);
+void elf_cache_uninit(FAR struct elf_loadinfo_s *loadinfo);
 
 /****************************************************************************
  * Name: elf_cache_init
  *
  * Description:
- *   Initialize the cache blocks
+ *   Allocate the cache blocks of the file described by 'loadinfo' and
+ *   assign them to loadinfo->cache
  *
  * Returned value:
  *   OK (0) on Success
- *   ERROR (-1) on Failure
+ *   Negative value on Failure
  ****************************************************************************/
-int elf_cache_init(int filfd, uint16_t offset, off_t filelen, uint8_t compression_type);
+int elf_cache_init(FAR struct elf_loadinfo_s *loadinfo);
 
 /****************************************************************************
  * Name: elf_cache_read
@@ -457,7 +475,7 @@ int elf_cache_init(int filfd, uint16_t offset, off_t filelen, uint8_t compressio
  *   Number of bytes read into buffer on Success
  *   Negative value on failure
  ****************************************************************************/
-int elf_cache_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer, size_t readsize, off_t offset);
+int elf_cache_read(FAR struct elf_loadinfo_s *loadinfo, FAR uint8_t *buffer, size_t readsize, off_t offset);
 #endif
 
 #ifdef CONFIG_SAVE_BIN_SECTION_ADDR
@@ -28,41 +28,13 @@
 #include <debug.h>
 #include <errno.h>
 
+#include <tinyara/kmalloc.h>
 #include <tinyara/fs/fs.h>
 #include "libelf.h"
 
 #ifdef CONFIG_COMPRESSED_BINARY
 #include <tinyara/binfmt/compression/compress_read.h>
 #endif
-/****************************************************************************
- * Private Declarations
- ****************************************************************************/
-
-/* Number of blocks to be caching */
-static unsigned int number_blocks_caching;
-
-/* Size of each blocks for caching */
-static unsigned int cache_blocks_size;
-
-/* Length of file w/o binary header */
-static unsigned int file_len;
-
-/* Number of blocks for caching */
-static unsigned int number_of_blocks;
-
-/* Pointer to block_cache_t list to be used for holding ELF blocks */
-static block_cache_t *blockcache;
-
-/* Pointers for maintaining doubly linked list of blockcache */
-static block_cache_t *head;		/* Pointer to least priority block for caching */
-static block_cache_t *tail;		/* Pointer to highest priority block for caching */
-static block_cache_t *most_accessed;	/* Pointer to most accessed block for quick access */
-
-/* Number of requests for the most accessed block in blockcache list */
-static unsigned int max_accessed_count;
-
-/* Compression Type of a file */
-static unsigned int elf_compress_type;
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -77,11 +49,11 @@ static unsigned int elf_compress_type;
  * Returned Value:
  *   None
  ****************************************************************************/
-static void elf_cache_blocks_to_read(int *first_block, int *last_block, int *no_blocks, int offset, int readsize)
+static void elf_cache_blocks_to_read(FAR struct elf_cache_s *cache, int *first_block, int *last_block, int *no_blocks, int offset, int readsize)
 {
 	int blocksize;
 
-	blocksize = cache_blocks_size;
+	blocksize = cache->cache_blocks_size;
 
 	*first_block = offset / blocksize;
 	*last_block = (offset + readsize) / blocksize;
@@ -98,12 +70,12 @@ static void elf_cache_blocks_to_read(int *first_block, int *last_block, int *no_
  *   Starting offset (positive) of 'block_number' block in binary on Success
  *   Negative value on Failure
  ****************************************************************************/
-static off_t elf_cache_lseek_block(int filfd, uint16_t binary_header_size, int block_number)
+static off_t elf_cache_lseek_block(FAR struct elf_cache_s *cache, int filfd, uint16_t binary_header_size, int block_number)
 {
 	off_t rpos;
 	off_t actual_offset;
 
-	actual_offset = binary_header_size + block_number * cache_blocks_size;
+	actual_offset = binary_header_size + block_number * cache->cache_blocks_size;
 
 	/* Seek to location of this block in actual ELF file */
 	rpos = lseek(filfd, actual_offset, SEEK_SET);
@@ -130,7 +102,7 @@ static off_t elf_cache_lseek_block(int filfd, uint16_t binary_header_size, int b
  *   Number of bytes read into out_buffer on Success
  *   Negative value on Failure
  ****************************************************************************/
-static off_t elf_cache_read_block(int filfd, uint16_t binary_header_size, FAR uint8_t *buf, int block_number)
+static off_t elf_cache_read_block(FAR struct elf_cache_s *cache, int filfd, uint16_t binary_header_size, FAR uint8_t *buf, int block_number)
 {
 	off_t rpos;
 	size_t readsize;
@@ -139,15 +111,15 @@ static off_t elf_cache_read_block(int filfd, uint16_t binary_header_size, FAR ui
 	binfo("filfd: %d block_number: %d binary_header_size: %d\n", filfd, block_number, binary_header_size);
 
 	/* Seek to location of 'block_number' block in elf file for uncompressed elf */
-	if (elf_compress_type == COMPRESS_TYPE_NONE) {
-		rpos = elf_cache_lseek_block(filfd, binary_header_size, block_number);
+	if (cache->elf_compress_type == COMPRESS_TYPE_NONE) {
+		rpos = elf_cache_lseek_block(cache, filfd, binary_header_size, block_number);
 	}
 #ifdef CONFIG_COMPRESSED_BINARY
 	else {
-		if (elf_compress_type == CONFIG_COMPRESSION_TYPE) {
-			rpos = binary_header_size + (block_number * cache_blocks_size);
+		if (cache->elf_compress_type == CONFIG_COMPRESSION_TYPE) {
+			rpos = binary_header_size + (block_number * cache->cache_blocks_size);
 		} else {
-			berr("No support for decompression of compression format %d of this binary\n", elf_compress_type);
+			berr("No support for decompression of compression format %d of this binary\n", cache->elf_compress_type);
 			return ERROR;
 		}
 	}
@@ -160,23 +132,23 @@ static off_t elf_cache_read_block(int filfd, uint16_t binary_header_size, FAR ui
 	}
 
 	/* Last unaligned blocks to be read with its actual size and not with blocksize;*/
-	if (block_number == number_of_blocks - 1) {
-		readsize = file_len % cache_blocks_size;
+	if (block_number == cache->number_of_blocks - 1) {
+		readsize = cache->file_len - block_number * cache->cache_blocks_size;
 	} else {
-		readsize = cache_blocks_size;
+		readsize = cache->cache_blocks_size;
 	}
 
-	if (elf_compress_type == COMPRESS_TYPE_NONE) {
+	if (cache->elf_compress_type == COMPRESS_TYPE_NONE) {
 		/* Read actual data to 'block_number's buf */
 		nbytes = read(filfd, buf, readsize);
 	}
 #ifdef CONFIG_COMPRESSED_BINARY
 	else {
-		if (elf_compress_type == CONFIG_COMPRESSION_TYPE) {
+		if (cache->elf_compress_type == CONFIG_COMPRESSION_TYPE) {
 			/* Read readsize bytes from offset from uncompressed file into user buffer */
-			nbytes = compress_read(filfd, binary_header_size, buf, readsize, rpos - binary_header_size);
+			nbytes = compress_read(cache->compctx, buf, readsize, rpos - binary_header_size);
 		} else {
-			berr("No support for decompression of compression format %d of this binary\n", elf_compress_type);
+			berr("No support for decompression of compression format %d of this binary\n", cache->elf_compress_type);
 			return ERROR;
 		}
 	}
@@ -211,7 +183,7 @@ static off_t elf_cache_read_block(int filfd, uint16_t binary_header_size, FAR ui
  *   Index in blockcache list where 'block_number' from elf
  *   binary is cached state. Return Negative value on failure.
  ****************************************************************************/
-static unsigned int elf_cache_update_blockcache_list(int block_number, int filfd, uint16_t binary_header_size)
+static unsigned int elf_cache_update_blockcache_list(FAR struct elf_cache_s *cache, int block_number, int filfd, uint16_t binary_header_size)
 {
 	unsigned int blockcache_index;		/* Which blockcache element has needed ELF data for read */
 	block_cache_t *ptr;					/* Pointer to element in blockcache list which will be updated */
@@ -228,14 +200,14 @@ static unsigned int elf_cache_update_blockcache_list(int block_number, int filfd
 	update_most_accessed = false;
 
 	/* First check is with block_number at most_accessed pointer */
-	if (most_accessed->block_number == block_number) {
+	if (cache->most_accessed->block_number == block_number) {
 		flag_for_caching = false;
-		blockcache_index = most_accessed->index_block_cache;
+		blockcache_index = cache->most_accessed->index_block_cache;
 	}
 
 	/* Start checking for if block is cached from the tail */
 	if (flag_for_caching == true) {
-		ptr = tail;
+		ptr = cache->tail;
 		while (ptr != NULL) {
 			if (ptr->block_number == block_number) {
 				flag_for_caching = false;
@@ -251,16 +223,16 @@ static unsigned int elf_cache_update_blockcache_list(int block_number, int filfd
 	if (flag_for_caching == true) {
 
 		/* If most_accessed == head, need to update most_accessed */
-		if (head == most_accessed)
+		if (cache->head == cache->most_accessed)
 			update_most_accessed = true;
 
 		/* Detach head, Reassign head to head->next */
-		ptr = head;
-		head = ptr->next;
-		head->prev = ptr->prev;
+		ptr = cache->head;
+		cache->head = ptr->next;
+		cache->head->prev = ptr->prev;
 
 		/* Read elf 'block_number' block into respective 'out_buffer' */
-		size = elf_cache_read_block(filfd, binary_header_size, ptr->out_buffer, block_number);
+		size = elf_cache_read_block(cache, filfd, binary_header_size, ptr->out_buffer, block_number);
 		if (size < 0) {
 			berr("Read for block %d failed\n", block_number);
 			return ERROR;
@@ -271,26 +243,26 @@ static unsigned int elf_cache_update_blockcache_list(int block_number, int filfd
 		ptr->no_requests_for_block = 1;
 
 		/* Updating most_accessed pointer */
-		if (ptr->no_requests_for_block >= max_accessed_count) {
-			max_accessed_count = ptr->no_requests_for_block;
-			most_accessed = ptr;
+		if (ptr->no_requests_for_block >= cache->max_accessed_count) {
+			cache->max_accessed_count = ptr->no_requests_for_block;
+			cache->most_accessed = ptr;
 		}
 
 		/* Always attach ptr at tail */
-		temp = tail;
+		temp = cache->tail;
 		temp->next = ptr;
 		ptr->prev = temp;
 		ptr->next = NULL;
-		tail = ptr;
+		cache->tail = ptr;
 
 		/* Update most_accessed from scratch, if needed */
 		if (update_most_accessed == true) {
-			max_accessed_count = 0;
-			temp = tail;
+			cache->max_accessed_count = 0;
+			temp = cache->tail;
 			while (temp != NULL) {
-				if (temp->no_requests_for_block > max_accessed_count) {
-					max_accessed_count = temp->no_requests_for_block;
-					most_accessed = temp;
+				if (temp->no_requests_for_block > cache->max_accessed_count) {
+					cache->max_accessed_count = temp->no_requests_for_block;
+					cache->most_accessed = temp;
 				}
 				temp = temp->prev;
 			}
@@ -302,40 +274,40 @@ static unsigned int elf_cache_update_blockcache_list(int block_number, int filfd
 	} else { /* If block is already cached */
 
 		/* If block is cached at head location */
-		if (head == &blockcache[blockcache_index]) {
+		if (cache->head == &cache->blockcache[blockcache_index]) {
 			/* Detach head, Reassign head to head->next */
-			ptr = head;
-			head = ptr->next;
-			head->prev = ptr->prev;
+			ptr = cache->head;
+			cache->head = ptr->next;
+			cache->head->prev = ptr->prev;
 
 			ptr->no_requests_for_block += 1;
 
 			/* Update most_accessed pointer */
-			if (ptr->no_requests_for_block >= max_accessed_count) {
-				max_accessed_count = ptr->no_requests_for_block;
-				most_accessed = ptr;
+			if (ptr->no_requests_for_block >= cache->max_accessed_count) {
+				cache->max_accessed_count = ptr->no_requests_for_block;
+				cache->most_accessed = ptr;
 			}
 
 			/* Always attach ptr at tail */
-			temp = tail;
+			temp = cache->tail;
 			temp->next = ptr;
 			ptr->prev = temp;
 			ptr->next = NULL;
-			tail = ptr;
+			cache->tail = ptr;
 
-		} else if (tail == &blockcache[blockcache_index]) { /* Block is cached at tail location */
-			blockcache[blockcache_index].no_requests_for_block += 1;
+		} else if (cache->tail == &cache->blockcache[blockcache_index]) { /* Block is cached at tail location */
+			cache->blockcache[blockcache_index].no_requests_for_block += 1;
 
 			/* Update most_accessed pointer */
-			ptr = tail;
-			if (ptr->no_requests_for_block >= max_accessed_count) {
-				max_accessed_count = ptr->no_requests_for_block;
-				most_accessed = ptr;
+			ptr = cache->tail;
+			if (ptr->no_requests_for_block >= cache->max_accessed_count) {
+				cache->max_accessed_count = ptr->no_requests_for_block;
+				cache->most_accessed = ptr;
 			}
 		} else { /* Block is cached at some other index in blockcache list */
 
 			/* Detach blockcache element at blockcache_index */
-			ptr = &blockcache[blockcache_index];
+			ptr = &cache->blockcache[blockcache_index];
 			ptr->prev->next = ptr->next;
 			ptr->next->prev = ptr->prev;
 
@@ -343,17 +315,17 @@ static unsigned int elf_cache_update_blockcache_list(int block_number, int filfd
 			ptr->no_requests_for_block += 1;
 
 			/* Update most accessed pointer */
-			if (ptr->no_requests_for_block >= max_accessed_count) {
-				max_accessed_count = ptr->no_requests_for_block;
-				most_accessed = ptr;
+			if (ptr->no_requests_for_block >= cache->max_accessed_count) {
+				cache->max_accessed_count = ptr->no_requests_for_block;
+				cache->most_accessed = ptr;
 			}
 
 			/* Always attach ptr at tail */
-			temp = tail;
+			temp = cache->tail;
 			temp->next = ptr;
 			ptr->prev = temp;
 			ptr->next = NULL;
-			tail = ptr;
+			cache->tail = ptr;
 		}
 	}
 
@@ -373,8 +345,11 @@ static unsigned int elf_cache_update_blockcache_list(int block_number, int filfd
  *   Number of bytes read into buffer on Success
  *   Negative value on failure
  ****************************************************************************/
-int elf_cache_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer, size_t readsize, off_t offset)
+int elf_cache_read(FAR struct elf_loadinfo_s *loadinfo, FAR uint8_t *buffer, size_t readsize, off_t offset)
 {
+	FAR struct elf_cache_s *cache = loadinfo->cache;
+	int filfd = loadinfo->filfd;
+	uint16_t binary_header_size = loadinfo->offset;
 	int first_block;
 	int last_block;
 	int no_blocks;
@@ -388,8 +363,8 @@ int elf_cache_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer,
 	binfo("filfd: %d readsize: %d offset: %d\n", filfd, readsize, offset);
 
 	/* Setting first block, end block and number of blocks to read */
-	blocksize = cache_blocks_size;
-	elf_cache_blocks_to_read(&first_block, &last_block, &no_blocks, offset, readsize);
+	blocksize = cache->cache_blocks_size;
+	elf_cache_blocks_to_read(cache, &first_block, &last_block, &no_blocks, offset, readsize);
 	if (first_block < 0 || no_blocks < 0) {
 		berr("Incorrect first_block, no_blocks info\n");
 		buffer_pos = ERROR;
@@ -405,8 +380,8 @@ int elf_cache_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer,
 	for (; block_number < first_block + no_blocks; block_number++) {
 
 		/* Update blockcache list and get data into one of the blockcache elements */
-		blockcache_index = elf_cache_update_blockcache_list(block_number, filfd, binary_header_size);
-		if (blockcache_index >= number_blocks_caching) {
+		blockcache_index = elf_cache_update_blockcache_list(cache, block_number, filfd, binary_header_size);
+		if (blockcache_index >= cache->number_blocks_caching) {
 			buffer_pos = ERROR;
 			goto error_cache_read;
 		}
@@ -418,7 +393,7 @@ int elf_cache_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer,
 			 * Otherwise, write from start_offset to end_offset into buffer.
 			 */
 			block_size_to_write = (((block_number + 1) * blocksize - 1) > (actual_offset + readsize - 1)) ? readsize : ((block_number + 1) * blocksize - actual_offset);
-			memcpy(&buffer[buffer_pos], &blockcache[blockcache_index].out_buffer[actual_offset - (block_number * blocksize)], block_size_to_write);
+			memcpy(&buffer[buffer_pos], &cache->blockcache[blockcache_index].out_buffer[actual_offset - (block_number * blocksize)], block_size_to_write);
 			buffer_pos += block_size_to_write;
 		} else if (block_number == last_block) {
 			/*
@@ -427,7 +402,7 @@ int elf_cache_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer,
 			 * Write from start_offset to end_offset from this block into buffer.
 			 */
 			block_size_to_write = actual_offset + readsize - (block_number * blocksize);
-			memcpy(&buffer[buffer_pos], &blockcache[blockcache_index].out_buffer[0], block_size_to_write);
+			memcpy(&buffer[buffer_pos], &cache->blockcache[blockcache_index].out_buffer[0], block_size_to_write);
 			buffer_pos += block_size_to_write;
 		} else {
 			/*
@@ -435,7 +410,7 @@ int elf_cache_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer,
 			 * So, write entire block into buffer.
 			 */
 			block_size_to_write = blocksize;
-			memcpy(&buffer[buffer_pos], &blockcache[blockcache_index].out_buffer[0], block_size_to_write);
+			memcpy(&buffer[buffer_pos], &cache->blockcache[blockcache_index].out_buffer[0], block_size_to_write);
 			buffer_pos += block_size_to_write;
 		}
 	}
@@ -448,99 +423,119 @@ error_cache_read:
  * Name: elf_cache_init
  *
  * Description:
- *   IInitialize the cache blocks
+ *   Allocate the block cache of the file described by 'loadinfo'.  Each
+ *   file has its own cache, so several binaries can be loaded at the same
+ *   time.
  *
  * Returned value:
  *   OK (0) on Success
  *   Negative value on Failure
  ****************************************************************************/
-int elf_cache_init(int filfd, uint16_t offset, off_t filelen, uint8_t compression_type)
+int elf_cache_init(FAR struct elf_loadinfo_s *loadinfo)
 {
-	int ret = OK;
+	FAR struct elf_cache_s *cache;
+
+	binfo("filfd: %d offset: %d filelen: %d compression_type: %d\n", loadinfo->filfd, loadinfo->offset, loadinfo->filelen, loadinfo->compression_type);
 
-	binfo("filfd: %d offset: %d filelen: %d compression_type: %d\n", filfd, offset, filelen, compression_type);
+	cache = (FAR struct elf_cache_s *)kmm_zalloc(sizeof(struct elf_cache_s));
+	if (!cache) {
+		berr("Failed kmm_zalloc for elf cache\n");
+		return -ENOMEM;
+	}
+
+	loadinfo->cache = cache;
 
 	/* Initialize the ELF params */
-	number_blocks_caching = CONFIG_ELF_CACHE_BLOCKS_COUNT;
-	cache_blocks_size = CONFIG_ELF_CACHE_BLOCK_SIZE;
-	file_len = filelen;
-	number_of_blocks = file_len / cache_blocks_size;
-	elf_compress_type = compression_type;
+	cache->number_blocks_caching = CONFIG_ELF_CACHE_BLOCKS_COUNT;
+	cache->cache_blocks_size = CONFIG_ELF_CACHE_BLOCK_SIZE;
+	cache->file_len = loadinfo->filelen;
+	cache->number_of_blocks = cache->file_len / cache->cache_blocks_size;
+	cache->elf_compress_type = loadinfo->compression_type;
+#ifdef CONFIG_COMPRESSED_BINARY
+	cache->compctx = loadinfo->compctx;
+#endif
 
 	/* Set number of blocks to use for caching */
-	if (CONFIG_ELF_CACHE_BLOCKS_COUNT > (CUTOFF_RATIO_CACHE_BLOCKS) * (number_of_blocks)) {
-		number_blocks_caching = (CUTOFF_RATIO_CACHE_BLOCKS) * (number_of_blocks);
+	if (CONFIG_ELF_CACHE_BLOCKS_COUNT > (CUTOFF_RATIO_CACHE_BLOCKS) * (cache->number_of_blocks)) {
+		cache->number_blocks_caching = (CUTOFF_RATIO_CACHE_BLOCKS) * (cache->number_of_blocks);
 	}
 
 	/* Extra unaligned data apart from blocksize */
-	if (file_len % cache_blocks_size) {
-		number_of_blocks++;
-		number_blocks_caching++;
+	if (cache->file_len % cache->cache_blocks_size) {
+		cache->number_of_blocks++;
+		cache->number_blocks_caching++;
 	}
 
 	/* Minimum 2 blocks needed for caching logic to work */
-	if (number_blocks_caching < 2) {
-		number_blocks_caching = 2;
+	if (cache->number_blocks_caching < 2) {
+		cache->number_blocks_caching = 2;
 	}
 
 	/* Initialize max_accesed_count to 0 */
-	max_accessed_count = 0;
+	cache->max_accessed_count = 0;
 
-	blockcache = (block_cache_t *)kmm_malloc(number_blocks_caching * sizeof(block_cache_t));
-	if (!blockcache) {
-		berr("Failed kmm_malloc for blockcache\n");
-		elf_cache_uninit();
+	cache->blockcache = (block_cache_t *)kmm_zalloc(cache->number_blocks_caching * sizeof(block_cache_t));
+	if (!cache->blockcache) {
+		berr("Failed kmm_zalloc for blockcache\n");
+		elf_cache_uninit(loadinfo);
 		return -ENOMEM;
 	}
 
 	/* Initialize blockcache list */
-	for (int i = 0; i < number_blocks_caching; i++) {
-		blockcache[i].out_buffer = (unsigned char *)kmm_malloc(cache_blocks_size);
+	for (int i = 0; i < cache->number_blocks_caching; i++) {
+		cache->blockcache[i].out_buffer = (unsigned char *)kmm_malloc(cache->cache_blocks_size);
 
-		if (!blockcache[i].out_buffer) {
+		if (!cache->blockcache[i].out_buffer) {
 			berr("Failed kmm_malloc for blockcache's out_buffer\n");
-			elf_cache_uninit();
+			elf_cache_uninit(loadinfo);
 			return -ENOMEM;
 		}
 
-		blockcache[i].block_number = -1;
-		blockcache[i].no_requests_for_block = 0;
-		blockcache[i].index_block_cache = i;
-		blockcache[i].next = &blockcache[(i + 1) % number_blocks_caching];
-		blockcache[i].prev = &blockcache[(i - 1) % number_blocks_caching];
+		cache->blockcache[i].block_number = -1;
+		cache->blockcache[i].no_requests_for_block = 0;
+		cache->blockcache[i].index_block_cache = i;
+		cache->blockcache[i].next = &cache->blockcache[(i + 1) % cache->number_blocks_caching];
+		cache->blockcache[i].prev = &cache->blockcache[(i - 1) % cache->number_blocks_caching];
 	}
 
 	/* Assign head, tail and most_accessed pointers */
-	head = &blockcache[0];
-	tail = &blockcache[number_blocks_caching - 1];
-	most_accessed = tail;
+	cache->head = &cache->blockcache[0];
+	cache->tail = &cache->blockcache[cache->number_blocks_caching - 1];
+	cache->most_accessed = cache->tail;
 
-	head->prev = NULL;
-	tail->next = NULL;
+	cache->head->prev = NULL;
+	cache->tail->next = NULL;
 
-	return ret;
+	return OK;
 }
 
 /****************************************************************************
  * Name: elf_cache_uninit
  *
  * Description:
- *   Release buffers initialized during elf_cache_init
+ *   Release the block cache allocated by elf_cache_init
  *
  * Returned Value:
  *   None
  ****************************************************************************/
-void elf_cache_uninit(void)
+void elf_cache_uninit(FAR struct elf_loadinfo_s *loadinfo)
 {
-	for (int i = 0; i < number_blocks_caching; i++) {
-		if (blockcache[i].out_buffer) {
-			kmm_free(blockcache[i].out_buffer);
-			blockcache[i].out_buffer = NULL;
-		}
+	FAR struct elf_cache_s *cache = loadinfo->cache;
+
+	if (!cache) {
+		return;
 	}
 
-	if (blockcache) {
-		kmm_free(blockcache);
-		blockcache = NULL;
+	if (cache->blockcache) {
+		for (int i = 0; i < cache->number_blocks_caching; i++) {
+			if (cache->blockcache[i].out_buffer) {
+				kmm_free(cache->blockcache[i].out_buffer);
+			}
+		}
+
+		kmm_free(cache->blockcache);
 	}
+
+	kmm_free(cache);
+	loadinfo->cache = NULL;
 }
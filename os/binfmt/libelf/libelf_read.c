@@ -143,7 +143,7 @@ int elf_read(FAR struct elf_loadinfo_s *loadinfo, FAR uint8_t *buffer, size_t re
 #if defined(CONFIG_ELF_CACHE_READ)
 			/* Cache only if readsize request <= cache block size */
 			if (readsize <= CONFIG_ELF_CACHE_BLOCK_SIZE) {
-				nbytes = elf_cache_read(loadinfo->filfd, loadinfo->offset, buffer, readsize, offset - loadinfo->offset);
+				nbytes = elf_cache_read(loadinfo, buffer, readsize, offset - loadinfo->offset);
 			} else {
 				rpos = lseek(loadinfo->filfd, offset, SEEK_SET);
 				if (rpos != offset) {
@@ -175,12 +175,12 @@ int elf_read(FAR struct elf_loadinfo_s *loadinfo, FAR uint8_t *buffer, size_t re
 #if defined(CONFIG_ELF_CACHE_READ)
 				/* Cache only if readsize request <= cache block size */
 				if (readsize <= CONFIG_ELF_CACHE_BLOCK_SIZE) {
-					nbytes = elf_cache_read(loadinfo->filfd, loadinfo->offset, buffer, readsize, offset - loadinfo->offset);
+					nbytes = elf_cache_read(loadinfo, buffer, readsize, offset - loadinfo->offset);
 				} else {
-					nbytes = compress_read(loadinfo->filfd, loadinfo->offset, buffer, readsize, offset - loadinfo->offset);
+					nbytes = compress_read(loadinfo->compctx, buffer, readsize, offset - loadinfo->offset);
 				}
 #else
-				nbytes = compress_read(loadinfo->filfd, loadinfo->offset, buffer, readsize, offset - loadinfo->offset);
+				nbytes = compress_read(loadinfo->compctx, buffer, readsize, offset - loadinfo->offset);
 #endif
 			} else {
 				berr("No support for decompression of compression format %d of this binary\n", loadinfo->compression_type);
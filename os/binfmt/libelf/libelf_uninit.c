@@ -106,14 +106,15 @@ int elf_uninit(struct elf_loadinfo_s *loadinfo)
 	/* Free buffers used for decompression */
 	if (loadinfo->compression_type > COMPRESS_TYPE_NONE) {
 #ifdef CONFIG_COMPRESSED_BINARY
-		compress_uninit();
+		compress_uninit(loadinfo->compctx);
+		loadinfo->compctx = NULL;
 #else
 		berr("No support for reading compressed binary\n");
 		return ERROR;
 #endif
 	}
 #if defined(CONFIG_ELF_CACHE_READ)
-	elf_cache_uninit();
+	elf_cache_uninit(loadinfo);
 #endif
 
 	/* Close the ELF file */
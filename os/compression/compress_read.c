@@ -25,10 +25,15 @@
 #include <stdint.h>
 #include <unistd.h>
 #include <string.h>
+#include <semaphore.h>
+#include <assert.h>
 #include <debug.h>
 #include <errno.h>
 
 #include <tinyara/fs/fs.h>
+#ifdef CONFIG_COMPRESSION_READAHEAD
+#include <tinyara/wqueue.h>
+#endif
 #include <tinyara/binfmt/compression/compress_read.h>
 
 #if CONFIG_COMPRESSION_TYPE == LZMA
@@ -38,11 +43,53 @@
 #endif
 
 /****************************************************************************
- * Private Declarations
+ * Pre-processor Definitions
  ****************************************************************************/
 
-static struct s_header *compression_header;
-static struct s_buffer buffers;
+/* One decompressed block is kept for the reader.  With read-ahead, a second
+ * one receives the next block, decompressed by the low priority worker.
+ */
+
+#ifdef CONFIG_COMPRESSION_READAHEAD
+#define COMPRESS_NSLOTS 2
+#else
+#define COMPRESS_NSLOTS 1
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#if CONFIG_COMPRESSION_TYPE == LZMA
+typedef size_t compress_len_t;
+#elif CONFIG_COMPRESSION_TYPE == MINIZ
+typedef mz_ulong compress_len_t;
+#endif
+
+/* A buffer pair holding one block */
+
+struct compress_slot_s {
+	int block;					/* Block held in out_buffer, -1 if none */
+	int result;					/* Result of the decompression of 'block' */
+	compress_len_t size;		/* Compressed size of 'block' in read_buffer */
+	unsigned char *read_buffer;
+	unsigned char *out_buffer;
+};
+
+/* The decompression state of one compressed file */
+
+struct compress_ctx_s {
+	int filfd;					/* Descriptor of the compressed file */
+	uint16_t binary_header_size;	/* Offset of the compression header */
+	struct s_header *header;	/* Compression header of the file */
+	struct compress_slot_s slot[COMPRESS_NSLOTS];
+	struct compress_slot_s *last;	/* Slot used by the last read */
+#ifdef CONFIG_COMPRESSION_READAHEAD
+	struct compress_slot_s *pending;	/* Slot being decompressed by the worker */
+	struct work_s work;
+	sem_t done;					/* Posted when the worker is done */
+#endif
+};
 
 /****************************************************************************
  * Private Functions
@@ -52,47 +99,44 @@ static struct s_buffer buffers;
  * Name: compress_decompress_block
  *
  * Description:
- *   Decompress block in 'read_buffer' of readsize into 'out_buffer' of writesize
+ *   Decompress the block in the read_buffer of 'slot' into 'out_buffer' of
+ *   'outsize' bytes
  *
  * Returned Value:
  *   Non-negative value on Success.
  *   Negative value on Failure.
  ****************************************************************************/
- #if CONFIG_COMPRESSION_TYPE == LZMA
-static int compress_decompress_block(unsigned char *out_buffer, unsigned int *writesize, unsigned char *read_buffer, unsigned int *size, int index)
-#elif CONFIG_COMPRESSION_TYPE == MINIZ
-static int compress_decompress_block(unsigned char *out_buffer, long unsigned int *writesize, unsigned char *read_buffer, long unsigned int *size, int index)
-#endif
+static int compress_decompress_block(FAR struct compress_ctx_s *ctx, FAR struct compress_slot_s *slot, FAR unsigned char *out_buffer, size_t outsize)
 {
 	int ret = ERROR;
+	compress_len_t writesize;
+	compress_len_t size = slot->size;
 
 #if CONFIG_COMPRESSION_TYPE == LZMA
-	if (compression_header->compression_format == COMPRESSION_TYPE_LZMA) {
+	if (ctx->header->compression_format == COMPRESSION_TYPE_LZMA) {
 		/* LZMA specific logic for decompression */
-		*writesize = compression_header->blocksize;
-		*size -= (LZMA_PROPS_SIZE);
+		writesize = outsize;
+		size -= (LZMA_PROPS_SIZE);
 
-		ret = LzmaUncompress(&out_buffer[0], writesize, &read_buffer[LZMA_PROPS_SIZE], size, &read_buffer[0], LZMA_PROPS_SIZE);
-		if (ret == SZ_ERROR_FAIL) {
-			bcmpdbg("Failure to decompress with LZMAUncompress API\n");
-			ret = -ret;
+		ret = LzmaUncompress(&out_buffer[0], &writesize, &slot->read_buffer[LZMA_PROPS_SIZE], &size, &slot->read_buffer[0], LZMA_PROPS_SIZE);
+		if (ret != SZ_OK) {
+			bcmpdbg("Failure to decompress with LZMAUncompress API; ret = %d\n", ret);
+			ret = ret > 0 ? -ret : ret;
 		}
 	}
 #elif CONFIG_COMPRESSION_TYPE == MINIZ
-		if (compression_header->compression_format == COMPRESSION_TYPE_MINIZ) {
-			/* Miniz specific logic for decompression */
-			*writesize = compression_header->blocksize;
-	
-			ret = mz_uncompress(out_buffer, writesize, read_buffer, *size);
-			if (ret != Z_OK) {
-				bcmpdbg("Failure to decompress with Miniz's uncompress API; ret = %d\n", ret);
-				if (ret > 0)
-					ret = -ret;
-			}
+	if (ctx->header->compression_format == COMPRESSION_TYPE_MINIZ) {
+		/* Miniz specific logic for decompression */
+		writesize = outsize;
+
+		ret = mz_uncompress(out_buffer, &writesize, slot->read_buffer, size);
+		if (ret != Z_OK) {
+			bcmpdbg("Failure to decompress with Miniz's uncompress API; ret = %d\n", ret);
+			ret = ret > 0 ? -ret : ret;
 		}
+	}
 #endif
 
-
 	return ret;
 }
 
@@ -106,11 +150,11 @@ static int compress_decompress_block(unsigned char *out_buffer, long unsigned in
  * Returned Value:
  *   None
  ****************************************************************************/
-static void compress_blocks_to_read(int *first_block, int *last_block, int *no_blocks, int offset, int readsize)
+static void compress_blocks_to_read(FAR struct compress_ctx_s *ctx, int *first_block, int *last_block, int *no_blocks, int offset, int readsize)
 {
 	int blocksize;
 
-	blocksize = compression_header->blocksize;
+	blocksize = ctx->header->blocksize;
 
 	*first_block = offset / blocksize;
 	*last_block = (offset + readsize - 1) / blocksize;
@@ -122,20 +166,21 @@ static void compress_blocks_to_read(int *first_block, int *last_block, int *no_b
  *
  * Description:
  *   Parses the header containing compression related info present in the
- *   compressed file and assigns values to compression_header members
+ *   compressed file and assigns it to the header of 'ctx'
  *
  * Returned value:
  *   OK (0) is Success
  *   Negative value on Failure
  ****************************************************************************/
-static int compress_parse_header(int filfd, uint16_t offset)
+static int compress_parse_header(FAR struct compress_ctx_s *ctx)
 {
 	off_t rpos;					/* Position returned by lseek */
 	int nbytes;					/* Number of bytes read  */
 	int compheader_size;				/* Total size of compression header */
+	uint16_t offset = ctx->binary_header_size;
 
 	/* Seek to location of size of compression header */
-	rpos = lseek(filfd, offset, SEEK_SET);
+	rpos = lseek(ctx->filfd, offset, SEEK_SET);
 	if (rpos != offset) {
 		int errval = get_errno();
 		bcmpdbg("ERROR : lseek to offset %lu failed: %d\n", (unsigned long)offset, errval);
@@ -143,30 +188,30 @@ static int compress_parse_header(int filfd, uint16_t offset)
 	}
 
 	/* Read compression header size from the file data */
-	nbytes = read(filfd, &compheader_size, sizeof(compheader_size));
+	nbytes = read(ctx->filfd, &compheader_size, sizeof(compheader_size));
 	if (nbytes != sizeof(compheader_size)) {
-		bcmpdbg("Read for compression header size from offset %lu failed\n", offset);
+		bcmpdbg("Read for compression header size from offset %lu failed\n", (unsigned long)offset);
 		return ERROR;
 	}
 
 	/* Allocate memory for compression header now that we know it's size */
-	compression_header = (struct s_header *)kmm_malloc(compheader_size);
-	if (!compression_header) {
+	ctx->header = (struct s_header *)kmm_malloc(compheader_size);
+	if (!ctx->header) {
 		bcmpdbg("Failed kmm_malloc for compression_header\n");
 		return -ENOMEM;
 	}
 
 	/* Assign compresssion_header->size_header */
-	compression_header->size_header = compheader_size;
+	ctx->header->size_header = compheader_size;
 
 	/* Read remaining compression header, including section offsets */
-	nbytes = read(filfd, ((uint8_t *)compression_header + sizeof(compression_header->size_header)), compheader_size - sizeof(compression_header->size_header));
-	if (nbytes != (compheader_size - sizeof(compression_header->size_header))) {
-		bcmpdbg("Read for compression header from offset %lu failed\n", offset);
+	nbytes = read(ctx->filfd, ((uint8_t *)ctx->header + sizeof(ctx->header->size_header)), compheader_size - sizeof(ctx->header->size_header));
+	if (nbytes != (compheader_size - sizeof(ctx->header->size_header))) {
+		bcmpdbg("Read for compression header from offset %lu failed\n", (unsigned long)offset);
 		return ERROR;
 	}
 
-	bcmpvdbg("Compressed Binary Header info: size (%d), compression format (%d), blocksize (%d), No. sections (%d), Uncompressed binary size = %d\n", compression_header->size_header, compression_header->compression_format, compression_header->blocksize, compression_header->sections, compression_header->binary_size);
+	bcmpvdbg("Compressed Binary Header info: size (%d), compression format (%d), blocksize (%d), No. sections (%d), Uncompressed binary size = %d\n", ctx->header->size_header, ctx->header->compression_format, ctx->header->blocksize, ctx->header->sections, ctx->header->binary_size);
 
 	return OK;
 }
@@ -181,103 +226,261 @@ static int compress_parse_header(int filfd, uint16_t offset)
  *   'block_offset' value (positive) on Success
  *   Negative value on Failure
  ****************************************************************************/
-static off_t compress_offset_block(int filfd, uint16_t binary_header_size, int block_number)
+static off_t compress_offset_block(FAR struct compress_ctx_s *ctx, int block_number)
 {
 	off_t position;
 
 	/* Return position for 'block_number' block */
-	position = binary_header_size + compression_header->size_header + compression_header->secoff[block_number];
+	position = ctx->binary_header_size + ctx->header->size_header + ctx->header->secoff[block_number];
 
 	return position;
 }
 
 /****************************************************************************
- * Name: compress_lseek_block
+ * Name: compress_read_block
  *
  * Description:
- *   Seek to start of "block_number" block in compressed blocks section
+ *   Read 'block_number' block from compressed blocks section into the
+ *   read_buffer of 'slot'
  *
  * Returned Value:
- *   Starting offset (positive) of 'block_number' block in binary on Success
+ *   Number of bytes read into read_buffer on Success
  *   Negative value on Failure
  ****************************************************************************/
-static off_t compress_lseek_block(int filfd, uint16_t binary_header_size, int block_number)
+static int compress_read_block(FAR struct compress_ctx_s *ctx, FAR struct compress_slot_s *slot, int block_number)
 {
 	off_t rpos;
-	off_t block_offset;
+	ssize_t readsize;
+	ssize_t nbytes;
+	off_t current_block_offset;
 
-	/* Calculate block offset from start of file for start of 'block_number' block */
-	block_offset = compress_offset_block(filfd, binary_header_size, block_number);
-	if (block_offset < 0) {
-		bcmpdbg("Incorrect offset for block number %d\n", block_number);
-		return block_offset;
+	/* Find out size of 'block_number' block in compressed file. Assign to readsize */
+	current_block_offset = compress_offset_block(ctx, block_number);
+	readsize = compress_offset_block(ctx, block_number + 1) - current_block_offset;
+	if (readsize < 0) {
+		bcmpdbg("Incorrect readsize %ld for block, has to be positive\n", (long)readsize);
+		return ERROR;
 	}
 
-	/* Seek to location of this block in compressed file */
-	rpos = lseek(filfd, block_offset, SEEK_SET);
-	if (rpos != block_offset) {
+	/* Seek to location of 'block_number' block in compressed file */
+	rpos = lseek(ctx->filfd, current_block_offset, SEEK_SET);
+	if (rpos != current_block_offset) {
 		int errval = get_errno();
-		bcmpdbg("Failed to seek to position %lu: %d\n", (unsigned long)block_offset, errval);
+		bcmpdbg("Failed to seek to position %lu: %d\n", (unsigned long)current_block_offset, errval);
 		return -errval;
 	}
 
-	return rpos;
+	/* Read 'block_number' block into buf */
+	nbytes = read(ctx->filfd, slot->read_buffer, readsize);
+	if (nbytes != readsize) {
+		bcmpdbg("Read for compressed block %d failed\n", block_number);
+		return ERROR;
+	}
+
+	slot->size = nbytes;
+	return nbytes;
 }
 
+#ifdef CONFIG_COMPRESSION_READAHEAD
 /****************************************************************************
- * Name: compress_read_block
+ * Name: compress_worker
  *
  * Description:
- *   Read 'block_number' block from compressed blocks section into read_buffer
+ *   Decompress the pending block on the low priority work queue.  The file
+ *   is read by the reader beforehand, because file descriptors are not
+ *   shared with the worker thread.
+ *
+ ****************************************************************************/
+static void compress_worker(FAR void *arg)
+{
+	FAR struct compress_ctx_s *ctx = (FAR struct compress_ctx_s *)arg;
+
+	ctx->pending->result = compress_decompress_block(ctx, ctx->pending, ctx->pending->out_buffer, ctx->header->blocksize);
+	sem_post(&ctx->done);
+}
+
+/****************************************************************************
+ * Name: compress_wait_readahead
+ *
+ * Description:
+ *   Wait until the worker is done with the pending block, if any.
+ *
+ ****************************************************************************/
+static void compress_wait_readahead(FAR struct compress_ctx_s *ctx)
+{
+	if (ctx->pending) {
+		while (sem_wait(&ctx->done) != OK) {
+			ASSERT(get_errno() == EINTR);
+		}
+
+		ctx->pending = NULL;
+	}
+}
+
+/****************************************************************************
+ * Name: compress_start_readahead
+ *
+ * Description:
+ *   Read 'block_number' block and let the worker decompress it into the
+ *   slot which is not 'current' while the reader copies 'current' out.
+ *
+ ****************************************************************************/
+static void compress_start_readahead(FAR struct compress_ctx_s *ctx, FAR struct compress_slot_s *current, int block_number)
+{
+	FAR struct compress_slot_s *slot;
+
+	if (ctx->pending || block_number >= ctx->header->sections - 1) {
+		return;
+	}
+
+	slot = (current == &ctx->slot[0]) ? &ctx->slot[1] : &ctx->slot[0];
+	if (slot->block == block_number) {
+		return;
+	}
+
+	slot->block = -1;
+	if (compress_read_block(ctx, slot, block_number) < 0) {
+		return;
+	}
+
+	slot->block = block_number;
+	ctx->pending = slot;
+	if (work_queue(LPWORK, &ctx->work, compress_worker, ctx, 0) != OK) {
+		slot->block = -1;
+		ctx->pending = NULL;
+	}
+}
+#endif
+
+/****************************************************************************
+ * Name: compress_find_block
+ *
+ * Description:
+ *   Find a slot already holding 'block_number' block decompressed.
  *
  * Returned Value:
- *   Number of bytes read into read_buffer on Success
- *   Negative value on Failure
+ *   The slot if found, NULL otherwise
  ****************************************************************************/
-static off_t compress_read_block(int filfd, uint16_t binary_header_size, FAR uint8_t *buf, int block_number)
+static FAR struct compress_slot_s *compress_find_block(FAR struct compress_ctx_s *ctx, int block_number)
 {
-	off_t rpos;
-	size_t readsize;
-	ssize_t nbytes;
-	off_t current_block_offset;
-	off_t next_block_offset;
+	FAR struct compress_slot_s *slot;
+	int i;
 
-	/* Find out size of 'block_number' block in compressed file. Assign to readsize */
-	next_block_offset = compress_offset_block(filfd, binary_header_size, block_number + 1);
-	if (next_block_offset < 0) {
-		bcmpdbg("Incorrect offset for block number %d\n", block_number + 1);
-		return ERROR;
+#ifdef CONFIG_COMPRESSION_READAHEAD
+	if (ctx->pending && ctx->pending->block == block_number) {
+		compress_wait_readahead(ctx);
 	}
+#endif
 
-	current_block_offset = compress_offset_block(filfd, binary_header_size, block_number);
-	if (current_block_offset < 0) {
-		bcmpdbg("Incorrect offset for block number %d\n", block_number);
-		return ERROR;
+	for (i = 0; i < COMPRESS_NSLOTS; i++) {
+		slot = &ctx->slot[i];
+#ifdef CONFIG_COMPRESSION_READAHEAD
+		if (slot == ctx->pending) {
+			continue;
+		}
+#endif
+		if (slot->block == block_number && slot->result >= 0) {
+			ctx->last = slot;
+			return slot;
+		}
 	}
 
-	readsize = next_block_offset - current_block_offset;
-	if (readsize < 0) {
-		bcmpdbg("Incorrect readsize %d for block, has to be positive\n", readsize);
-		return readsize;
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: compress_free_slot
+ *
+ * Description:
+ *   Return the least recently used slot which is not in use by the worker.
+ ****************************************************************************/
+static FAR struct compress_slot_s *compress_free_slot(FAR struct compress_ctx_s *ctx)
+{
+	FAR struct compress_slot_s *slot = &ctx->slot[0];
+
+#ifdef CONFIG_COMPRESSION_READAHEAD
+	if (slot == ctx->pending || (slot == ctx->last && !ctx->pending)) {
+		slot = &ctx->slot[1];
 	}
+#endif
 
-	/* Seek to location of 'block_number' block in compressed file */
-	rpos = compress_lseek_block(filfd, binary_header_size, block_number);
-	if (rpos < 0) {
-		bcmpdbg("Failed to seek to offset of block number %d\n", block_number);
-		return rpos;
+	return slot;
+}
+
+/****************************************************************************
+ * Name: compress_get_block
+ *
+ * Description:
+ *   Get a slot holding 'block_number' block decompressed.  The block is
+ *   decompressed only if no slot holds it already.
+ *
+ * Returned Value:
+ *   The slot on Success, NULL on Failure
+ ****************************************************************************/
+static FAR struct compress_slot_s *compress_get_block(FAR struct compress_ctx_s *ctx, int block_number)
+{
+	FAR struct compress_slot_s *slot;
+
+	slot = compress_find_block(ctx, block_number);
+	if (slot) {
+		return slot;
 	}
 
-	/* Read 'block_number' block into buf */
-	nbytes = read(filfd, buf, readsize);
-	if (nbytes != readsize) {
+	slot = compress_free_slot(ctx);
+	slot->block = -1;
+	if (compress_read_block(ctx, slot, block_number) < 0) {
 		bcmpdbg("Read for compressed block %d failed\n", block_number);
-		return ERROR;
+		return NULL;
 	}
 
-	return nbytes;
+	slot->result = compress_decompress_block(ctx, slot, slot->out_buffer, ctx->header->blocksize);
+	if (slot->result < 0) {
+		bcmpdbg("Failed to decompress %d block of this binary\n", block_number);
+		return NULL;
+	}
+
+	slot->block = block_number;
+	ctx->last = slot;
+	return slot;
 }
 
+/****************************************************************************
+ * Name: compress_read_direct
+ *
+ * Description:
+ *   Decompress 'block_number' block straight into 'buffer' of 'size' bytes,
+ *   which is the whole uncompressed block, without going through an
+ *   out_buffer.  Only the read_buffer of a slot is used, so the block held
+ *   by its out_buffer stays valid.
+ *
+ * Returned Value:
+ *   Non-negative value on Success.
+ *   Negative value on Failure.
+ ****************************************************************************/
+static int compress_read_direct(FAR struct compress_ctx_s *ctx, int block_number, FAR uint8_t *buffer, size_t size)
+{
+	FAR struct compress_slot_s *slot;
+	int ret;
+
+	slot = compress_free_slot(ctx);
+	ret = compress_read_block(ctx, slot, block_number);
+	if (ret < 0) {
+		bcmpdbg("Read for compressed block %d failed\n", block_number);
+		return ret;
+	}
+
+	ret = compress_decompress_block(ctx, slot, buffer, size);
+	if (ret < 0) {
+		bcmpdbg("Failed to decompress %d block of this binary\n", block_number);
+	}
+
+	return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
 /****************************************************************************
  * Name: compress_read
  *
@@ -291,28 +494,23 @@ static off_t compress_read_block(int filfd, uint16_t binary_header_size, FAR uin
  *   Number of bytes read into buffer on Success
  *   Negative value on failure
  ****************************************************************************/
-int compress_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer, size_t readsize, off_t offset)
+int compress_read(FAR struct compress_ctx_s *ctx, FAR uint8_t *buffer, size_t readsize, off_t offset)
 {
 	int first_block;
 	int last_block;
 	int no_blocks;
 	int index;
-	int ret;
 	int actual_offset;			/* Offset from start of uncompressed file */
 	int block_size_to_write;	/* Size to write into buffer from decompressed block */
 	int buffer_index;
 	int blocksize;
-#if CONFIG_COMPRESSION_TYPE == LZMA
-	unsigned int writesize;
-	unsigned int size;
-#elif CONFIG_COMPRESSION_TYPE == MINIZ
-	long unsigned int writesize;
-	long unsigned int size;
-#endif
+	int block_start;			/* Offset of the current block in uncompressed file */
+	int block_end;				/* End of the current block in uncompressed file */
+	FAR struct compress_slot_s *slot = NULL;
 
 	/* Setting first block, end block and number of blocks to read and decompressed */
-	blocksize = compression_header->blocksize;
-	compress_blocks_to_read(&first_block, &last_block, &no_blocks, offset, readsize);
+	blocksize = ctx->header->blocksize;
+	compress_blocks_to_read(ctx, &first_block, &last_block, &no_blocks, offset, readsize);
 	if (first_block < 0 || no_blocks < 0) {
 		bcmpdbg("Incorrect first_block, no_blocks info\n");
 		buffer_index = ERROR;
@@ -324,24 +522,44 @@ int compress_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer, s
 	/* Actual Offset in uncompressed file is same as Offset passed to this function */
 	actual_offset = offset;
 
-	/* Reading and decompressing blocks from first_block to last_block. Then writing to buffer. */
+	/* Decompressing blocks from first_block to last_block. Then writing to buffer. */
 	for (; index < first_block + no_blocks; index++) {
-		/* Read compressed 'index' block into read_buffer */
-		size = compress_read_block(filfd, binary_header_size, buffers.read_buffer, index);
-		if (size < 0) {
-			bcmpdbg("Read for compressed block %d failed\n", index);
-			buffer_index = size;
-			goto error_compress_read;
+		block_start = index * blocksize;
+		block_end = block_start + blocksize;
+		if (block_end > ctx->header->binary_size) {
+			block_end = ctx->header->binary_size;
 		}
 
-		/* Decompress block in read_buffer to out_buffer */
-		ret = compress_decompress_block(buffers.out_buffer, &writesize, buffers.read_buffer, &size, index);
-		if (ret == ERROR) {
-			bcmpdbg("Failed to decompress %d block of this binary\n", index);
-			buffer_index = ret;
+		/*
+		 * A block which is wholly requested and not decompressed yet is
+		 * decompressed straight into the buffer.  This is the case for all
+		 * but the first and last blocks of a large section.
+		 */
+		if (block_start >= actual_offset && block_end <= actual_offset + readsize && !compress_find_block(ctx, index)) {
+			block_size_to_write = block_end - block_start;
+			if (compress_read_direct(ctx, index, &buffer[buffer_index], block_size_to_write) < 0) {
+				buffer_index = ERROR;
+				goto error_compress_read;
+			}
+
+			buffer_index += block_size_to_write;
+			continue;
+		}
+
+		slot = compress_get_block(ctx, index);
+		if (!slot) {
+			buffer_index = ERROR;
 			goto error_compress_read;
 		}
 
+#ifdef CONFIG_COMPRESSION_READAHEAD
+		/* Binaries are mostly read sequentially.  Let the worker decompress
+		 * the next block while this one is copied out.
+		 */
+
+		compress_start_readahead(ctx, slot, index + 1);
+#endif
+
 		if (index == first_block) {
 			/*
 			 * Read appropriate number of bytes to buffer from this block using readsize and offset info.
@@ -349,7 +567,7 @@ int compress_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer, s
 			 * Otherwise, write from start_offset to end_offset into buffer.
 			 */
 			block_size_to_write = ((index + 1) * blocksize - 1 > actual_offset + readsize - 1 ? readsize : (index + 1) * blocksize - actual_offset);
-			memcpy(&buffer[buffer_index], &buffers.out_buffer[actual_offset - (index * blocksize)], block_size_to_write);
+			memcpy(&buffer[buffer_index], &slot->out_buffer[actual_offset - (index * blocksize)], block_size_to_write);
 			buffer_index += block_size_to_write;
 		} else if (index == last_block) {
 			/*
@@ -358,7 +576,7 @@ int compress_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer, s
 			 * Write from start_offset to end_offset from this block into buffer.
 			 */
 			block_size_to_write = actual_offset + readsize - (index * blocksize);
-			memcpy(&buffer[buffer_index], &buffers.out_buffer[0], block_size_to_write);
+			memcpy(&buffer[buffer_index], &slot->out_buffer[0], block_size_to_write);
 			buffer_index += block_size_to_write;
 		} else {
 			/*
@@ -366,11 +584,17 @@ int compress_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer, s
 			 * So, write entire block into buffer.
 			 */
 			block_size_to_write = blocksize;
-			memcpy(&buffer[buffer_index], &buffers.out_buffer[0], block_size_to_write);
+			memcpy(&buffer[buffer_index], &slot->out_buffer[0], block_size_to_write);
 			buffer_index += block_size_to_write;
 		}
 	}
 
+#ifdef CONFIG_COMPRESSION_READAHEAD
+	/* Nothing was started if the last block went straight to the buffer */
+
+	compress_start_readahead(ctx, ctx->last, last_block + 1);
+#endif
+
 error_compress_read:
 	return buffer_index;
 }
@@ -379,41 +603,67 @@ error_compress_read:
  * Name: compress_init
  *
  * Description:
- *   Initialize the compression_header of type'struct s_header' for this file
+ *   Allocate the decompression state of the compressed file 'filfd' whose
+ *   compression header is at 'offset', and return it in 'ctx'.  Each file
+ *   has its own state, so several files can be read at the same time.
  *
  * Returned value:
  *   OK (0) on Success
- *   ERROR (-1) on Failure
+ *   Negative value on Failure
  ****************************************************************************/
-int compress_init(int filfd, uint16_t offset, off_t *filelen)
+int compress_init(int filfd, uint16_t offset, off_t *filelen, FAR struct compress_ctx_s **ctx)
 {
+	FAR struct compress_ctx_s *newctx;
+	int readsize;
 	int ret;
+	int i;
+
+	newctx = (FAR struct compress_ctx_s *)kmm_zalloc(sizeof(struct compress_ctx_s));
+	if (!newctx) {
+		bcmpdbg("Failed kmm_zalloc for compression context\n");
+		return -ENOMEM;
+	}
+
+	newctx->filfd = filfd;
+	newctx->binary_header_size = offset;
+#ifdef CONFIG_COMPRESSION_READAHEAD
+	sem_init(&newctx->done, 0, 0);
+	sem_setprotocol(&newctx->done, SEM_PRIO_NONE);
+#endif
 
 	/* Parsing compression header for compressed file */
-	ret = compress_parse_header(filfd, offset);
+	ret = compress_parse_header(newctx);
 	if (ret != OK) {
 		bcmpdbg("Failed to parse compression header from file\n");
 		goto error_compress_init;
 	}
 
 	/* Assign file length as that of uncompressed file */
-	*filelen = compression_header->binary_size;
+	*filelen = newctx->header->binary_size;
 
+	readsize = newctx->header->blocksize;
 #if CONFIG_COMPRESSION_TYPE == LZMA
-	/* Allocating memory for read and out buffer to be used for LZMA decompression */
-	if (compression_header->compression_format == COMPRESSION_TYPE_LZMA) {
-		buffers.read_buffer = (unsigned char *)kmm_malloc(compression_header->blocksize + 5);
-		buffers.out_buffer = (unsigned char *)kmm_malloc(compression_header->blocksize);
-	}
-#elif CONFIG_COMPRESSION_TYPE == MINIZ
-	/* Allocating memory for read and out buffer to be used for Miniz decompression */
-	if (compression_header->compression_format == COMPRESSION_TYPE_MINIZ) {
-		buffers.read_buffer = (unsigned char *)kmm_malloc(compression_header->blocksize);
-		buffers.out_buffer = (unsigned char *)kmm_malloc(compression_header->blocksize);
-	}
+	/* LZMA blocks carry the LZMA properties in front of the data */
+	readsize += LZMA_PROPS_SIZE;
 #endif
 
+	/* Allocating memory for read and out buffers to be used for decompression */
+	for (i = 0; i < COMPRESS_NSLOTS; i++) {
+		newctx->slot[i].block = -1;
+		newctx->slot[i].read_buffer = (unsigned char *)kmm_malloc(readsize);
+		newctx->slot[i].out_buffer = (unsigned char *)kmm_malloc(newctx->header->blocksize);
+		if (!newctx->slot[i].read_buffer || !newctx->slot[i].out_buffer) {
+			bcmpdbg("Failed kmm_malloc for decompression buffers\n");
+			ret = -ENOMEM;
+			goto error_compress_init;
+		}
+	}
+
+	*ctx = newctx;
+	return OK;
+
 error_compress_init:
+	compress_uninit(newctx);
 	return ret;
 }
 
@@ -421,32 +671,50 @@ error_compress_init:
  * Name: compress_uninit
  *
  * Description:
- *   Release buffers initialized during compress_init
+ *   Release the decompression state allocated by compress_init
  *
  * Returned Value:
  *   None
  ****************************************************************************/
-void compress_uninit(void)
+void compress_uninit(FAR struct compress_ctx_s *ctx)
 {
-#if CONFIG_COMPRESSION_TYPE == LZMA || CONFIG_COMPRESSION_TYPE == MINIZ
+	int i;
+
+	if (!ctx) {
+		return;
+	}
+
+#ifdef CONFIG_COMPRESSION_READAHEAD
+	/* The worker may still use the buffers */
+
+	compress_wait_readahead(ctx);
+	sem_destroy(&ctx->done);
+#endif
+
 	/* Freeing memory allocated to read_buffer and out_buffer for file decompression */
-	if (compression_header->compression_format == COMPRESSION_TYPE_LZMA || compression_header->compression_format == COMPRESSION_TYPE_MINIZ) {
-		if (buffers.read_buffer) {
-			kmm_free(buffers.read_buffer);
-			buffers.read_buffer = NULL;
+	for (i = 0; i < COMPRESS_NSLOTS; i++) {
+		if (ctx->slot[i].read_buffer) {
+			kmm_free(ctx->slot[i].read_buffer);
 		}
-		if (buffers.out_buffer) {
-			kmm_free(buffers.out_buffer);
-			buffers.out_buffer = NULL;
+		if (ctx->slot[i].out_buffer) {
+			kmm_free(ctx->slot[i].out_buffer);
 		}
 	}
-#endif
 
-	kmm_free(compression_header);
-	compression_header = NULL;
+	if (ctx->header) {
+		kmm_free(ctx->header);
+	}
+
+	kmm_free(ctx);
 }
 
-struct s_header *get_compression_header(void)
+/****************************************************************************
+ * Name: get_compression_header
+ *
+ * Returned Value:
+ *   Address of the compression header of 'ctx'
+ ****************************************************************************/
+struct s_header *get_compression_header(FAR struct compress_ctx_s *ctx)
 {
-	return compression_header;
+	return ctx->header;
 }
@@ -48,6 +48,7 @@ static int test_compress_decompress_function(unsigned long arg)
 	int filefd;
 	int ret;
 	off_t filelen;
+	struct compress_ctx_s *ctx;
 	unsigned int writesize;
 	unsigned int size;
 	size_t readsize = 2048;
@@ -61,14 +62,14 @@ static int test_compress_decompress_function(unsigned long arg)
 		return -errval;
 	}
 
-	ret = compress_init(filefd, 0, &filelen);
+	ret = compress_init(filefd, 0, &filelen, &ctx);
 
 	if (ret != OK) {
 		berr("Failed to read header for compressed binary : %d\n", ret);
 		return ret;
 	}
 
-	compression_header = get_compression_header();
+	compression_header = get_compression_header(ctx);
 
 	dst_buffer = (uint8_t *)malloc(2048 * sizeof(uint8_t));
 
@@ -79,14 +80,14 @@ static int test_compress_decompress_function(unsigned long arg)
 
 
 	for (i = 0; i < (compression_header->sections - 1); i++) {
-		size = compress_read(filefd, 0, dst_buffer, readsize, i*2048);
+		size = compress_read(ctx, dst_buffer, readsize, i*2048);
 		if (size != 2048) {
 			berr("Read for compressed block %d failed\n", i);
 			return ERROR;
 		}
 	}
 
-	compress_uninit();
+	compress_uninit(ctx);
 	free(dst_buffer);
 
 	return OK;
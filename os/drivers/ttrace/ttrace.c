@@ -40,7 +40,10 @@
 #include <tinyara/kmalloc.h>
 #include <tinyara/fs/fs.h>
 #include <tinyara/arch.h>
+#include <tinyara/clock.h>
 #include <tinyara/ringbuf.h>
+#include <tinyara/sched.h>
+#include <tinyara/ttrace.h>
 
 #include <arch/irq.h>
 
@@ -77,6 +80,35 @@ struct ttrace_dev_s {
 	FAR char *ttrace_packets;  /* Trace packets buffer */
 };
 
+#ifdef CONFIG_TTRACE_COMPACT
+#define TTRACE_ALIGN(n)         (((n) + 3) & ~3)
+#define TTRACE_DELTA_MAX        0xffff
+#define TTRACE_TIME_INTERVAL    64	/* Records between two TTRACE_REC_TIME */
+
+/* Entry of the string table, the string itself is in g_strpool */
+
+struct ttrace_str_s {
+	uint32_t hash;
+	int16_t pid;               /* Task of a task name, -1 for a message */
+	uint16_t offset;           /* Offset in g_strpool */
+	uint8_t len;
+};
+
+/* State of the compact trace buffer and of its reader */
+
+struct ttrace_compact_s {
+	int head;                  /* Oldest record */
+	int tail;                  /* Where the next record is written */
+	uint64_t last_usec;        /* Time of the last record, 0 before the first */
+	uint16_t since_time;       /* Records since the last TTRACE_REC_TIME */
+	uint16_t dropped;          /* Records lost because the buffer was full */
+	uint16_t nstr;             /* Used entries in g_strtab */
+	uint16_t poolused;         /* Used bytes in g_strpool */
+	uint16_t rd_str;           /* Next string table entry to read */
+	bool rd_hdr;               /* Dump header was read */
+};
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -110,6 +142,12 @@ static struct ringbuf g_ringbuf = {
 static uint32_t g_state = TTRACE_STATE_IDLE;
 static uint32_t g_selected_tag = 0;
 
+#ifdef CONFIG_TTRACE_COMPACT
+static struct ttrace_compact_s g_compact;
+static struct ttrace_str_s g_strtab[CONFIG_TTRACE_STRTAB_SIZE];
+static char g_strpool[CONFIG_TTRACE_STRPOOL_SIZE];
+#endif
+
 /* This is the device structure for the T-trace function. It
  * must be statically initialized because the T-trace ttrace_putc function
  * could be called before the driver initialization logic executes.
@@ -125,6 +163,342 @@ static struct ttrace_dev_s g_sysdev = {
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_TTRACE_COMPACT
+/****************************************************************************
+ * Name: ttrace_recsize
+ *
+ * Description:
+ *   Return the size of the record at offset in the trace buffer, or 0 for
+ *   padding up to the end of the buffer.
+ *
+ ****************************************************************************/
+
+static int ttrace_recsize(int offset)
+{
+	FAR struct ttrace_rec_str_s *rec = (FAR struct ttrace_rec_str_s *)&g_ringbuf.buffer[offset];
+
+	switch (rec->type) {
+	case TTRACE_REC_SCHED:
+		return sizeof(struct ttrace_rec_sched_s);
+	case TTRACE_REC_STR:
+		return sizeof(struct ttrace_rec_str_s) + TTRACE_ALIGN(rec->len + 1);
+	case TTRACE_REC_PAD:
+		return 0;
+	default:
+		return sizeof(struct ttrace_rec_s);
+	}
+}
+
+/****************************************************************************
+ * Name: ttrace_compact_reset
+ ****************************************************************************/
+
+static void ttrace_compact_reset(void)
+{
+	memset(&g_compact, 0, sizeof(g_compact));
+	g_ringbuf.bufsize = CONFIG_TTRACE_BUFSIZE & ~3;
+	g_ringbuf.is_overwritten = 0;
+}
+
+/****************************************************************************
+ * Name: ttrace_compact_used
+ *
+ * Description:
+ *   Return the number of bytes a read of the whole trace would return.
+ *
+ ****************************************************************************/
+
+static int ttrace_compact_used(void)
+{
+	int used;
+	int i;
+
+	used = sizeof(struct ttrace_dump_hdr_s);
+	for (i = 0; i < g_compact.nstr; i++) {
+		used += sizeof(struct ttrace_rec_str_s) + TTRACE_ALIGN(g_strtab[i].len + 1);
+	}
+
+	return used + (g_compact.tail - g_compact.head + g_ringbuf.bufsize) % g_ringbuf.bufsize;
+}
+
+/****************************************************************************
+ * Name: ttrace_put
+ *
+ * Description:
+ *   Append a record to the trace buffer.  A record is never split at the
+ *   end of the buffer.  If there is no space, the oldest records are
+ *   dropped in overwrite mode, otherwise the new record is dropped.
+ *
+ ****************************************************************************/
+
+static int ttrace_put(FAR const void *rec, int size)
+{
+	irqstate_t flags;
+	int bufsize = g_ringbuf.bufsize;
+	int need;
+	int len;
+
+	flags = irqsave();
+
+	need = size;
+	if (g_compact.tail + size > bufsize) {
+		need += bufsize - g_compact.tail;
+	}
+
+	/* Keep one word free, so that head == tail means empty */
+
+	while (bufsize - 4 - (g_compact.tail - g_compact.head + bufsize) % bufsize < need) {
+		if (!g_ringbuf.is_overwritable) {
+			g_compact.dropped++;
+			irqrestore(flags);
+			return TTRACE_INVALID;
+		}
+
+		len = ttrace_recsize(g_compact.head);
+		g_compact.head = len == 0 ? 0 : (g_compact.head + len) % bufsize;
+		g_ringbuf.is_overwritten = 1;
+	}
+
+	if (need != size) {
+		g_ringbuf.buffer[g_compact.tail + 2] = TTRACE_REC_PAD;
+		g_compact.tail = 0;
+	}
+
+	memcpy(&g_ringbuf.buffer[g_compact.tail], rec, size);
+	g_compact.tail = (g_compact.tail + size) % bufsize;
+
+	irqrestore(flags);
+	return TTRACE_VALID;
+}
+
+/****************************************************************************
+ * Name: ttrace_intern
+ *
+ * Description:
+ *   Return the id of a string in the string table, adding it if needed.
+ *   A new string is also written to the trace buffer, for readers which
+ *   read the trace while it is running.
+ *
+ ****************************************************************************/
+
+static uint16_t ttrace_intern(FAR const char *str, int16_t pid)
+{
+	FAR struct ttrace_str_s *entry;
+	struct {
+		struct ttrace_rec_str_s rec;
+		char str[TTRACE_MSG_BYTES];
+	} strrec;
+	uint32_t hash = 2166136261u;
+	int len;
+	int i;
+
+	for (len = 0; len < TTRACE_MSG_BYTES - 1 && str[len] != '\0'; len++) {
+		hash = (hash ^ (uint8_t)str[len]) * 16777619u;
+	}
+
+	for (i = 0; i < g_compact.nstr; i++) {
+		entry = &g_strtab[i];
+		if (entry->hash == hash && entry->pid == pid && entry->len == len && memcmp(&g_strpool[entry->offset], str, len) == 0) {
+			return i;
+		}
+	}
+
+	if (g_compact.nstr == CONFIG_TTRACE_STRTAB_SIZE || g_compact.poolused + len + 1 > CONFIG_TTRACE_STRPOOL_SIZE) {
+		return TTRACE_STRID_NONE;
+	}
+
+	memset(&strrec, 0, sizeof(strrec));
+	strrec.rec.type = TTRACE_REC_STR;
+	strrec.rec.len = len;
+	strrec.rec.pid = pid;
+	strrec.rec.id = g_compact.nstr;
+	memcpy(strrec.str, str, len);
+
+	/* The string is only added once its record is in the buffer, so that
+	 * no record refers to an id which a reader of the trace never saw.
+	 */
+
+	if (ttrace_put(&strrec, sizeof(struct ttrace_rec_str_s) + TTRACE_ALIGN(len + 1)) != TTRACE_VALID) {
+		return TTRACE_STRID_NONE;
+	}
+
+	entry = &g_strtab[g_compact.nstr];
+	entry->hash = hash;
+	entry->pid = pid;
+	entry->len = len;
+	entry->offset = g_compact.poolused;
+	memcpy(&g_strpool[entry->offset], str, len);
+	g_strpool[entry->offset + len] = '\0';
+	g_compact.poolused += len + 1;
+
+	return g_compact.nstr++;
+}
+
+/****************************************************************************
+ * Name: ttrace_compact_write
+ *
+ * Description:
+ *   Convert a trace_packet written by the trace library to a compact record.
+ *
+ ****************************************************************************/
+
+static int ttrace_compact_write(FAR const struct trace_packet *packet)
+{
+	struct ttrace_rec_time_s trec;
+	struct ttrace_rec_sched_s srec;
+	struct ttrace_rec_s rec;
+	uint64_t usec;
+	uint16_t delta = 0;
+	int ret;
+
+	/* The absolute time is recorded when the delta does not fit, and
+	 * regularly so that a reader can find it after older records were
+	 * overwritten.  extra is set when the delta to the previous record is
+	 * not known.  After a record was dropped, the next one starts again
+	 * with the absolute time, since the delta would be relative to a
+	 * record which is not in the buffer.
+	 */
+
+	usec = (uint64_t)packet->ts.tv_sec * USEC_PER_SEC + packet->ts.tv_usec;
+	if (g_compact.last_usec == 0 || usec < g_compact.last_usec || usec - g_compact.last_usec > TTRACE_DELTA_MAX) {
+		trec.delta = 0;
+		trec.extra = 1;
+	} else {
+		delta = usec - g_compact.last_usec;
+		trec.delta = delta;
+		trec.extra = 0;
+	}
+
+	if (trec.extra || ++g_compact.since_time >= TTRACE_TIME_INTERVAL) {
+		trec.type = TTRACE_REC_TIME;
+		trec.usec = (uint32_t)usec;
+		g_compact.since_time = 0;
+		if (ttrace_put(&trec, sizeof(trec)) != TTRACE_VALID) {
+			g_compact.last_usec = 0;
+			return TTRACE_INVALID;
+		}
+		delta = 0;
+	}
+
+	if (packet->event_type == 's') {
+		srec.delta = delta;
+		srec.type = TTRACE_REC_SCHED;
+		srec.prev_state = packet->msg.sched_msg.prev_state;
+		srec.prev_pid = packet->msg.sched_msg.prev_pid;
+		srec.next_pid = packet->msg.sched_msg.next_pid;
+		srec.prev_prio = packet->msg.sched_msg.prev_prio;
+		srec.next_prio = packet->msg.sched_msg.next_prio;
+		srec.reserved = 0;
+
+		/* Task names are only stored in the string table */
+
+		(void)ttrace_intern(packet->msg.sched_msg.prev_comm, srec.prev_pid);
+		(void)ttrace_intern(packet->msg.sched_msg.next_comm, srec.next_pid);
+		ret = ttrace_put(&srec, sizeof(srec));
+	} else {
+		rec.delta = delta;
+		rec.extra = 0;
+		rec.pid = packet->pid;
+		rec.arg = 0;
+		if (packet->event_type != 'b') {
+			rec.type = TTRACE_REC_END;
+		} else if (packet->codelen & TTRACE_CODE_UNIQUE) {
+			rec.type = TTRACE_REC_BEGIN_UID;
+			rec.extra = packet->codelen & ~TTRACE_CODE_UNIQUE;
+		} else {
+			rec.type = TTRACE_REC_BEGIN;
+			rec.arg = ttrace_intern(packet->msg.message, -1);
+		}
+
+		ret = ttrace_put(&rec, sizeof(rec));
+	}
+
+	if (ret != TTRACE_VALID) {
+		g_compact.last_usec = 0;
+		g_compact.since_time = 0;
+	} else {
+		g_compact.last_usec = usec;
+	}
+
+	return ret;
+}
+
+
+/****************************************************************************
+ * Name: ttrace_compact_read
+ *
+ * Description:
+ *   Copy the dump header, the string table and then whole records to the
+ *   buffer.  Records are removed from the trace buffer as they are read.
+ *   Reading again from offset 0 starts with the header again.
+ *
+ ****************************************************************************/
+
+static ssize_t ttrace_compact_read(FAR struct file *filep, FAR char *buffer, size_t len)
+{
+	FAR struct ttrace_dump_hdr_s *hdr;
+	FAR struct ttrace_rec_str_s *rec;
+	FAR struct ttrace_str_s *entry;
+	irqstate_t flags;
+	size_t nread = 0;
+	int size;
+
+	if (filep->f_pos == 0) {
+		g_compact.rd_hdr = false;
+		g_compact.rd_str = 0;
+	}
+
+	if (!g_compact.rd_hdr && len >= sizeof(struct ttrace_dump_hdr_s)) {
+		hdr = (FAR struct ttrace_dump_hdr_s *)buffer;
+		memcpy(hdr->magic, TTRACE_DUMP_MAGIC, sizeof(hdr->magic));
+		hdr->version = TTRACE_DUMP_VERSION;
+		hdr->overwritten = g_ringbuf.is_overwritten;
+		hdr->dropped = g_compact.dropped;
+		nread = sizeof(struct ttrace_dump_hdr_s);
+		g_compact.rd_hdr = true;
+	}
+
+	while (g_compact.rd_hdr && g_compact.rd_str < g_compact.nstr) {
+		entry = &g_strtab[g_compact.rd_str];
+		size = sizeof(struct ttrace_rec_str_s) + TTRACE_ALIGN(entry->len + 1);
+		if (nread + size > len) {
+			goto out;
+		}
+
+		rec = (FAR struct ttrace_rec_str_s *)&buffer[nread];
+		memset(rec, 0, size);
+		rec->type = TTRACE_REC_STR;
+		rec->len = entry->len;
+		rec->pid = entry->pid;
+		rec->id = g_compact.rd_str++;
+		memcpy(rec->str, &g_strpool[entry->offset], entry->len);
+		nread += size;
+	}
+
+	flags = irqsave();
+	while (g_compact.rd_hdr && g_compact.head != g_compact.tail) {
+		size = ttrace_recsize(g_compact.head);
+		if (size == 0) {
+			g_compact.head = 0;
+			continue;
+		}
+
+		if (nread + size > len) {
+			break;
+		}
+
+		memcpy(&buffer[nread], &g_ringbuf.buffer[g_compact.head], size);
+		g_compact.head = (g_compact.head + size) % g_ringbuf.bufsize;
+		nread += size;
+	}
+	irqrestore(flags);
+
+out:
+	filep->f_pos += nread;
+	return (ssize_t)nread;
+}
+#endif
+
 /****************************************************************************
  * Name: ttrace_read
  ****************************************************************************/
@@ -133,6 +507,16 @@ static ssize_t ttrace_read(FAR struct file *filep, FAR char *buffer, size_t len)
 {
 	struct inode *inode = filep->f_inode;
 	struct ttrace_dev_s *priv = inode->i_private;
+#ifdef CONFIG_TTRACE_COMPACT
+	ssize_t ret;
+
+	/* Records can be read while tracing is running, to stream them out */
+
+	sched_lock();
+	ret = ttrace_compact_read(filep, buffer, len);
+	sched_unlock();
+	return ret;
+#endif
 
 	if (TTRACE_STATE_IDLE != g_state) {
 		return TTRACE_INVALID;
@@ -168,8 +552,14 @@ static ssize_t ttrace_write(FAR struct file *filep, FAR const char *buffer, size
 	DEBUGASSERT(priv);
 	sched_lock();
 
+#ifdef CONFIG_TTRACE_COMPACT
+	if (len >= sizeof(struct trace_packet) - TTRACE_MSG_BYTES) {
+		(void)ttrace_compact_write((FAR const struct trace_packet *)buffer);
+	}
+#else
 	ringbuf_write(buffer, len, &g_ringbuf);
 	priv->ttrace_head = g_ringbuf.index;
+#endif
 
 	sched_unlock();
 	return (ssize_t)len;
@@ -192,6 +582,9 @@ static int ttrace_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 	case TTRACE_START:
 		g_state = TTRACE_STATE_RUNNING;
 		priv->ttrace_head = 0;
+#ifdef CONFIG_TTRACE_COMPACT
+		ttrace_compact_reset();
+#endif
 		break;
 	case TTRACE_OVERWRITE:
 		g_ringbuf.is_overwritable = arg;
@@ -217,14 +610,21 @@ static int ttrace_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 		ret = g_selected_tag;
 		break;
 	case TTRACE_SET_BUFSIZE:
+#ifndef CONFIG_TTRACE_COMPACT
+		/* Compact records have different sizes and are never split */
 		g_ringbuf.bufsize = CONFIG_TTRACE_BUFSIZE - (CONFIG_TTRACE_BUFSIZE % arg);
+#endif
 		break;
 	case TTRACE_USED_BUFSIZE:
+#ifdef CONFIG_TTRACE_COMPACT
+		ret = ttrace_compact_used();
+#else
 		if (g_ringbuf.is_overwritten == 0) {
 			ret = priv->ttrace_head;
 		} else {
 			ret = CONFIG_TTRACE_BUFSIZE;
 		}
+#endif
 		ttdbg("used bufsize: %d\r\n", ret);
 		break;
 	case TTRACE_BUFFER:
@@ -79,6 +79,11 @@
 #include <tinyara/fs/mtd.h>
 #include <tinyara/fs/smart_procfs.h>
 #include <tinyara/fs/smart.h>
+#ifdef CONFIG_MTD_SMART_BGGC
+#include <semaphore.h>
+#include <tinyara/clock.h>
+#include <tinyara/wqueue.h>
+#endif
 
 /****************************************************************************
  * Private Definitions
@@ -234,6 +239,69 @@
 
 #define SET_TO_TRUE(v, n) v[n/8] |= (1<<(7-(n%8)))
 #define GET_VAL(v, n) (v[n/8] & 1<<(7-(n%8)))
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+#error "CONFIG_MTD_SMART_CHECKPOINT needs the full sector map"
+#endif
+#ifdef CONFIG_SMARTFS_BAD_SECTOR
+#error "CONFIG_MTD_SMART_CHECKPOINT does not support CONFIG_SMARTFS_BAD_SECTOR"
+#endif
+
+/* The checkpoint area holds two slots at the end of the device.  Each slot
+ * starts with an erase block holding the header in its first MTD block and
+ * the log of modified erase blocks in the rest, followed by the erase blocks
+ * holding the sector map and the free and release counts.
+ */
+
+#define SMART_CP_MAGIC              "SMCP"
+#define SMART_CP_VERSION            1
+#define SMART_CP_NSLOTS             2
+#define SMART_CP_ERASED16           ((uint16_t)((CONFIG_SMARTFS_ERASEDSTATE << 8) | CONFIG_SMARTFS_ERASEDSTATE))
+
+/* Log entries are stored so that no erase block number reads as erased */
+
+#define SMART_CP_ENTRY(b)           ((uint16_t)((b) ^ (uint16_t)~SMART_CP_ERASED16))
+#define SMART_CP_SLOTADDR(d, s)     ((off_t)((d)->cpblock + (s) * (d)->cpslotblocks) * (d)->geo.erasesize)
+#define SMART_CP_MAPSIZE(d)         ((uint32_t)(d)->totalsectors * sizeof(uint16_t) + ((d)->neraseblocks << 1))
+#define SMART_CP_LOGSIZE(d)         (((d)->geo.erasesize - (d)->geo.blocksize) / sizeof(uint16_t))
+#define SMART_CP_ISDIRTY(m, b)      ((m)[(b) >> 3] & (1 << ((b) & 0x07)))
+#define SMART_CP_TOUCH(d, o, n)     smart_checkpoint_touch(d, o, n)
+#else
+#define SMART_CP_TOUCH(d, o, n)
+#endif
+
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+/* The block index keeps, for the free counts and for the release counts, a
+ * tree in which each node holds the highest key of up to 16 erase blocks or
+ * child nodes.  The root gives the best erase block to allocate sectors from
+ * or to collect, and a path from the root to that block is found by reading
+ * at most 16 entries per level.
+ */
+
+#define SMART_BLKINDEX_FANOUT       16
+#define SMART_BLKINDEX_MAXLEVELS    4
+#define SMART_BLKINDEX_FREE         0
+#define SMART_BLKINDEX_RELEASE      1
+#define SMART_BLKINDEX_NTREES       2
+#define SMART_BLKINDEX_UPDATE(d, b) smart_blkindex_update(d, b)
+#else
+#define SMART_BLKINDEX_UPDATE(d, b)
+#endif
+
+#ifdef CONFIG_MTD_SMART_BGGC
+#define smart_semgive(d)            sem_post(&(d)->exclsem)
+#else
+#define smart_semtake(d)
+#define smart_semgive(d)
+#define smart_gc_kick(d)
+#endif
+
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
+#define SMART_COUNT_PROGRAM(d, n)   ((d)->programbytes += (n))
+#else
+#define SMART_COUNT_PROGRAM(d, n)
+#endif
 /* Bit mapping for wear level bits */
 /* These are defined to allow updating the wear leveling with the minimum
  * number of sector relocations / maximum use of 1 --> 0 transitions when
@@ -289,6 +357,29 @@ struct smart_cache_s {
  * increase the wear of the device 2x.
  */
 
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+/* Header of a checkpoint slot.  It is written after the sector map, so a
+ * slot with a valid header always holds a complete map.
+ */
+
+struct smart_cp_header_s {
+	uint8_t magic[4];			/* SMART_CP_MAGIC */
+	uint8_t version;			/* SMART_CP_VERSION */
+	uint8_t formatstatus;		/* Format status of the device */
+	uint8_t formatversion;		/* Format version on the device */
+	uint8_t namesize;			/* Length of filenames on the device */
+	uint32_t seq;				/* Incremented with each checkpoint */
+	uint32_t mapsize;			/* Size of the sector map and counts */
+	uint32_t mapcrc;			/* CRC-32 of the sector map and counts */
+	uint16_t totalsectors;		/* Geometry the map was made for */
+	uint16_t neraseblocks;
+	uint16_t freesectors;		/* Total number of free sectors */
+	uint16_t releasesectors;	/* Total number of released sectors */
+	uint32_t crc;				/* CRC-32 of the fields above */
+	uint8_t state;				/* Erased until the checkpoint is dropped */
+};
+#endif
+
 #ifdef CONFIG_MTD_SMART_ENABLE_CRC
 struct smart_allocsector_s {
 	struct smart_allocsector_s *next;	/* Pointer to next alloc sector */
@@ -303,6 +394,7 @@ struct smart_struct_s {
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
 	uint32_t unusedsectors;	/* Count of unused sectors (i.e. free when erased) */
 	uint32_t blockerases;		/* Count of unused sectors (i.e. free when erased) */
+	uint32_t programbytes;		/* Count of bytes programmed to the FLASH */
 #endif
 	uint16_t reservedsector;    /* Number of reserved sector (i.e. logging sectors of journal) */
 	uint16_t neraseblocks;		/* Number of erase blocks or sub-sectors */
@@ -357,6 +449,28 @@ struct smart_struct_s {
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
 	FAR uint8_t *erasecounts;	/* Number of erases for each erase block */
 #endif
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	uint16_t cpblock;			/* First erase block of the checkpoint area */
+	uint16_t cpslotblocks;		/* Erase blocks per checkpoint slot, 0 if none */
+	uint16_t cplogcount;		/* Entries in the log of the current checkpoint */
+	uint8_t cpslot;				/* Slot of the newest checkpoint */
+	bool cpvalid;				/* Device state is the checkpoint plus its log */
+	uint32_t cpseq;				/* Sequence number of the newest checkpoint */
+	FAR uint8_t *cpdirty;		/* Bitmap of the erase blocks in the log */
+#endif
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	FAR uint16_t *blkindex;		/* Trees of the free and release counts */
+	uint16_t blkindexnodes;		/* Nodes in one tree */
+	uint16_t blkindexlevel[SMART_BLKINDEX_MAXLEVELS + 1];	/* First node of each level */
+	uint8_t blkindexlevels;		/* Levels in one tree */
+	bool blkindexvalid;			/* Trees match the free and release counts */
+#endif
+#ifdef CONFIG_MTD_SMART_BGGC
+	sem_t exclsem;				/* Serializes the file system and the collection */
+	struct work_s gcwork;		/* Background garbage collection */
+	struct smart_gc_watermark_s gcwatermark;	/* When the collection runs */
+	clock_t gclastaccess;		/* Time of the last access by the file system */
+#endif
 #ifdef CONFIG_MTD_SMART_ALLOC_DEBUG
 	size_t bytesalloc;
 	struct smart_alloc_s
@@ -470,6 +584,19 @@ static void smart_erase_block_if_empty(FAR struct smart_struct_s *dev, uint16_t
 static int smart_relocate_sector(FAR struct smart_struct_s *dev, uint16_t oldsector, uint16_t newsector);
 static int smart_validate_crc(FAR struct smart_struct_s *dev);
 static crc_t smart_calc_sector_crc(FAR struct smart_struct_s *dev);
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+static void smart_checkpoint_touch(FAR struct smart_struct_s *dev, off_t offset, size_t nbytes);
+static int smart_checkpoint_write(FAR struct smart_struct_s *dev);
+#endif
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+static void smart_blkindex_init(FAR struct smart_struct_s *dev);
+static void smart_blkindex_build(FAR struct smart_struct_s *dev);
+static void smart_blkindex_update(FAR struct smart_struct_s *dev, uint16_t block);
+#endif
+#ifdef CONFIG_MTD_SMART_BGGC
+static void smart_semtake(FAR struct smart_struct_s *dev);
+static void smart_gc_kick(FAR struct smart_struct_s *dev);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -559,6 +686,27 @@ static void smart_free(FAR struct smart_struct_s *dev, FAR void *ptr)
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: smart_semtake
+ *
+ * Description: Takes the semaphore which serializes the accesses of the
+ *              file system and of the background garbage collection.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_BGGC
+static void smart_semtake(FAR struct smart_struct_s *dev)
+{
+	while (sem_wait(&dev->exclsem) != 0) {
+		/* The only case that an error should occur here is if
+		 * the wait was awakened by a signal.
+		 */
+
+		ASSERT(*get_errno_ptr() == EINTR);
+	}
+}
+#endif
+
 /****************************************************************************
  * Name: smart_open
  *
@@ -581,7 +729,23 @@ static int smart_open(FAR struct inode *inode)
 
 static int smart_close(FAR struct inode *inode)
 {
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	FAR struct smart_struct_s *dev;
+#endif
+
 	fvdbg("Entry\n");
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	DEBUGASSERT(inode && inode->i_private);
+
+	/* Save the sector map so that the next boot does not scan the whole
+	 * device.  A failure only costs a full scan, so it is not reported.
+	 */
+
+	dev = (FAR struct smart_struct_s *)inode->i_private;
+	smart_semtake(dev);
+	(void)smart_checkpoint_write(dev);
+	smart_semgive(dev);
+#endif
 	return OK;
 }
 
@@ -816,6 +980,7 @@ static ssize_t smart_reload(struct smart_struct_s *dev, FAR uint8_t *buffer, off
 static ssize_t smart_read(FAR struct inode *inode, unsigned char *buffer, size_t start_sector, unsigned int nsectors)
 {
 	struct smart_struct_s *dev;
+	ssize_t nread;
 
 	fvdbg("SMART: sector: %d nsectors: %d\n", start_sector, nsectors);
 
@@ -825,7 +990,12 @@ static ssize_t smart_read(FAR struct inode *inode, unsigned char *buffer, size_t
 #else
 	dev = (struct smart_struct_s *)inode->i_private;
 #endif
-	return smart_reload(dev, buffer, start_sector, nsectors);
+
+	smart_semtake(dev);
+	nread = smart_reload(dev, buffer, start_sector, nsectors);
+	smart_gc_kick(dev);
+	smart_semgive(dev);
+	return nread;
 }
 
 /****************************************************************************
@@ -860,7 +1030,7 @@ static ssize_t smart_write(FAR struct inode *inode, FAR const unsigned char *buf
 	dev = (FAR struct smart_struct_s *)inode->i_private;
 #endif
 
-	/* I think maybe we need to lock on a mutex here. */
+	smart_semtake(dev);
 
 	/* Get the aligned block.  Here is is assumed: (1) The number of R/W blocks
 	 * per erase block is a power of 2, and (2) the erase begins with that same
@@ -887,6 +1057,8 @@ static ssize_t smart_write(FAR struct inode *inode, FAR const unsigned char *buf
 	/* Loop for all blocks to be written. */
 
 	while (remaining > 0) {
+		SMART_CP_TOUCH(dev, nextblock * dev->geo.blocksize, dev->geo.blocksize);
+
 		/* If this is an aligned block, then erase the block. */
 
 		if (alignedblock == nextblock) {
@@ -897,8 +1069,7 @@ static ssize_t smart_write(FAR struct inode *inode, FAR const unsigned char *buf
 			if (ret < 0) {
 				fdbg("Erase block=%d failed: %d\n", eraseblock, ret);
 
-				/* Unlock the mutex if we add one. */
-
+				smart_semgive(dev);
 				return ret;
 			}
 		}
@@ -918,13 +1089,13 @@ static ssize_t smart_write(FAR struct inode *inode, FAR const unsigned char *buf
 
 		fdbg("Write MTD block %d from offset %d\n", nextblock, offset);
 		nxfrd = MTD_BWRITE(dev->mtd, nextblock, blkstowrite, &buffer[offset]);
+		SMART_COUNT_PROGRAM(dev, blkstowrite * dev->geo.blocksize);
 		if (nxfrd != blkstowrite) {
 			/* The block is not empty!!  What to do? */
 
 			fdbg("Write block %d failed: %d.\n", nextblock, nxfrd);
 
-			/* Unlock the mutex if we add one. */
-
+			smart_semgive(dev);
 			return -EIO;
 		}
 
@@ -936,6 +1107,8 @@ static ssize_t smart_write(FAR struct inode *inode, FAR const unsigned char *buf
 		alignedblock += mtdBlksPerErase;
 	}
 
+	smart_gc_kick(dev);
+	smart_semgive(dev);
 	return nsectors;
 }
 #endif							/* CONFIG_FS_WRITABLE */
@@ -1036,6 +1209,7 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
 	dev->unusedsectors = 0;
 	dev->blockerases = 0;
+	dev->programbytes = 0;
 #endif
 
 	/* Release any existing rwbuffer and sMap. */
@@ -1211,6 +1385,12 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 	dev->uneven_wearcount = 0;
 #endif
 
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	/* The counts are set up again, the index is built once they are known. */
+
+	smart_blkindex_init(dev);
+#endif
+
 	/* Allocate a read/write buffer. */
 
 	dev->rwbuffer = (FAR char *)smart_malloc(dev, size, "RW Buffer");
@@ -1286,11 +1466,14 @@ errexit:
 static ssize_t smart_bytewrite(FAR struct smart_struct_s *dev, size_t offset, int nbytes, FAR const uint8_t *buffer)
 {
 	ssize_t ret;
+
+	SMART_CP_TOUCH(dev, offset, nbytes);
 #ifdef CONFIG_MTD_BYTE_WRITE
 	/* Check if the underlying MTD device supports write. */
 
 	if (dev->mtd->write != NULL) {
 		ret = MTD_WRITE(dev->mtd, offset, nbytes, buffer);
+		SMART_COUNT_PROGRAM(dev, nbytes);
 		goto errout;
 	} else
 #endif
@@ -1322,6 +1505,7 @@ static ssize_t smart_bytewrite(FAR struct smart_struct_s *dev, size_t offset, in
 		/* Write the data back to the device. */
 
 		ret = MTD_BWRITE(dev->mtd, startblock, nblocks, (FAR uint8_t *)dev->bytebuffer);
+		SMART_COUNT_PROGRAM(dev, nblocks * dev->geo.blocksize);
 		if (ret < 0) {
 			fdbg("Error %d writing to device\n", -ret);
 			goto errout;
@@ -1333,6 +1517,418 @@ errout:
 	return ret;
 }
 
+/****************************************************************************
+ * Name: smart_checkpoint_reserve
+ *
+ * Description: Reserve the checkpoint area at the end of the device.  The
+ *              area is taken out of the geometry, so the rest of the driver
+ *              never sees it.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+static void smart_checkpoint_reserve(FAR struct smart_struct_s *dev)
+{
+	uint32_t totalsectors;
+	uint32_t mapsize;
+	uint32_t slotblocks;
+
+	dev->cpslotblocks = 0;
+	dev->cplogcount = 0;
+	dev->cpslot = SMART_CP_NSLOTS - 1;
+	dev->cpvalid = false;
+	dev->cpseq = 0;
+
+	if (dev->geo.erasesize <= dev->geo.blocksize || dev->geo.erasesize < CONFIG_MTD_SMART_SECTOR_SIZE) {
+		fdbg("No room for a checkpoint log, checkpoint disabled\n");
+		return;
+	}
+
+	/* Size the map for the whole device, the map of what is left after the
+	 * reservation is smaller.
+	 */
+
+	totalsectors = dev->geo.neraseblocks * (dev->geo.erasesize / CONFIG_MTD_SMART_SECTOR_SIZE);
+	if (totalsectors > 65534) {
+		totalsectors = 65534;
+	}
+
+	mapsize = totalsectors * sizeof(uint16_t) + (dev->geo.neraseblocks << 1);
+	slotblocks = 1 + (mapsize + dev->geo.erasesize - 1) / dev->geo.erasesize;
+
+	/* Do not let the checkpoint take more than a quarter of the device. */
+
+	if (SMART_CP_NSLOTS * slotblocks * 4 > dev->geo.neraseblocks) {
+		fdbg("Device too small for a checkpoint, checkpoint disabled\n");
+		return;
+	}
+
+	dev->cpslotblocks = (uint16_t)slotblocks;
+	dev->geo.neraseblocks -= SMART_CP_NSLOTS * slotblocks;
+	dev->cpblock = dev->geo.neraseblocks;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_checkpoint_drop
+ *
+ * Description: Mark the checkpoint in the given slot as no longer usable by
+ *              programming the state byte of its header.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+static void smart_checkpoint_drop(FAR struct smart_struct_s *dev, uint8_t slot)
+{
+	uint8_t state = (uint8_t)~CONFIG_SMARTFS_ERASEDSTATE;
+	ssize_t ret;
+
+	if (slot == dev->cpslot) {
+		dev->cpvalid = false;
+	}
+
+	ret = smart_bytewrite(dev, SMART_CP_SLOTADDR(dev, slot) + offsetof(struct smart_cp_header_s, state), 1, &state);
+	if (ret != 1) {
+		fdbg("Error %d dropping checkpoint slot %d\n", ret, slot);
+	}
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_checkpoint_touch
+ *
+ * Description: Must be called before a range of the device is written or
+ *              erased.  The first time an erase block is modified after the
+ *              checkpoint, its number is appended to the checkpoint log so
+ *              that the block is scanned again at the next boot.  When the
+ *              log is full, the checkpoint is dropped instead.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+static void smart_checkpoint_touch(FAR struct smart_struct_s *dev, off_t offset, size_t nbytes)
+{
+	uint32_t block;
+	uint32_t last;
+	uint16_t entry;
+	off_t address;
+	ssize_t ret;
+
+	if (!dev->cpvalid || nbytes == 0) {
+		return;
+	}
+
+	/* Blocks past the end of the sector area belong to the checkpoint
+	 * itself and are not logged.
+	 */
+
+	block = offset / dev->geo.erasesize;
+	last = (offset + nbytes - 1) / dev->geo.erasesize;
+	for (; block <= last && block < dev->neraseblocks; block++) {
+		if (SMART_CP_ISDIRTY(dev->cpdirty, block)) {
+			continue;
+		}
+
+		if (dev->cplogcount >= SMART_CP_LOGSIZE(dev)) {
+			fvdbg("Checkpoint log full\n");
+			smart_checkpoint_drop(dev, dev->cpslot);
+			return;
+		}
+
+		address = SMART_CP_SLOTADDR(dev, dev->cpslot) + dev->geo.blocksize + dev->cplogcount * sizeof(uint16_t);
+		entry = SMART_CP_ENTRY(block);
+		ret = smart_bytewrite(dev, address, sizeof(uint16_t), (FAR const uint8_t *)&entry);
+		if (ret != sizeof(uint16_t)) {
+			fdbg("Error %d writing checkpoint log\n", ret);
+			smart_checkpoint_drop(dev, dev->cpslot);
+			return;
+		}
+
+		dev->cpdirty[block >> 3] |= 1 << (block & 0x07);
+		dev->cplogcount++;
+	}
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_checkpoint_load
+ *
+ * Description: Load the sector map, the counts and the format information
+ *              from the newest checkpoint, then forget everything known
+ *              about the erase blocks listed in its log.  The caller must
+ *              scan those blocks again.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+static int smart_checkpoint_load(FAR struct smart_struct_s *dev)
+{
+	struct smart_cp_header_s header;
+	struct smart_cp_header_s newest;
+	uint32_t mapsize;
+	uint32_t logsize;
+	uint32_t x;
+	uint16_t entry;
+	uint16_t block;
+	uint16_t nbytes;
+	uint16_t count;
+	uint16_t prerelease;
+	off_t address;
+	bool found;
+	ssize_t ret;
+	uint8_t slot;
+
+	dev->cpvalid = false;
+	if (dev->cpslotblocks == 0) {
+		return -ENOSYS;
+	}
+
+	/* Find the newest slot with a valid header. */
+
+	found = false;
+	for (slot = 0; slot < SMART_CP_NSLOTS; slot++) {
+		ret = MTD_READ(dev->mtd, SMART_CP_SLOTADDR(dev, slot), sizeof(header), (FAR uint8_t *)&header);
+		if (ret != sizeof(header)) {
+			continue;
+		}
+
+		if (memcmp(header.magic, SMART_CP_MAGIC, sizeof(header.magic)) != 0 ||
+			header.crc != crc32((FAR const uint8_t *)&header, offsetof(struct smart_cp_header_s, crc))) {
+			continue;
+		}
+
+		if (!found || header.seq > newest.seq) {
+			memcpy(&newest, &header, sizeof(header));
+			dev->cpslot = slot;
+			dev->cpseq = header.seq;
+			found = true;
+		}
+	}
+
+	if (!found) {
+		return -ENOENT;
+	}
+
+	if (newest.state != CONFIG_SMARTFS_ERASEDSTATE) {
+		return -ENOENT;
+	}
+
+	/* From here on, a checkpoint which cannot be used is dropped.  The
+	 * device is then modified without logging, so the checkpoint must not
+	 * be trusted at a later boot.
+	 */
+
+	mapsize = SMART_CP_MAPSIZE(dev);
+	if (newest.version != SMART_CP_VERSION || newest.totalsectors != dev->totalsectors ||
+		newest.neraseblocks != dev->neraseblocks || newest.mapsize != mapsize) {
+		fdbg("Checkpoint does not match the device\n");
+		ret = -EINVAL;
+		goto errout;
+	}
+
+	address = SMART_CP_SLOTADDR(dev, dev->cpslot);
+	ret = MTD_READ(dev->mtd, address + dev->geo.erasesize, mapsize, (FAR uint8_t *)dev->sMap);
+	if (ret != (ssize_t)mapsize) {
+		fdbg("Error %d reading checkpoint map\n", ret);
+		ret = -EIO;
+		goto errout;
+	}
+
+	if (crc32((FAR const uint8_t *)dev->sMap, mapsize) != newest.mapcrc) {
+		fdbg("Checkpoint map CRC error\n");
+		ret = -EIO;
+		goto errout;
+	}
+
+	/* Read the log.  It ends at the first erased entry, an entry which was
+	 * torn by a power loss does not name a block that was modified.
+	 */
+
+	memset(dev->cpdirty, 0, (dev->neraseblocks + 7) >> 3);
+	dev->cplogcount = 0;
+	logsize = SMART_CP_LOGSIZE(dev);
+	address += dev->geo.blocksize;
+	for (x = 0; x < logsize; x++) {
+		if ((x * sizeof(uint16_t)) % dev->sectorsize == 0) {
+			nbytes = dev->sectorsize;
+			if (nbytes > (logsize - x) * sizeof(uint16_t)) {
+				nbytes = (logsize - x) * sizeof(uint16_t);
+			}
+
+			ret = MTD_READ(dev->mtd, address + x * sizeof(uint16_t), nbytes, (FAR uint8_t *)dev->rwbuffer);
+			if (ret != nbytes) {
+				fdbg("Error %d reading checkpoint log\n", ret);
+				ret = -EIO;
+				goto errout;
+			}
+		}
+
+		memcpy(&entry, &dev->rwbuffer[(x * sizeof(uint16_t)) % dev->sectorsize], sizeof(uint16_t));
+		if (entry == SMART_CP_ERASED16) {
+			break;
+		}
+
+		block = SMART_CP_ENTRY(entry);
+		if (block < dev->neraseblocks) {
+			dev->cpdirty[block >> 3] |= 1 << (block & 0x07);
+		}
+
+		dev->cplogcount++;
+	}
+
+	dev->formatstatus = newest.formatstatus;
+	dev->formatversion = newest.formatversion;
+	dev->namesize = newest.namesize;
+	dev->freesectors = newest.freesectors;
+	dev->releasesectors = newest.releasesectors;
+
+	/* Unmap the logical sectors held by the logged blocks. */
+
+	for (x = 0; x < dev->totalsectors; x++) {
+		if (dev->sMap[x] != 0xFFFF && SMART_CP_ISDIRTY(dev->cpdirty, dev->sMap[x] / dev->sectorsPerBlk)) {
+			dev->sMap[x] = 0xFFFF;
+			if (x == 0) {
+				dev->formatstatus = SMART_FMT_STAT_NOFMT;
+			}
+		}
+	}
+
+	/* Return the logged blocks to the state they have before a scan. */
+
+	for (block = 0; block < dev->neraseblocks; block++) {
+		if (!SMART_CP_ISDIRTY(dev->cpdirty, block)) {
+			continue;
+		}
+
+		if (block == dev->neraseblocks - 1 && dev->totalsectors == 65534) {
+			prerelease = 2;
+		} else {
+			prerelease = 0;
+		}
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+		dev->freesectors += dev->availSectPerBlk - prerelease - smart_get_count(dev, dev->freecount, block);
+		count = smart_get_count(dev, dev->releasecount, block) - prerelease;
+		smart_set_count(dev, dev->freecount, block, dev->availSectPerBlk - prerelease);
+		smart_set_count(dev, dev->releasecount, block, prerelease);
+#else
+		dev->freesectors += dev->availSectPerBlk - prerelease - dev->freecount[block];
+		count = dev->releasecount[block] - prerelease;
+		dev->freecount[block] = dev->availSectPerBlk - prerelease;
+		dev->releasecount[block] = prerelease;
+#endif
+		dev->releasesectors = dev->releasesectors > count ? dev->releasesectors - count : 0;
+	}
+
+	fdbg("Checkpoint %u loaded, %u erase blocks to scan\n", newest.seq, dev->cplogcount);
+	dev->cpvalid = true;
+	return OK;
+
+errout:
+	smart_checkpoint_drop(dev, dev->cpslot);
+	return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_checkpoint_write
+ *
+ * Description: Write the sector map, the counts and the format information
+ *              to the older checkpoint slot, which then becomes the newest
+ *              one with an empty log.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+static int smart_checkpoint_write(FAR struct smart_struct_s *dev)
+{
+	struct smart_cp_header_s header;
+	uint32_t mapsize;
+	uint32_t offset;
+	uint32_t nbytes;
+	off_t address;
+	uint8_t slot;
+	int ret;
+
+	if (dev->cpslotblocks == 0 || dev->formatstatus != SMART_FMT_STAT_FORMATTED) {
+		return OK;
+	}
+
+	/* Nothing was modified since the checkpoint. */
+
+	if (dev->cpvalid && dev->cplogcount == 0) {
+		return OK;
+	}
+
+	slot = (dev->cpslot + 1) % SMART_CP_NSLOTS;
+	address = SMART_CP_SLOTADDR(dev, slot);
+	mapsize = SMART_CP_MAPSIZE(dev);
+
+	ret = MTD_ERASE(dev->mtd, dev->cpblock + slot * dev->cpslotblocks, dev->cpslotblocks);
+	if (ret < 0) {
+		fdbg("Error %d erasing checkpoint slot %d\n", ret, slot);
+		return ret;
+	}
+
+	/* Write the sector map and the counts, which follow it in memory. */
+
+	for (offset = 0; offset < mapsize; offset += dev->sectorsize) {
+		nbytes = mapsize - offset;
+		if (nbytes > dev->sectorsize) {
+			nbytes = dev->sectorsize;
+		}
+
+		memcpy(dev->rwbuffer, (FAR uint8_t *)dev->sMap + offset, nbytes);
+		memset(&dev->rwbuffer[nbytes], CONFIG_SMARTFS_ERASEDSTATE, dev->sectorsize - nbytes);
+		ret = MTD_BWRITE(dev->mtd, (address + dev->geo.erasesize + offset) / dev->geo.blocksize, dev->mtdBlksPerSector, (FAR uint8_t *)dev->rwbuffer);
+		SMART_COUNT_PROGRAM(dev, dev->sectorsize);
+		if (ret != dev->mtdBlksPerSector) {
+			fdbg("Error %d writing checkpoint map\n", ret);
+			return -EIO;
+		}
+	}
+
+	/* Drop the previous checkpoint before the new one becomes valid, so a
+	 * stale checkpoint can never be picked up after a power loss.
+	 */
+
+	smart_checkpoint_drop(dev, dev->cpslot);
+
+	memset(&header, CONFIG_SMARTFS_ERASEDSTATE, sizeof(header));
+	memcpy(header.magic, SMART_CP_MAGIC, sizeof(header.magic));
+	header.version = SMART_CP_VERSION;
+	header.formatstatus = dev->formatstatus;
+	header.formatversion = dev->formatversion;
+	header.namesize = dev->namesize;
+	header.seq = dev->cpseq + 1;
+	header.mapsize = mapsize;
+	header.mapcrc = crc32((FAR const uint8_t *)dev->sMap, mapsize);
+	header.totalsectors = dev->totalsectors;
+	header.neraseblocks = dev->neraseblocks;
+	header.freesectors = dev->freesectors;
+	header.releasesectors = dev->releasesectors;
+	header.crc = crc32((FAR const uint8_t *)&header, offsetof(struct smart_cp_header_s, crc));
+
+	memset(dev->rwbuffer, CONFIG_SMARTFS_ERASEDSTATE, dev->geo.blocksize);
+	memcpy(dev->rwbuffer, &header, sizeof(header));
+	ret = MTD_BWRITE(dev->mtd, address / dev->geo.blocksize, 1, (FAR uint8_t *)dev->rwbuffer);
+	SMART_COUNT_PROGRAM(dev, dev->geo.blocksize);
+	if (ret != 1) {
+		fdbg("Error %d writing checkpoint header\n", ret);
+		return -EIO;
+	}
+
+	dev->cpslot = slot;
+	dev->cpseq = header.seq;
+	dev->cplogcount = 0;
+	memset(dev->cpdirty, 0, (dev->neraseblocks + 7) >> 3);
+	dev->cpvalid = true;
+
+	fvdbg("Checkpoint %u written to slot %d\n", header.seq, slot);
+	return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: smart_add_sector_to_cache
  *
@@ -1703,6 +2299,7 @@ static int smart_set_wear_level(FAR struct smart_struct_s *dev, uint16_t block,
 	/* Mark wear bits as dirty. */
 
 	dev->wearflags |= SMART_WEARFLAGS_WRITE_NEEDED;
+	SMART_BLKINDEX_UPDATE(dev, block);
 
 	/* Test if min / max need to be updated. */
 
@@ -1790,6 +2387,9 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 	struct smart_sect_header_s header;
 	uint8_t *sector_seq_log = NULL;
 	bool status_released, status_committed;
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	FAR uint8_t *rescan = NULL;
+#endif
 #ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
 	int dupsector;
 	uint16_t duplogsector;
@@ -1808,6 +2408,12 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 		goto err_out;
 	}
 
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	/* The counts are rebuilt below, the index is built from them at the end. */
+
+	dev->blkindexvalid = false;
+#endif
+
 	/* Initialize the device variables. */
 
 	totalsectors = dev->totalsectors;
@@ -1819,6 +2425,25 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 	}
 #endif
 
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	/* With a valid checkpoint, only the erase blocks modified after it are
+	 * scanned.  Keep a copy of their list, the scan itself may log more
+	 * blocks which are already accounted for.
+	 */
+
+	if (smart_checkpoint_load(dev) == OK) {
+		rescan = (FAR uint8_t *)kmm_malloc((dev->neraseblocks + 7) >> 3);
+		if (rescan != NULL) {
+			memcpy(rescan, dev->cpdirty, (dev->neraseblocks + 7) >> 3);
+			goto scan;
+		}
+
+		/* The loaded map is only a part of the device state. */
+
+		smart_checkpoint_drop(dev, dev->cpslot);
+	}
+#endif
+
 	dev->formatstatus = SMART_FMT_STAT_NOFMT;
 	dev->freesectors = dev->availSectPerBlk * dev->geo.neraseblocks;
 	dev->releasesectors = 0;
@@ -1853,6 +2478,9 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 	memset(dev->sBitMap, 0, (dev->totalsectors + 7) >> 3);
 #endif
 
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+scan:
+#endif
 	/* Now scan the MTD device. */
 	sector_seq_log = (uint8_t *)kmm_zalloc(sizeof(uint8_t) * totalsectors);
 
@@ -1862,6 +2490,11 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 	}
 
 	for (sector = 0; sector < totalsectors; sector++) {
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+		if (rescan != NULL && !SMART_CP_ISDIRTY(rescan, sector / dev->sectorsPerBlk)) {
+			continue;
+		}
+#endif
 		winner = sector;
 		fvdbg("Scan sector %d\n", sector);
 
@@ -2309,6 +2942,10 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 	smart_read_wearstatus(dev);
 #endif
 
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	smart_blkindex_build(dev);
+#endif
+
 	fdbg("SMART Scan\n");
 	fdbg("   Erase size:   %10d\n", dev->sectorsPerBlk * dev->sectorsize);
 	fdbg("   Erase count:  %10d\n", dev->neraseblocks);
@@ -2330,6 +2967,11 @@ err_out:
 	if (sector_seq_log != NULL) {
 		kmm_free(sector_seq_log);
 	}
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	if (rescan != NULL) {
+		kmm_free(rescan);
+	}
+#endif
 	return ret;
 }
 
@@ -2425,6 +3067,7 @@ static void verify_erased_block(FAR struct smart_struct_s *dev, uint16_t block)
 		}
 		if (SECTOR_IS_COMMITTED(header) || SECTOR_IS_RELEASED(header)) {
 			dev->freecount[block]--;
+			SMART_BLKINDEX_UPDATE(dev, block);
 			fdbg("SECTOR %d ERASE FAIL!! status : %d (%d, %d)\n", sector, header.status, SECTOR_IS_COMMITTED(header), SECTOR_IS_RELEASED(header));
 		}
 	}
@@ -2459,10 +3102,12 @@ static void smart_erase_block_if_empty(FAR struct smart_struct_s *dev, uint16_t
 		dev->unusedsectors += freecount;
 		dev->blockerases++;
 #endif
+		SMART_CP_TOUCH(dev, (off_t)block * dev->geo.erasesize, dev->geo.erasesize);
 		ret = MTD_ERASE(dev->mtd, block, 1);
 		if (ret < 0) {
 			fdbg("MTD_ERASE failed!!\n");
 			dev->freecount[block] = 0;
+			SMART_BLKINDEX_UPDATE(dev, block);
 			return;
 		}
 
@@ -2499,6 +3144,7 @@ static void smart_erase_block_if_empty(FAR struct smart_struct_s *dev, uint16_t
 		dev->releasecount[block] = prerelease;
 		dev->freecount[block] = dev->availSectPerBlk - prerelease;
 #endif							/* CONFIG_MTD_SMART_PACK_COUNTS */
+		SMART_BLKINDEX_UPDATE(dev, block);
 
 		verify_erased_block(dev, block);
 
@@ -2709,6 +3355,7 @@ static int smart_relocate_static_data(FAR struct smart_struct_s *dev, uint16_t b
 #else
 				dev->freecount[block]--;
 #endif							/* CONFIG_MTD_SMART_PACK_COUNTS */
+				SMART_BLKINDEX_UPDATE(dev, block);
 				dev->freesectors--;
 				fvdbg("Decrease freecount %d (Block %d)\n", dev->freecount[block], block);
 			}
@@ -2912,6 +3559,12 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev, unsigned long a
 	if (ret < 0) {
 		return ret;
 	}
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+
+	/* The checkpoint area was erased as well. */
+
+	dev->cpvalid = false;
+#endif
 
 	/* Now construct a logical sector zero header to write to the device. */
 
@@ -2981,6 +3634,7 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev, unsigned long a
 	/* Write the sector to the flash. */
 
 	wrcount = MTD_BWRITE(dev->mtd, 0, dev->mtdBlksPerSector, (FAR uint8_t *)dev->rwbuffer);
+	SMART_COUNT_PROGRAM(dev, dev->sectorsize);
 	if (wrcount != dev->mtdBlksPerSector) {
 		/* The block is not empty!!  What to do? */
 
@@ -3045,6 +3699,10 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev, unsigned long a
 	}
 #endif
 
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	smart_blkindex_build(dev);
+#endif
+
 #ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
 
 	/* Un-register any extra directory device entries. */
@@ -3131,7 +3789,9 @@ static int smart_relocate_sector(FAR struct smart_struct_s *dev, uint16_t oldsec
 
 	/* Write the data to the new physical sector location. */
 
+	SMART_CP_TOUCH(dev, (off_t)newsector * dev->sectorsize, dev->sectorsize);
 	ret = MTD_BWRITE(dev->mtd, newsector * dev->mtdBlksPerSector, dev->mtdBlksPerSector, (FAR uint8_t *)dev->rwbuffer);
+	SMART_COUNT_PROGRAM(dev, dev->sectorsize);
 
 #else							/* CONFIG_MTD_SMART_ENABLE_CRC */
 
@@ -3144,7 +3804,9 @@ static int smart_relocate_sector(FAR struct smart_struct_s *dev, uint16_t oldsec
 
 	/* Write the data to the new physical sector location. */
 
+	SMART_CP_TOUCH(dev, (off_t)newsector * dev->sectorsize, dev->sectorsize);
 	ret = MTD_BWRITE(dev->mtd, newsector * dev->mtdBlksPerSector, dev->mtdBlksPerSector, (FAR uint8_t *)dev->rwbuffer);
+	SMART_COUNT_PROGRAM(dev, dev->sectorsize);
 
 	/* Commit the sector. */
 
@@ -3252,6 +3914,7 @@ static int smart_relocate_block(FAR struct smart_struct_s *dev, uint16_t block)
 
 	dev->freecount[block] = 0;
 #endif
+	SMART_BLKINDEX_UPDATE(dev, block);
 
 	/* Next move all live data in the block to a new home. */
 
@@ -3361,16 +4024,19 @@ static int smart_relocate_block(FAR struct smart_struct_s *dev, uint16_t block)
 #else
 			dev->freecount[newsector / dev->sectorsPerBlk]--;
 #endif
+			SMART_BLKINDEX_UPDATE(dev, newsector / dev->sectorsPerBlk);
 			fvdbg("\tBlock %d freecount = %d\n", allocblock, dev->freecount[allocblock]);
 		}
 	}
 
 	/* Now erase the erase block. */
 
+	SMART_CP_TOUCH(dev, (off_t)block * dev->geo.erasesize, dev->geo.erasesize);
 	ret = MTD_ERASE(dev->mtd, block, 1);
 	if (ret < 0) {
 		fdbg("MTD_ERASE failed!!\n");
 		dev->freecount[block] = 0;
+		SMART_BLKINDEX_UPDATE(dev, block);
 		return ret;
 	}
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
@@ -3398,78 +4064,321 @@ static int smart_relocate_block(FAR struct smart_struct_s *dev, uint16_t block)
 		   so "pre-release" them so they never get allocated.
 		 */
 
-		prerelease = 2;
-	} else {
-		prerelease = 0;
+		prerelease = 2;
+	} else {
+		prerelease = 0;
+	}
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+	oldrelease = smart_get_count(dev, dev->releasecount, block);
+	dev->freesectors += oldrelease - prerelease;
+	dev->releasesectors -= oldrelease - prerelease;
+	smart_set_count(dev, dev->freecount, block, dev->availSectPerBlk - prerelease);
+	smart_set_count(dev, dev->releasecount, block, prerelease);
+#else
+	oldrelease = dev->releasecount[block];
+	dev->freesectors += oldrelease - prerelease;
+	dev->releasesectors -= oldrelease - prerelease;
+	dev->freecount[block] = dev->availSectPerBlk - prerelease;
+	dev->releasecount[block] = prerelease;
+#endif
+	SMART_BLKINDEX_UPDATE(dev, block);
+
+	verify_erased_block(dev, block);
+
+#ifdef CONFIG_SMART_LOCAL_CHECKFREE
+	if (smart_checkfree(dev, __LINE__) != OK) {
+		fdbg("   ...while relocating block %d, free=%d, release=%d, oldrelease=%d\n", block, freecount, releasecount, oldrelease);
+	}
+#endif
+
+	/* Test if this erase causes the block to reach the full relocate
+	 * threshold requiring static data relocation.
+	 */
+
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+	smart_relocate_static_data(dev, block);
+#endif
+
+	return OK;
+
+errout:
+	/* Restore the block's freecount if error. */
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+	smart_set_count(dev, dev->freecount, block, freecount);
+#else
+	dev->freecount[block] = freecount;
+	fdbg("Freecount is RESTORED!! to %d\n", freecount);
+#endif
+	SMART_BLKINDEX_UPDATE(dev, block);
+	return ret;
+}
+
+static void print_sector_headers(FAR struct smart_struct_s *dev, int targetblock)
+{
+	int ret;
+	int block;
+	int sector;
+	uint32_t readaddr;
+	struct smart_sect_header_s header;
+	for (block = 0; block < dev->neraseblocks; block++) {
+		if (targetblock < 0 || (targetblock >= 0 && block == targetblock)) {
+			printf("block (%d), freecount = %d\t", block, dev->freecount[block]);
+			for (sector = block * dev->sectorsPerBlk; sector < block * dev->sectorsPerBlk + dev->availSectPerBlk; sector++) {
+				readaddr = sector * dev->mtdBlksPerSector * dev->geo.blocksize;
+				ret = MTD_READ(dev->mtd, readaddr, sizeof(struct smart_sect_header_s), (FAR uint8_t *)&header);
+				if (ret != sizeof(struct smart_sect_header_s)) {
+					fdbg("Error reading phys sector %d\n", sector);
+					return;
+				}
+				printf("%d status : %d (%d, %d)\t", sector, header.status, SECTOR_IS_COMMITTED(header), SECTOR_IS_RELEASED(header));
+			}
+			printf("\n");
+		}
+	}
+}
+
+/****************************************************************************
+ * Name: smart_blkindex_key
+ *
+ * Description:  Returns the rank of an erase block in the free or release
+ *               index, 0 if the block must not be chosen.  Blocks are ranked
+ *               by their count first and then by the lowest wear level.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+static uint16_t smart_blkindex_key(FAR struct smart_struct_s *dev, uint8_t which, uint16_t block)
+{
+	uint16_t count;
+	uint8_t wearlevel = 0;
+
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+	/* Leave out worn blocks, they are only used when nothing else is left. */
+
+	wearlevel = smart_get_wear_level(dev, block);
+	if (wearlevel >= (which == SMART_BLKINDEX_FREE ? SMART_WEAR_FULL_RELOCATE_THRESHOLD : SMART_WEAR_REORG_THRESHOLD)) {
+		return 0;
+	}
+#endif
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+	count = smart_get_count(dev, which == SMART_BLKINDEX_FREE ? dev->freecount : dev->releasecount, block);
+#else
+	count = which == SMART_BLKINDEX_FREE ? dev->freecount[block] : dev->releasecount[block];
+#endif
+	if (count == 0) {
+		return 0;
+	}
+
+	return (count << 4) | (SMART_WEAR_ZERO_MASK - wearlevel);
+}
+
+/****************************************************************************
+ * Name: smart_blkindex_node
+ *
+ * Description:  Computes the value of a node from its erase blocks or its
+ *               child nodes.
+ *
+ ****************************************************************************/
+
+static uint16_t smart_blkindex_node(FAR struct smart_struct_s *dev, uint8_t which, uint8_t level, uint16_t node)
+{
+	FAR uint16_t *tree = &dev->blkindex[which * dev->blkindexnodes];
+	uint32_t first;
+	uint32_t last;
+	uint32_t x;
+	uint16_t key;
+	uint16_t max = 0;
+
+	first = (uint32_t)node * SMART_BLKINDEX_FANOUT;
+	if (level == 0) {
+		last = first + SMART_BLKINDEX_FANOUT;
+		if (last > dev->neraseblocks) {
+			last = dev->neraseblocks;
+		}
+		for (x = first; x < last; x++) {
+			key = smart_blkindex_key(dev, which, x);
+			if (key > max) {
+				max = key;
+			}
+		}
+	} else {
+		last = first + SMART_BLKINDEX_FANOUT;
+		if (last > (uint32_t)(dev->blkindexlevel[level] - dev->blkindexlevel[level - 1])) {
+			last = (uint32_t)(dev->blkindexlevel[level] - dev->blkindexlevel[level - 1]);
+		}
+		for (x = first; x < last; x++) {
+			key = tree[dev->blkindexlevel[level - 1] + x];
+			if (key > max) {
+				max = key;
+			}
+		}
+	}
+
+	return max;
+}
+
+/****************************************************************************
+ * Name: smart_blkindex_init
+ *
+ * Description:  Allocates the block index for the current geometry.  The
+ *               index is optional: if it can't be allocated, erase blocks
+ *               are chosen by scanning the counts.
+ *
+ ****************************************************************************/
+
+static void smart_blkindex_init(FAR struct smart_struct_s *dev)
+{
+	uint32_t nodes;
+	uint8_t level;
+
+	dev->blkindexvalid = false;
+	if (dev->blkindex != NULL) {
+		smart_free(dev, dev->blkindex);
+		dev->blkindex = NULL;
+	}
+
+	dev->blkindexlevel[0] = 0;
+	nodes = dev->neraseblocks;
+	for (level = 0; level < SMART_BLKINDEX_MAXLEVELS; level++) {
+		nodes = (nodes + SMART_BLKINDEX_FANOUT - 1) / SMART_BLKINDEX_FANOUT;
+		dev->blkindexlevel[level + 1] = dev->blkindexlevel[level] + nodes;
+		if (nodes == 1) {
+			break;
+		}
+	}
+
+	dev->blkindexlevels = level + 1;
+	dev->blkindexnodes = dev->blkindexlevel[dev->blkindexlevels];
+	dev->blkindex = (FAR uint16_t *)smart_malloc(dev, SMART_BLKINDEX_NTREES * dev->blkindexnodes * sizeof(uint16_t), "Block index");
+	if (dev->blkindex == NULL) {
+		fdbg("Error allocating block index, scanning the counts instead\n");
 	}
+}
 
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-	oldrelease = smart_get_count(dev, dev->releasecount, block);
-	dev->freesectors += oldrelease - prerelease;
-	dev->releasesectors -= oldrelease - prerelease;
-	smart_set_count(dev, dev->freecount, block, dev->availSectPerBlk - prerelease);
-	smart_set_count(dev, dev->releasecount, block, prerelease);
-#else
-	oldrelease = dev->releasecount[block];
-	dev->freesectors += oldrelease - prerelease;
-	dev->releasesectors -= oldrelease - prerelease;
-	dev->freecount[block] = dev->availSectPerBlk - prerelease;
-	dev->releasecount[block] = prerelease;
-#endif
+/****************************************************************************
+ * Name: smart_blkindex_build
+ *
+ * Description:  Computes the whole block index from the free and release
+ *               counts, after they were set up by a scan or a format.
+ *
+ ****************************************************************************/
 
-	verify_erased_block(dev, block);
+static void smart_blkindex_build(FAR struct smart_struct_s *dev)
+{
+	uint8_t which;
+	uint8_t level;
+	uint16_t node;
 
-#ifdef CONFIG_SMART_LOCAL_CHECKFREE
-	if (smart_checkfree(dev, __LINE__) != OK) {
-		fdbg("   ...while relocating block %d, free=%d, release=%d, oldrelease=%d\n", block, freecount, releasecount, oldrelease);
+	if (dev->blkindex == NULL) {
+		return;
 	}
-#endif
 
-	/* Test if this erase causes the block to reach the full relocate
-	 * threshold requiring static data relocation.
-	 */
+	for (which = 0; which < SMART_BLKINDEX_NTREES; which++) {
+		for (level = 0; level < dev->blkindexlevels; level++) {
+			for (node = 0; node < dev->blkindexlevel[level + 1] - dev->blkindexlevel[level]; node++) {
+				dev->blkindex[which * dev->blkindexnodes + dev->blkindexlevel[level] + node] = smart_blkindex_node(dev, which, level, node);
+			}
+		}
+	}
 
-#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
-	smart_relocate_static_data(dev, block);
-#endif
+	dev->blkindexvalid = true;
+}
 
-	return OK;
+/****************************************************************************
+ * Name: smart_blkindex_update
+ *
+ * Description:  Updates the path from an erase block to the roots after
+ *               its free or release count or its wear level changed.
+ *
+ ****************************************************************************/
 
-errout:
-	/* Restore the block's freecount if error. */
+static void smart_blkindex_update(FAR struct smart_struct_s *dev, uint16_t block)
+{
+	FAR uint16_t *entry;
+	uint16_t node;
+	uint16_t value;
+	uint8_t which;
+	uint8_t level;
+
+	if (!dev->blkindexvalid) {
+		return;
+	}
+
+	for (which = 0; which < SMART_BLKINDEX_NTREES; which++) {
+		node = block;
+		for (level = 0; level < dev->blkindexlevels; level++) {
+			node /= SMART_BLKINDEX_FANOUT;
+			value = smart_blkindex_node(dev, which, level, node);
+			entry = &dev->blkindex[which * dev->blkindexnodes + dev->blkindexlevel[level] + node];
+			if (*entry == value) {
+				break;
+			}
 
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-	smart_set_count(dev, dev->freecount, block, freecount);
-#else
-	dev->freecount[block] = freecount;
-	fdbg("Freecount is RESTORED!! to %d\n", freecount);
-#endif
-	return ret;
+			*entry = value;
+		}
+	}
 }
 
-static void print_sector_headers(FAR struct smart_struct_s *dev, int targetblock)
+/****************************************************************************
+ * Name: smart_blkindex_select
+ *
+ * Description:  Returns the unworn erase block with the most free or
+ *               released sectors, or 0xFFFF if there is none.
+ *
+ ****************************************************************************/
+
+static uint16_t smart_blkindex_select(FAR struct smart_struct_s *dev, uint8_t which)
 {
-	int ret;
-	int block;
-	int sector;
-	uint32_t readaddr;
-	struct smart_sect_header_s header;
-	for (block = 0; block < dev->neraseblocks; block++) {
-		if (targetblock < 0 || (targetblock >= 0 && block == targetblock)) {
-			printf("block (%d), freecount = %d\t", block, dev->freecount[block]);
-			for (sector = block * dev->sectorsPerBlk; sector < block * dev->sectorsPerBlk + dev->availSectPerBlk; sector++) {
-				readaddr = sector * dev->mtdBlksPerSector * dev->geo.blocksize;
-				ret = MTD_READ(dev->mtd, readaddr, sizeof(struct smart_sect_header_s), (FAR uint8_t *)&header);
-				if (ret != sizeof(struct smart_sect_header_s)) {
-					fdbg("Error reading phys sector %d\n", sector);
-					return;
-				}
-				printf("%d status : %d (%d, %d)\t", sector, header.status, SECTOR_IS_COMMITTED(header), SECTOR_IS_RELEASED(header));
-			}
-			printf("\n");
+	FAR uint16_t *tree = &dev->blkindex[which * dev->blkindexnodes];
+	uint32_t first;
+	uint32_t last;
+	uint32_t x;
+	uint16_t max;
+	uint16_t node = 0;
+	uint8_t level = dev->blkindexlevels - 1;
+
+	max = tree[dev->blkindexlevel[level]];
+	if (max == 0) {
+		return 0xFFFF;
+	}
+
+	/* Follow the children holding the maximum down to the erase block. */
+
+	while (level-- > 0) {
+		first = (uint32_t)node * SMART_BLKINDEX_FANOUT;
+		last = first + SMART_BLKINDEX_FANOUT;
+		if (last > (uint32_t)(dev->blkindexlevel[level + 1] - dev->blkindexlevel[level])) {
+			last = (uint32_t)(dev->blkindexlevel[level + 1] - dev->blkindexlevel[level]);
+		}
+		for (x = first; x < last && tree[dev->blkindexlevel[level] + x] != max; x++) ;
+		if (x == last) {
+			goto errout;
 		}
+
+		node = x;
 	}
+
+	first = (uint32_t)node * SMART_BLKINDEX_FANOUT;
+	last = first + SMART_BLKINDEX_FANOUT;
+	if (last > dev->neraseblocks) {
+		last = dev->neraseblocks;
+	}
+	for (x = first; x < last && smart_blkindex_key(dev, which, x) != max; x++) ;
+	if (x < last) {
+		return x;
+	}
+
+errout:
+	/* A count was changed without updating the index.  Stop using it. */
+
+	fdbg("Program bug!  Block index out of date\n");
+	dev->blkindexvalid = false;
+	return 0xFFFF;
 }
+#endif							/* CONFIG_MTD_SMART_BLOCK_INDEX */
 
 /****************************************************************************
  * Name: smart_findfreephyssector
@@ -3489,6 +4398,7 @@ static uint16_t smart_findfreephyssector(FAR struct smart_struct_s *dev, uint8_t
 #endif
 	uint16_t physicalsector;
 	uint16_t x, block;
+	uint16_t firstsector;
 	uint32_t readaddr;
 	struct smart_sect_header_s header;
 	int ret;
@@ -3514,6 +4424,19 @@ retry:
 		dev->lastallocblock = 0;
 	}
 
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	/* Take the best unworn block from the index.  The blocks are only
+	 * scanned when all blocks with free sectors are worn.
+	 */
+
+	if (dev->blkindexvalid) {
+		allocblock = smart_blkindex_select(dev, SMART_BLKINDEX_FREE);
+		if (allocblock != 0xFFFF) {
+			goto found;
+		}
+	}
+#endif
+
 	block = dev->lastallocblock;
 	for (x = 0; x < dev->neraseblocks; x++) {
 		/* Test if this block has more free blocks than the
@@ -3618,6 +4541,9 @@ retry:
 		}
 	}
 
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+found:
+#endif
 	/* Now find a free physical sector within this selected
 	 * erase block to allocate. */
 	sector_buff = (uint8_t *)kmm_zalloc(dev->mtdBlksPerSector * dev->geo.blocksize);
@@ -3626,7 +4552,25 @@ retry:
 		return physicalsector;
 	}
 
-	for (x = allocblock * dev->sectorsPerBlk; x < allocblock * dev->sectorsPerBlk + dev->availSectPerBlk; x++) {
+	firstsector = allocblock * dev->sectorsPerBlk;
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	/* Sectors of an erase block are allocated in order, so the free ones
+	 * normally follow the used ones.  Start there and only go back to the
+	 * beginning of the block if nothing is found.
+	 */
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+	count = smart_get_count(dev, dev->freecount, allocblock);
+#else
+	count = dev->freecount[allocblock];
+#endif
+	if (count < dev->availSectPerBlk) {
+		firstsector += dev->availSectPerBlk - count;
+	}
+
+rescan:
+#endif
+	for (x = firstsector; x < allocblock * dev->sectorsPerBlk + dev->availSectPerBlk; x++) {
 		/* Check if this physical sector is available. */
 
 #ifdef CONFIG_MTD_SMART_ENABLE_CRC
@@ -3712,6 +4656,7 @@ retry:
 						dev->freecount[allocblock]--;
 						dev->releasecount[allocblock]++;
 #endif
+						SMART_BLKINDEX_UPDATE(dev, allocblock);
 						dev->freesectors--;
 						dev->releasesectors++;
 						fvdbg("Block %d freecount[%d] = %d\n", allocblock, x / dev->sectorsPerBlk, dev->freecount[x / dev->sectorsPerBlk]);
@@ -3725,6 +4670,13 @@ retry:
 		}
 	}
 
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	if (physicalsector == 0xFFFF && firstsector != allocblock * dev->sectorsPerBlk) {
+		firstsector = allocblock * dev->sectorsPerBlk;
+		goto rescan;
+	}
+#endif
+
 error:
 	if (physicalsector == 0xFFFF || physicalsector >= dev->totalsectors) {
 		if (bitflipped) {
@@ -3754,6 +4706,63 @@ error:
 	return physicalsector;
 }
 
+/****************************************************************************
+ * Name: smart_find_collectblock
+ *
+ * Description:  Finds the erase block with the most released sectors,
+ *               skipping the blocks that have been worn completely.
+ *               Returns 0xFFFF if no block has released sectors.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_WRITABLE
+static uint16_t smart_find_collectblock(FAR struct smart_struct_s *dev)
+{
+	uint16_t collectblock;
+	uint16_t releasemax;
+	int x;
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+	uint8_t count;
+#endif
+
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	if (dev->blkindexvalid) {
+		collectblock = smart_blkindex_select(dev, SMART_BLKINDEX_RELEASE);
+		if (collectblock != 0xFFFF || dev->blkindexvalid) {
+			return collectblock;
+		}
+	}
+#endif
+
+	collectblock = 0xFFFF;
+	releasemax = 0;
+	for (x = 0; x < dev->neraseblocks; x++) {
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+		/* Don't collect blocks that have been worn completely. */
+
+		if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD) {
+			continue;
+		}
+#endif
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+		count = smart_get_count(dev, dev->releasecount, x);
+		if (count > releasemax) {
+			releasemax = count;
+			collectblock = x;
+		}
+#else
+		if (dev->releasecount[x] > releasemax) {
+			releasemax = dev->releasecount[x];
+			collectblock = x;
+		}
+#endif
+	}
+
+	return collectblock;
+}
+#endif
+
 /****************************************************************************
  * Name: smart_garbagecollect
  *
@@ -3767,13 +4776,8 @@ error:
 static int smart_garbagecollect(FAR struct smart_struct_s *dev)
 {
 	uint16_t collectblock;
-	uint16_t releasemax;
 	bool collect = TRUE;
-	int x;
 	int ret;
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-	uint8_t count;
-#endif
 
 	while (collect) {
 		collect = FALSE;
@@ -3797,32 +4801,7 @@ static int smart_garbagecollect(FAR struct smart_struct_s *dev)
 		if (collect) {
 			/* Find the block with the most released sectors. */
 
-			collectblock = 0xFFFF;
-			releasemax = 0;
-			for (x = 0; x < dev->neraseblocks; x++) {
-#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
-				/* Don't collect blocks that have been worn completely. */
-
-				if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD) {
-					continue;
-				}
-#endif
-
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-				count = smart_get_count(dev, dev->releasecount, x);
-				if (count > releasemax) {
-					releasemax = count;
-					collectblock = x;
-				}
-#else
-				if (dev->releasecount[x] > releasemax) {
-					releasemax = dev->releasecount[x];
-					collectblock = x;
-				}
-#endif
-			}
-			//releasemax = smart_get_count(dev, dev->releasecount, collectblock);
-
+			collectblock = smart_find_collectblock(dev);
 			if (collectblock == 0xFFFF) {
 				/* Need to collect, but no sectors with released blocks! */
 
@@ -4148,7 +5127,12 @@ static int smart_write_alloc_sector(FAR struct smart_struct_s *dev, uint16_t log
 #ifndef CONFIG_MTD_SMART_ENABLE_CRC
 	header->crc8 = smart_calc_sector_crc(dev);
 	fvdbg("Write MTD block ALLOCATION!!! Logical %d -> Physical %d\n", logical, physical);
+	SMART_CP_TOUCH(dev, (off_t)physical * dev->sectorsize, dev->sectorsize);
 	ret = MTD_BWRITE(dev->mtd, physical * dev->mtdBlksPerSector, 1, (FAR uint8_t *)dev->rwbuffer);
+
+	/* Only the header is programmed, the rest of the block stays erased */
+
+	SMART_COUNT_PROGRAM(dev, sizeof(struct smart_sect_header_s));
 	if (ret != 1) {
 		/* The block is not empty!!  What to do? */
 
@@ -4517,7 +5501,9 @@ relocate_good_sector:
 	if (needsrelocate) {
 		/* Write the entire sector to the new physical location, uncommitted. */
 
+		SMART_CP_TOUCH(dev, (off_t)physsector * dev->sectorsize, dev->sectorsize);
 		ret = MTD_BWRITE(dev->mtd, physsector * dev->mtdBlksPerSector, dev->mtdBlksPerSector, (FAR uint8_t *)dev->rwbuffer);
+		SMART_COUNT_PROGRAM(dev, dev->sectorsize);
 		if (ret != dev->mtdBlksPerSector) {
 			fdbg("Error writing to physical sector %d\n", physsector);
 			ret = -EIO;
@@ -4591,6 +5577,8 @@ relocate_good_sector:
 			dev->releasecount[oldblock]++;
 			dev->freecount[newblock]--;
 #endif
+			SMART_BLKINDEX_UPDATE(dev, oldblock);
+			SMART_BLKINDEX_UPDATE(dev, newblock);
 			dev->freesectors--;
 			dev->releasesectors++;
 			fvdbg("line %d, Decreased freecount %d (Block %d)\n",	__LINE__, dev->freecount[newblock], newblock);
@@ -4623,7 +5611,9 @@ relocate_good_sector:
 #ifdef CONFIG_MTD_SMART_ENABLE_CRC
 		/* Write the entire sector to FLASH when CRC enabled. */
 
+		SMART_CP_TOUCH(dev, (off_t)physsector * dev->sectorsize, dev->sectorsize);
 		ret = MTD_BWRITE(dev->mtd, physsector * dev->mtdBlksPerSector, dev->mtdBlksPerSector, (FAR uint8_t *)dev->rwbuffer);
+		SMART_COUNT_PROGRAM(dev, dev->sectorsize);
 		if (ret != dev->mtdBlksPerSector) {
 			fdbg("Error writing to physical sector %d\n", physsector);
 			ret = -EIO;
@@ -4713,6 +5703,7 @@ errout:
 		dev->releasecount[block]++;
 		dev->freecount[physsector / dev->sectorsPerBlk]--;
 #endif
+		SMART_BLKINDEX_UPDATE(dev, block);
 		dev->freesectors--;
 		dev->releasesectors++;
 
@@ -5090,6 +6081,7 @@ static int smart_allocsector(FAR struct smart_struct_s *dev, unsigned long reque
 #else
 		dev->freecount[allocblock]--;
 #endif
+		SMART_BLKINDEX_UPDATE(dev, allocblock);
 		dev->freesectors--;
 		fvdbg("Decrease freecount %d (block %d)\n", dev->freecount[allocblock], allocblock);
 	}
@@ -5184,6 +6176,7 @@ static inline int smart_freesector(FAR struct smart_struct_s *dev, unsigned long
 #else
 	dev->releasecount[block]++;
 #endif
+	SMART_BLKINDEX_UPDATE(dev, block);
 
 	/* Unmap this logical sector. */
 
@@ -5204,6 +6197,119 @@ errout:
 }
 #endif							/* CONFIG_FS_WRITABLE */
 
+/****************************************************************************
+ * Name: smart_gc_worker
+ *
+ * Description:  Collects one erase block in the background once the device
+ *               has been idle long enough, and queues itself again until
+ *               the stop watermark is reached.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_BGGC
+static void smart_gc_worker(FAR void *arg)
+{
+	FAR struct smart_struct_s *dev = (FAR struct smart_struct_s *)arg;
+	clock_t delay;
+	clock_t idle;
+	uint16_t block;
+	uint16_t freecount;
+	uint16_t releasecount;
+	uint16_t livecount;
+
+	smart_semtake(dev);
+
+	/* Wait until the file system leaves the device alone for long enough. */
+
+	delay = MSEC2TICK(dev->gcwatermark.idlems);
+	idle = clock_systimer() - dev->gclastaccess;
+	if (idle < delay) {
+		(void)work_queue(LPWORK, &dev->gcwork, smart_gc_worker, dev, delay - idle);
+		goto out;
+	}
+
+	if ((uint32_t)dev->freesectors * 100 >= (uint32_t)dev->totalsectors * dev->gcwatermark.stop) {
+		goto out;
+	}
+
+	block = smart_find_collectblock(dev);
+	if (block == 0xFFFF) {
+		goto out;
+	}
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+	freecount = smart_get_count(dev, dev->freecount, block);
+	releasecount = smart_get_count(dev, dev->releasecount, block);
+#else
+	freecount = dev->freecount[block];
+	releasecount = dev->releasecount[block];
+#endif
+
+	/* Leave blocks with few released sectors, and the last free sectors,
+	 * to the collection done by writes.
+	 */
+
+	livecount = dev->availSectPerBlk - freecount - releasecount;
+	if ((uint32_t)releasecount * 100 < (uint32_t)dev->availSectPerBlk * dev->gcwatermark.minreleased || dev->freesectors <= freecount + livecount + dev->sectorsPerBlk + 4) {
+		goto out;
+	}
+
+	fvdbg("Collecting block %d, free=%d released=%d\n", block, freecount, releasecount);
+	if (smart_relocate_block(dev, block) != OK) {
+		fdbg("Error collecting block %d\n", block);
+		goto out;
+	}
+
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+	if (dev->wearflags & SMART_WEARFLAGS_WRITE_NEEDED) {
+		smart_write_wearstatus(dev);
+	}
+#endif
+
+	/* Continue with the next block, unless the file system needs the device. */
+
+	(void)work_queue(LPWORK, &dev->gcwork, smart_gc_worker, dev, 0);
+
+out:
+	smart_semgive(dev);
+}
+
+/****************************************************************************
+ * Name: smart_gc_kick
+ *
+ * Description:  Records an access by the file system and schedules the
+ *               background garbage collection when free sectors run low.
+ *
+ ****************************************************************************/
+
+static void smart_gc_kick(FAR struct smart_struct_s *dev)
+{
+	dev->gclastaccess = clock_systimer();
+
+	if (work_available(&dev->gcwork) && dev->formatstatus == SMART_FMT_STAT_FORMATTED && dev->releasesectors > 0 && (uint32_t)dev->freesectors * 100 < (uint32_t)dev->totalsectors * dev->gcwatermark.start) {
+		(void)work_queue(LPWORK, &dev->gcwork, smart_gc_worker, dev, MSEC2TICK(dev->gcwatermark.idlems));
+	}
+}
+
+/****************************************************************************
+ * Name: smart_gc_setwatermark
+ *
+ * Description:  Validates and sets the watermarks of the background
+ *               garbage collection.
+ *
+ ****************************************************************************/
+
+static int smart_gc_setwatermark(FAR struct smart_struct_s *dev, FAR const struct smart_gc_watermark_s *watermark)
+{
+	if (watermark == NULL || watermark->start > watermark->stop || watermark->stop > 100 || watermark->minreleased == 0 || watermark->minreleased > 100) {
+		return -EINVAL;
+	}
+
+	memcpy(&dev->gcwatermark, watermark, sizeof(struct smart_gc_watermark_s));
+	return OK;
+}
+#endif							/* CONFIG_MTD_SMART_BGGC */
+
 /****************************************************************************
  * Name: smart_ioctl
  *
@@ -5228,6 +6334,8 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 	dev = (FAR struct smart_struct_s *)inode->i_private;
 #endif
 
+	smart_semtake(dev);
+
 	/* Process the ioctl's we care about first, pass any we don't respond
 	 * to directly to the underlying MTD device.
 	 */
@@ -5242,7 +6350,8 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 #ifdef CONFIG_DEBUG
 		if (arg == 0) {
 			fdbg("ERROR: BIOC_XIPBASE argument is NULL\n");
-			return -EINVAL;
+			ret = -EINVAL;
+			goto ok_out;
 		}
 #endif
 
@@ -5327,6 +6436,7 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 		procfs_data->unusedsectors = dev->unusedsectors;
 		procfs_data->blockerases = dev->blockerases;
 		procfs_data->sectorsperblk = dev->sectorsPerBlk;
+		procfs_data->programbytes = dev->programbytes;
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
 		procfs_data->formatsector = dev->sMap[0];
@@ -5351,6 +6461,23 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 		goto ok_out;
 #endif
 
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	case BIOC_FLUSH:
+		ret = smart_checkpoint_write(dev);
+		goto ok_out;
+#endif
+
+#ifdef CONFIG_MTD_SMART_BGGC
+	case BIOC_GETGCWATERMARK:
+		memcpy((FAR struct smart_gc_watermark_s *)arg, &dev->gcwatermark, sizeof(struct smart_gc_watermark_s));
+		ret = OK;
+		goto ok_out;
+
+	case BIOC_SETGCWATERMARK:
+		ret = smart_gc_setwatermark(dev, (FAR const struct smart_gc_watermark_s *)arg);
+		goto ok_out;
+#endif
+
 	case BIOC_DEBUGCMD:
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
 		debug_data = (FAR struct mtd_smart_debug_data_s *)arg;
@@ -5379,6 +6506,8 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 	}
 
 ok_out:
+	smart_gc_kick(dev);
+	smart_semgive(dev);
 	return ret;
 }
 
@@ -5429,6 +6558,18 @@ int smart_initialize(int minor, FAR struct mtd_dev_s *mtd, FAR const char *partn
 		/* Initialize the SMART device structure. */
 
 		dev->mtd = mtd;
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+		dev->cpdirty = NULL;
+#endif
+#ifdef CONFIG_MTD_SMART_BGGC
+		sem_init(&dev->exclsem, 0, 1);
+		memset(&dev->gcwork, 0, sizeof(struct work_s));
+		dev->gcwatermark.start = CONFIG_MTD_SMART_BGGC_START;
+		dev->gcwatermark.stop = CONFIG_MTD_SMART_BGGC_STOP;
+		dev->gcwatermark.minreleased = CONFIG_MTD_SMART_BGGC_MIN_RELEASED;
+		dev->gcwatermark.idlems = CONFIG_MTD_SMART_BGGC_IDLE_MS;
+		dev->gclastaccess = 0;
+#endif
 #ifdef CONFIG_MTD_SMART_ALLOC_DEBUG
 		dev->bytesalloc = 0;
 		for (totalsectors = 0; totalsectors < SMART_MAX_ALLOCS; totalsectors++) {
@@ -5449,6 +6590,10 @@ int smart_initialize(int minor, FAR struct mtd_dev_s *mtd, FAR const char *partn
 			goto errout;
 		}
 
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+		smart_checkpoint_reserve(dev);
+#endif
+
 		/* Set the sector size to the default for now. */
 
 #ifdef CONFIG_SMARTFS_BAD_SECTOR
@@ -5472,6 +6617,9 @@ int smart_initialize(int minor, FAR struct mtd_dev_s *mtd, FAR const char *partn
 #endif
 #ifdef CONFIG_MTD_SMART_ENABLE_CRC
 		dev->allocsector = NULL;
+#endif
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+		dev->blkindex = NULL;
 #endif
 		dev->sectorsize = 0;
 		ret = smart_setsectorsize(dev, CONFIG_MTD_SMART_SECTOR_SIZE);
@@ -5481,6 +6629,17 @@ int smart_initialize(int minor, FAR struct mtd_dev_s *mtd, FAR const char *partn
 			goto errout;
 		}
 
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+		if (dev->cpslotblocks > 0) {
+			dev->cpdirty = (FAR uint8_t *)smart_malloc(dev, (dev->neraseblocks + 7) >> 3, "Checkpoint log");
+			if (dev->cpdirty == NULL) {
+				ret = -ENOMEM;
+				goto errout;
+			}
+			memset(dev->cpdirty, 0, (dev->neraseblocks + 7) >> 3);
+		}
+#endif
+
 		/* Calculate the totalsectors on this device and validate. */
 
 		totalsectors = dev->neraseblocks * dev->sectorsPerBlk;
@@ -5586,6 +6745,19 @@ errout:
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
 	smart_free(dev, dev->erasecounts);
 #endif
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	if (dev->cpdirty != NULL) {
+		smart_free(dev, dev->cpdirty);
+	}
+#endif
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	if (dev->blkindex != NULL) {
+		smart_free(dev, dev->blkindex);
+	}
+#endif
+#ifdef CONFIG_MTD_SMART_BGGC
+	sem_destroy(&dev->exclsem);
+#endif
 #ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
 	if (rootdirdev) {
 		smart_free(dev, rootdirdev);
@@ -5711,6 +6883,7 @@ int smart_recoversectors(FAR struct inode *inode, char *validsectors, int *nobso
 #else
 			dev->releasecount[block]++;
 #endif
+			SMART_BLKINDEX_UPDATE(dev, block);
 
 			/* if the mapping is sane, Unmap this logical->physicalsector map. */
 			if (physsector == sector) {
@@ -66,6 +66,9 @@
 
 #include <tinyara/fs/mtd.h>
 #include <tinyara/fs/smart.h>
+#ifdef CONFIG_SMARTFS_WRITEBACK_TIMEOUT_MS
+#include <tinyara/wqueue.h>
+#endif
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -232,9 +235,12 @@
 #define UINT8_TO_UINT16(UINT8_ARRAY)                    ((uint16_t)(((uint16_t)UINT8_ARRAY[1] << 8) & 0xFF00) | UINT8_ARRAY[0])
 #define SMARTFS_NEXTSECTOR(h)   (UINT8_TO_UINT16(h->nextsector))
 #define SMARTFS_USED(h)                 (UINT8_TO_UINT16(h->used))
-#ifdef CONFIG_MTD_SMART_ENABLE_CRC
+#if defined(CONFIG_MTD_SMART_ENABLE_CRC) || defined(CONFIG_SMARTFS_WRITEBACK_CACHE)
 #define CONFIG_SMARTFS_USE_SECTOR_BUFFER
 #endif
+#if defined(CONFIG_SMARTFS_WRITEBACK_TIMEOUT_MS) && CONFIG_SMARTFS_WRITEBACK_TIMEOUT_MS > 0
+#define SMARTFS_WRITEBACK_TIMEOUT
+#endif
 #ifdef CONFIG_SMARTFS_BAD_SECTOR
 #define SMARTFS_BSM_LOG_SECTOR_NUMBER   11
 #endif
@@ -335,6 +341,20 @@ struct smartfs_chain_header_s {
 };
 #endif
 
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+/* This structure records where a directory entry was last found.  It is
+ * only a hint: the entry is checked against the directory sector each
+ * time it is used.
+ */
+
+struct smartfs_dcache_s {
+	uint32_t hash;				/* Hash of the entry name */
+	uint16_t parent;			/* First sector of the parent directory */
+	uint16_t dsector;			/* Sector holding the entry, 0 if unused */
+	uint16_t doffset;			/* Offset of the entry in dsector */
+};
+#endif
+
 /* This structure describes the state of one open file.  This structure
  * is protected by the volume semaphore.
  */
@@ -344,6 +364,7 @@ struct smartfs_ofile_s {
 #ifdef CONFIG_SMARTFS_USE_SECTOR_BUFFER
 	uint8_t *buffer;			/* Sector buffer to reduce writes */
 	uint8_t bflags;				/* Buffer flags */
+	uint16_t bsector;			/* Logical sector held in the buffer */
 #endif
 	int16_t crefs;				/* Reference count */
 	mode_t oflags;				/* Open mode */
@@ -381,6 +402,17 @@ struct smartfs_mountpt_s {
 #endif
 #ifdef CONFIG_SMARTFS_JOURNALING
 	struct journal_transaction_manager_s *journal;
+#endif
+#ifdef SMARTFS_WRITEBACK_TIMEOUT
+	struct work_s fs_flushwork;	/* Writes back the sector buffers of open files */
+	uint8_t fs_flushcount;		/* Write-back works queued or running */
+#endif
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+	struct smartfs_dcache_s fs_dcache[CONFIG_SMARTFS_DENTRY_CACHE_SIZE];
+#endif
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
+	uint32_t fs_writebytes;		/* Bytes written to files since the mount */
+	uint32_t fs_programbase;	/* Bytes programmed by the device before the mount */
 #endif
 	uint8_t fs_rootsector;		/* Root directory sector num */
 };
@@ -515,6 +547,10 @@ int smartfs_countdirentries(struct smartfs_mountpt_s *fs, struct smartfs_entry_s
 
 int smartfs_truncatefile(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *entry, FAR struct smartfs_ofile_s *sf);
 
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+void smartfs_dcache_invalidate(struct smartfs_mountpt_s *fs, uint16_t dsector);
+#endif
+
 uint16_t smartfs_rdle16(FAR const void *val);
 
 void smartfs_wrle16(void *dest, uint16_t val);
@@ -734,6 +734,8 @@ static size_t smartfs_status_read(FAR struct file *filep, FAR char *buffer, size
 	FAR struct smartfs_file_s *priv;
 	int ret;
 	size_t len;
+	uint32_t programbytes;
+	uint32_t amplification;
 #ifdef CONFIG_DEBUG_FS
 	int utilization;
 #endif
@@ -752,6 +754,21 @@ static size_t smartfs_status_read(FAR struct file *filep, FAR char *buffer, size
 		if (ret == OK) {
 			/* Format and return data in the buffer */
 			len = snprintf(buffer, buflen, "Total Sectors    %d\nFree Sectors     %d\n" "Released Sectors %d\n", procfs_data.totalsectors, procfs_data.freesectors, procfs_data.releasesectors);
+
+			/* Report the bytes programmed to the FLASH for each byte written
+			 * to files since the mount, in hundredths.
+			 */
+
+			programbytes = procfs_data.programbytes - priv->level1.mount->fs_programbase;
+			if (priv->level1.mount->fs_writebytes == 0) {
+				amplification = 0;
+			} else {
+				amplification = (uint32_t)((uint64_t)programbytes * 100 / priv->level1.mount->fs_writebytes);
+			}
+
+			if (len < buflen) {
+				len += snprintf(&buffer[len], buflen - len, "Bytes Written    %u\nBytes Programmed %u\n" "Write Amplif.    %u.%02u\n", (unsigned int)priv->level1.mount->fs_writebytes, (unsigned int)programbytes, (unsigned int)(amplification / 100), (unsigned int)(amplification % 100));
+			}
 #ifdef CONFIG_DEBUG_FS
 			/* Calculate the sector utilization percentage */
 			if (procfs_data.blockerases == 0) {
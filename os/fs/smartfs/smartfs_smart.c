@@ -75,6 +75,12 @@
 #include <tinyara/fs/ioctl.h>
 #include <tinyara/fs/mtd.h>
 #include <tinyara/fs/smart.h>
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
+#include <tinyara/fs/smart_procfs.h>
+#endif
+#ifdef CONFIG_SMARTFS_WRITEBACK_TIMEOUT_MS
+#include <tinyara/clock.h>
+#endif
 
 #include "smartfs.h"
 
@@ -117,6 +123,9 @@ static void smartfs_stat_common(FAR struct smartfs_mountpt_s *fs, FAR struct sma
 static int smartfs_stat(struct inode *mountpt, const char *relpath, struct stat *buf);
 
 static off_t smartfs_seek_internal(struct smartfs_mountpt_s *fs, struct smartfs_ofile_s *sf, off_t offset, int whence);
+#ifdef SMARTFS_WRITEBACK_TIMEOUT
+static void smartfs_writeback_worker(FAR void *arg);
+#endif
 
 /****************************************************************************
  * Private Variables
@@ -222,6 +231,7 @@ static int smartfs_open(FAR struct file *filep, const char *relpath, int oflags,
 	}
 
 	sf->bflags = 0;
+	sf->bsector = SMARTFS_ERASEDSTATE_16BIT;
 #endif							/* CONFIG_SMARTFS_USE_SECTOR_BUFFER */
 
 	sf->entry.name = NULL;
@@ -609,18 +619,18 @@ static int smartfs_sync_internal(struct smartfs_mountpt_s *fs, struct smartfs_of
 
 		header = (struct smartfs_chain_header_s *)sf->buffer;
 #ifdef CONFIG_SMARTFS_DYNAMIC_HEADER
-		used_value = get_leftover_used_byte_count((uint8_t *)sf.buffer, get_used_byte_count((uint8_t *)header->used));
+		used_value = get_leftover_used_byte_count((uint8_t *)sf->buffer, get_used_byte_count((uint8_t *)header->used));
 		if (used_value == 0) {
 			set_used_byte_count((uint8_t *)header->used, sf->byteswritten);
 #else
-		if (header->used[0] == CONFIG_SMARTFS_ERASEDSTATE) {
-			*((uint16_t *)header->used) = sf->byteswritten;
+		if (SMARTFS_USED(header) == SMARTFS_ERASEDSTATE_16BIT) {
+			smartfs_wrle16(header->used, sf->byteswritten);
 #endif
 		} else {
 #ifdef CONFIG_SMARTFS_DYNAMIC_HEADER
 			set_used_byte_count((uint8_t *)header->used, used_value + sf->byteswritten);
 #else
-			*((uint16_t *)header->used) += sf->byteswritten;
+			smartfs_wrle16(header->used, SMARTFS_USED(header) + sf->byteswritten);
 #endif
 		}
 
@@ -712,6 +722,38 @@ errout:
 	return ret;
 }
 
+/****************************************************************************
+ * Name: smartfs_writeback_worker
+ *
+ * Description: Write the sector buffers of all open files on the volume
+ *   back to the device.  Runs on the low priority work queue when data has
+ *   been in a buffer for CONFIG_SMARTFS_WRITEBACK_TIMEOUT_MS.
+ *
+ ****************************************************************************/
+
+#ifdef SMARTFS_WRITEBACK_TIMEOUT
+static void smartfs_writeback_worker(FAR void *arg)
+{
+	struct smartfs_mountpt_s *fs = (struct smartfs_mountpt_s *)arg;
+	struct smartfs_ofile_s *sf;
+
+	smartfs_semtake(fs);
+
+	for (sf = fs->fs_head; sf != NULL; sf = sf->fnext) {
+		if (sf->bflags & SMARTFS_BFLAG_DIRTY) {
+			(void)smartfs_sync_internal(fs, sf);
+		}
+	}
+
+	/* This is the last access to the mount, smartfs_unbind() may free it
+	 * as soon as the semaphore is given.
+	 */
+
+	fs->fs_flushcount--;
+	smartfs_semgive(fs);
+}
+#endif
+
 /****************************************************************************
  * Name: smartfs_write
  ****************************************************************************/
@@ -822,6 +864,14 @@ static ssize_t smartfs_write(FAR struct file *filep, const char *buffer, size_t
 				fdbg("Error %d writing sector %d data\n", ret, sf->currsector);
 				goto errout_with_semaphore;
 			}
+#ifdef CONFIG_SMARTFS_USE_SECTOR_BUFFER
+
+			/* Keep the buffered copy of the sector up to date */
+
+			if (readwrite.logsector == sf->bsector) {
+				memcpy(&sf->buffer[readwrite.offset], readwrite.buffer, readwrite.count);
+			}
+#endif
 
 			/* Update our control variables */
 
@@ -863,6 +913,24 @@ static ssize_t smartfs_write(FAR struct file *filep, const char *buffer, size_t
 		 */
 
 #ifdef CONFIG_SMARTFS_USE_SECTOR_BUFFER
+		if (sf->bsector != sf->currsector) {
+			/* The buffer holds another sector, e.g. after writing over the
+			 * end of the previous one.  Read the current sector first.
+			 */
+
+			readwrite.logsector = sf->currsector;
+			readwrite.offset = 0;
+			readwrite.count = fs->fs_llformat.availbytes;
+			readwrite.buffer = sf->buffer;
+			ret = FS_IOCTL(fs, BIOC_READSECT, (unsigned long)&readwrite);
+			if (ret < 0) {
+				fdbg("Error %d reading sector %d data\n", ret, sf->currsector);
+				goto errout_with_semaphore;
+			}
+
+			sf->bsector = sf->currsector;
+		}
+
 		readwrite.count = fs->fs_llformat.availbytes - sf->curroffset;
 		if (readwrite.count > buflen) {
 			readwrite.count = buflen;
@@ -925,7 +993,7 @@ static ssize_t smartfs_write(FAR struct file *filep, const char *buffer, size_t
 			/* Copy the new sector to the old one and chain it */
 
 			header = (struct smartfs_chain_header_s *)sf->buffer;
-			*((uint16_t *)header->nextsector) = (uint16_t)ret;
+			smartfs_wrle16(header->nextsector, (uint16_t)ret);
 
 			/* Now sync the file to write this sector out */
 
@@ -946,6 +1014,7 @@ static ssize_t smartfs_write(FAR struct file *filep, const char *buffer, size_t
 
 			sf->bflags = SMARTFS_BFLAG_DIRTY;
 			sf->currsector = SMARTFS_NEXTSECTOR(header);
+			sf->bsector = sf->currsector;
 			sf->curroffset = sizeof(struct smartfs_chain_header_s);
 			memset(sf->buffer, CONFIG_SMARTFS_ERASEDSTATE, fs->fs_llformat.availbytes);
 			header->type = SMARTFS_DIRENT_TYPE_FILE;
@@ -1019,9 +1088,21 @@ static ssize_t smartfs_write(FAR struct file *filep, const char *buffer, size_t
 #endif							/* CONFIG_SMARTFS_USE_SECTOR_BUFFER */
 	}
 
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
+	fs->fs_writebytes += byteswritten;
+#endif
 	ret = byteswritten;
 
 errout_with_semaphore:
+#ifdef SMARTFS_WRITEBACK_TIMEOUT
+	/* Bound the time the written data stays only in the sector buffer */
+
+	if ((sf->bflags & SMARTFS_BFLAG_DIRTY) && work_available(&fs->fs_flushwork)) {
+		if (work_queue(LPWORK, &fs->fs_flushwork, smartfs_writeback_worker, fs, MSEC2TICK(CONFIG_SMARTFS_WRITEBACK_TIMEOUT_MS)) == OK) {
+			fs->fs_flushcount++;
+		}
+	}
+#endif
 	smartfs_semgive(fs);
 	return ret;
 }
@@ -1156,6 +1237,8 @@ static off_t smartfs_seek_internal(struct smartfs_mountpt_s *fs, struct smartfs_
 			fdbg("Error %d reading sector %d header\n", ret, sf->currsector);
 			goto errout;
 		}
+
+		sf->bsector = sf->currsector;
 	}
 #endif
 
@@ -1528,6 +1611,9 @@ static int smartfs_bind(FAR struct inode *blkdriver, const void *data, void **ha
 {
 	struct smartfs_mountpt_s *fs;
 	int ret;
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
+	struct mtd_smart_procfs_data_s procfs_data;
+#endif
 
 	/* Open the block driver */
 
@@ -1574,6 +1660,14 @@ static int smartfs_bind(FAR struct inode *blkdriver, const void *data, void **ha
 		goto error_with_semaphore;
 	}
 
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
+	/* The write amplification is reported from this mount on */
+
+	if (FS_IOCTL(fs, BIOC_GETPROCFSD, (unsigned long)&procfs_data) == OK) {
+		fs->fs_programbase = procfs_data.programbytes;
+	}
+#endif
+
 	*handle = (void *)fs;
 #ifdef CONFIG_SMARTFS_JOURNALING
 	ret = smartfs_journal_init(fs);
@@ -1627,6 +1721,29 @@ static int smartfs_unbind(void *handle, FAR struct inode **blkdriver)
 		smartfs_semgive(fs);
 		return -EBUSY;
 	}
+#ifdef SMARTFS_WRITEBACK_TIMEOUT
+	/* A queued write-back is just cancelled.  A worker which was already
+	 * taken from the queue may be waiting for the semaphore, so let it
+	 * finish before the mount is freed.
+	 */
+
+	if (work_cancel(LPWORK, &fs->fs_flushwork) == OK) {
+		fs->fs_flushcount--;
+	}
+
+	while (fs->fs_flushcount > 0) {
+		smartfs_semgive(fs);
+		usleep(USEC_PER_TICK);
+		smartfs_semtake(fs);
+	}
+
+	/* Files may have been opened while the semaphore was given */
+
+	if (fs->fs_head != NULL) {
+		smartfs_semgive(fs);
+		return -EBUSY;
+	}
+#endif
 	/* Unmount ... close the block driver */
 	ret = smartfs_unmount(fs);
 #ifdef CONFIG_SMARTFS_JOURNALING
@@ -2101,6 +2218,9 @@ int smartfs_rename(struct inode *mountpt, const char *oldrelpath, const char *ne
 
 		/* Now mark the old entry as inactive */
 
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+		smartfs_dcache_invalidate(fs, oldentry.dsector);
+#endif
 		readwrite.logsector = oldentry.dsector;
 		readwrite.offset = 0;
 		readwrite.count = fs->fs_llformat.availbytes;
@@ -191,6 +191,80 @@ static uint8_t smartfs_calc_crc_data(struct journal_transaction_manager_s *j_mgr
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+/****************************************************************************
+ * Name: smartfs_dcache_hash
+ *
+ * Description: Computes the FNV-1a hash of the first namesize bytes of a
+ *              name, the part that is compared with directory entries.
+ *
+ ****************************************************************************/
+
+static uint32_t smartfs_dcache_hash(const char *name, uint16_t namesize)
+{
+	uint32_t hash = 2166136261u;
+
+	while (namesize-- > 0 && *name != '\0') {
+		hash ^= (uint8_t)*name++;
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_slot
+ *
+ * Description: Returns the cache slot for a name in a directory.
+ *
+ ****************************************************************************/
+
+static struct smartfs_dcache_s *smartfs_dcache_slot(struct smartfs_mountpt_s *fs, uint16_t parent, uint32_t hash)
+{
+	return &fs->fs_dcache[(hash ^ parent) % CONFIG_SMARTFS_DENTRY_CACHE_SIZE];
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_find
+ *
+ * Description: Returns the cache slot holding the location of a name in a
+ *              directory, or NULL if the name is not cached.
+ *
+ ****************************************************************************/
+
+static struct smartfs_dcache_s *smartfs_dcache_find(struct smartfs_mountpt_s *fs, uint16_t parent, uint32_t hash)
+{
+	struct smartfs_dcache_s *dcache;
+
+	dcache = smartfs_dcache_slot(fs, parent, hash);
+	if (dcache->dsector == 0 || dcache->parent != parent || dcache->hash != hash) {
+		return NULL;
+	}
+
+	return dcache;
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_insert
+ *
+ * Description: Records the location of a name in a directory, replacing
+ *              whatever the slot held before.
+ *
+ ****************************************************************************/
+
+static void smartfs_dcache_insert(struct smartfs_mountpt_s *fs, uint16_t parent, uint32_t hash, uint16_t dsector, uint16_t doffset)
+{
+	struct smartfs_dcache_s *dcache;
+
+	dcache = smartfs_dcache_slot(fs, parent, hash);
+	dcache->hash = hash;
+	dcache->parent = parent;
+	dcache->dsector = dsector;
+	dcache->doffset = doffset;
+}
+#endif
+
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -783,6 +857,10 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *d
 #ifdef CONFIG_SMARTFS_DYNAMIC_HEADER
 	int used_value;
 #endif
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+	struct smartfs_dcache_s *dcache;
+	uint32_t hash;
+#endif
 
 	/* Initialize directory level zero as the root sector */
 
@@ -855,6 +933,16 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *d
 
 			dirsector = dirstack[depth];
 
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+			/* Go straight to the sector the name was last found in */
+
+			hash = smartfs_dcache_hash(fs->fs_workbuffer, fs->fs_llformat.namesize);
+			dcache = smartfs_dcache_find(fs, dirstack[depth], hash);
+			if (dcache != NULL) {
+				dirsector = dcache->dsector;
+			}
+#endif
+
 			/* Read the directory */
 
 			offset = 0xFFFF;
@@ -884,6 +972,24 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *d
 				/* Search for the entry */
 
 				offset = sizeof(struct smartfs_chain_header_s);
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+				if (dcache != NULL) {
+					/* Only check the cached entry.  If it is not there
+					 * anymore, search the directory from its first sector.
+					 */
+
+					offset = dcache->doffset;
+					entry = (struct smartfs_entry_header_s *)&fs->fs_rwbuffer[offset];
+					if (offset + entrysize > readwrite.count || !(ENTRY_VALID(entry)) || strncmp(entry->name, fs->fs_workbuffer, fs->fs_llformat.namesize) != 0) {
+						dcache->dsector = 0;
+						dcache = NULL;
+						dirsector = dirstack[depth];
+						continue;
+					}
+
+					dcache = NULL;
+				}
+#endif
 				entry = (struct smartfs_entry_header_s *)&fs->fs_rwbuffer[offset];
 				while (offset < readwrite.count) {
 					/* Test if this entry is valid and active */
@@ -907,6 +1013,9 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *d
 						 * open it and continue searching.
 						 */
 
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+						smartfs_dcache_insert(fs, dirstack[depth], hash, readwrite.logsector, offset);
+#endif
 						if (*ptr == '\0') {
 							/* We are at the last segment.  Report the entry */
 
@@ -1234,6 +1343,7 @@ int smartfs_createentry(struct smartfs_mountpt_s *fs, uint16_t parentdirsector,
 			chainheader = (struct smartfs_chain_header_s *)sf->buffer;
 			chainheader->type = SMARTFS_SECTOR_TYPE_FILE;
 			sf->bflags = SMARTFS_BFLAG_DIRTY | SMARTFS_BFLAG_NEWALLOC;
+			sf->bsector = nextsector;
 		} else
 #endif
 		{
@@ -1283,6 +1393,10 @@ int smartfs_createentry(struct smartfs_mountpt_s *fs, uint16_t parentdirsector,
 		goto errout;
 	}
 
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+	smartfs_dcache_insert(fs, parentdirsector, smartfs_dcache_hash(filename, fs->fs_llformat.namesize), psector, offset);
+#endif
+
 	/* Now fill in the entry */
 
 	direntry->firstsector = nextsector;
@@ -1313,6 +1427,29 @@ errout:
 	return ret;
 }
 
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+/****************************************************************************
+ * Name: smartfs_dcache_invalidate
+ *
+ * Description: Drops all cached entries held in a directory sector.  This
+ *              must be called before an entry is marked inactive, so that
+ *              the sector can not be freed and reused by another directory
+ *              while the cache still points into it.
+ *
+ ****************************************************************************/
+
+void smartfs_dcache_invalidate(struct smartfs_mountpt_s *fs, uint16_t dsector)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_SMARTFS_DENTRY_CACHE_SIZE; i++) {
+		if (fs->fs_dcache[i].dsector == dsector) {
+			fs->fs_dcache[i].dsector = 0;
+		}
+	}
+}
+#endif
+
 /****************************************************************************
  * Name: smartfs_deleteentry
  *
@@ -1377,6 +1514,9 @@ int smartfs_deleteentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *en
 
 	/* Remove the entry from the directory tree */
 
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+	smartfs_dcache_invalidate(fs, entry->dsector);
+#endif
 	readwrite.logsector = entry->dsector;
 	readwrite.offset = 0;
 	readwrite.count = fs->fs_llformat.availbytes;
@@ -1685,6 +1825,7 @@ int smartfs_truncatefile(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *e
 		header = (struct smartfs_chain_header_s *)sf->buffer;
 		header->type = SMARTFS_SECTOR_TYPE_FILE;
 		sf->bflags = SMARTFS_BFLAG_DIRTY;
+		sf->bsector = entry->firstsector;
 		entry->datlen = 0;
 	}
 #endif
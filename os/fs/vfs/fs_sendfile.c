@@ -0,0 +1,82 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/sendfile.h>
+#include <errno.h>
+
+#include <tinyara/fs/fs.h>
+#include <tinyara/net/net.h>
+
+#if defined(CONFIG_NET_SENDFILE) && CONFIG_NFILE_DESCRIPTORS > 0
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sendfile
+ *
+ * Description:
+ *   sendfile() copies data between one file descriptor and another.  When
+ *   outfd is a socket that supports it, the file is handed to the network
+ *   stack which reads it straight into the buffers that are transmitted,
+ *   so the data is not copied through a user buffer.  Otherwise this falls
+ *   back to the read()/write() loop of lib_sendfile().
+ *
+ *   See lib_sendfile() for the description of the parameters.
+ *
+ * Returned Value:
+ *   If the transfer was successful, the number of bytes written to outfd is
+ *   returned.  On error, -1 is returned, and errno is set appropriately.
+ *
+ ****************************************************************************/
+
+ssize_t sendfile(int outfd, int infd, FAR off_t *offset, size_t count)
+{
+#if CONFIG_NSOCKET_DESCRIPTORS > 0
+	FAR struct file *filep;
+	ssize_t ret;
+	int errcode;
+
+	if ((unsigned int)outfd >= CONFIG_NFILE_DESCRIPTORS && (unsigned int)infd < CONFIG_NFILE_DESCRIPTORS) {
+		errcode = fs_getfilep(infd, &filep);
+		if (errcode < 0) {
+			set_errno(-errcode);
+			return ERROR;
+		}
+
+		ret = net_sendfile(outfd, filep, offset, count);
+		if (ret >= 0 || get_errno() != ENOSYS) {
+			return ret;
+		}
+
+		/* Not supported by this socket, fall back to copying */
+	}
+#endif
+
+	return lib_sendfile(outfd, infd, offset, count);
+}
+
+#endif							/* CONFIG_NET_SENDFILE && CONFIG_NFILE_DESCRIPTORS > 0 */
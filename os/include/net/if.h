@@ -286,6 +286,27 @@ struct netmon_netdev_stats {
 	u32_t devoutoctets;
 };
 #endif								/* CONFIG_NET_STATS */
+#ifdef CONFIG_NET_MEMP_STATS
+#define NETMON_MEMP_NAMELEN 16
+/* Memory pool usage. */
+struct netmon_memp_stats {
+	char name[NETMON_MEMP_NAMELEN];
+	u16_t size;						/* Size of one element */
+	u32_t avail;					/* Elements the pool holds now */
+	u32_t limit;					/* Elements the pool can grow to */
+	u32_t used;						/* Elements in use */
+	u32_t max;						/* Most elements ever in use */
+	u32_t err;						/* Failed allocations */
+};
+/* SIOCGMEMPSTATS argument. On input, npools is the number of entries in
+ * pools; on output it is the number of pools, of which only as many as
+ * fit were filled in.
+ */
+struct netmon_memp {
+	int npools;
+	struct netmon_memp_stats *pools;
+};
+#endif								/* CONFIG_NET_MEMP_STATS */
 #endif                              /* CONFIG_NET_NETMON */
 /*******************************************************************************************
  * Public Function Prototypes
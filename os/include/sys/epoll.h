@@ -0,0 +1,146 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/**
+ * @defgroup EPOLL_KERNEL EPOLL
+ * @brief Provides APIs for Epoll
+ * @ingroup KERNEL
+ *
+ * @{
+ */
+
+/// @file sys/epoll.h
+/// @brief I/O event notification APIs for network sockets
+
+#ifndef __INCLUDE_SYS_EPOLL_H
+#define __INCLUDE_SYS_EPOLL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <poll.h>
+
+#ifdef CONFIG_NET_EPOLL
+
+/****************************************************************************
+ * Pre-Processor Definitions
+ ****************************************************************************/
+
+/* Event bits, shared with poll() so that the two can be mixed */
+
+#define EPOLLIN         POLLIN
+#define EPOLLOUT        POLLOUT
+#define EPOLLERR        POLLERR
+#define EPOLLHUP        POLLHUP
+
+/* Input flags. EPOLLERR and EPOLLHUP are always reported. */
+
+#define EPOLLONESHOT    (1u << 30)	/* Disable the entry after one event */
+#define EPOLLET         (1u << 31)	/* Edge triggered */
+
+/* epoll_ctl() operations */
+
+#define EPOLL_CTL_ADD   1
+#define EPOLL_CTL_DEL   2
+#define EPOLL_CTL_MOD   3
+
+/* epoll_create1() flags, accepted and ignored */
+
+#define EPOLL_CLOEXEC   0x01
+
+/****************************************************************************
+ * Type Definitions
+ ****************************************************************************/
+
+typedef union epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+} epoll_data_t;
+
+struct epoll_event {
+	uint32_t events;			/* Requested events; returned events */
+	epoll_data_t data;			/* Returned as is with each event */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C" {
+#else
+#define EXTERN extern
+#endif
+
+/**
+ * @ingroup EPOLL_KERNEL
+ * @brief open an epoll instance
+ * @details @b #include <sys/epoll.h> \n
+ * size is only checked to be positive, as on Linux.
+ * The instance takes one network socket descriptor until it is closed.
+ * @since TizenRT v4.0
+ */
+EXTERN int epoll_create(int size);
+
+/**
+ * @ingroup EPOLL_KERNEL
+ * @brief open an epoll instance
+ * @details @b #include <sys/epoll.h> \n
+ * SYSTEM CALL API
+ * @since TizenRT v4.0
+ */
+EXTERN int epoll_create1(int flags);
+
+/**
+ * @ingroup EPOLL_KERNEL
+ * @brief add, modify or remove a socket in the interest list of an epoll instance
+ * @details @b #include <sys/epoll.h> \n
+ * SYSTEM CALL API \n
+ * Only network sockets can be registered. A socket is removed from all
+ * interest lists when it is closed.
+ * @since TizenRT v4.0
+ */
+EXTERN int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *event);
+
+/**
+ * @ingroup EPOLL_KERNEL
+ * @brief wait for events on an epoll instance
+ * @details @b #include <sys/epoll.h> \n
+ * SYSTEM CALL API \n
+ * timeout is in milliseconds, -1 waits forever and 0 returns at once.
+ * @since TizenRT v4.0
+ */
+EXTERN int epoll_wait(int epfd, FAR struct epoll_event *events, int maxevents, int timeout);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif							/* CONFIG_NET_EPOLL */
+
+#endif							/* __INCLUDE_SYS_EPOLL_H */
+/**
+ * @} */
@@ -373,6 +373,53 @@ int getpeername(int s, struct sockaddr *name, socklen_t *namelen);
 ssize_t recvmsg(int sockfd, struct msghdr *msg, int flags);
 ssize_t sendmsg(int sockfd, struct msghdr *msg, int flags);
 
+#ifdef CONFIG_NET_ZEROCOPY
+/**
+* @brief  receive data from a TCP or UDP socket without copying it
+*
+* @details @b #include <sys/socket.h>\n
+* zb->seg[] are set to point at up to len bytes of received data inside
+* the network stack buffers, which stay valid until recv_zc_release().
+* The data is consumed as with recv(). MSG_PEEK is not supported.
+* @param[in] sockfd the file descriptor of the socket
+* @param[out] zb receives the data segments
+* @param[in] len the maximum number of bytes to return, not 0
+* @param[in] flags MSG_DONTWAIT or 0
+* @return On success, the number of bytes in zb->seg[], 0 when the peer closed. On failure, -1 is returned.
+* @since TizenRT v4.0
+*/
+ssize_t recv_zc(int sockfd, struct zc_rbuf *zb, size_t len, int flags);
+
+/**
+* @brief  give back the buffers of a successful recv_zc()
+*
+* @details @b #include <sys/socket.h>\n
+* @param[in] zb the buffers filled by recv_zc()
+* @return none
+* @since TizenRT v4.0
+*/
+void recv_zc_release(struct zc_rbuf *zb);
+
+/**
+* @brief  send data on a socket without copying it into the network stack
+*
+* @details @b #include <sys/socket.h>\n
+* data must stay unmodified until release(data, arg) is called, which
+* happens exactly once, after the peer acknowledged the data for TCP and
+* before send_zc() returns for UDP. release may run in the network thread
+* and must not block.
+* @param[in] sockfd the file descriptor of the socket
+* @param[in] data the data to send
+* @param[in] size the length of data
+* @param[in] flags MSG_DONTWAIT, MSG_MORE or 0
+* @param[in] release called when the stack does not reference data anymore
+* @param[in] arg passed to release
+* @return On success, the number of bytes sent. On failure, -1 is returned.
+* @since TizenRT v4.0
+*/
+ssize_t send_zc(int sockfd, const void *data, size_t size, int flags, zc_release_t release, void *arg);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
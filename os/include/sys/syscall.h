@@ -469,7 +469,20 @@
 #define SYS_setsockopt                 (__SYS_network + 12)
 #define SYS_shutdown                   (__SYS_network + 13)
 #define SYS_socket                     (__SYS_network + 14)
-#define __SYS_prctl                    (__SYS_network + 15)
+#ifdef CONFIG_NET_EPOLL
+#define SYS_epoll_create1              (__SYS_network + 15)
+#define SYS_epoll_ctl                  (__SYS_network + 16)
+#define SYS_epoll_wait                 (__SYS_network + 17)
+#define __SYS_sendfile                 (__SYS_network + 18)
+#else
+#define __SYS_sendfile                 (__SYS_network + 15)
+#endif
+#ifdef CONFIG_NET_SENDFILE
+#define SYS_sendfile                   __SYS_sendfile
+#define __SYS_prctl                    (__SYS_sendfile + 1)
+#else
+#define __SYS_prctl                    __SYS_sendfile
+#endif
 #else
 #define __SYS_prctl                    __SYS_network
 #endif
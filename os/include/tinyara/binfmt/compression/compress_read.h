@@ -22,6 +22,9 @@
 /****************************************************************************
  * Included Files
  ****************************************************************************/
+#include <sys/types.h>
+#include <stdint.h>
+
 #include <tinyara/binfmt/compression/compression.h>
 
 /****************************************************************************
@@ -32,11 +35,11 @@
  * Public Types
  ****************************************************************************/
 
-/* Struct for buffers to be used for read/decompression */
-struct s_buffer {
-	unsigned char *read_buffer;
-	unsigned char *out_buffer;
-};
+/* Decompression state of one compressed file, private to compress_read.c.
+ * Each file being read has its own, so several binaries can be loaded at
+ * the same time.
+ */
+struct compress_ctx_s;
 
 /****************************************************************************
  * Function Prototypes
@@ -46,24 +49,25 @@ struct s_buffer {
  * Name: compress_uninit
  *
  * Description:
- *   Release buffers initialized during compress_init
+ *   Release the decompression state allocated by compress_init
  *
  * Returned Value:
  *   None
  ****************************************************************************/
-void compress_uninit(void);
+void compress_uninit(FAR struct compress_ctx_s *ctx);
 
 /****************************************************************************
  * Name: compress_init
  *
  * Description:
- *   Initialize the header 's_header' for this binary
+ *   Parse the header 's_header' of the compressed file 'filfd' found at
+ *   'offset', and allocate its decompression state into 'ctx'
  *
  * Returned value:
  *   OK (0) on Success
- *   ERROR (-1) on Failure
+ *   Negative value on Failure
  ****************************************************************************/
-int compress_init(int filfd, uint16_t offset, off_t *filelen);
+int compress_init(int filfd, uint16_t offset, off_t *filelen, FAR struct compress_ctx_s **ctx);
 
 /****************************************************************************
  * Name: compress_read
@@ -78,14 +82,14 @@ int compress_init(int filfd, uint16_t offset, off_t *filelen);
  *   Number of bytes read into buffer on Success
  *   Negative value on failure
  ****************************************************************************/
-int compress_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer, size_t readsize, off_t offset);
+int compress_read(FAR struct compress_ctx_s *ctx, FAR uint8_t *buffer, size_t readsize, off_t offset);
 
 /****************************************************************************
  * Name: get_compression_header
  *
  * Returned Value:
- *   Address of the compression_header
+ *   Address of the compression header of 'ctx'
  ****************************************************************************/
-struct s_header *get_compression_header(void);
+struct s_header *get_compression_header(FAR struct compress_ctx_s *ctx);
 
 #endif							/* __INCLUDE_COMPRESS_READ_H */
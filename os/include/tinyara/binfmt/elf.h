@@ -107,6 +107,9 @@
  * Public Types
  ****************************************************************************/
 
+struct compress_ctx_s;
+struct elf_cache_s;
+
 /* This struct provides a description of the currently loaded instantiation
  * of an ELF binary.
  */
@@ -172,6 +175,12 @@ struct elf_loadinfo_s {
 	int filfd;					/* Descriptor for the file being loaded */
 	uint16_t offset;             /* elf offset when binary header is included */
 	uint8_t compression_type;		/* Binary Compression type */
+#ifdef CONFIG_COMPRESSED_BINARY
+	FAR struct compress_ctx_s *compctx;	/* Decompression state of the file */
+#endif
+#ifdef CONFIG_ELF_CACHE_READ
+	FAR struct elf_cache_s *cache;	/* Block cache of the file */
+#endif
 	uintptr_t symtab;			/* Copy of symbol table */
 	uintptr_t reltab;			/* Copy of relocation table */
 	uintptr_t strtab;			/* Copy of string table */
@@ -928,6 +928,20 @@ ssize_t file_pwrite(FAR struct file *filep, FAR const void *buf, size_t nbytes,
 off_t file_seek(FAR struct file *filep, off_t offset, int whence);
 #endif
 
+/* libc/misc/lib_sendfile.c *************************************************/
+/****************************************************************************
+ * Name: lib_sendfile
+ *
+ * Description:
+ *   The read()/write() copy loop behind sendfile().  Used by sendfile()
+ *   when the output descriptor cannot take the file data directly.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SENDFILE
+ssize_t lib_sendfile(int outfd, int infd, FAR off_t *offset, size_t count);
+#endif
+
 /* fs/fs_fsync.c ************************************************************/
 /****************************************************************************
  * Name: file_fsync
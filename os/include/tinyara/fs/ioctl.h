@@ -242,6 +242,21 @@
 										 *      the block with specific debug
 										 *      command and data.
 										 * OUT: None.  */
+#define BIOC_FLUSH      _BIOC(0x000C)	/* Write any state kept in memory by the
+										 * block driver to the media.
+										 * IN:  None
+										 * OUT: None (ioctl return value provides
+										 *      success/failure indication). */
+#define BIOC_GETGCWATERMARK _BIOC(0x000D)	/* Get the watermarks of the
+										 * background garbage collection.
+										 * IN:  Pointer to the watermarks
+										 * OUT: None (ioctl return value provides
+										 *      success/failure indication). */
+#define BIOC_SETGCWATERMARK _BIOC(0x000E)	/* Set the watermarks of the
+										 * background garbage collection.
+										 * IN:  Pointer to the watermarks
+										 * OUT: None (ioctl return value provides
+										 *      success/failure indication). */
 
 /* TinyAra MTD driver ioctl definitions ***************************************/
 
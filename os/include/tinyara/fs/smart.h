@@ -102,6 +102,18 @@ struct smart_read_write_s {
 	const uint8_t *buffer;		/* Pointer to the data to write */
 };
 
+/* The following defines when the background garbage collection runs.  It
+ * is read and changed with the BIOC_GETGCWATERMARK and BIOC_SETGCWATERMARK
+ * ioctls.
+ */
+
+struct smart_gc_watermark_s {
+	uint8_t start;				/* Start when less than this percentage of sectors is free */
+	uint8_t stop;				/* Stop when this percentage of sectors is free */
+	uint8_t minreleased;		/* Percentage of released sectors to collect a block */
+	uint16_t idlems;			/* Milliseconds without I/O before collecting a block */
+};
+
 /* The following defines the procfs data exchange interface between the
  * SMART MTD and FS layers.
  */
@@ -170,6 +170,19 @@
 #define MM_MAX_CHUNK     (1 << MM_MAX_SHIFT)
 #define MM_NNODES        (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
 
+/* Each power-of-two size range is split into MM_SL_COUNT free lists of
+ * equal width with the TLSF policy.  The best fit policy uses a single
+ * list per range.
+ */
+
+#ifdef CONFIG_MM_POLICY_TLSF
+#define MM_SL_SHIFT      CONFIG_MM_TLSF_SLSHIFT
+#else
+#define MM_SL_SHIFT      0
+#endif
+#define MM_SL_COUNT      (1 << MM_SL_SHIFT)
+#define MM_NLISTS        (MM_NNODES << MM_SL_SHIFT)
+
 #define MM_GRAN_MASK     (MM_MIN_CHUNK-1)
 #define MM_ALIGN_UP(a)   (((a) + MM_GRAN_MASK) & ~MM_GRAN_MASK)
 #define MM_ALIGN_DOWN(a) ((a) & ~MM_GRAN_MASK)
@@ -185,6 +198,17 @@
 #endif
 #define MM_IS_ALLOCATED(n) ((int)((struct mm_allocnode_s*)(n)->preceding) < 0)
 
+/* Size class definitions.  Chunks up to MM_SIZECLASS_MAXCHUNK bytes are
+ * kept on per-size-class stacks when they are freed.  Each class holds
+ * chunks of exactly one size, and classes are spaced by MM_MIN_CHUNK.
+ */
+
+#ifdef CONFIG_MM_SIZECLASS
+#define MM_SIZECLASS_MAXCHUNK  MM_ALIGN_DOWN(CONFIG_MM_SIZECLASS_MAXSIZE)
+#define MM_SIZECLASS_NCLASSES  (MM_SIZECLASS_MAXCHUNK >> MM_MIN_SHIFT)
+#define MM_SIZECLASS_NDX(s)    (((s) >> MM_MIN_SHIFT) - 1)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -202,6 +226,10 @@
 #define HEAPINFO_DEL_INFO 2
 
 #define HEAPINFO_HEAP_TYPE_KERNEL 1
+#ifdef CONFIG_MM_SIZECLASS
+/* Owner pid of the chunks which are kept on the size class stacks */
+#define HEAPINFO_SIZECLASS (INT16_MAX - 2)
+#endif
 #ifdef CONFIG_APP_BINARY_SEPARATION
 #define HEAPINFO_HEAP_TYPE_BINARY    3
 #endif
@@ -256,6 +284,24 @@ typedef size_t mmaddress_t;		/* 32 bit address space */
 	(sizeof(mmaddress_t) + sizeof(pid_t) + sizeof(uint16_t))
 #endif
 
+/* Operations reported to the heap trace hook, see mm_set_trace_hook() */
+
+#ifdef CONFIG_DEBUG_MM_HEAPTRACE
+#define MM_TRACE_MALLOC  0
+#define MM_TRACE_REALLOC 1
+#define MM_TRACE_FREE    2
+
+#define MM_TRACE(op, oldmem, mem, size, caller) \
+	do { \
+		mm_trace_hook_t hook_ = g_mm_trace_hook; \
+		if (hook_) { \
+			hook_(op, oldmem, mem, size, caller); \
+		} \
+	} while (0)
+#else
+#define MM_TRACE(op, oldmem, mem, size, caller)
+#endif
+
 /* This describes an allocated chunk.  An allocated chunk is
  * distinguished from a free chunk by bit 15/31 of the 'preceding' chunk
  * size.  If set, then this is an allocated chunk.
@@ -380,7 +426,29 @@ struct mm_heap_s {
 	 * speed searches for free nodes.
 	 */
 
-	struct mm_freenode_s mm_nodelist[MM_NNODES + 1];
+	struct mm_freenode_s mm_nodelist[MM_NLISTS + 1];
+
+#ifdef CONFIG_MM_POLICY_TLSF
+	/* Bit n of mm_fl_bitmap is set if any list of the size range n is not
+	 * empty.  Bit m of mm_sl_bitmap[n] is set if list m of the size range n
+	 * is not empty.
+	 */
+
+	uint32_t mm_fl_bitmap;
+	uint32_t mm_sl_bitmap[MM_NNODES];
+#endif
+
+#ifdef CONFIG_MM_SIZECLASS
+	/* Small chunks released by mm_free() are pushed onto these stacks,
+	 * one per size class, and still look allocated to the rest of the
+	 * allocator.  The first word of the chunk payload links the stack.
+	 */
+
+	FAR struct mm_allocnode_s *mm_sizeclass[MM_SIZECLASS_NCLASSES];
+	uint8_t mm_sizeclass_cnt[MM_SIZECLASS_NCLASSES];
+	size_t mm_sizeclass_nchunks;	/* Number of cached chunks */
+	size_t mm_sizeclass_size;		/* Total size of cached chunks */
+#endif
 };
 
 /****************************************************************************
@@ -519,6 +587,10 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size,
 FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size);
 #endif
 
+/* Functions contained in mm_realloc.c **************************************/
+
+FAR void *mm_try_expand(FAR struct mm_heap_s *heap, FAR void *mem, size_t size);
+
 /* Functions contained in kmm_realloc.c *************************************/
 
 #ifdef CONFIG_MM_KERNEL_HEAP
@@ -659,6 +731,39 @@ void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 
 int mm_size2ndx(size_t size);
 
+/* Functions contained in mm_tlsf.c *****************************************/
+
+#ifdef CONFIG_MM_POLICY_TLSF
+FAR struct mm_freenode_s *mm_tlsf_search(FAR struct mm_heap_s *heap, size_t size);
+#endif
+
+/* Functions contained in mm_freechunk.c ************************************/
+
+void mm_freechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node);
+
+/* Functions contained in mm_sizeclass.c ************************************/
+
+#ifdef CONFIG_MM_SIZECLASS
+void mm_sizeclass_initialize(FAR struct mm_heap_s *heap);
+FAR struct mm_allocnode_s *mm_sizeclass_pop(FAR struct mm_heap_s *heap, size_t size);
+bool mm_sizeclass_push(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node);
+int mm_sizeclass_flush(FAR struct mm_heap_s *heap);
+#ifdef CONFIG_DEBUG_DOUBLE_FREE
+bool mm_sizeclass_cached(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node);
+#endif
+#endif
+
+/* Functions contained in mm_tcache.c ***************************************/
+
+#ifdef CONFIG_MM_TASK_CACHE
+FAR struct mm_allocnode_s *mm_tcache_alloc(FAR struct mm_heap_s *heap, size_t size);
+bool mm_tcache_free(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node);
+int mm_tcache_flush(FAR struct mm_heap_s *heap);
+#ifdef CONFIG_DEBUG_DOUBLE_FREE
+bool mm_tcache_cached(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node);
+#endif
+#endif
+
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 /* Functions contained in kmm_mallinfo.c . Used to display memory allocation details */
 void heapinfo_parse(FAR struct mm_heap_s *heap, int mode, pid_t pid);
@@ -683,6 +788,22 @@ struct mm_heap_s *mm_get_heap_with_index(int index);
 
 int mm_get_heapindex(void *mem);
 
+#ifdef CONFIG_DEBUG_MM_HEAPTRACE
+/* Called for each successful malloc(), realloc() and free() of the user
+ * heap with the chunk before and after the operation, the requested size
+ * and the caller address.  The hook runs in the context of the caller and
+ * must not use the heap itself.
+ */
+
+typedef void (*mm_trace_hook_t)(int op, FAR void *oldmem, FAR void *mem, size_t size, mmaddress_t caller);
+
+EXTERN mm_trace_hook_t g_mm_trace_hook;
+
+/* Install the trace hook, or remove it with NULL */
+
+void mm_set_trace_hook(mm_trace_hook_t hook);
+#endif
+
 #if defined(CONFIG_APP_BINARY_SEPARATION) && defined(__KERNEL__)
 void mm_initialize_app_heap(void);
 void mm_add_app_heap_list(struct mm_heap_s *heap, char *app_name);
@@ -795,6 +916,21 @@ void *zalloc_at(int heap_index, size_t size);
 #define zalloc_at(heap_index, size)              zalloc(size)
 #endif
 
+/**
+ * @brief Resize a memory block of the user heap without moving it.
+ * @details @b #include <tinyara/mm/mm.h>\n
+ *   realloc_in_place grows the block only into the free memory which follows
+ *   it, so the data never has to be copied.  A smaller size shrinks the block
+ *   in place.  On failure, the block is left unchanged and the caller may
+ *   fall back to realloc().
+ * @param[in] mem the pointer to a memory block previously allocated
+ * @param[in] size the new size for the memory block
+ *
+ * @return On success, mem is returned. On failure, NULL is returned.
+ * @since TizenRT v3.1 PRE
+ */
+void *realloc_in_place(void *mem, size_t size);
+
 /**
  * @endcond
  */
@@ -208,6 +208,9 @@
  * it's provided to running iotivity app on binary protection env */
 #define SIOCGIFNAME      _SIOC(0x0056)  /* get active NIC name. */
 
+/* Get lwIP memory pool usage, see struct netmon_memp in include/net/if.h */
+#define SIOCGMEMPSTATS   _SIOC(0x0057)  /* Get lwIP memory pool stats */
+
 /****************************************************************************
  * Type Definitions
  ****************************************************************************/
@@ -339,6 +339,31 @@ void net_releaselist(FAR struct socketlist *list);
 
 int net_close(int sockfd);
 
+/****************************************************************************
+ * Function: net_sendfile
+ *
+ * Description:
+ *   Send count bytes of an open file on a socket without copying them
+ *   through a user buffer.  Used by sendfile() when the output descriptor
+ *   is a socket.
+ *
+ * Parameters:
+ *   sockfd  Socket descriptor of the socket to send on
+ *   infile  The file to read from
+ *   offset  Where to start reading, or NULL to use and update the file
+ *           position
+ *   count   Number of bytes to send
+ *
+ * Returned Value:
+ *   The number of bytes sent; -1 on error with errno set appropriately.
+ *   ENOSYS means that the socket does not support it.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SENDFILE
+ssize_t net_sendfile(int sockfd, FAR struct file *infile, FAR off_t *offset, size_t count);
+#endif
+
 /****************************************************************************
  * Function: net_poll
  *
@@ -501,6 +501,24 @@ struct task_group_s {
 #define IS_LOADED_MODULE(group)    (group->tg_bininfo != NULL)   /* Points loading data if it is loaded */
 #endif
 
+/* struct mm_tcache_s ************************************************************/
+/* Small heap chunks recently freed by a thread.  malloc() of the same thread
+ * reuses them without taking the heap semaphore.
+ */
+
+#ifdef CONFIG_MM_TASK_CACHE
+struct mm_heap_s;
+
+struct mm_tcache_s {
+	FAR struct mm_heap_s *heap;	/* Heap which the cached chunks belong to */
+	FAR void *chunk[CONFIG_MM_TASK_CACHE_DEPTH];	/* Cached chunks       */
+	uint8_t nchunks;			/* Number of cached chunks             */
+	bool closed;				/* Thread is exiting, do not cache     */
+	uint32_t nhits;				/* Allocations served from the cache   */
+	uint32_t nmisses;			/* Allocations which missed the cache  */
+};
+#endif
+
 /* struct tcb_s ******************************************************************/
 
 FAR struct wdog_s;				/* Forward reference                   */
@@ -605,6 +623,12 @@ struct tcb_s {
 
 	int pterrno;				/* Current per-thread errno            */
 
+#ifdef CONFIG_MM_TASK_CACHE
+	/* Heap related fields ******************************************************* */
+
+	struct mm_tcache_s tcache;	/* Small chunks freed by this thread   */
+#endif
+
 	/* State save areas ********************************************************** */
 	/* The form and content of these fields are platform-specific.                */
 
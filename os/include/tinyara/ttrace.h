@@ -56,6 +56,7 @@
 #define TTRACE_BUFFER              'b'
 #define TTRACE_DUMP                'd'
 #define TTRACE_PRINT               'p'
+#define TTRACE_HEXDUMP             'x'
 
 #define TTRACE_CODE_VARIABLE        0
 #define TTRACE_CODE_UNIQUE         (1 << 7)
@@ -103,6 +104,73 @@ struct trace_packet {        // total 44 byte(message), 12byte(uid)
 	union trace_message msg;   // 32B
 };
 
+#ifdef CONFIG_TTRACE_COMPACT
+/* Compact records, used instead of trace_packet in the trace buffer when
+ * CONFIG_TTRACE_COMPACT is enabled.  Strings are stored once in a string
+ * table and referred by id.  Timestamps are deltas in microseconds from the
+ * previous record.  A TTRACE_REC_TIME record gives the absolute time when the
+ * delta does not fit, and every 64 records.  Records are 4 byte aligned.
+ *
+ * Reading /dev/ttrace returns struct ttrace_dump_hdr_s, the string table as
+ * TTRACE_REC_STR records, then the records of the trace buffer.
+ */
+
+#define TTRACE_DUMP_MAGIC          "TTRC"
+#define TTRACE_DUMP_VERSION        1
+
+#define TTRACE_REC_PAD             0	/* Rest of the buffer is unused */
+#define TTRACE_REC_TIME            1	/* struct ttrace_rec_time_s */
+#define TTRACE_REC_BEGIN           2	/* arg: string id */
+#define TTRACE_REC_BEGIN_UID       3	/* extra: unique id */
+#define TTRACE_REC_END             4
+#define TTRACE_REC_SCHED           5	/* struct ttrace_rec_sched_s */
+#define TTRACE_REC_STR             6	/* struct ttrace_rec_str_s */
+
+#define TTRACE_STRID_NONE          0xffff	/* String table was full */
+
+struct ttrace_dump_hdr_s {         // total 8B
+	char magic[4];                     // "TTRC"
+	uint8_t version;                   // TTRACE_DUMP_VERSION
+	uint8_t overwritten;               // Older records were overwritten
+	uint16_t dropped;                  // Records lost because the buffer was full
+};
+
+struct ttrace_rec_s {              // total 8B, begin, begin_uid and end
+	uint16_t delta;                    // us since the previous record
+	uint8_t type;                      // TTRACE_REC_xxx
+	uint8_t extra;                     // unique id
+	int16_t pid;
+	uint16_t arg;                      // string id
+};
+
+struct ttrace_rec_time_s {         // total 8B
+	uint16_t delta;                    // 0 if extra is set
+	uint8_t type;
+	uint8_t extra;                     // 1 if the delta did not fit
+	uint32_t usec;                     // Absolute time (us), lower 32 bits
+};
+
+struct ttrace_rec_sched_s {        // total 12B
+	uint16_t delta;
+	uint8_t type;
+	uint8_t prev_state;
+	int16_t prev_pid;
+	int16_t next_pid;
+	uint8_t prev_prio;
+	uint8_t next_prio;
+	uint16_t reserved;
+};
+
+struct ttrace_rec_str_s {          // total 8B + string, padded to 4B
+	uint16_t delta;                    // always 0
+	uint8_t type;
+	uint8_t len;                       // Length of str without terminator
+	int16_t pid;                       // Task of a task name, -1 for a message
+	uint16_t id;
+	char str[];
+};
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
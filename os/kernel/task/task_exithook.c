@@ -64,6 +64,10 @@
 
 #include <tinyara/sched.h>
 #include <tinyara/fs/fs.h>
+#ifdef CONFIG_MM_TASK_CACHE
+#include <tinyara/kmalloc.h>
+#include <tinyara/mm/mm.h>
+#endif
 
 #include "sched/sched.h"
 #include "group/group.h"
@@ -514,6 +518,32 @@ static inline void task_flushstreams(FAR struct tcb_s *tcb)
 #define task_flushstreams(tcb)
 #endif
 
+/****************************************************************************
+ * Name: task_releasetcache
+ *
+ * Description:
+ *   Return the small heap chunks cached by the exiting thread to the heap.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_TASK_CACHE
+static inline void task_releasetcache(FAR struct tcb_s *tcb)
+{
+	FAR struct mm_tcache_s *tcache = &tcb->tcache;
+
+	/* Chunks freed by the exiting thread from now on go to the heap */
+
+	tcache->closed = true;
+
+	while (tcache->nchunks > 0) {
+		tcache->nchunks--;
+		sched_kfree((FAR char *)tcache->chunk[tcache->nchunks] + SIZEOF_MM_ALLOCNODE);
+	}
+}
+#else
+#define task_releasetcache(tcb)
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -639,6 +669,10 @@ void task_exithook(FAR struct tcb_s *tcb, int status, bool nonblocking)
 	sig_cleanup(tcb);			/* Deallocate Signal lists */
 #endif
 
+	/* Return the heap chunks cached by the thread */
+
+	task_releasetcache(tcb);
+
 	/* This function can be re-entered in certain cases.  Set a flag
 	 * bit in the TCB to not that we have already completed this exit
 	 * processing.
@@ -20,6 +20,8 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <unistd.h>
+#include <stdbool.h>
+#include <semaphore.h>
 #ifdef CONFIG_ARCH_LOWPUTC
 #include <sched.h>
 #endif
@@ -58,6 +60,9 @@ static void logm_flush(struct lib_outstream_s *stream)
 {
 	sched_lock();
 
+#ifdef CONFIG_LOGM_BINARY
+	logm_bin_flush(stream);
+#else
 	while (g_logm_head != g_logm_tail) {
 		stream->put(stream, g_logm_rsvbuf[g_logm_head]);
 		g_logm_head = (g_logm_head + 1) % logm_bufsize;
@@ -66,6 +71,7 @@ static void logm_flush(struct lib_outstream_s *stream)
 	if (LOGM_STATUS(LOGM_BUFFER_OVERFLOW)) {
 		LOGM_STATUS_CLEAR(LOGM_BUFFER_OVERFLOW);
 	}
+#endif
 
 	/* Reset nput in stream for next stream */
 	stream->nput = 0;
@@ -74,6 +80,26 @@ static void logm_flush(struct lib_outstream_s *stream)
 }
 #endif
 
+/* Wake logm task when the buffer is used up to the threshold */
+void logm_wakeup(void)
+{
+	irqstate_t flags;
+	int used;
+	bool post = false;
+
+	flags = irqsave();
+	used = (g_logm_tail - g_logm_head + logm_bufsize) % logm_bufsize;
+	if (!LOGM_STATUS(LOGM_DRAIN_REQ) && (LOGM_STATUS(LOGM_BUFFER_OVERFLOW) || used * 100 >= logm_bufsize * LOGM_WAKEUP_THRESHOLD)) {
+		LOGM_STATUS_SET(LOGM_DRAIN_REQ);
+		post = true;
+	}
+	irqrestore(flags);
+
+	if (post) {
+		sem_post(&g_logm_sem);
+	}
+}
+
 /* logm_internal hook for syslog & printfs */
 int logm_internal(int flag, int indx, int priority, const char *fmt, va_list ap)
 {
@@ -87,11 +113,16 @@ int logm_internal(int flag, int indx, int priority, const char *fmt, va_list ap)
 	if (LOGM_STATUS(LOGM_READY) && !LOGM_STATUS(LOGM_BUFFER_RESIZE_REQ) \
 		&& flag == LOGM_NORMAL && !up_interrupt_context()) {
 
+#ifdef CONFIG_LOGM_BINARY
+		/* Only the arguments are stored, logm_task formats the message */
+		return logm_bin_internal(priority, fmt, ap);
+#endif
 		flags = irqsave();
 
 		if (LOGM_STATUS(LOGM_BUFFER_OVERFLOW)) {
 			g_logm_dropmsg_count++;
 			irqrestore(flags);
+			logm_wakeup();
 			return 0;
 		}
 
@@ -114,6 +145,7 @@ int logm_internal(int flag, int indx, int priority, const char *fmt, va_list ap)
 			g_logm_overflow_offset = g_logm_tail;
 		}
 		irqrestore(flags);
+		logm_wakeup();
 	} else {
 		/* Low Output: Sytem is not yet completely ready or this is called from interrupt handler */
 #ifdef CONFIG_ARCH_LOWPUTC
@@ -20,6 +20,12 @@
 
 #include <tinyara/config.h>
 #include <stdint.h>
+#include <semaphore.h>
+#ifdef CONFIG_LOGM_BINARY
+#include <stdio.h>
+#include <stdarg.h>
+#include <tinyara/streams.h>
+#endif
 
 /****************************************************************************
  * Preprocessor Definitions
@@ -39,6 +45,19 @@
 #define LOGM_PRINT_INTERVAL        (1000)
 #endif
 
+#ifdef CONFIG_LOGM_OUTPUT_PATH
+#define LOGM_OUTPUT_PATH CONFIG_LOGM_OUTPUT_PATH
+#else
+#define LOGM_OUTPUT_PATH ""
+#endif
+#define LOGM_OUTPUT_PATH_MAX 32
+
+#ifdef CONFIG_LOGM_WAKEUP_THRESHOLD
+#define LOGM_WAKEUP_THRESHOLD CONFIG_LOGM_WAKEUP_THRESHOLD
+#else
+#define LOGM_WAKEUP_THRESHOLD (50)
+#endif
+
 #ifndef BIT
 #define BIT(x) (1 << (x))
 #endif
@@ -46,6 +65,18 @@
 #define LOGM_READY BIT(0)
 #define LOGM_BUFFER_RESIZE_REQ BIT(1)
 #define LOGM_BUFFER_OVERFLOW BIT(2)
+#define LOGM_DRAIN_REQ BIT(3)
+#define LOGM_OUTPUT_CHANGE_REQ BIT(4)
+
+#ifdef CONFIG_LOGM_BINARY
+/* Binary record states.  A record can only be printed once committed. */
+#define LOGM_BIN_RESERVED 0x5a
+#define LOGM_BIN_COMMITTED 0xa5
+#define LOGM_BIN_PAD 0xc3		/* Rest of the buffer is unused, next record is at 0 */
+
+#define LOGM_BIN_FMTCOPY BIT(0)		/* Format string is stored after the header */
+#define LOGM_BIN_TRUNCATED BIT(1)	/* Arguments did not fit in the record */
+#endif
 
 #define LOGM_STATUS(a) (logm_status & (a))
 #define LOGM_STATUS_SET(a) (logm_status |= (a))
@@ -57,6 +88,22 @@
 
 /* Structure for a single debug message */
 
+#ifdef CONFIG_LOGM_BINARY
+/* Header of a binary record.  It is followed by the format string when
+ * LOGM_BIN_FMTCOPY is set, then by the arguments in the order of the
+ * conversions: int and double in native format, strings copied with their
+ * terminator.  Each field and the record size are padded to 4 bytes.
+ */
+
+struct logm_binrec_s {
+	uint8_t state;				/* LOGM_BIN_RESERVED, COMMITTED or PAD */
+	uint8_t flags;				/* LOGM_BIN_FMTCOPY, LOGM_BIN_TRUNCATED */
+	uint16_t size;				/* Size of the record including this header */
+	uint32_t ticks;				/* System time when the message was logged */
+	const char *fmt;			/* Format string in .rodata, NULL if copied */
+};
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 #define EXTERN extern "C"
@@ -74,12 +121,23 @@ EXTERN int logm_bufsize;
 EXTERN uint8_t logm_status;
 EXTERN volatile int new_logm_bufsize;
 EXTERN volatile int logm_print_interval;
+EXTERN sem_t g_logm_sem;
+EXTERN char g_logm_output_path[LOGM_OUTPUT_PATH_MAX];
+#ifdef CONFIG_LOGM_BINARY
+EXTERN volatile int g_logm_writers;
+#endif
 
 /************************************************************************************
  * Private Function Prototypes
  ************************************************************************************/
 int logm_task(int argc, char *argv[]);
 void logm_register_tashcmds(void);
+void logm_wakeup(void);
+#ifdef CONFIG_LOGM_BINARY
+int logm_bin_internal(int priority, const char *fmt, va_list ap);
+void logm_bin_flush(struct lib_outstream_s *stream);
+void logm_bin_dump(FILE *stream);
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -0,0 +1,584 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* Binary logging: a caller only stores the format pointer, the raw
+ * arguments and a timestamp in a record of the logm buffer, and the
+ * message is formatted later by logm_task.  Interrupts are only disabled
+ * while a record is reserved and committed, not while it is filled.
+ * The record layout is described in logm.h and tools/logm/README.md.
+ */
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sys/types.h>
+#include <arch/irq.h>
+#include <tinyara/arch.h>
+#include <tinyara/clock.h>
+#include <tinyara/logm.h>
+#include <tinyara/streams.h>
+#include "logm.h"
+
+#define LOGM_BIN_ALIGN(n)	(((n) + 3) & ~3)
+#define LOGM_BIN_RECMAX		LOGM_BIN_ALIGN(CONFIG_LOGM_BINARY_RECORD_SIZE)
+#define LOGM_BIN_SPECMAX	16
+
+enum logm_argtype_e {
+	LOGM_ARG_NONE,				/* "%%" */
+	LOGM_ARG_INT,				/* Everything passed as int or long */
+	LOGM_ARG_LONGLONG,
+	LOGM_ARG_DOUBLE,
+	LOGM_ARG_PTR,
+	LOGM_ARG_STR,				/* Copied into the record */
+	LOGM_ARG_BAD				/* Not supported, the rest of the format is printed as is */
+};
+
+struct logm_conv_s {
+	uint8_t type;				/* enum logm_argtype_e */
+	uint8_t nstar;				/* Number of '*' width and precision arguments */
+	uint8_t len;				/* Length of the conversion, including '%' */
+};
+
+/* Bounds of the kernel text and read-only data.  Formats outside are
+ * copied into the record as they may not exist anymore when printed.
+ */
+
+extern uint32_t _stext;
+extern uint32_t _etext;
+
+volatile int g_logm_writers;
+
+/* Find the next conversion in fmt and the type of its argument */
+
+static const char *logm_bin_nextconv(const char *fmt, struct logm_conv_s *conv)
+{
+	const char *p;
+	int nlong = 0;
+
+	fmt = strchr(fmt, '%');
+	if (fmt == NULL) {
+		return NULL;
+	}
+
+	p = fmt + 1;
+	conv->nstar = 0;
+	while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0') {
+		p++;
+	}
+
+	if (*p == '*') {
+		conv->nstar++;
+		p++;
+	}
+	while (*p >= '0' && *p <= '9') {
+		p++;
+	}
+
+	if (*p == '.') {
+		p++;
+		if (*p == '*') {
+			conv->nstar++;
+			p++;
+		}
+		while (*p >= '0' && *p <= '9') {
+			p++;
+		}
+	}
+
+	conv->type = LOGM_ARG_INT;
+	for (;; p++) {
+		if (*p == 'l') {
+			nlong++;
+		} else if (*p == 'j') {
+			nlong = 2;
+		} else if (*p == 'z' || *p == 't') {
+			nlong = sizeof(size_t) > sizeof(int) ? 2 : nlong;
+		} else if (*p == 'L') {
+			conv->type = LOGM_ARG_BAD;
+		} else if (*p != 'h') {
+			break;
+		}
+	}
+
+	switch (*p) {
+	case '%':
+		conv->type = LOGM_ARG_NONE;
+		break;
+
+	case 'd':
+	case 'i':
+	case 'u':
+	case 'x':
+	case 'X':
+	case 'o':
+	case 'c':
+		if (conv->type == LOGM_ARG_INT && (nlong > 1 || (nlong == 1 && sizeof(long) > sizeof(int)))) {
+			conv->type = LOGM_ARG_LONGLONG;
+		}
+		break;
+
+	case 'f':
+	case 'F':
+	case 'e':
+	case 'E':
+	case 'g':
+	case 'G':
+		if (conv->type == LOGM_ARG_INT) {
+			conv->type = LOGM_ARG_DOUBLE;
+		}
+		break;
+
+	case 'p':
+		conv->type = LOGM_ARG_PTR;
+		break;
+
+	case 's':
+		conv->type = LOGM_ARG_STR;
+		break;
+
+	default:
+		conv->type = LOGM_ARG_BAD;
+		break;
+	}
+
+#ifndef CONFIG_HAVE_LONG_LONG
+	if (conv->type == LOGM_ARG_LONGLONG) {
+		conv->type = LOGM_ARG_BAD;
+	}
+#endif
+
+	if (*p != '\0') {
+		p++;
+	}
+
+	conv->len = p - fmt;
+	if (conv->len >= LOGM_BIN_SPECMAX) {
+		conv->type = LOGM_ARG_BAD;
+	}
+
+	return fmt;
+}
+
+static int logm_bin_argsize(uint8_t type)
+{
+	switch (type) {
+	case LOGM_ARG_INT:
+		return sizeof(int);
+#ifdef CONFIG_HAVE_LONG_LONG
+	case LOGM_ARG_LONGLONG:
+		return sizeof(long long);
+#endif
+	case LOGM_ARG_DOUBLE:
+		return sizeof(double);
+	case LOGM_ARG_PTR:
+		return LOGM_BIN_ALIGN(sizeof(void *));
+	default:
+		return 0;
+	}
+}
+
+/* Reserve size contiguous bytes in the buffer.  Called with interrupts
+ * disabled.  One byte is always left free so that head == tail means empty.
+ */
+
+static int logm_bin_reserve(int size)
+{
+	int head = g_logm_head;
+	int tail = g_logm_tail;
+	struct logm_binrec_s *pad;
+
+	if (head > tail) {
+		if (head - tail - 1 < size) {
+			return ERROR;
+		}
+	} else if (logm_bufsize - tail < size + (head == 0 ? 1 : 0)) {
+		/* No room up to the end of the buffer.  Wrap if there is room at
+		 * the start, and mark the end as padding.
+		 */
+
+		if (head - 1 < size) {
+			return ERROR;
+		}
+
+		pad = (struct logm_binrec_s *)&g_logm_rsvbuf[tail];
+		pad->state = LOGM_BIN_PAD;
+		tail = 0;
+	}
+
+	g_logm_tail = (tail + size) % logm_bufsize;
+	return tail;
+}
+
+int logm_bin_internal(int priority, const char *fmt, va_list ap)
+{
+	irqstate_t flags;
+	struct logm_binrec_s *rec;
+	struct logm_conv_s conv;
+	const char *p;
+	const char *str;
+	uint8_t *data;
+	uint8_t recflags = 0;
+	va_list ap2;
+	int size;
+	int len;
+	int i;
+	int off;
+
+	/* First pass: find the size of the record */
+
+	size = sizeof(struct logm_binrec_s);
+	if ((uintptr_t)fmt < (uintptr_t)&_stext || (uintptr_t)fmt >= (uintptr_t)&_etext) {
+		recflags |= LOGM_BIN_FMTCOPY;
+		size += LOGM_BIN_ALIGN(strlen(fmt) + 1);
+		if (size > LOGM_BIN_RECMAX) {
+			recflags |= LOGM_BIN_TRUNCATED;
+			size = LOGM_BIN_RECMAX;
+		}
+	}
+
+	va_copy(ap2, ap);
+	len = size;
+	for (p = fmt; (p = logm_bin_nextconv(p, &conv)) != NULL; p += conv.len) {
+		if (conv.type == LOGM_ARG_BAD) {
+			break;
+		}
+
+		for (i = 0; i < conv.nstar; i++) {
+			(void)va_arg(ap2, int);
+		}
+
+		switch (conv.type) {
+		case LOGM_ARG_INT:
+			(void)va_arg(ap2, int);
+			break;
+#ifdef CONFIG_HAVE_LONG_LONG
+		case LOGM_ARG_LONGLONG:
+			(void)va_arg(ap2, long long);
+			break;
+#endif
+		case LOGM_ARG_DOUBLE:
+			(void)va_arg(ap2, double);
+			break;
+		case LOGM_ARG_PTR:
+			(void)va_arg(ap2, void *);
+			break;
+		case LOGM_ARG_STR:
+			str = va_arg(ap2, const char *);
+			len += LOGM_BIN_ALIGN(strlen(str ? str : "(null)") + 1);
+			break;
+		default:
+			break;
+		}
+
+		len += conv.nstar * sizeof(int) + logm_bin_argsize(conv.type);
+		if (len > LOGM_BIN_RECMAX) {
+			/* Keep what fits.  A string is cut to the space left. */
+
+			recflags |= LOGM_BIN_TRUNCATED;
+			if (conv.type == LOGM_ARG_STR && size + (int)(conv.nstar * sizeof(int)) + 4 <= LOGM_BIN_RECMAX) {
+				size = LOGM_BIN_RECMAX;
+			}
+			break;
+		}
+
+		size = len;
+	}
+	va_end(ap2);
+
+	/* Reserve the record */
+
+	flags = irqsave();
+	if (LOGM_STATUS(LOGM_BUFFER_RESIZE_REQ) || (off = logm_bin_reserve(size)) < 0) {
+		g_logm_dropmsg_count++;
+		LOGM_STATUS_SET(LOGM_BUFFER_OVERFLOW);
+		irqrestore(flags);
+		logm_wakeup();
+		return 0;
+	}
+
+	rec = (struct logm_binrec_s *)&g_logm_rsvbuf[off];
+	rec->state = LOGM_BIN_RESERVED;
+	rec->size = size;
+	g_logm_writers++;
+	irqrestore(flags);
+
+	/* Second pass: fill the record with interrupts enabled */
+
+	rec->flags = recflags;
+	rec->ticks = clock_systimer();
+	rec->fmt = fmt;
+	data = (uint8_t *)(rec + 1);
+	if (recflags & LOGM_BIN_FMTCOPY) {
+		len = size - sizeof(struct logm_binrec_s);
+		strncpy((char *)data, fmt, len);
+		if (data[len - 1] != '\0') {
+			data[len - 1] = '\0';
+			rec->flags |= LOGM_BIN_TRUNCATED;
+		}
+		len = strlen((char *)data) + 1;
+		data += LOGM_BIN_ALIGN(len);
+		rec->fmt = NULL;
+	}
+
+	for (p = fmt; (p = logm_bin_nextconv(p, &conv)) != NULL; p += conv.len) {
+		if (conv.type == LOGM_ARG_BAD) {
+			break;
+		}
+
+		len = (uint8_t *)rec + size - data;
+		if (conv.type != LOGM_ARG_NONE && len < (int)(conv.nstar * sizeof(int)) + (conv.type == LOGM_ARG_STR ? 4 : logm_bin_argsize(conv.type))) {
+			rec->flags |= LOGM_BIN_TRUNCATED;
+			break;
+		}
+
+		for (i = 0; i < conv.nstar; i++) {
+			*(int *)data = va_arg(ap, int);
+			data += sizeof(int);
+			len -= sizeof(int);
+		}
+
+		switch (conv.type) {
+		case LOGM_ARG_INT:
+			*(int *)data = va_arg(ap, int);
+			break;
+#ifdef CONFIG_HAVE_LONG_LONG
+		case LOGM_ARG_LONGLONG: {
+			long long val = va_arg(ap, long long);
+			memcpy(data, &val, sizeof(val));
+			break;
+		}
+#endif
+		case LOGM_ARG_DOUBLE: {
+			double val = va_arg(ap, double);
+			memcpy(data, &val, sizeof(val));
+			break;
+		}
+		case LOGM_ARG_PTR: {
+			void *val = va_arg(ap, void *);
+			memcpy(data, &val, sizeof(val));
+			break;
+		}
+		case LOGM_ARG_STR:
+			str = va_arg(ap, const char *);
+			strncpy((char *)data, str ? str : "(null)", len);
+			if (data[len - 1] != '\0') {
+				/* Cut to the space left */
+
+				data[len - 1] = '\0';
+				rec->flags |= LOGM_BIN_TRUNCATED;
+			}
+			data += LOGM_BIN_ALIGN(strlen((char *)data) + 1);
+			break;
+		default:
+			break;
+		}
+
+		if (conv.type != LOGM_ARG_STR) {
+			data += logm_bin_argsize(conv.type);
+		}
+	}
+
+	/* Publish the record.  irqsave() is also a compiler barrier, so the
+	 * record is complete before the drain can see it.
+	 */
+
+	flags = irqsave();
+	rec->state = LOGM_BIN_COMMITTED;
+	g_logm_writers--;
+	irqrestore(flags);
+	logm_wakeup();
+
+	return size;
+}
+
+static void logm_bin_puts(struct lib_outstream_s *stream, const char *str, int len)
+{
+	while (len-- > 0 && *str != '\0') {
+		stream->put(stream, *str++);
+	}
+}
+
+#define LOGM_BIN_PRINT(stream, spec, star, nstar, val) \
+	do { \
+		if ((nstar) == 0) { \
+			lib_sprintf(stream, spec, val); \
+		} else if ((nstar) == 1) { \
+			lib_sprintf(stream, spec, (star)[0], val); \
+		} else { \
+			lib_sprintf(stream, spec, (star)[0], (star)[1], val); \
+		} \
+	} while (0)
+
+/* Format one committed record */
+
+static void logm_bin_print(struct lib_outstream_s *stream, struct logm_binrec_s *rec)
+{
+	struct logm_conv_s conv;
+	const char *fmt;
+	const char *p;
+	const uint8_t *data;
+	const uint8_t *end;
+	char spec[LOGM_BIN_SPECMAX];
+	int star[2];
+	int i;
+
+	data = (const uint8_t *)(rec + 1);
+	end = (const uint8_t *)rec + rec->size;
+	if (rec->flags & LOGM_BIN_FMTCOPY) {
+		fmt = (const char *)data;
+		data += LOGM_BIN_ALIGN(strlen(fmt) + 1);
+	} else {
+		fmt = rec->fmt;
+	}
+
+#ifdef CONFIG_LOGM_TIMESTAMP
+	{
+		uint32_t msec = TICK2MSEC(rec->ticks);
+		lib_sprintf(stream, "[%4d.%4d] ", msec / 1000, (msec % 1000) * 10);
+	}
+#endif
+
+	for (; (p = logm_bin_nextconv(fmt, &conv)) != NULL; fmt = p + conv.len) {
+		logm_bin_puts(stream, fmt, p - fmt);
+		if (conv.type == LOGM_ARG_BAD) {
+			fmt = p;
+			break;
+		}
+
+		if (conv.type == LOGM_ARG_NONE) {
+			stream->put(stream, '%');
+			continue;
+		}
+
+		if (end - data < (int)(conv.nstar * sizeof(int)) + (conv.type == LOGM_ARG_STR ? 1 : logm_bin_argsize(conv.type))) {
+			/* The arguments were truncated */
+
+			logm_bin_puts(stream, "...\n", 4);
+			return;
+		}
+
+		for (i = 0; i < conv.nstar; i++) {
+			memcpy(&star[i], data, sizeof(int));
+			data += sizeof(int);
+		}
+
+		memcpy(spec, p, conv.len);
+		spec[conv.len] = '\0';
+		switch (conv.type) {
+		case LOGM_ARG_INT: {
+			int val;
+			memcpy(&val, data, sizeof(val));
+			LOGM_BIN_PRINT(stream, spec, star, conv.nstar, val);
+			break;
+		}
+#ifdef CONFIG_HAVE_LONG_LONG
+		case LOGM_ARG_LONGLONG: {
+			long long val;
+			memcpy(&val, data, sizeof(val));
+			LOGM_BIN_PRINT(stream, spec, star, conv.nstar, val);
+			break;
+		}
+#endif
+		case LOGM_ARG_DOUBLE: {
+			double val;
+			memcpy(&val, data, sizeof(val));
+			LOGM_BIN_PRINT(stream, spec, star, conv.nstar, val);
+			break;
+		}
+		case LOGM_ARG_PTR: {
+			void *val;
+			memcpy(&val, data, sizeof(val));
+			LOGM_BIN_PRINT(stream, spec, star, conv.nstar, val);
+			break;
+		}
+		case LOGM_ARG_STR:
+			LOGM_BIN_PRINT(stream, spec, star, conv.nstar, (const char *)data);
+			data += LOGM_BIN_ALIGN(strlen((const char *)data) + 1);
+			if (data >= end && (rec->flags & LOGM_BIN_TRUNCATED)) {
+				/* The string was cut */
+
+				logm_bin_puts(stream, "...\n", 4);
+				return;
+			}
+			break;
+		default:
+			break;
+		}
+
+		if (conv.type != LOGM_ARG_STR) {
+			data += logm_bin_argsize(conv.type);
+		}
+	}
+
+	logm_bin_puts(stream, fmt, strlen(fmt));
+	if (rec->flags & LOGM_BIN_TRUNCATED) {
+		logm_bin_puts(stream, "...\n", 4);
+	}
+}
+
+/* Format and remove all committed records, oldest first.  Stops at a record
+ * that is still being written.
+ */
+
+void logm_bin_flush(struct lib_outstream_s *stream)
+{
+	irqstate_t flags;
+	struct logm_binrec_s *rec;
+	int dropped;
+
+	while (g_logm_head != g_logm_tail) {
+		rec = (struct logm_binrec_s *)&g_logm_rsvbuf[g_logm_head];
+		if (((volatile struct logm_binrec_s *)rec)->state == LOGM_BIN_PAD) {
+			g_logm_head = 0;
+			continue;
+		}
+
+		if (((volatile struct logm_binrec_s *)rec)->state != LOGM_BIN_COMMITTED) {
+			break;
+		}
+
+		logm_bin_print(stream, rec);
+		g_logm_head = (g_logm_head + rec->size) % logm_bufsize;
+	}
+
+	flags = irqsave();
+	dropped = g_logm_dropmsg_count;
+	g_logm_dropmsg_count = 0;
+	LOGM_STATUS_CLEAR(LOGM_BUFFER_OVERFLOW);
+	irqrestore(flags);
+
+	if (dropped > 0) {
+		lib_sprintf(stream, "\n[LOGM BUFFER OVERFLOW] %d messages are dropped\n", dropped);
+	}
+}
+
+/* Print the raw buffer for tools/logm/logm_decoder.py */
+
+void logm_bin_dump(FILE *stream)
+{
+	int i;
+
+	fprintf(stream, "LOGM DUMP size=%d head=%d tail=%d ticks=%u usec_per_tick=%d\n", logm_bufsize, g_logm_head, g_logm_tail, (unsigned int)clock_systimer(), USEC_PER_TICK);
+	for (i = 0; i < logm_bufsize; i++) {
+		fprintf(stream, (i % 32) == 31 ? "%02x\n" : "%02x", (uint8_t)g_logm_rsvbuf[i]);
+	}
+	fprintf(stream, "\nLOGM DUMP END\n");
+}
@@ -19,10 +19,17 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <semaphore.h>
+#include <tinyara/semaphore.h>
 #include <sys/types.h>
 #include <arch/irq.h>
 #include <tinyara/logm.h>
 #include <tinyara/config.h>
+#include <tinyara/streams.h>
 #include "logm.h"
 #ifdef CONFIG_LOGM_TEST
 #include "logm_test.h"
@@ -32,6 +39,20 @@ uint8_t logm_status;
 int logm_bufsize = LOGM_BUFFER_SIZE;
 char * g_logm_rsvbuf = NULL;
 volatile int logm_print_interval = LOGM_PRINT_INTERVAL * 1000;
+sem_t g_logm_sem;
+char g_logm_output_path[LOGM_OUTPUT_PATH_MAX];
+static int g_logm_fd = -1;
+
+#ifdef CONFIG_LOGM_BINARY
+#define LOGM_WRITE_BUFSIZE 64
+
+/* Stream which collects formatted messages for one write() */
+struct logm_fdstream_s {
+	struct lib_outstream_s public;
+	int len;
+	char buf[LOGM_WRITE_BUFSIZE];
+};
+#endif
 
 static int logm_change_bufsize(int buflen)
 {
@@ -41,6 +62,11 @@ static int logm_change_bufsize(int buflen)
 		return ERROR;
 	}
 
+#ifdef CONFIG_LOGM_BINARY
+	/* Records are word aligned */
+	buflen &= ~3;
+#endif
+
 	/* Realloc new buffer with new length */
 	char *new_g_logm_rsvbuf = (char *)realloc(g_logm_rsvbuf, buflen);
 	if (new_g_logm_rsvbuf == NULL) {
@@ -62,9 +88,139 @@ static int logm_change_bufsize(int buflen)
 	return OK;
 }
 
+/* Open the output device, falling back to the task's stdout */
+static void logm_open_output(const char *path)
+{
+	int fd = ERROR;
+
+	if (path[0] != '\0') {
+		fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0666);
+	}
+
+	if (fd < 0) {
+		fflush(stdout);
+		fd = fileno(stdout);
+	}
+
+	if (g_logm_fd >= 0 && g_logm_fd != fileno(stdout)) {
+		close(g_logm_fd);
+	}
+	g_logm_fd = fd;
+}
+
+/* Write len bytes of the buffer, retrying on partial writes */
+static void logm_write(const char *buf, int len)
+{
+	ssize_t ret;
+
+	while (len > 0) {
+		ret = write(g_logm_fd, buf, len);
+		if (ret <= 0) {
+			if (ret < 0 && get_errno() == EINTR) {
+				continue;
+			}
+			/* Output is broken, drop the messages */
+			break;
+		}
+		buf += ret;
+		len -= ret;
+	}
+}
+
+#ifdef CONFIG_LOGM_BINARY
+static void logm_fdstream_flush(struct logm_fdstream_s *strm)
+{
+	logm_write(strm->buf, strm->len);
+	strm->len = 0;
+}
+
+static void logm_fdstream_putc(struct lib_outstream_s *this, int ch)
+{
+	struct logm_fdstream_s *strm = (struct logm_fdstream_s *)this;
+
+	strm->buf[strm->len++] = ch;
+	if (strm->len == LOGM_WRITE_BUFSIZE) {
+		logm_fdstream_flush(strm);
+	}
+	this->nput++;
+}
+#else
+/* Write the ring from head up to end in one piece */
+static void logm_drain_span(int end)
+{
+	irqstate_t flags;
+
+	/* Stop at the position where messages were dropped to report it there */
+	if (g_logm_overflow_offset > g_logm_head && g_logm_overflow_offset < end) {
+		end = g_logm_overflow_offset;
+	}
+
+	logm_write(&g_logm_rsvbuf[g_logm_head], end - g_logm_head);
+
+	flags = irqsave();
+	g_logm_head = end % logm_bufsize;
+	LOGM_STATUS_CLEAR(LOGM_BUFFER_OVERFLOW);
+	irqrestore(flags);
+
+	if (g_logm_overflow_offset >= 0 && g_logm_overflow_offset == g_logm_head) {
+		dprintf(g_logm_fd, "\n[LOGM BUFFER OVERFLOW] %d messages are dropped\n", g_logm_dropmsg_count);
+		g_logm_overflow_offset = -1;
+	}
+}
+
+/* Write everything queued, at most two contiguous pieces of the ring plus
+ * one more for each overflow report.
+ */
+static void logm_drain(void)
+{
+	int tail;
+
+	while (g_logm_head != (tail = g_logm_tail)) {
+		logm_drain_span(tail > g_logm_head ? tail : logm_bufsize);
+	}
+}
+#endif
+
+/* Sleep until the buffer fills up to the wakeup threshold or the print
+ * interval elapses.
+ */
+static void logm_wait(void)
+{
+	struct timespec abstime;
+	irqstate_t flags;
+
+	clock_gettime(CLOCK_REALTIME, &abstime);
+	abstime.tv_sec += logm_print_interval / 1000000;
+	abstime.tv_nsec += (logm_print_interval % 1000000) * 1000;
+	if (abstime.tv_nsec >= 1000000000) {
+		abstime.tv_sec++;
+		abstime.tv_nsec -= 1000000000;
+	}
+
+	(void)sem_timedwait(&g_logm_sem, &abstime);
+
+	flags = irqsave();
+	LOGM_STATUS_CLEAR(LOGM_DRAIN_REQ);
+	while (sem_trywait(&g_logm_sem) == OK) ;
+	irqrestore(flags);
+}
+
 int logm_task(int argc, char *argv[])
 {
 	irqstate_t flags;
+#ifdef CONFIG_LOGM_BINARY
+	struct logm_fdstream_s strm;
+
+	logm_bufsize &= ~3;
+	strm.public.put = logm_fdstream_putc;
+	strm.public.flush = lib_noflush;
+	strm.public.nput = 0;
+	strm.len = 0;
+#endif
+
+	logm_open_output(LOGM_OUTPUT_PATH);
+	sem_init(&g_logm_sem, 0, 0);
+	sem_setprotocol(&g_logm_sem, SEM_PRIO_NONE);
 
 	g_logm_rsvbuf = (char *)malloc(logm_bufsize);
 	memset(g_logm_rsvbuf, 0, logm_bufsize);
@@ -77,26 +233,34 @@ int logm_task(int argc, char *argv[])
 #endif
 
 	while (1) {
-		while (g_logm_head != g_logm_tail) {
-			fputc(g_logm_rsvbuf[g_logm_head], stdout);
-			g_logm_head = (g_logm_head + 1) % logm_bufsize;
-			if (LOGM_STATUS(LOGM_BUFFER_OVERFLOW)) {
-				LOGM_STATUS_CLEAR(LOGM_BUFFER_OVERFLOW);
-			}
-			if (g_logm_overflow_offset >= 0 && g_logm_overflow_offset == g_logm_head) {
-				fprintf(stdout, "\n[LOGM BUFFER OVERFLOW] %d messages are dropped\n", g_logm_dropmsg_count);
-				g_logm_overflow_offset = -1;
-			}
+#ifdef CONFIG_LOGM_BINARY
+		logm_bin_flush(&strm.public);
+		logm_fdstream_flush(&strm);
+#else
+		logm_drain();
+#endif
+
+		if (LOGM_STATUS(LOGM_OUTPUT_CHANGE_REQ)) {
+			logm_open_output(g_logm_output_path);
+			LOGM_STATUS_CLEAR(LOGM_OUTPUT_CHANGE_REQ);
 		}
 
 		if (LOGM_STATUS(LOGM_BUFFER_RESIZE_REQ)) {
 			flags = irqsave();
+#ifdef CONFIG_LOGM_BINARY
+			/* Wait until no record is being filled */
+			if (g_logm_writers > 0) {
+				irqrestore(flags);
+				logm_wait();
+				continue;
+			}
+#endif
 			if (logm_change_bufsize(new_logm_bufsize) != OK) {
-				fprintf(stdout, "\n[LOGM] Failed to change buffer size\n");
+				dprintf(g_logm_fd, "\n[LOGM] Failed to change buffer size\n");
 			}
 			irqrestore(flags);
 		}
-		usleep(logm_print_interval);
+		logm_wait();
 	}
 	return 0;					// Just to make compiler happy
 }
@@ -19,6 +19,7 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sched.h>
 #include <apps/shell/tash.h>
 #include <tinyara/logm.h>
 #include "logm.h"
@@ -38,13 +39,23 @@ void logm_register_tashcmds(void)
 static void logm_usage(void)
 {
 	fprintf(stdout, "[LOGM USAGE]\n");
-	fprintf(stdout, "usage: logm [-b <BUFSIZE>] [-i <TIME>]\n");
+#ifdef CONFIG_LOGM_BINARY
+	fprintf(stdout, "usage: logm [-b <BUFSIZE>] [-i <TIME>] [-o <PATH>] [-d]\n");
+#else
+	fprintf(stdout, "usage: logm [-b <BUFSIZE>] [-i <TIME>] [-o <PATH>]\n");
+#endif
 
 	fprintf(stdout, "options:\n");
 	fprintf(stdout, "    -b BUFSIZE\n");
 	fprintf(stdout, "        Set logm buffer size (bytes)\n");
 	fprintf(stdout, "    -i TIME\n");
 	fprintf(stdout, "        Set buffer flusing interval (ms)\n");
+	fprintf(stdout, "    -o PATH\n");
+	fprintf(stdout, "        Write messages to a device or file, stdout if it can not be opened\n");
+#ifdef CONFIG_LOGM_BINARY
+	fprintf(stdout, "    -d\n");
+	fprintf(stdout, "        Dump binary buffer for tools/logm/logm_decoder.py\n");
+#endif
 
 }
 
@@ -59,6 +70,7 @@ static void logm_info(void)
 	fprintf(stdout, "[LOGM CONFIGURATIONS]\n");
 	fprintf(stdout, "  Buffer size : %d (bytes)\n", bufsize);
 	fprintf(stdout, "  Flusing interval : %d (ms)\n", interval);
+	fprintf(stdout, "  Output : %s\n", g_logm_output_path[0] != '\0' ? g_logm_output_path : LOGM_OUTPUT_PATH);
 }
 
 static int logm_tash(int argc, char **args)
@@ -82,8 +94,10 @@ static int logm_tash(int argc, char **args)
 	/*
 	 * -b [bufsize] : set buffer size (bytes)
 	 * -i [time] : set buffer flushing interval (ms)
+	 * -o [path] : set output device or file
+	 * -d : dump binary buffer
 	 */
-	while ((opt = getopt(argc, args, "b:i:")) != -1) {
+	while ((opt = getopt(argc, args, "b:i:o:d")) != -1) {
 		switch (opt) {
 		case 'b':
 			/* TASH>> logm -b 10240 */
@@ -100,6 +114,23 @@ static int logm_tash(int argc, char **args)
 				logm_set_values(LOGM_INTERVAL, atoi(optarg));
 			}
 			break;
+		case 'o':
+			/* TASH>> logm -o /mnt/log.txt */
+			/* logm task reopens its output when it wakes up next */
+			if (optarg != NULL && strlen(optarg) < LOGM_OUTPUT_PATH_MAX) {
+				strncpy(g_logm_output_path, optarg, LOGM_OUTPUT_PATH_MAX);
+				LOGM_STATUS_SET(LOGM_OUTPUT_CHANGE_REQ);
+			}
+			break;
+#ifdef CONFIG_LOGM_BINARY
+		case 'd':
+			/* TASH>> logm -d */
+			/* keep logm task from draining the buffer while it is printed */
+			sched_lock();
+			logm_bin_dump(stdout);
+			sched_unlock();
+			break;
+#endif
 		default:
 			logm_usage();
 			return 0;
@@ -58,6 +58,8 @@
 
 #include <tinyara/mm/mm.h>
 
+#include "mm_node.h"
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -88,9 +90,19 @@ void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 
 	int ndx = mm_size2ndx(node->size);
 
+#ifdef CONFIG_MM_POLICY_TLSF
+	/* The lists are not sorted.  Put the new free node at the head of the
+	 * list and mark the list as non-empty.
+	 */
+
+	prev = &heap->mm_nodelist[ndx];
+	next = prev->flink;
+	MM_TLSF_SETBIT(heap, ndx);
+#else
 	/* Now put the new free node in a descending order */
 
 	for (prev = &heap->mm_nodelist[ndx], next = prev->flink; next && next->size > node->size; prev = next, next = next->flink) ;
+#endif
 
 	/* Does it go in mid next or at the end? */
 
@@ -64,7 +64,6 @@
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 #include  <tinyara/sched.h>
 #endif
-#include "mm_node.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -74,6 +73,50 @@
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_DEBUG_DOUBLE_FREE
+/****************************************************************************
+ * Name: mm_checkfree
+ *
+ * Description:
+ *   Assert on following logical error scenarios
+ *   1) Attempt to free an unallocated memory or
+ *   2) Attempt to release some arbitrary memory or
+ *   3) Attempt to release already released memory ( double free )
+ *   Catch this bug and report to USER in debug mode
+ *   1st scenario: int *ptr; free(ptr);
+ *   2nd scenario: int *ptr = (int*)0x02069f50; free(ptr);
+ *   3rd scenario: ptr = malloc(100); free(ptr); if(ptr) { free(ptr); }
+ *
+ *   It is assumed that the caller holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+static void mm_checkfree(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
+{
+	if ((node->preceding & MM_ALLOC_BIT) != MM_ALLOC_BIT) {
+		dbg("Attempt for double freeing a pointer or releasing an unallocated pointer\n");
+		PANIC();
+	}
+
+	/* Cached chunks are still marked as allocated.  The caches of other
+	 * threads cannot be searched, so only the one of this thread is.
+	 */
+
+#ifdef CONFIG_MM_TASK_CACHE
+	if (mm_tcache_cached(heap, (FAR struct mm_allocnode_s *)node)) {
+		dbg("Attempt for double freeing a pointer\n");
+		PANIC();
+	}
+#endif
+#ifdef CONFIG_MM_SIZECLASS
+	if (mm_sizeclass_cached(heap, (FAR struct mm_allocnode_s *)node)) {
+		dbg("Attempt for double freeing a pointer\n");
+		PANIC();
+	}
+#endif
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -89,8 +132,6 @@
 void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 {
 	FAR struct mm_freenode_s *node;
-	FAR struct mm_freenode_s *prev;
-	FAR struct mm_freenode_s *next;
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 	struct mm_allocnode_s *alloc_node;
 #endif
@@ -113,30 +154,35 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 		return;
 	}
 
-	/* We need to hold the MM semaphore while we muck with the
-	 * nodelist.
-	 */
-
-	mm_takesemaphore(heap);
-
 	/* Map the memory chunk into a free node */
 
 	node = (FAR struct mm_freenode_s *)((char *)mem - SIZEOF_MM_ALLOCNODE);
+
+#ifdef CONFIG_MM_TASK_CACHE
 #ifdef CONFIG_DEBUG_DOUBLE_FREE
-	/* Assert on following logical error scenarios
-	 * 1) Attempt to free an unallocated memory or
-	 * 2) Attempt to release some arbitrary memory or
-	 * 3) Attempt to release already released memory ( double free )
-	 * Catch this bug and report to USER in debug mode
-	 * 1st scenario: int *ptr; free(ptr);
-	 * 2nd scenario: int *ptr = (int*)0x02069f50; free(ptr);
-	 * 3rd scenario: ptr = malloc(100); free(ptr); if(ptr) { free(ptr); }
+	/* The cache below bypasses the check done under the semaphore */
+
+	mm_takesemaphore(heap);
+	mm_checkfree(heap, node);
+	mm_givesemaphore(heap);
+#endif
+
+	/* Keep small chunks in the cache of this thread for its next malloc.
+	 * The cache is private to the thread, so the MM semaphore is not needed.
 	 */
-	if ((node->preceding & MM_ALLOC_BIT) != MM_ALLOC_BIT) {
-		dbg("Attempt for double freeing a pointer or releasing an unallocated pointer\n");
-		PANIC();
+
+	if (mm_tcache_free(heap, (FAR struct mm_allocnode_s *)node)) {
+		return;
 	}
+#endif
 
+	/* We need to hold the MM semaphore while we muck with the
+	 * nodelist.
+	 */
+
+	mm_takesemaphore(heap);
+#ifdef CONFIG_DEBUG_DOUBLE_FREE
+	mm_checkfree(heap, node);
 #endif
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 	alloc_node = (struct mm_allocnode_s *)node;
@@ -146,55 +192,17 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 		heapinfo_update_total_size(heap, ((-1) * alloc_node->size), alloc_node->pid);
 	}
 #endif
-	node->preceding &= ~MM_ALLOC_BIT;
-
-	/* Check if the following node is free and, if so, merge it */
-
-	next = (FAR struct mm_freenode_s *)((char *)node + node->size);
-	if ((next->preceding & MM_ALLOC_BIT) == 0) {
-		FAR struct mm_allocnode_s *andbeyond;
+#ifdef CONFIG_MM_SIZECLASS
+	/* Keep small chunks on their size class stack for the next malloc */
 
-		/* Get the node following the next node (which will
-		 * become the new next node). We know that we can never
-		 * index past the tail chunk because it is always allocated.
-		 */
-
-		andbeyond = (FAR struct mm_allocnode_s *)((char *)next + next->size);
-
-		/* Remove the next node.  There must be a predecessor,
-		 * but there may not be a successor node.
-		 */
-
-		REMOVE_NODE_FROM_LIST(next);
-
-		/* Then merge the two chunks */
-
-		node->size          += next->size;
-		andbeyond->preceding = node->size | (andbeyond->preceding & MM_ALLOC_BIT);
-		next                 = (FAR struct mm_freenode_s *)andbeyond;
-	}
-
-	/* Check if the preceding node is also free and, if so, merge
-	 * it with this node
-	 */
-
-	prev = (FAR struct mm_freenode_s *)((char *)node - node->preceding);
-	if ((prev->preceding & MM_ALLOC_BIT) == 0) {
-		/* Remove the node.  There must be a predecessor, but there may
-		 * not be a successor node.
-		 */
-
-		REMOVE_NODE_FROM_LIST(prev);
-
-		/* Then merge the two chunks */
-
-		prev->size     += node->size;
-		next->preceding = prev->size | (next->preceding & MM_ALLOC_BIT);
-		node            = prev;
+	if (mm_sizeclass_push(heap, (FAR struct mm_allocnode_s *)node)) {
+		mm_givesemaphore(heap);
+		return;
 	}
+#endif
 
-	/* Add the merged node to the nodelist */
+	/* Merge the chunk with its neighbors and add it to the nodelist */
 
-	mm_addfreechunk(heap, node);
+	mm_freechunk(heap, node);
 	mm_givesemaphore(heap);
 }
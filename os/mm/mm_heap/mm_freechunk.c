@@ -0,0 +1,99 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <tinyara/mm/mm.h>
+
+#include "mm_node.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_freechunk
+ *
+ * Description:
+ *   Return an allocated chunk to the nodelist, merging it with adjacent
+ *   free chunks if possible.  It is assumed that the caller holds the mm
+ *   semaphore and has already removed the chunk from the heapinfo
+ *   accounting.
+ *
+ ****************************************************************************/
+
+void mm_freechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
+{
+	FAR struct mm_freenode_s *prev;
+	FAR struct mm_freenode_s *next;
+
+	node->preceding &= ~MM_ALLOC_BIT;
+
+	/* Check if the following node is free and, if so, merge it */
+
+	next = (FAR struct mm_freenode_s *)((char *)node + node->size);
+	if ((next->preceding & MM_ALLOC_BIT) == 0) {
+		FAR struct mm_allocnode_s *andbeyond;
+
+		/* Get the node following the next node (which will
+		 * become the new next node). We know that we can never
+		 * index past the tail chunk because it is always allocated.
+		 */
+
+		andbeyond = (FAR struct mm_allocnode_s *)((char *)next + next->size);
+
+		/* Remove the next node.  There must be a predecessor,
+		 * but there may not be a successor node.
+		 */
+
+		REMOVE_NODE_FROM_LIST(heap, next);
+
+		/* Then merge the two chunks */
+
+		node->size          += next->size;
+		andbeyond->preceding = node->size | (andbeyond->preceding & MM_ALLOC_BIT);
+		next                 = (FAR struct mm_freenode_s *)andbeyond;
+	}
+
+	/* Check if the preceding node is also free and, if so, merge
+	 * it with this node
+	 */
+
+	prev = (FAR struct mm_freenode_s *)((char *)node - node->preceding);
+	if ((prev->preceding & MM_ALLOC_BIT) == 0) {
+		/* Remove the node.  There must be a predecessor, but there may
+		 * not be a successor node.
+		 */
+
+		REMOVE_NODE_FROM_LIST(heap, prev);
+
+		/* Then merge the two chunks */
+
+		prev->size     += node->size;
+		next->preceding = prev->size | (next->preceding & MM_ALLOC_BIT);
+		node            = prev;
+	}
+
+	/* Add the merged node to the nodelist */
+
+	mm_addfreechunk(heap, node);
+}
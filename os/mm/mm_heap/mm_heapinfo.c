@@ -59,8 +59,10 @@
 #include <unistd.h>
 #include <stdint.h>
 #include <stdio.h>
-#ifdef CONFIG_HEAPINFO_USER_GROUP
+#if defined(CONFIG_HEAPINFO_USER_GROUP) || defined(CONFIG_MM_TASK_CACHE)
 #include <string.h>
+#endif
+#ifdef CONFIG_HEAPINFO_USER_GROUP
 #include <tinyara/mm/heapinfo_internal.h>
 #endif
 
@@ -80,6 +82,66 @@ struct heapinfo_group_info_s group_info[HEAPINFO_THREAD_NUM];
 heapinfo_total_info_t total_info;
 #endif
 
+#ifdef CONFIG_MM_TASK_CACHE
+struct heapinfo_tcache_s {
+	pid_t pid;
+	uint8_t nchunks;
+	uint32_t nhits;
+	uint32_t nmisses;
+};
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#if defined(CONFIG_DEBUG_MM_HEAPINFO) && defined(CONFIG_MM_TASK_CACHE)
+/****************************************************************************
+ * Name: heapinfo_collect_tcache
+ *
+ * Description:
+ *   Copy the thread cache statistics of a tcb.  This is called by
+ *   sched_foreach() with interrupts disabled, so nothing is printed here.
+ ****************************************************************************/
+static void heapinfo_collect_tcache(FAR struct tcb_s *tcb, FAR void *arg)
+{
+	struct heapinfo_tcache_s *info = (struct heapinfo_tcache_s *)arg + PIDHASH(tcb->pid);
+
+	info->pid = tcb->pid;
+	info->nchunks = tcb->tcache.nchunks;
+	info->nhits = tcb->tcache.nhits;
+	info->nmisses = tcb->tcache.nmisses;
+}
+
+/****************************************************************************
+ * Name: heapinfo_show_tcache
+ *
+ * Description:
+ *   Display the cache hit and miss counts of all threads.
+ ****************************************************************************/
+static void heapinfo_show_tcache(void)
+{
+	struct heapinfo_tcache_s info[CONFIG_MAX_TASKS];
+	int ndx;
+
+	memset(info, 0, sizeof(info));
+	for (ndx = 0; ndx < CONFIG_MAX_TASKS; ndx++) {
+		info[ndx].pid = HEAPINFO_NONSCHED;
+	}
+
+	sched_foreach(heapinfo_collect_tcache, info);
+
+	printf("\n< Thread Cache >\n");
+	printf(" Pid | Cached |    Hits    |   Misses   \n");
+	printf("-----|--------|------------|------------\n");
+	for (ndx = 0; ndx < CONFIG_MAX_TASKS; ndx++) {
+		if (info[ndx].pid != HEAPINFO_NONSCHED && (info[ndx].nhits || info[ndx].nmisses)) {
+			printf("%4d | %6u | %10u | %10u\n", info[ndx].pid, info[ndx].nchunks, info[ndx].nhits, info[ndx].nmisses);
+		}
+	}
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -156,6 +218,17 @@ void heapinfo_parse(FAR struct mm_heap_s *heap, int mode, pid_t pid)
 		for (node = heap->mm_heapstart[region]; node < heap->mm_heapend[region]; node = (struct mm_allocnode_s *)((char *)node + node->size)) {
 
 			/* Check if the node corresponds to an allocated memory chunk */
+#ifdef CONFIG_MM_SIZECLASS
+			if (node->pid == HEAPINFO_SIZECLASS && (node->preceding & MM_ALLOC_BIT) != 0) {
+				/* Free chunk kept on a size class stack */
+				ordblks++;
+				fordblks += node->size;
+				if (mode == HEAPINFO_DETAIL_ALL || mode == HEAPINFO_DETAIL_FREE || mode == HEAPINFO_DETAIL_SPECIFIC_HEAP) {
+					printf("0x%x | %8d |   %c    |            |       |\n", node, node->size, 'C');
+				}
+				continue;
+			}
+#endif
 			if ((pid == HEAPINFO_PID_ALL || node->pid == pid) && (node->preceding & MM_ALLOC_BIT) != 0) {
 				if (mode == HEAPINFO_DETAIL_ALL || mode == HEAPINFO_DETAIL_PID || mode == HEAPINFO_DETAIL_SPECIFIC_HEAP) {
 					if (node->pid >= 0) {
@@ -195,7 +268,11 @@ void heapinfo_parse(FAR struct mm_heap_s *heap, int mode, pid_t pid)
 		}
 
 		if (mode != HEAPINFO_SIMPLE) {
-			printf("** PID(S) in Pid colum means that mem is used for stack of PID\n\n");
+			printf("** PID(S) in Pid colum means that mem is used for stack of PID\n");
+#ifdef CONFIG_MM_SIZECLASS
+			printf("** Status C means that mem is free and cached in a size class\n");
+#endif
+			printf("\n");
 		}
 		mm_givesemaphore(heap);
 	}
@@ -250,17 +327,21 @@ void heapinfo_parse(FAR struct mm_heap_s *heap, int mode, pid_t pid)
 
 	mm_takesemaphore(heap);
 
-	for (ndx = 0; ndx < MM_NNODES; ++ndx) {
+	for (ndx = 0; ndx < MM_NLISTS; ++ndx) {
 		for (fnode = heap->mm_nodelist[ndx].flink; fnode && fnode->size; fnode = fnode->flink) {
-			++nodelist_cnt[ndx];
-			nodelist_size[ndx] += fnode->size;
+			++nodelist_cnt[ndx >> MM_SL_SHIFT];
+			nodelist_size[ndx >> MM_SL_SHIFT] += fnode->size;
 		}
 	}
 
 	mm_givesemaphore(heap);
 
 	for (ndx = 0; ndx < MM_NNODES; ++ndx) {
+#ifdef CONFIG_MM_POLICY_TLSF
+		printf("Nodelist[%d] ranging [%u, %u] : num %d, size %u [Bytes]\n", ndx, 1 << (ndx + MM_MIN_SHIFT), (1 << (ndx + MM_MIN_SHIFT + 1)) - 1, nodelist_cnt[ndx], nodelist_size[ndx]);
+#else
 		printf("Nodelist[%d] ranging [%u, %u] : num %d, size %u [Bytes]\n", ndx, ((ndx > 0 ? (1 << (ndx + MM_MIN_SHIFT)) : 0) + 1), 1 << (ndx + MM_MIN_SHIFT + 1), nodelist_cnt[ndx], nodelist_size[ndx]);
+#endif
 	}
 #endif
 
@@ -275,6 +356,10 @@ void heapinfo_parse(FAR struct mm_heap_s *heap, int mode, pid_t pid)
 		}
 	}
 
+#ifdef CONFIG_MM_TASK_CACHE
+	heapinfo_show_tcache();
+#endif
+
 	return;
 }
 /****************************************************************************
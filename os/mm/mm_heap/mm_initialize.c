@@ -220,7 +220,17 @@ void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart, size_t heaps
 
 	/* Initialize the node array */
 
-	memset(heap->mm_nodelist, 0, sizeof(struct mm_freenode_s) * (MM_NNODES + 1));
+	memset(heap->mm_nodelist, 0, sizeof(struct mm_freenode_s) * (MM_NLISTS + 1));
+#ifdef CONFIG_MM_POLICY_TLSF
+	heap->mm_fl_bitmap = 0;
+	memset(heap->mm_sl_bitmap, 0, sizeof(heap->mm_sl_bitmap));
+#endif
+
+#ifdef CONFIG_MM_SIZECLASS
+	/* Start with empty size class stacks */
+
+	mm_sizeclass_initialize(heap);
+#endif
 
 	/* Initialize the malloc semaphore to one (to support one-at-
 	 * a-time access to private data sets).
@@ -137,6 +137,18 @@ int mm_mallinfo(FAR struct mm_heap_s *heap, FAR struct mallinfo *info)
 
 	DEBUGASSERT(uordblks + fordblks == heap->mm_heapsize);
 
+#ifdef CONFIG_MM_SIZECLASS
+	/* Chunks on the size class stacks look allocated while walking the
+	 * heap, but they are free from the point of view of the user.
+	 */
+
+	mm_takesemaphore(heap);
+	ordblks  += heap->mm_sizeclass_nchunks;
+	uordblks -= heap->mm_sizeclass_size;
+	fordblks += heap->mm_sizeclass_size;
+	mm_givesemaphore(heap);
+#endif
+
 #if CONFIG_KMM_NHEAPS > 1
 	info->arena    += heap->mm_heapsize;
 	info->ordblks  += ordblks;
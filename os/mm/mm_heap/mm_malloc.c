@@ -111,7 +111,9 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 {
 	FAR struct mm_freenode_s *node;
 	void *ret = NULL;
+#ifndef CONFIG_MM_POLICY_TLSF
 	int ndx;
+#endif
 
 	/* Handle bad sizes */
 
@@ -132,10 +134,48 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
 	size = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
 
+#ifdef CONFIG_MM_TASK_CACHE
+	/* Reuse a chunk recently freed by this thread.  The cache is private to
+	 * the thread, so the MM semaphore is not needed.
+	 */
+
+	node = (FAR struct mm_freenode_s *)mm_tcache_alloc(heap, size);
+	if (node) {
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		((struct mm_allocnode_s *)node)->alloc_call_addr = caller_retaddr;
+#endif
+		return (void *)((char *)node + SIZEOF_MM_ALLOCNODE);
+	}
+#endif
+
 	/* We need to hold the MM semaphore while we muck with the nodelist. */
 
 	mm_takesemaphore(heap);
 
+#ifdef CONFIG_MM_SIZECLASS
+	/* Small chunks freed earlier are kept on per-size-class stacks.  Serve
+	 * the request from there without searching the nodelist.
+	 */
+
+	node = (FAR struct mm_freenode_s *)mm_sizeclass_pop(heap, size);
+	if (node) {
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		heapinfo_update_node((struct mm_allocnode_s *)node, caller_retaddr);
+		heapinfo_add_size(heap, ((struct mm_allocnode_s *)node)->pid, node->size);
+		heapinfo_update_total_size(heap, node->size, ((struct mm_allocnode_s *)node)->pid);
+#endif
+		mm_givesemaphore(heap);
+		return (void *)((char *)node + SIZEOF_MM_ALLOCNODE);
+	}
+#endif
+
+#ifdef CONFIG_MM_POLICY_TLSF
+	/* Take the first chunk of the first non-empty list whose chunks are all
+	 * large enough.  The bitmaps of the heap give that list in constant time.
+	 */
+
+	node = mm_tlsf_search(heap, size);
+#else
 	/* Get the location in the node list to start the search
 	 * by converting the request size into a nodelist index.
 	 */
@@ -159,13 +199,14 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 	if (!(node && node->size == size)) {
 		node = prev;
 	}
+#endif
 
 	/* If we found a node with non-zero size, then this is one to use. Since
 	 * the list is ordered, we know that is must be best fitting chunk
 	 * available.
 	 */
 
-	if (node->size) {
+	if (node && node->size) {
 		FAR struct mm_freenode_s *remainder;
 		FAR struct mm_freenode_s *next;
 		size_t remaining;
@@ -174,7 +215,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 		 * a successor node.
 		 */
 
-		REMOVE_NODE_FROM_LIST(node);
+		REMOVE_NODE_FROM_LIST(heap, node);
 
 		/* Check if we have to split the free node into one of the allocated
 		 * size and another smaller freenode.  In some cases, the remaining
@@ -221,6 +262,40 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 #endif
 		ret = (void *)((char *)node + SIZEOF_MM_ALLOCNODE);
 	}
+#ifdef CONFIG_MM_TASK_CACHE
+	else if (mm_tcache_flush(heap) > 0) {
+		/* The chunks cached by this thread may merge into a large enough
+		 * chunk.  Search again now that they are back in the nodelist.
+		 */
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		ret = mm_malloc(heap, size - SIZEOF_MM_ALLOCNODE, caller_retaddr);
+#else
+		ret = mm_malloc(heap, size - SIZEOF_MM_ALLOCNODE);
+#endif
+		/* The search again has reported its result already */
+
+		mm_givesemaphore(heap);
+		return ret;
+	}
+#endif
+#ifdef CONFIG_MM_SIZECLASS
+	else if (mm_sizeclass_flush(heap) > 0) {
+		/* The cached small chunks may merge into a large enough chunk.
+		 * Search again now that they are back in the nodelist.
+		 */
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		ret = mm_malloc(heap, size - SIZEOF_MM_ALLOCNODE, caller_retaddr);
+#else
+		ret = mm_malloc(heap, size - SIZEOF_MM_ALLOCNODE);
+#endif
+		/* The search again has reported its result already */
+
+		mm_givesemaphore(heap);
+		return ret;
+	}
+#endif
 
 	mm_givesemaphore(heap);
 
@@ -155,8 +155,15 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment, size_t size)
 	 * If this list does not have free nodes whose size is large enough
 	 * to accommodate the requested size, it will fail due to no more space.
 	 */
-	for (; ndx < MM_NNODES; ndx++) {
+	for (; ndx < MM_NLISTS; ndx++) {
 		node = heap->mm_nodelist[ndx].flink;
+#ifdef CONFIG_MM_POLICY_TLSF
+		/* The lists are not sorted.  Try every node of the list, the
+		 * nodes smaller than the required size never fit below.
+		 */
+
+		for ( ; node; node = node->flink) {
+#else
 		if (!(node && node->size >= newsize)) {
 			/* If the list at this index is empty or if the size of first node
 			 * in the list is less than the required size, then go to next index.
@@ -176,6 +183,7 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment, size_t size)
 
 		/* Now, traverse the list in reverse direction, towards bigger size nodes */
 		for ( ; node; node = node->blink) {
+#endif
 			/* Search the suitable aligned address in the same node. */
 			for (alignchunk = (FAR struct mm_allocnode_s *)(((size_t)node + SIZEOF_MM_ALLOCNODE + mask) & ~mask);
 				(uintptr_t)(alignchunk + alignment) < (uintptr_t)(node + node->size);
@@ -212,7 +220,7 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment, size_t size)
 		 * a successor node.
 		 */
 
-		REMOVE_NODE_FROM_LIST(node);
+		REMOVE_NODE_FROM_LIST(heap, node);
 
 		/* Check if there is free space at the beginning of the aligned chunk */
 		if ((size_t)newnode - (size_t)node >= SIZEOF_MM_FREENODE) {
@@ -248,12 +256,13 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment, size_t size)
 
 		/* Check if there is free space at the end of the aligned chunk */
 
-		if (node->size > size + SIZEOF_MM_ALLOCNODE) {
+		if (node->size > newsize) {
 			/* Shrink the chunk by that much -- remember, mm_shrinkchunk wants
-			 * internal chunk sizes that include SIZEOF_MM_ALLOCNODE, and not the
-			 * malloc-compatible sizes that we have.
+			 * internal chunk sizes that include SIZEOF_MM_ALLOCNODE and are
+			 * aligned to the granule, and not the malloc-compatible sizes
+			 * that we have.
 			 */
-			mm_shrinkchunk(heap, (FAR struct mm_allocnode_s *)node, size + SIZEOF_MM_ALLOCNODE);
+			mm_shrinkchunk(heap, (FAR struct mm_allocnode_s *)node, newsize);
 		}
 
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
@@ -264,6 +273,38 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment, size_t size)
 
 		ret = (void *)alignchunk;
 	}
+#ifdef CONFIG_MM_TASK_CACHE
+	else if (mm_tcache_flush(heap) > 0) {
+		/* Search again with the chunks cached by this thread back in the
+		 * nodelist.
+		 */
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		ret = mm_memalign(heap, alignment, size, caller_retaddr);
+#else
+		ret = mm_memalign(heap, alignment, size);
+#endif
+		/* The search again has reported its result already */
+
+		mm_givesemaphore(heap);
+		return ret;
+	}
+#endif
+#ifdef CONFIG_MM_SIZECLASS
+	else if (mm_sizeclass_flush(heap) > 0) {
+		/* Search again with the cached small chunks back in the nodelist */
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		ret = mm_memalign(heap, alignment, size, caller_retaddr);
+#else
+		ret = mm_memalign(heap, alignment, size);
+#endif
+		/* The search again has reported its result already */
+
+		mm_givesemaphore(heap);
+		return ret;
+	}
+#endif
 
 	mm_givesemaphore(heap);
 
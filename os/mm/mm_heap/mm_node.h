@@ -23,19 +23,59 @@
  * Included Files
  ****************************************************************************/
 
+#include <stdint.h>
 #include <assert.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define REMOVE_NODE_FROM_LIST(node)				\
+#ifdef CONFIG_MM_POLICY_TLSF
+/* Index of the most and the least significant set bit of a non-zero word.
+ * Both map on the CLZ instruction of ARM.
+ */
+
+#define MM_FLS(w)  (31 - __builtin_clz((uint32_t)(w)))
+#define MM_FFS(w)  MM_FLS((w) & -(w))
+
+/* Mark the list 'ndx' as non-empty or empty in the TLSF bitmaps */
+
+#define MM_TLSF_SETBIT(heap, ndx)						\
+	do {									\
+		(heap)->mm_sl_bitmap[(ndx) >> MM_SL_SHIFT] |= 1 << ((ndx) & (MM_SL_COUNT - 1)); \
+		(heap)->mm_fl_bitmap |= 1 << ((ndx) >> MM_SL_SHIFT);		\
+	} while (0)
+
+#define MM_TLSF_CLEARBIT(heap, ndx)						\
+	do {									\
+		(heap)->mm_sl_bitmap[(ndx) >> MM_SL_SHIFT] &= ~(1 << ((ndx) & (MM_SL_COUNT - 1))); \
+		if ((heap)->mm_sl_bitmap[(ndx) >> MM_SL_SHIFT] == 0) {		\
+			(heap)->mm_fl_bitmap &= ~(1 << ((ndx) >> MM_SL_SHIFT));	\
+		}								\
+	} while (0)
+
+/* The list heads are the only nodes with a zero size.  If the removed node
+ * was the only node of its list, the list becomes empty.
+ */
+
+#define MM_TLSF_REMOVED(heap, node)						\
+	do {									\
+		if (!(node)->flink && (node)->blink->size == 0) {		\
+			MM_TLSF_CLEARBIT(heap, (node)->blink - (heap)->mm_nodelist); \
+		}								\
+	} while (0)
+#else
+#define MM_TLSF_REMOVED(heap, node)
+#endif
+
+#define REMOVE_NODE_FROM_LIST(heap, node)			\
 	do {							\
 		DEBUGASSERT((node)->blink);			\
 		(node)->blink->flink = (node)->flink;		\
 		if ((node)->flink) {				\
 			(node)->flink->blink = (node)->blink;	\
 		}						\
+		MM_TLSF_REMOVED(heap, node);			\
 	} while (0)
 
 /****************************************************************************
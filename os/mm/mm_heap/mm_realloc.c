@@ -74,6 +74,60 @@
  * Private Functions
  ****************************************************************************/
 
+#ifndef CONFIG_REALLOC_DISABLE_NEIGHBOR_EXTENSION
+/****************************************************************************
+ * Name: mm_takenext
+ *
+ * Description:
+ *   Extend the allocated chunk 'node' by 'takenext' bytes taken from the
+ *   free chunk 'next' which follows it.  What is left of 'next', if large
+ *   enough, is returned to the nodelist.  It is assumed that the caller
+ *   holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+static void mm_takenext(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node, FAR struct mm_freenode_s *next, size_t takenext)
+{
+	FAR struct mm_freenode_s *newnode;
+	FAR struct mm_allocnode_s *andbeyond;
+	size_t nextsize = next->size;
+
+	/* Get the chunk following the next node (which could be the tail
+	 * chunk)
+	 */
+
+	andbeyond = (FAR struct mm_allocnode_s *)((char *)next + nextsize);
+
+	/* Remove the next node.  There must be a predecessor, but there
+	 * may not be a successor node.
+	 */
+
+	REMOVE_NODE_FROM_LIST(heap, next);
+
+	/* Extend the node into the next chunk */
+	/* Did we consume the entire next chunk? */
+
+	if ((nextsize - takenext) >= SIZEOF_MM_FREENODE) {
+		/* No, take what we need from the next chunk and return it to
+		 * the free nodelist.
+		 */
+		node->size          += takenext;
+		newnode              = (FAR struct mm_freenode_s *)((char *)node + node->size);
+		newnode->size        = nextsize - takenext;
+		newnode->preceding   = node->size;
+		andbeyond->preceding = newnode->size | (andbeyond->preceding & MM_ALLOC_BIT);
+
+		/* Add the new free node to the nodelist (with the new size) */
+
+		mm_addfreechunk(heap, newnode);
+	} else {
+		/* Yes, just update some pointers. */
+		node->size          += nextsize;
+		andbeyond->preceding = node->size | (andbeyond->preceding & MM_ALLOC_BIT);
+	}
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -91,9 +145,10 @@
  *  If the request is for more space and the current allocation can be
  *  extended, it will be extended by:
  *
- *     (1) Taking the additional space from the following free chunk, or
- *     (2) Taking the additional space from the preceding free chunk.
- *     (3) Or both
+ *     (1) Taking the additional space from the following free chunk, which
+ *         leaves the data in place, or if that is not enough,
+ *     (2) Taking the whole following free chunk and the rest from the
+ *         preceding free chunk.  The data is then moved down in memory.
  *
  *  If the request is for more space but the current chunk cannot be
  *  extended, then malloc a new buffer, copy the data into the new buffer,
@@ -211,50 +266,23 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 		heapinfo_update_total_size(heap, (-1) * oldsize, oldnode->pid);
 #endif
 
-		/* Check if we can extend into the previous chunk and if the
-		 * previous chunk is smaller than the next chunk.
+		/* Growing into the next chunk leaves the data where it is, so take
+		 * as much as possible from there.  The previous chunk is used only
+		 * for the rest, because the data has to be moved then.
 		 */
 
-		if (prevsize > 0 && (nextsize >= prevsize || nextsize < 1)) {
-			/* Can we get everything we need from the previous chunk? */
-
-			if (needed > prevsize) {
-				/* No, take the whole previous chunk and get the
-				 * rest that we need from the next chunk.
-				 */
-
-				takeprev = prevsize;
-				takenext = needed - prevsize;
-			} else {
-				/* Yes, take what we need from the previous chunk */
-
-				takeprev = needed;
-				takenext = 0;
-			}
-
-			needed = 0;
+		if (needed > nextsize) {
+			takenext = nextsize;
+			takeprev = needed - nextsize;
+		} else {
+			takenext = needed;
 		}
 
-		/* Check if we can extend into the next chunk and if we still need
-		 * more memory.
-		 */
-
-		if (nextsize > 0 && needed) {
-			/* Can we get everything we need from the next chunk? */
-
-			if (needed > nextsize) {
-				/* No, take the whole next chunk and get the rest that we
-				 * need from the previous chunk.
-				 */
-
-				takeprev = needed - nextsize;
-				takenext = nextsize;
-			} else {
-				/* Yes, take what we need from the previous chunk */
+		/* Extend into the next free chunk */
 
-				takeprev = 0;
-				takenext = needed;
-			}
+		if (takenext) {
+			mm_takenext(heap, oldnode, next, takenext);
+			next = (FAR struct mm_freenode_s *)((FAR char *)oldnode + oldnode->size);
 		}
 
 		/* Extend into the previous free chunk */
@@ -267,7 +295,7 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 			 * there may not be a successor node.
 			 */
 
-			REMOVE_NODE_FROM_LIST(prev);
+			REMOVE_NODE_FROM_LIST(heap, prev);
 
 			/* Extend the node into the previous free chunk */
 			/* Did we consume the entire preceding chunk? */
@@ -278,7 +306,7 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 				 */
 				newnode            = (FAR struct mm_allocnode_s *)((FAR char *)oldnode - takeprev);
 				prev->size        -= takeprev;
-				newnode->size      = oldsize + takeprev;
+				newnode->size      = oldnode->size + takeprev;
 				newnode->preceding = prev->size | MM_ALLOC_BIT;
 				next->preceding    = newnode->size | (next->preceding & MM_ALLOC_BIT);
 
@@ -289,63 +317,21 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 				/* Yes.. update its size (newnode->preceding is already set) */
 				takeprev            = prev->size;
 				newnode             = (FAR struct mm_allocnode_s *)((FAR char *)oldnode - takeprev);
-				newnode->size      += oldsize;
+				newnode->size      += oldnode->size;
 				newnode->preceding |= MM_ALLOC_BIT;
 				next->preceding     = newnode->size | (next->preceding & MM_ALLOC_BIT);
 			}
 
 			oldnode = newnode;
-			oldsize = newnode->size;
 
-			/* Now we have to move the user contents 'down' in memory.  memcpy should
-			 * should be save for this.
+			/* Now we have to move the user contents 'down' in memory.  The
+			 * old and the new locations may overlap.
 			 */
 
 			newmem = (FAR void *)((FAR char *)newnode + SIZEOF_MM_ALLOCNODE);
-			memcpy(newmem, oldmem, oldsize - SIZEOF_MM_ALLOCNODE);
+			memmove(newmem, oldmem, oldsize - SIZEOF_MM_ALLOCNODE);
 		}
 
-		/* Extend into the next free chunk */
-
-		if (takenext) {
-			FAR struct mm_freenode_s *newnode;
-			FAR struct mm_allocnode_s *andbeyond;
-
-			/* Get the chunk following the next node (which could be the tail
-			 * chunk)
-			 */
-
-			andbeyond = (FAR struct mm_allocnode_s *)((char *)next + nextsize);
-
-			/* Remove the next node.  There must be a predecessor, but there
-			 * may not be a successor node.
-			 */
-
-			REMOVE_NODE_FROM_LIST(next);
-
-			/* Extend the node into the next chunk */
-			/* Did we consume the entire preceding chunk? */
-
-			if ((nextsize - takenext) >= SIZEOF_MM_FREENODE) {
-				/* No, take what we need from the next chunk and return it to
-				 * the free nodelist.
-				 */
-				oldnode->size        = oldsize + takenext;
-				newnode              = (FAR struct mm_freenode_s *)((char *)oldnode + oldnode->size);
-				newnode->size        = nextsize - takenext;
-				newnode->preceding   = oldnode->size;
-				andbeyond->preceding = newnode->size | (andbeyond->preceding & MM_ALLOC_BIT);
-
-				/* Add the new free node to the nodelist (with the new size) */
-
-				mm_addfreechunk(heap, newnode);
-			} else {
-				/* Yes, just update some pointers. */
-				takenext             = nextsize;
-				oldnode->size        = oldsize + takenext;
-				andbeyond->preceding = oldnode->size | (andbeyond->preceding & MM_ALLOC_BIT);
-			}
-		}
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 		/* update the chunk to realloc task information */
 		heapinfo_update_node(oldnode, caller_retaddr);
@@ -380,3 +366,74 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 		return newmem;
 	}
 }
+
+/****************************************************************************
+ * Name: mm_try_expand
+ *
+ * Description:
+ *   Resize an allocation without ever moving it.  The allocation grows
+ *   only into the free chunk which follows it, and a request for less
+ *   space shrinks it in place as mm_realloc() does.  This lets a buffer
+ *   grow without holding the old and the new copies at the same time.
+ *
+ * Return Value:
+ *   'mem' if the allocation now holds at least 'size' bytes, NULL if it
+ *   cannot grow in place.  The allocation is left unchanged on failure.
+ *
+ ****************************************************************************/
+
+FAR void *mm_try_expand(FAR struct mm_heap_s *heap, FAR void *mem, size_t size)
+{
+	FAR struct mm_allocnode_s *node;
+#ifndef CONFIG_REALLOC_DISABLE_NEIGHBOR_EXTENSION
+	FAR struct mm_freenode_s *next;
+#endif
+	FAR void *ret = NULL;
+	size_t newsize;
+	size_t oldsize;
+
+	if (!mem || size < 1 || size > MM_ALIGN_DOWN(MMSIZE_MAX) - SIZEOF_MM_ALLOCNODE) {
+		return NULL;
+	}
+
+	newsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
+	node = (FAR struct mm_allocnode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+
+	mm_takesemaphore(heap);
+
+	oldsize = node->size;
+	if (newsize < oldsize) {
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		heapinfo_subtract_size(heap, node->pid, oldsize);
+		heapinfo_update_total_size(heap, (-1) * oldsize, node->pid);
+#endif
+		mm_shrinkchunk(heap, node, newsize);
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		heapinfo_add_size(heap, node->pid, node->size);
+		heapinfo_update_total_size(heap, node->size, node->pid);
+#endif
+		ret = mem;
+	} else if (newsize == oldsize) {
+		ret = mem;
+	}
+#ifndef CONFIG_REALLOC_DISABLE_NEIGHBOR_EXTENSION
+	else {
+		next = (FAR struct mm_freenode_s *)((FAR char *)node + oldsize);
+		if ((next->preceding & MM_ALLOC_BIT) == 0 && oldsize + next->size >= newsize) {
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+			heapinfo_subtract_size(heap, node->pid, oldsize);
+			heapinfo_update_total_size(heap, (-1) * oldsize, node->pid);
+#endif
+			mm_takenext(heap, node, next, newsize - oldsize);
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+			heapinfo_add_size(heap, node->pid, node->size);
+			heapinfo_update_total_size(heap, node->size, node->pid);
+#endif
+			ret = mem;
+		}
+	}
+#endif
+
+	mm_givesemaphore(heap);
+	return ret;
+}
@@ -58,6 +58,8 @@
 
 #include <tinyara/mm/mm.h>
 
+#include "mm_node.h"
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -74,6 +76,26 @@
  *
  ****************************************************************************/
 
+#ifdef CONFIG_MM_POLICY_TLSF
+int mm_size2ndx(size_t size)
+{
+	int fl;
+	int sl;
+
+	if ((size >> MM_MAX_SHIFT) > 1) {
+		return MM_NLISTS - 1;
+	}
+
+	/* The first level is the power-of-two range [2^fl, 2^(fl + 1)[ holding
+	 * the size.  The second level is the sub-range of equal width in it.
+	 */
+
+	fl = MM_FLS(size);
+	sl = (size >> (fl - MM_SL_SHIFT)) & (MM_SL_COUNT - 1);
+
+	return ((fl - MM_MIN_SHIFT) << MM_SL_SHIFT) + sl;
+}
+#else
 int mm_size2ndx(size_t size)
 {
 	int ndx = 0;
@@ -104,3 +126,4 @@ int mm_size2ndx(size_t size)
 		return ndx;
 	}
 }
+#endif
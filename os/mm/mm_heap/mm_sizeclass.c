@@ -0,0 +1,205 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <string.h>
+#include <assert.h>
+
+#include <tinyara/mm/mm.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The first word of the payload of a cached chunk points to the next
+ * cached chunk of the same size class.
+ */
+
+#define SIZECLASS_LINK(n) \
+	(*(FAR struct mm_allocnode_s **)((FAR char *)(n) + SIZEOF_MM_ALLOCNODE))
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_sizeclass_initialize
+ *
+ * Description:
+ *   Initialize the size class stacks of the heap to empty.
+ *
+ ****************************************************************************/
+
+void mm_sizeclass_initialize(FAR struct mm_heap_s *heap)
+{
+	memset(heap->mm_sizeclass, 0, sizeof(heap->mm_sizeclass));
+	memset(heap->mm_sizeclass_cnt, 0, sizeof(heap->mm_sizeclass_cnt));
+	heap->mm_sizeclass_nchunks = 0;
+	heap->mm_sizeclass_size = 0;
+}
+
+/****************************************************************************
+ * Name: mm_sizeclass_pop
+ *
+ * Description:
+ *   Take a cached chunk of exactly 'size' bytes (including the chunk header)
+ *   from its size class stack.  The returned chunk is still marked as
+ *   allocated.  It is assumed that the caller holds the mm semaphore.
+ *
+ * Return Value:
+ *   The chunk on success, NULL if the size is not handled by the size
+ *   classes or if the size class is empty.
+ *
+ ****************************************************************************/
+
+FAR struct mm_allocnode_s *mm_sizeclass_pop(FAR struct mm_heap_s *heap, size_t size)
+{
+	FAR struct mm_allocnode_s *node;
+	int ndx;
+
+	if (size > MM_SIZECLASS_MAXCHUNK) {
+		return NULL;
+	}
+
+	ndx = MM_SIZECLASS_NDX(size);
+	node = heap->mm_sizeclass[ndx];
+	if (!node) {
+		return NULL;
+	}
+
+	DEBUGASSERT(node->size == size && (node->preceding & MM_ALLOC_BIT) != 0);
+
+	heap->mm_sizeclass[ndx] = SIZECLASS_LINK(node);
+	heap->mm_sizeclass_cnt[ndx]--;
+	heap->mm_sizeclass_nchunks--;
+	heap->mm_sizeclass_size -= size;
+
+	return node;
+}
+
+/****************************************************************************
+ * Name: mm_sizeclass_push
+ *
+ * Description:
+ *   Keep a chunk being freed on its size class stack instead of returning
+ *   it to the nodelist.  The chunk stays marked as allocated so that it is
+ *   never merged with its free neighbors.  It is assumed that the caller
+ *   holds the mm semaphore.
+ *
+ * Return Value:
+ *   true if the chunk was cached, false if the caller should free it to
+ *   the nodelist.
+ *
+ ****************************************************************************/
+
+bool mm_sizeclass_push(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node)
+{
+	int ndx;
+
+	if (node->size > MM_SIZECLASS_MAXCHUNK) {
+		return false;
+	}
+
+	ndx = MM_SIZECLASS_NDX(node->size);
+	if (heap->mm_sizeclass_cnt[ndx] >= CONFIG_MM_SIZECLASS_DEPTH) {
+		return false;
+	}
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	/* Cached chunks are not owned by any task */
+
+	node->pid = HEAPINFO_SIZECLASS;
+#endif
+
+	SIZECLASS_LINK(node) = heap->mm_sizeclass[ndx];
+	heap->mm_sizeclass[ndx] = node;
+	heap->mm_sizeclass_cnt[ndx]++;
+	heap->mm_sizeclass_nchunks++;
+	heap->mm_sizeclass_size += node->size;
+
+	return true;
+}
+
+/****************************************************************************
+ * Name: mm_sizeclass_cached
+ *
+ * Description:
+ *   Check if a chunk is on its size class stack.  Cached chunks stay marked
+ *   as allocated, so this is how a double free of one is caught.  It is
+ *   assumed that the caller holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEBUG_DOUBLE_FREE
+bool mm_sizeclass_cached(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node)
+{
+	FAR struct mm_allocnode_s *cached;
+
+	if (node->size > MM_SIZECLASS_MAXCHUNK) {
+		return false;
+	}
+
+	for (cached = heap->mm_sizeclass[MM_SIZECLASS_NDX(node->size)]; cached; cached = SIZECLASS_LINK(cached)) {
+		if (cached == node) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif
+
+/****************************************************************************
+ * Name: mm_sizeclass_flush
+ *
+ * Description:
+ *   Return all cached chunks to the nodelist, merging them with adjacent
+ *   free chunks.  This is used when an allocation cannot be satisfied from
+ *   the nodelist.  It is assumed that the caller holds the mm semaphore.
+ *
+ * Return Value:
+ *   The number of chunks returned to the nodelist.
+ *
+ ****************************************************************************/
+
+int mm_sizeclass_flush(FAR struct mm_heap_s *heap)
+{
+	FAR struct mm_allocnode_s *node;
+	int nflushed = 0;
+	int ndx;
+
+	for (ndx = 0; ndx < MM_SIZECLASS_NCLASSES; ndx++) {
+		while ((node = heap->mm_sizeclass[ndx]) != NULL) {
+			heap->mm_sizeclass[ndx] = SIZECLASS_LINK(node);
+			mm_freechunk(heap, (FAR struct mm_freenode_s *)node);
+			nflushed++;
+		}
+
+		heap->mm_sizeclass_cnt[ndx] = 0;
+	}
+
+	heap->mm_sizeclass_nchunks = 0;
+	heap->mm_sizeclass_size = 0;
+
+	return nflushed;
+}
@@ -0,0 +1,206 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdbool.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/sched.h>
+#include <tinyara/mm/mm.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_tcache_alloc
+ *
+ * Description:
+ *   Take a chunk of exactly 'size' bytes (including the chunk header) from
+ *   the cache of the running thread.  The cache is private to the thread,
+ *   so the mm semaphore is not needed.  The returned chunk is still marked
+ *   as allocated.
+ *
+ * Return Value:
+ *   The chunk on success, NULL if there is no such chunk in the cache.
+ *
+ ****************************************************************************/
+
+FAR struct mm_allocnode_s *mm_tcache_alloc(FAR struct mm_heap_s *heap, size_t size)
+{
+	FAR struct mm_tcache_s *tcache;
+	FAR struct mm_allocnode_s *node;
+	int ndx;
+
+	if (size > CONFIG_MM_TASK_CACHE_MAXSIZE || up_interrupt_context()) {
+		return NULL;
+	}
+
+	tcache = &sched_self()->tcache;
+
+	/* Search from the most recently freed chunk */
+
+	if (tcache->heap == heap) {
+		for (ndx = tcache->nchunks - 1; ndx >= 0; ndx--) {
+			node = (FAR struct mm_allocnode_s *)tcache->chunk[ndx];
+			if (node->size == size) {
+				tcache->chunk[ndx] = tcache->chunk[tcache->nchunks - 1];
+				tcache->nchunks--;
+				tcache->nhits++;
+				return node;
+			}
+		}
+	}
+
+	tcache->nmisses++;
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: mm_tcache_free
+ *
+ * Description:
+ *   Keep a chunk being freed in the cache of the running thread instead of
+ *   returning it to the heap.  The chunk stays marked as allocated.
+ *
+ * Return Value:
+ *   true if the chunk was cached, false if the caller should free it to
+ *   the heap.
+ *
+ ****************************************************************************/
+
+bool mm_tcache_free(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node)
+{
+	FAR struct tcb_s *tcb;
+	FAR struct mm_tcache_s *tcache;
+
+	if (node->size > CONFIG_MM_TASK_CACHE_MAXSIZE || (node->preceding & MM_ALLOC_BIT) == 0 || up_interrupt_context()) {
+		return false;
+	}
+
+	tcb = sched_self();
+	tcache = &tcb->tcache;
+	if (tcache->closed || tcache->nchunks >= CONFIG_MM_TASK_CACHE_DEPTH) {
+		return false;
+	}
+
+	/* All cached chunks come from one heap */
+
+	if (tcache->nchunks > 0 && tcache->heap != heap) {
+		return false;
+	}
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	/* The chunk stays counted as allocated by its owner while it is cached.
+	 * Cache only the chunks owned by this thread so that the accounting
+	 * remains correct when the chunk is reused.
+	 */
+
+	if (node->pid != tcb->pid) {
+		return false;
+	}
+#endif
+
+	tcache->heap = heap;
+	tcache->chunk[tcache->nchunks] = node;
+	tcache->nchunks++;
+	return true;
+}
+
+/****************************************************************************
+ * Name: mm_tcache_cached
+ *
+ * Description:
+ *   Check if a chunk is in the cache of the running thread.  Cached chunks
+ *   stay marked as allocated, so this is how a double free of one is
+ *   caught.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEBUG_DOUBLE_FREE
+bool mm_tcache_cached(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node)
+{
+	FAR struct mm_tcache_s *tcache;
+	int ndx;
+
+	if (up_interrupt_context()) {
+		return false;
+	}
+
+	tcache = &sched_self()->tcache;
+	if (tcache->heap != heap) {
+		return false;
+	}
+
+	for (ndx = 0; ndx < tcache->nchunks; ndx++) {
+		if (tcache->chunk[ndx] == (FAR void *)node) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif
+
+/****************************************************************************
+ * Name: mm_tcache_flush
+ *
+ * Description:
+ *   Return the chunks cached by the running thread to the nodelist.  This
+ *   is used when an allocation cannot be satisfied from the nodelist.  The
+ *   caches of other threads cannot be touched safely, so they are left as
+ *   they are.  It is assumed that the caller holds the mm semaphore.
+ *
+ * Return Value:
+ *   The number of chunks returned to the nodelist.
+ *
+ ****************************************************************************/
+
+int mm_tcache_flush(FAR struct mm_heap_s *heap)
+{
+	FAR struct mm_tcache_s *tcache;
+	FAR struct mm_allocnode_s *node;
+	int nflushed = 0;
+
+	if (up_interrupt_context()) {
+		return 0;
+	}
+
+	tcache = &sched_self()->tcache;
+	if (tcache->heap != heap) {
+		return 0;
+	}
+
+	while (tcache->nchunks > 0) {
+		tcache->nchunks--;
+		node = (FAR struct mm_allocnode_s *)tcache->chunk[tcache->nchunks];
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		heapinfo_subtract_size(heap, node->pid, node->size);
+		heapinfo_update_total_size(heap, ((-1) * node->size), node->pid);
+#endif
+		mm_freechunk(heap, (FAR struct mm_freenode_s *)node);
+		nflushed++;
+	}
+
+	return nflushed;
+}
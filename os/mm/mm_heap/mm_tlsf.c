@@ -0,0 +1,132 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <tinyara/mm/mm.h>
+
+#include "mm_node.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_tlsf_findlist
+ *
+ * Description:
+ *   Find the first non-empty list at or after the list 'ndx' using the
+ *   bitmaps.
+ *
+ * Return Value:
+ *   The index of the list, or -1 if all of these lists are empty.
+ *
+ ****************************************************************************/
+
+static int mm_tlsf_findlist(FAR struct mm_heap_s *heap, int ndx)
+{
+	uint32_t bitmap;
+	int fl;
+	int sl;
+
+	if (ndx >= MM_NLISTS) {
+		return -1;
+	}
+
+	fl = ndx >> MM_SL_SHIFT;
+	sl = ndx & (MM_SL_COUNT - 1);
+
+	/* Look for a larger list in the same size range first */
+
+	bitmap = heap->mm_sl_bitmap[fl] & (~0U << sl);
+	if (bitmap == 0) {
+		/* Take the smallest list of the next non-empty size range */
+
+		bitmap = heap->mm_fl_bitmap & (~0U << (fl + 1));
+		if (bitmap == 0) {
+			return -1;
+		}
+
+		fl = MM_FFS(bitmap);
+		bitmap = heap->mm_sl_bitmap[fl];
+	}
+
+	return (fl << MM_SL_SHIFT) + MM_FFS(bitmap);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_tlsf_search
+ *
+ * Description:
+ *   Find a free chunk of at least 'size' bytes (including the chunk header)
+ *   with the TLSF policy.  The search starts at the first list whose chunks
+ *   are all large enough, so the first chunk of the first non-empty list
+ *   found in the bitmaps is taken.  The chunk is not removed from its list.
+ *   It is assumed that the caller holds the mm semaphore.
+ *
+ * Return Value:
+ *   The free chunk on success, NULL if there is no large enough chunk.
+ *
+ ****************************************************************************/
+
+FAR struct mm_freenode_s *mm_tlsf_search(FAR struct mm_heap_s *heap, size_t size)
+{
+	FAR struct mm_freenode_s *node;
+	int ndx;
+	int start;
+	int found;
+
+	/* The chunks of the list holding the size itself may be smaller than the
+	 * size unless the size is the lower bound of the list.  The last list
+	 * holds all the chunks above its lower bound, whatever their size.
+	 */
+
+	ndx = mm_size2ndx(size);
+	if (ndx < MM_NLISTS - 1 && (size & ((1 << (MM_FLS(size) - MM_SL_SHIFT)) - 1)) == 0) {
+		start = ndx;
+	} else {
+		start = ndx + 1;
+	}
+
+	found = mm_tlsf_findlist(heap, start);
+	if (found >= 0) {
+		return heap->mm_nodelist[found].flink;
+	}
+
+	/* No list is guaranteed to fit.  As a last resort before failing, look
+	 * through the list holding the size itself.
+	 */
+
+	if (start != ndx) {
+		for (node = heap->mm_nodelist[ndx].flink; node; node = node->flink) {
+			if (node->size >= size) {
+				return node;
+			}
+		}
+	}
+
+	return NULL;
+}
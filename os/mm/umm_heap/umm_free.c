@@ -82,8 +82,14 @@
 void free(FAR void *mem)
 {
 	struct mm_heap_s *heap;
+#ifdef CONFIG_DEBUG_MM_HEAPTRACE
+	ARCH_GET_RET_ADDRESS
+#endif
 	heap = mm_get_heap(mem);
 	if (heap) {
+		/* Report the free first, the chunk can be reused right after */
+
+		MM_TRACE(MM_TRACE_FREE, mem, NULL, 0, retaddr);
 		mm_free(heap, mem);
 		return;
 	}
@@ -211,15 +211,18 @@ FAR void *malloc(size_t size)
 #endif
 
 	ret = heap_malloc(size, heap_idx, CONFIG_KMM_NHEAPS, retaddr);
-	if (ret != NULL) {
-		return ret;
-	}
 
 #if (defined(CONFIG_RAM_MALLOC_PRIOR_INDEX) && CONFIG_RAM_MALLOC_PRIOR_INDEX > 0)
-	/* Try to mm_calloc to other heaps */
-	ret = heap_malloc(size, 0, CONFIG_RAM_MALLOC_PRIOR_INDEX, retaddr);
+	if (ret == NULL) {
+		/* Try to mm_calloc to other heaps */
+		ret = heap_malloc(size, 0, CONFIG_RAM_MALLOC_PRIOR_INDEX, retaddr);
+	}
 #endif
 
+	if (ret != NULL) {
+		MM_TRACE(MM_TRACE_MALLOC, NULL, ret, size, retaddr);
+	}
+
 	return ret;
 #endif /* CONFIG_BUILD_KERNEL */
 }
@@ -131,6 +131,7 @@ FAR void *realloc(FAR void *oldmem, size_t size)
 	ret = mm_realloc(&BASE_HEAP[heap_idx], oldmem, size);
 #endif
 	if (ret != NULL) {
+		MM_TRACE(MM_TRACE_REALLOC, oldmem, ret, size, retaddr);
 		return ret;
 	}
 	/* Try to mm_malloc to another heap */
@@ -144,8 +145,43 @@ FAR void *realloc(FAR void *oldmem, size_t size)
 #endif
 		if (ret != NULL) {
 			mm_free(&BASE_HEAP[prev_heap_idx], oldmem);
+			MM_TRACE(MM_TRACE_REALLOC, oldmem, ret, size, retaddr);
 			return ret;
 		}
 	}
 	return NULL;
 }
+
+/****************************************************************************
+ * Name: realloc_in_place
+ *
+ * Description:
+ *   Resize memory of the user heap without moving it.
+ *
+ * Parameters:
+ *   mem  - The memory allocated
+ *   size - Size (in bytes) of the memory region after resizing.
+ *
+ * Return Value:
+ *   mem on success, NULL if the memory cannot be resized in place.
+ *
+ ****************************************************************************/
+
+FAR void *realloc_in_place(FAR void *mem, size_t size)
+{
+	int heap_idx;
+	void *ret;
+#ifdef CONFIG_DEBUG_MM_HEAPTRACE
+	ARCH_GET_RET_ADDRESS
+#endif
+	heap_idx = mm_get_heapindex(mem);
+	if (heap_idx < 0) {
+		return NULL;
+	}
+
+	ret = mm_try_expand(&BASE_HEAP[heap_idx], mem, size);
+	if (ret != NULL) {
+		MM_TRACE(MM_TRACE_REALLOC, mem, ret, size, retaddr);
+	}
+	return ret;
+}
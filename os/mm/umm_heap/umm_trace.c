@@ -0,0 +1,52 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * mm/umm_heap/umm_trace.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <tinyara/mm/mm.h>
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+mm_trace_hook_t g_mm_trace_hook;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_set_trace_hook
+ *
+ * Description:
+ *   Install the hook which malloc(), realloc() and free() of the user heap
+ *   report each operation to, together with the caller address recorded
+ *   for heap info.  NULL removes the hook.
+ *
+ ****************************************************************************/
+
+void mm_set_trace_hook(mm_trace_hook_t hook)
+{
+	g_mm_trace_hook = hook;
+}
@@ -716,6 +716,19 @@ err_t netconn_send(struct netconn *conn, struct netbuf *buf)
  */
 err_t netconn_write_partly(struct netconn *conn, const void *dataptr, size_t size, u8_t apiflags, size_t *bytes_written)
 {
+#if LWIP_TCP_ZEROCOPY
+	return netconn_write_partly_zc(conn, dataptr, size, apiflags, bytes_written, NULL);
+}
+
+/**
+ * @ingroup netconn_tcp
+ * Same as netconn_write_partly, without NETCONN_COPY the data is referenced
+ * through zc, which is released once TCP does not need the data anymore
+ * (see tcp_write_zc).
+ */
+err_t netconn_write_partly_zc(struct netconn *conn, const void *dataptr, size_t size, u8_t apiflags, size_t *bytes_written, struct tcp_zc *zc)
+{
+#endif
 	API_MSG_VAR_DECLARE(msg);
 	err_t err;
 	u8_t dontblock;
@@ -743,6 +756,9 @@ err_t netconn_write_partly(struct netconn *conn, const void *dataptr, size_t siz
 	API_MSG_VAR_REF(msg).msg.w.dataptr = dataptr;
 	API_MSG_VAR_REF(msg).msg.w.apiflags = apiflags;
 	API_MSG_VAR_REF(msg).msg.w.len = size;
+#if LWIP_TCP_ZEROCOPY
+	API_MSG_VAR_REF(msg).msg.w.zc = zc;
+#endif
 #if LWIP_SO_SNDTIMEO
 	if (conn->send_timeout != 0) {
 		/* get the time we started, which is later compared to
@@ -1531,7 +1531,11 @@ static err_t lwip_netconn_do_writemore(struct netconn *conn WRITE_DELAYED_PARAM)
 			}
 		}
 		LWIP_ASSERT("lwip_netconn_do_writemore: invalid length!", ((conn->write_offset + len) <= conn->current_msg->msg.w.len));
+#if LWIP_TCP_ZEROCOPY
+		err = tcp_write_zc(conn->pcb.tcp, dataptr, len, apiflags, conn->current_msg->msg.w.zc);
+#else
 		err = tcp_write(conn->pcb.tcp, dataptr, len, apiflags);
+#endif
 		/* if OK or memory error, check available space */
 		if ((err == ERR_OK) || (err == ERR_MEM)) {
 err_mem:
@@ -102,6 +102,11 @@
 #include <tinyara/clock.h>
 #endif
 
+#if LWIP_SENDFILE
+#include <tinyara/fs/fs.h>
+#include <tinyara/kmalloc.h>
+#endif
+
 /* If the netconn API is not required publicly, then we include the necessary
    files here to get the implementation */
 #if !LWIP_NETCONN
@@ -304,6 +309,55 @@ static void lwip_socket_unregister_membership(int s, const ip4_addr_t *if_addr,
 static void lwip_socket_drop_registered_memberships(int s);
 #endif							/* LWIP_IGMP */
 
+#if LWIP_EPOLL
+/** A socket in the interest list of an epoll instance. The item is linked
+ *  on the socket, so that event_callback() only visits the instances
+ *  interested in that socket, and on the instance, for close and epoll_ctl.
+ */
+struct lwip_epitem {
+	/** next registration of the same socket */
+	struct lwip_epitem *sock_next;
+	/** next registration of the same epoll instance */
+	struct lwip_epitem *ep_next;
+	/** next item in the ready queue of the epoll instance */
+	struct lwip_epitem *rdy_next;
+	struct lwip_epoll *ep;
+	struct lwip_sock *sock;
+	int fd;
+	/** requested events and EPOLLET/EPOLLONESHOT */
+	u32_t events;
+	epoll_data_t data;
+	/** set while the item is on the ready queue */
+	u8_t ready;
+	/** set after an EPOLLONESHOT event, until EPOLL_CTL_MOD */
+	u8_t disabled;
+};
+
+/** An epoll instance, referenced by the socket slot it occupies */
+struct lwip_epoll {
+	struct lwip_epitem *items;
+	/** sockets which became ready since the last epoll_wait() */
+	struct lwip_epitem *rdy_head;
+	struct lwip_epitem *rdy_tail;
+	/** semaphore to wake up the tasks waiting in epoll_wait() */
+	sys_sem_t sem;
+	/** number of tasks waiting in epoll_wait() */
+	int waiting;
+	/** don't signal the semaphore twice for the same wait */
+	u8_t signalled;
+	/** the instance was closed while tasks were waiting */
+	u8_t closed;
+#if !LWIP_SELECT
+	/** poll() waiting for this instance to have ready items */
+	struct pollfd *pollfd;
+#endif
+};
+
+#define SOCK_IS_EPOLL(sock) ((sock)->epoll != NULL)
+#else
+#define SOCK_IS_EPOLL(sock) 0
+#endif							/* LWIP_EPOLL */
+
 /** The global array of available sockets */
 static struct lwip_sock sockets[NUM_SOCKETS];
 /** The global list of tasks waiting for select */
@@ -335,6 +389,11 @@ static volatile int select_cb_ctr;
 
 /* Forward delcaration of some functions */
 static void event_callback(struct netconn *conn, enum netconn_evt evt, u16_t len);
+#if LWIP_EPOLL
+static void lwip_epoll_notify(struct lwip_sock *sock, enum netconn_evt evt);
+static void lwip_epoll_detach(struct lwip_sock *sock);
+static int lwip_epoll_close(int epfd);
+#endif
 #if !LWIP_TCPIP_CORE_LOCKING
 static void lwip_getsockopt_callback(void *arg);
 static void lwip_setsockopt_callback(void *arg);
@@ -460,7 +519,7 @@ int alloc_socket(struct netconn *newconn, int accepted)
 	for (i = 0; i < NUM_SOCKETS; ++i) {
 		/* Protect socket array */
 		SYS_ARCH_PROTECT(lev);
-		if (!sockets[i].conn && (sockets[i].select_waiting == 0)) {
+		if (!sockets[i].conn && (sockets[i].select_waiting == 0) && !SOCK_IS_EPOLL(&sockets[i])) {
 			newconn->pid = getpid();
 			sockets[i].conn = newconn;
 			/* The socket is not yet known to anyone, so no need to protect
@@ -496,6 +555,11 @@ void free_socket(struct lwip_sock *sock, int is_tcp)
 	sock->lastoffset = 0;
 	sock->err = 0;
 
+#if LWIP_EPOLL
+	/* Drop the socket from all interest lists, the slot can be reused */
+	lwip_epoll_detach(sock);
+#endif
+
 	/* Protect socket array */
 	SYS_ARCH_SET(sock->conn, NULL);
 	/* don't use 'sock' after this line, as another task might have allocated it */
@@ -659,6 +723,12 @@ int lwip_close(int s)
 
 	LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_close(%d)\n", s));
 
+#if LWIP_EPOLL
+	if (lwip_epoll_close(s) == 0) {
+		return 0;
+	}
+#endif
+
 	sock = get_socket(s);
 	if (!sock) {
 		return -1;
@@ -996,6 +1066,384 @@ int lwip_send(int s, const void *data, size_t size, int flags)
 	return (err == ERR_OK ? (int)written : -1);
 }
 
+#if LWIP_ZEROCOPY
+/** A send_zc() request, freed once TCP freed all pbufs referencing buf */
+struct lwip_zcsend {
+	struct tcp_zc zc;
+	zc_release_t release;
+	void *buf;
+	void *arg;
+};
+
+/**
+ * Receive without copying: zb->seg[] are pointed at the data in the pbufs
+ * and the pbufs are kept until lwip_recv_zc_release(). Returns at most the
+ * data of one received pbuf chain, in up to CONFIG_NET_ZEROCOPY_MAXSEG
+ * segments. The data is consumed as with lwip_recv, MSG_PEEK is not
+ * supported.
+ */
+int lwip_recv_zc(int s, struct zc_rbuf *zb, size_t len, int flags)
+{
+	struct lwip_sock *sock;
+	void *buf;
+	struct pbuf *p;
+	struct pbuf *q;
+	u16_t buflen;
+	u16_t off;
+	u16_t seglen;
+	size_t total;
+	err_t err;
+
+	LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_recv_zc(%d, %p, %" SZT_F ", 0x%x)\n", s, zb, len, flags));
+	sock = get_socket(s);
+	if (!sock) {
+		return -1;
+	}
+
+	/* A zero length would take nothing, but still dequeue a datagram, and
+	   its 0 return would read as a closed connection */
+	if (zb == NULL || len == 0 || (flags & MSG_PEEK) != 0) {
+		sock_set_errno(sock, EINVAL);
+		return -1;
+	}
+	zb->priv = NULL;
+	zb->nseg = 0;
+
+	if (sock->lastdata) {
+		buf = sock->lastdata;
+	} else {
+		if (((flags & MSG_DONTWAIT) || netconn_is_nonblocking(sock->conn)) && (sock->rcvevent <= 0)) {
+			set_errno(EWOULDBLOCK);
+			return -1;
+		}
+
+		if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_TCP) {
+			err = netconn_recv_tcp_pbuf(sock->conn, (struct pbuf **)&buf);
+		} else {
+			err = netconn_recv(sock->conn, (struct netbuf **)&buf);
+		}
+		if (err != ERR_OK) {
+			sock_set_errno(sock, err_to_errno(err));
+			if (err == ERR_CLSD) {
+				sock->conn->last_err = ERR_OK;
+				return 0;
+			}
+			return -1;
+		}
+		sock->lastdata = buf;
+	}
+
+	if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_TCP) {
+		p = (struct pbuf *)buf;
+	} else {
+		p = ((struct netbuf *)buf)->p;
+	}
+	buflen = p->tot_len - sock->lastoffset;
+
+	/* Skip what previous reads consumed, then map the rest */
+	off = sock->lastoffset;
+	for (q = p; q != NULL && off >= q->len; q = q->next) {
+		off -= q->len;
+	}
+
+	total = 0;
+	for (; q != NULL && total < len && zb->nseg < CONFIG_NET_ZEROCOPY_MAXSEG; q = q->next) {
+		if (zb->priv == NULL) {
+			/* The reference on the first pbuf used keeps the rest of
+			   the chain too, whatever happens to the pbufs before it */
+			pbuf_ref(q);
+			zb->priv = q;
+		}
+		seglen = q->len - off;
+		if (seglen > len - total) {
+			seglen = (u16_t)(len - total);
+		}
+		zb->seg[zb->nseg].iov_base = (u8_t *)q->payload + off;
+		zb->seg[zb->nseg].iov_len = seglen;
+		zb->nseg++;
+		total += seglen;
+		off = 0;
+	}
+
+	if ((NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_TCP) && (buflen > total)) {
+		sock->lastoffset += (u16_t)total;
+	} else {
+		sock->lastdata = NULL;
+		sock->lastoffset = 0;
+		if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_TCP) {
+			pbuf_free((struct pbuf *)buf);
+		} else {
+			netbuf_delete((struct netbuf *)buf);
+		}
+	}
+
+	sock_set_errno(sock, 0);
+	return (int)total;
+}
+
+/** Give back the pbufs of a successful lwip_recv_zc() */
+void lwip_recv_zc_release(struct zc_rbuf *zb)
+{
+	if (zb != NULL && zb->priv != NULL) {
+		pbuf_free((struct pbuf *)zb->priv);
+		zb->priv = NULL;
+		zb->nseg = 0;
+	}
+}
+
+static void lwip_zcsend_done(struct tcp_zc *zc)
+{
+	struct lwip_zcsend *zs = (struct lwip_zcsend *)zc;
+
+	zs->release(zs->buf, zs->arg);
+	mem_free(zs);
+}
+
+/**
+ * Send without copying the data into the stack. release(data, arg) is
+ * called exactly once, when the stack does not reference data anymore,
+ * which is after the peer acknowledged it for TCP. The data must not be
+ * modified before. It may be called from the tcpip thread.
+ */
+int lwip_send_zc(int s, const void *data, size_t size, int flags, zc_release_t release, void *arg)
+{
+	struct lwip_sock *sock;
+	struct lwip_zcsend *zs;
+	err_t err;
+	u8_t write_flags;
+	size_t written;
+	int ret;
+
+	LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_send_zc(%d, data=%p, size=%" SZT_F ", flags=0x%x)\n", s, data, size, flags));
+
+	if (release == NULL) {
+		set_errno(EINVAL);
+		return -1;
+	}
+
+	sock = get_socket(s);
+	if (!sock) {
+		release((void *)data, arg);
+		return -1;
+	}
+
+	if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) != NETCONN_TCP) {
+		/* lwip_sendto references the data and is done with it on return */
+		ret = lwip_send(s, data, size, flags);
+		release((void *)data, arg);
+		return ret;
+	}
+
+	zs = (struct lwip_zcsend *)mem_malloc(sizeof(struct lwip_zcsend));
+	if (zs == NULL) {
+		release((void *)data, arg);
+		sock_set_errno(sock, ENOMEM);
+		return -1;
+	}
+	zs->zc.refs = 1;
+	zs->zc.done = lwip_zcsend_done;
+	zs->release = release;
+	zs->buf = (void *)data;
+	zs->arg = arg;
+
+	write_flags = ((flags & MSG_MORE) ? NETCONN_MORE : 0) | ((flags & MSG_DONTWAIT) ? NETCONN_DONTBLOCK : 0);
+	written = 0;
+	err = netconn_write_partly_zc(sock->conn, data, size, write_flags, &written, &zs->zc);
+
+	/* Drop our own reference, the queued segments hold the others */
+	tcp_zc_unref(&zs->zc);
+
+	LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_send_zc(%d) err=%d written=%" SZT_F "\n", s, err, written));
+	sock_set_errno(sock, err_to_errno(err));
+	return (err == ERR_OK ? (int)written : -1);
+}
+#endif							/* LWIP_ZEROCOPY */
+
+#if LWIP_SENDFILE
+/** State of one lwip_sendfile() call, freed with its last buffer */
+struct lwip_sendfile {
+	/** signalled each time TCP frees a buffer */
+	sys_sem_t sem;
+	/** buffers still referenced by TCP */
+	u16_t inflight;
+	/** set once lwip_sendfile() does not use this anymore */
+	u8_t finished;
+};
+
+/** A buffer of file data, followed by CONFIG_NET_SENDFILE_CHUNKSIZE bytes */
+struct lwip_sfchunk {
+	struct tcp_zc zc;
+	struct lwip_sendfile *sf;
+};
+
+static void lwip_sendfile_done(struct tcp_zc *zc)
+{
+	struct lwip_sfchunk *chunk = (struct lwip_sfchunk *)zc;
+	struct lwip_sendfile *sf = chunk->sf;
+	u8_t last;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	kmm_free(chunk);
+
+	SYS_ARCH_PROTECT(lev);
+	sf->inflight--;
+	last = (sf->finished && sf->inflight == 0);
+	if (!last) {
+		sys_sem_signal(&sf->sem);
+	}
+	SYS_ARCH_UNPROTECT(lev);
+
+	if (last) {
+		sys_sem_free(&sf->sem);
+		kmm_free(sf);
+	}
+}
+
+/**
+ * Send count bytes of filep on the TCP socket s. The file is read into
+ * buffers which TCP references without copying them, at most
+ * CONFIG_NET_SENDFILE_NCHUNKS buffers are waiting for an acknowledgement.
+ * Each wait for an acknowledgement is bounded by the send timeout of the
+ * socket, and a non-blocking socket does not wait. The buffers still sent
+ * are freed by TCP, what was sent so far is returned, or -1 with EAGAIN.
+ * The file position is handled as by sendfile(). Returns -1 with errno
+ * ENOSYS for other sockets, which use the copying sendfile.
+ */
+int lwip_sendfile(int s, struct file *filep, off_t *offset, size_t count)
+{
+	struct lwip_sock *sock;
+	struct lwip_sendfile *sf;
+	struct lwip_sfchunk *chunk;
+	off_t savepos = 0;
+	off_t pos;
+	size_t total = 0;
+	size_t written;
+	ssize_t nread;
+	u8_t apiflags;
+	u8_t wait;
+	u8_t last;
+	u32_t timeout = 0;
+	err_t err = ERR_OK;
+	int errcode = 0;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_sendfile(%d, count=%" SZT_F ")\n", s, count));
+
+	sock = get_socket(s);
+	if (!sock) {
+		return -1;
+	}
+
+	if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) != NETCONN_TCP) {
+		set_errno(ENOSYS);
+		return -1;
+	}
+
+	if (offset) {
+		savepos = file_seek(filep, 0, SEEK_CUR);
+		if (savepos == (off_t)-1) {
+			return -1;
+		}
+		pos = file_seek(filep, *offset, SEEK_SET);
+	} else {
+		pos = file_seek(filep, 0, SEEK_CUR);
+	}
+	if (pos == (off_t)-1) {
+		return -1;
+	}
+
+	sf = (struct lwip_sendfile *)kmm_malloc(sizeof(struct lwip_sendfile));
+	if (sf == NULL) {
+		sock_set_errno(sock, ENOMEM);
+		return -1;
+	}
+	if (sys_sem_new(&sf->sem, 0) != ERR_OK) {
+		kmm_free(sf);
+		sock_set_errno(sock, ENOMEM);
+		return -1;
+	}
+	sf->inflight = 0;
+	sf->finished = 0;
+#if LWIP_SO_SNDTIMEO
+	timeout = (u32_t)netconn_get_sendtimeout(sock->conn);
+#endif
+
+	while (total < count) {
+		/* Wait until the peer acknowledged one of the buffers */
+		SYS_ARCH_PROTECT(lev);
+		wait = (sf->inflight >= CONFIG_NET_SENDFILE_NCHUNKS);
+		SYS_ARCH_UNPROTECT(lev);
+		if (wait) {
+			if (netconn_is_nonblocking(sock->conn) || sys_arch_sem_wait(&sf->sem, timeout) == SYS_ARCH_TIMEOUT) {
+				errcode = EAGAIN;
+				break;
+			}
+			continue;
+		}
+
+		chunk = (struct lwip_sfchunk *)kmm_malloc(sizeof(struct lwip_sfchunk) + CONFIG_NET_SENDFILE_CHUNKSIZE);
+		if (chunk == NULL) {
+			errcode = ENOMEM;
+			break;
+		}
+
+		nread = file_read(filep, chunk + 1, LWIP_MIN(count - total, CONFIG_NET_SENDFILE_CHUNKSIZE));
+		if (nread <= 0) {
+			kmm_free(chunk);
+			errcode = (int)-nread;
+			break;
+		}
+
+		chunk->zc.refs = 1;
+		chunk->zc.done = lwip_sendfile_done;
+		chunk->sf = sf;
+		SYS_ARCH_PROTECT(lev);
+		sf->inflight++;
+		SYS_ARCH_UNPROTECT(lev);
+
+		apiflags = (total + (size_t)nread < count) ? NETCONN_MORE : 0;
+		written = 0;
+		err = netconn_write_partly_zc(sock->conn, chunk + 1, (size_t)nread, apiflags, &written, &chunk->zc);
+		tcp_zc_unref(&chunk->zc);
+
+		total += written;
+		if (err != ERR_OK || written < (size_t)nread) {
+			break;
+		}
+	}
+
+	/* The file position follows what was sent, not what was read */
+	pos += total;
+	if (offset) {
+		*offset = pos;
+		file_seek(filep, savepos, SEEK_SET);
+	} else {
+		file_seek(filep, pos, SEEK_SET);
+	}
+
+	SYS_ARCH_PROTECT(lev);
+	sf->finished = 1;
+	last = (sf->inflight == 0);
+	SYS_ARCH_UNPROTECT(lev);
+	if (last) {
+		sys_sem_free(&sf->sem);
+		kmm_free(sf);
+	}
+
+	LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_sendfile(%d) err=%d sent=%" SZT_F "\n", s, err, total));
+	if (total == 0 && err != ERR_OK) {
+		sock_set_errno(sock, err_to_errno(err));
+		return -1;
+	}
+	if (total == 0 && errcode != 0) {
+		sock_set_errno(sock, errcode);
+		return -1;
+	}
+	sock_set_errno(sock, 0);
+	return (int)total;
+}
+#endif							/* LWIP_SENDFILE */
+
 int lwip_sendmsg(int s, const struct msghdr *msg, int flags)
 {
 	struct lwip_sock *sock;
@@ -1083,15 +1531,25 @@ int lwip_sendmsg(int s, const struct msghdr *msg, int flags)
 		} else {
 			/* flatten the IO vectors */
 			size_t offset = 0;
+#if LWIP_CHECKSUM_ON_COPY
+			/* checksum each IO vector while copying it, a vector starting
+			   at an odd offset contributes its sum byte swapped */
+			u32_t acc = 0;
 			for (i = 0; i < msg->msg_iovlen; i++) {
-				MEMCPY(&((u8_t *) chain_buf->p->payload)[offset], msg->msg_iov[i].iov_base, msg->msg_iov[i].iov_len);
+				u16_t chksum = LWIP_CHKSUM_COPY(&((u8_t *) chain_buf->p->payload)[offset], msg->msg_iov[i].iov_base, (u16_t) msg->msg_iov[i].iov_len);
+				if (offset & 1) {
+					chksum = SWAP_BYTES_IN_WORD(chksum);
+				}
+				acc += chksum;
 				offset += msg->msg_iov[i].iov_len;
 			}
-#if LWIP_CHECKSUM_ON_COPY
-			{
-				/* This can be improved by using LWIP_CHKSUM_COPY() and aggregating the checksum for each IO vector */
-				u16_t chksum = ~inet_chksum_pbuf(chain_buf->p);
-				netbuf_set_chksum(chain_buf, chksum);
+			acc = FOLD_U32T(acc);
+			acc = FOLD_U32T(acc);
+			netbuf_set_chksum(chain_buf, (u16_t) acc);
+#else							/* LWIP_CHECKSUM_ON_COPY */
+			for (i = 0; i < msg->msg_iovlen; i++) {
+				MEMCPY(&((u8_t *) chain_buf->p->payload)[offset], msg->msg_iov[i].iov_base, msg->msg_iov[i].iov_len);
+				offset += msg->msg_iov[i].iov_len;
 			}
 #endif							/* LWIP_CHECKSUM_ON_COPY */
 			err = ERR_OK;
@@ -1301,6 +1759,536 @@ int lwip_writev(int s, const struct iovec *iov, int iovcnt)
 	return lwip_sendmsg(s, &msg, 0);
 }
 
+#if LWIP_EPOLL
+
+/** Get the epoll instance behind a descriptor, call it protected */
+static struct lwip_epoll *lwip_epoll_get(int epfd)
+{
+	epfd -= LWIP_SOCKET_OFFSET;
+	if ((epfd < 0) || (epfd >= NUM_SOCKETS)) {
+		return NULL;
+	}
+	return sockets[epfd].epoll;
+}
+
+/** Requested events pending on a socket, call it protected */
+static u32_t lwip_epoll_revents(struct lwip_sock *sock, u32_t events)
+{
+	u32_t revents = 0;
+
+	if ((events & EPOLLIN) && ((sock->lastdata != NULL) || (sock->rcvevent > 0))) {
+		revents |= EPOLLIN;
+	}
+	if ((events & EPOLLOUT) && (sock->sendevent != 0)) {
+		revents |= EPOLLOUT;
+	}
+	/* Errors and hang-ups are reported even when they were not asked for */
+	if (sock->errevent != 0) {
+		revents |= EPOLLERR;
+	}
+#if LWIP_TCP
+	/* The pcb of a TCP connection is gone once it was reset or closed in
+	 * both directions, the socket cannot send or receive any more.
+	 */
+	if ((sock->conn != NULL) && (NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_TCP) && (sock->conn->pcb.tcp == NULL)) {
+		revents |= EPOLLHUP;
+	}
+#endif
+	return revents;
+}
+
+/** Put an item on the ready queue and wake up a waiter, call it protected */
+static void lwip_epoll_enqueue(struct lwip_epitem *item)
+{
+	struct lwip_epoll *ep = item->ep;
+
+	item->ready = 1;
+	item->rdy_next = NULL;
+	if (ep->rdy_tail != NULL) {
+		ep->rdy_tail->rdy_next = item;
+	} else {
+		ep->rdy_head = item;
+	}
+	ep->rdy_tail = item;
+
+	if (ep->waiting > 0 && !ep->signalled) {
+		ep->signalled = 1;
+		sys_sem_signal(&ep->sem);
+	}
+#if !LWIP_SELECT
+	if (ep->pollfd != NULL) {
+		ep->pollfd->revents |= (ep->pollfd->events & POLLIN);
+		if (ep->pollfd->revents != 0) {
+			sys_sem_signal(ep->pollfd->sem);
+		}
+		ep->pollfd = NULL;
+	}
+#endif
+}
+
+/** Take an item off the ready queue, call it protected */
+static void lwip_epoll_unqueue(struct lwip_epoll *ep, struct lwip_epitem *item)
+{
+	struct lwip_epitem **pp;
+	struct lwip_epitem *prev = NULL;
+
+	if (!item->ready) {
+		return;
+	}
+	for (pp = &ep->rdy_head; *pp != item; pp = &(*pp)->rdy_next) {
+		prev = *pp;
+	}
+	*pp = item->rdy_next;
+	if (ep->rdy_tail == item) {
+		ep->rdy_tail = prev;
+	}
+	item->ready = 0;
+}
+
+/** Take an item off the list of its socket, call it protected */
+static void lwip_epoll_unlink_sock(struct lwip_epitem *item)
+{
+	struct lwip_epitem **pp;
+
+	for (pp = &item->sock->epitems; *pp != item; pp = &(*pp)->sock_next) {
+	}
+	*pp = item->sock_next;
+}
+
+/** Take an item off the interest list of its instance, call it protected */
+static void lwip_epoll_unlink_ep(struct lwip_epitem *item)
+{
+	struct lwip_epitem **pp;
+
+	for (pp = &item->ep->items; *pp != item; pp = &(*pp)->ep_next) {
+	}
+	*pp = item->ep_next;
+}
+
+/**
+ * Called from event_callback() with the socket array protected. Only the
+ * instances registered on this socket are visited.
+ */
+static void lwip_epoll_notify(struct lwip_sock *sock, enum netconn_evt evt)
+{
+	struct lwip_epitem *item;
+
+	for (item = sock->epitems; item != NULL; item = item->sock_next) {
+		if (item->ready || item->disabled) {
+			continue;
+		}
+		/* Edge triggered items are only reported when something new happened */
+		if ((item->events & EPOLLET) && (evt == NETCONN_EVT_RCVMINUS || evt == NETCONN_EVT_SENDMINUS)) {
+			continue;
+		}
+		if (lwip_epoll_revents(sock, item->events) != 0) {
+			lwip_epoll_enqueue(item);
+		}
+	}
+}
+
+/** Remove a socket which is being freed from all interest lists */
+static void lwip_epoll_detach(struct lwip_sock *sock)
+{
+	struct lwip_epitem *items;
+	struct lwip_epitem *item;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	items = sock->epitems;
+	sock->epitems = NULL;
+	for (item = items; item != NULL; item = item->sock_next) {
+		lwip_epoll_unqueue(item->ep, item);
+		lwip_epoll_unlink_ep(item);
+	}
+	SYS_ARCH_UNPROTECT(lev);
+
+	while (items != NULL) {
+		item = items;
+		items = item->sock_next;
+		mem_free(item);
+	}
+}
+
+/**
+ * Move the ready items to events, call it protected. Items which are not
+ * ready any more (the data was read in the meantime) are dropped, level
+ * triggered items which are still ready go back to the end of the queue
+ * so that they are reported again by the next call.
+ */
+static int lwip_epoll_collect(struct lwip_epoll *ep, struct epoll_event *events, int maxevents)
+{
+	struct lwip_epitem *item;
+	struct lwip_epitem *rehead = NULL;
+	struct lwip_epitem *retail = NULL;
+	u32_t revents;
+	int nready = 0;
+
+	while (nready < maxevents && (item = ep->rdy_head) != NULL) {
+		ep->rdy_head = item->rdy_next;
+		if (ep->rdy_head == NULL) {
+			ep->rdy_tail = NULL;
+		}
+		item->ready = 0;
+
+		revents = item->disabled ? 0 : lwip_epoll_revents(item->sock, item->events);
+		if (revents == 0) {
+			continue;
+		}
+
+		events[nready].events = revents;
+		events[nready].data = item->data;
+		nready++;
+
+		if (item->events & EPOLLONESHOT) {
+			item->disabled = 1;
+		} else if (!(item->events & EPOLLET)) {
+			item->ready = 1;
+			item->rdy_next = NULL;
+			if (retail != NULL) {
+				retail->rdy_next = item;
+			} else {
+				rehead = item;
+			}
+			retail = item;
+		}
+	}
+
+	if (rehead != NULL) {
+		if (ep->rdy_tail != NULL) {
+			ep->rdy_tail->rdy_next = rehead;
+		} else {
+			ep->rdy_head = rehead;
+		}
+		ep->rdy_tail = retail;
+	}
+	return nready;
+}
+
+static void lwip_epoll_free(struct lwip_epoll *ep)
+{
+	sys_sem_free(&ep->sem);
+	mem_free(ep);
+}
+
+/**
+ * Create an epoll instance. It takes a free socket slot, so that its
+ * descriptor is routed here by close() and poll() like a socket.
+ */
+int lwip_epoll_create(int flags)
+{
+	struct lwip_epoll *ep;
+	int i;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	if (flags & ~EPOLL_CLOEXEC) {
+		set_errno(EINVAL);
+		return -1;
+	}
+
+	ep = (struct lwip_epoll *)mem_malloc(sizeof(struct lwip_epoll));
+	if (ep == NULL) {
+		set_errno(ENOMEM);
+		return -1;
+	}
+	memset(ep, 0, sizeof(struct lwip_epoll));
+	if (sys_sem_new(&ep->sem, 0) != ERR_OK) {
+		mem_free(ep);
+		set_errno(ENOMEM);
+		return -1;
+	}
+
+	for (i = 0; i < NUM_SOCKETS; ++i) {
+		SYS_ARCH_PROTECT(lev);
+		if (!sockets[i].conn && (sockets[i].select_waiting == 0) && !SOCK_IS_EPOLL(&sockets[i])) {
+			sockets[i].epoll = ep;
+			SYS_ARCH_UNPROTECT(lev);
+			LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_epoll_create() = %d\n", i + LWIP_SOCKET_OFFSET));
+			return i + LWIP_SOCKET_OFFSET;
+		}
+		SYS_ARCH_UNPROTECT(lev);
+	}
+
+	lwip_epoll_free(ep);
+	set_errno(ENFILE);
+	return -1;
+}
+
+/**
+ * Close an epoll instance
+ *
+ * @return 0 if epfd was an epoll instance, -1 if it is not one
+ */
+static int lwip_epoll_close(int epfd)
+{
+	struct lwip_epoll *ep;
+	struct lwip_epitem *items;
+	struct lwip_epitem *item;
+	int waiting;
+	int i;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	ep = lwip_epoll_get(epfd);
+	if (ep == NULL) {
+		SYS_ARCH_UNPROTECT(lev);
+		return -1;
+	}
+	sockets[epfd - LWIP_SOCKET_OFFSET].epoll = NULL;
+
+	items = ep->items;
+	ep->items = NULL;
+	ep->rdy_head = NULL;
+	ep->rdy_tail = NULL;
+	for (item = items; item != NULL; item = item->ep_next) {
+		lwip_epoll_unlink_sock(item);
+	}
+
+	/* The last task leaving epoll_wait() frees the instance */
+	waiting = ep->waiting;
+	if (waiting > 0) {
+		ep->closed = 1;
+		for (i = 0; i < waiting; i++) {
+			sys_sem_signal(&ep->sem);
+		}
+	}
+#if !LWIP_SELECT
+	if (ep->pollfd != NULL) {
+		ep->pollfd->revents |= POLLHUP;
+		sys_sem_signal(ep->pollfd->sem);
+		ep->pollfd = NULL;
+	}
+#endif
+	SYS_ARCH_UNPROTECT(lev);
+
+	while (items != NULL) {
+		item = items;
+		items = item->ep_next;
+		mem_free(item);
+	}
+	if (waiting == 0) {
+		lwip_epoll_free(ep);
+	}
+
+	LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_epoll_close(%d)\n", epfd));
+	set_errno(0);
+	return 0;
+}
+
+int lwip_epoll_ctl(int epfd, int op, int fd, struct epoll_event *event)
+{
+	struct lwip_epoll *ep;
+	struct lwip_sock *sock;
+	struct lwip_epitem *item;
+	struct lwip_epitem *freeitem = NULL;
+	int err = 0;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	if ((op == EPOLL_CTL_ADD || op == EPOLL_CTL_MOD) && event == NULL) {
+		set_errno(EFAULT);
+		return -1;
+	}
+
+	/* Allocate before taking the protection, it is freed again on error */
+	if (op == EPOLL_CTL_ADD) {
+		freeitem = (struct lwip_epitem *)mem_malloc(sizeof(struct lwip_epitem));
+		if (freeitem == NULL) {
+			set_errno(ENOMEM);
+			return -1;
+		}
+		memset(freeitem, 0, sizeof(struct lwip_epitem));
+	}
+
+	SYS_ARCH_PROTECT(lev);
+	ep = lwip_epoll_get(epfd);
+	sock = tryget_socket(fd);
+	if (ep == NULL || sock == NULL) {
+		err = EBADF;
+		goto errout;
+	}
+
+	for (item = ep->items; item != NULL && item->sock != sock; item = item->ep_next) {
+	}
+
+	switch (op) {
+	case EPOLL_CTL_ADD:
+		if (item != NULL) {
+			err = EEXIST;
+			goto errout;
+		}
+		item = freeitem;
+		freeitem = NULL;
+		item->ep = ep;
+		item->sock = sock;
+		item->fd = fd;
+		item->events = event->events;
+		item->data = event->data;
+		item->ep_next = ep->items;
+		ep->items = item;
+		item->sock_next = sock->epitems;
+		sock->epitems = item;
+		break;
+
+	case EPOLL_CTL_MOD:
+		if (item == NULL) {
+			err = ENOENT;
+			goto errout;
+		}
+		item->events = event->events;
+		item->data = event->data;
+		item->disabled = 0;
+		break;
+
+	case EPOLL_CTL_DEL:
+		if (item == NULL) {
+			err = ENOENT;
+			goto errout;
+		}
+		lwip_epoll_unqueue(ep, item);
+		lwip_epoll_unlink_ep(item);
+		lwip_epoll_unlink_sock(item);
+		freeitem = item;
+		item = NULL;
+		break;
+
+	default:
+		err = EINVAL;
+		goto errout;
+	}
+
+	/* Events which are already pending are reported by the next wait */
+	if (item != NULL && !item->ready && lwip_epoll_revents(sock, item->events) != 0) {
+		lwip_epoll_enqueue(item);
+	}
+
+errout:
+	SYS_ARCH_UNPROTECT(lev);
+	if (freeitem != NULL) {
+		mem_free(freeitem);
+	}
+	if (err != 0) {
+		set_errno(err);
+		return -1;
+	}
+	return 0;
+}
+
+int lwip_epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout)
+{
+	struct lwip_epoll *ep;
+	u32_t msectimeout;
+	u32_t waitres;
+	int nready;
+	int err = 0;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	if (events == NULL || maxevents <= 0) {
+		set_errno(EINVAL);
+		return -1;
+	}
+
+	SYS_ARCH_PROTECT(lev);
+	ep = lwip_epoll_get(epfd);
+	if (ep == NULL) {
+		SYS_ARCH_UNPROTECT(lev);
+		set_errno(EBADF);
+		return -1;
+	}
+
+	for (;;) {
+		nready = lwip_epoll_collect(ep, events, maxevents);
+		if (nready > 0 || timeout == 0) {
+			break;
+		}
+
+		/* None ready, wait to be woken by event_callback() */
+		if (timeout < 0) {
+			/* Wait forever */
+			msectimeout = 0;
+		} else if (timeout < MSEC_PER_TICK) {
+			/* Wait MSEC_PER_TICK at least (0 means wait forever) */
+			msectimeout = MSEC_PER_TICK;
+		} else {
+			msectimeout = timeout;
+		}
+
+		ep->waiting++;
+		SYS_ARCH_UNPROTECT(lev);
+		waitres = sys_arch_sem_wait(&ep->sem, msectimeout);
+		SYS_ARCH_PROTECT(lev);
+		ep->waiting--;
+		ep->signalled = 0;
+
+		if (ep->closed) {
+			/* epfd was closed while we were waiting */
+			int last = (ep->waiting == 0);
+			SYS_ARCH_UNPROTECT(lev);
+			if (last) {
+				lwip_epoll_free(ep);
+			}
+			set_errno(EBADF);
+			return -1;
+		}
+
+		if (waitres == SYS_ARCH_CANCELED) {
+			err = ECANCELED;
+			nready = -1;
+			break;
+		} else if (waitres == SYS_ARCH_TIMEOUT) {
+			/* Look at the queue one last time */
+			timeout = 0;
+		} else if (timeout > 0) {
+			timeout = (waitres < (u32_t)timeout) ? timeout - (int)waitres : 0;
+		}
+	}
+	SYS_ARCH_UNPROTECT(lev);
+
+	LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_epoll_wait(%d): nready=%d\n", epfd, nready));
+	set_errno(err);
+	return nready;
+}
+
+#if !LWIP_SELECT
+/**
+ * poll() on an epoll instance reports POLLIN while sockets are queued as
+ * ready, so that one descriptor can stand for many sockets in a poll() loop.
+ * Only one poll() at a time is supported on the same instance.
+ */
+static int lwip_epoll_poll(int epfd, struct pollfd *fds, bool setup)
+{
+	struct lwip_epoll *ep;
+	int ret = 0;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	ep = lwip_epoll_get(epfd);
+	if (ep == NULL) {
+		ret = -EBADF;
+	} else if (setup) {
+		if (ep->rdy_head != NULL && (fds->events & POLLIN)) {
+			fds->revents |= POLLIN;
+			sys_sem_signal(fds->sem);
+		} else if (ep->pollfd != NULL) {
+			ret = -EBUSY;
+		} else {
+			ep->pollfd = fds;
+		}
+	} else {
+		if (ep->pollfd == fds) {
+			ep->pollfd = NULL;
+		}
+		if (ep->rdy_head != NULL) {
+			fds->revents |= (fds->events & POLLIN);
+		}
+	}
+	SYS_ARCH_UNPROTECT(lev);
+
+	return ret;
+}
+#endif							/* !LWIP_SELECT */
+
+#endif							/* LWIP_EPOLL */
+
 #if LWIP_SELECT
 
 /**
@@ -1750,6 +2738,12 @@ int lwip_poll(int fd, struct pollfd *fds, bool setup)
 
 	struct lwip_sock *sock = NULL;
 
+#if LWIP_EPOLL
+	if (fd >= LWIP_SOCKET_OFFSET && fd < NUM_SOCKETS + LWIP_SOCKET_OFFSET && SOCK_IS_EPOLL(&sockets[fd - LWIP_SOCKET_OFFSET])) {
+		return lwip_epoll_poll(fd, fds, setup);
+	}
+#endif
+
 	/* First get the socket's status (protected)... */
 
 	sock = tryget_socket(fd);
@@ -1849,6 +2843,12 @@ static void event_callback(struct netconn *conn, enum netconn_evt evt, u16_t len
 		break;
 	}
 
+#if LWIP_EPOLL
+	if (sock->epitems != NULL) {
+		lwip_epoll_notify(sock, evt);
+	}
+#endif
+
 	if (sock->select_waiting == 0) {
 		/* none is waiting for this socket, no need to check select_cb_list */
 		SYS_ARCH_UNPROTECT(lev);
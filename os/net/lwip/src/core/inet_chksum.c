@@ -27,7 +27,7 @@
  * \#define LWIP_CHKSUM your_checksum_routine
  *
  * Or you can select from the implementations below by defining
- * LWIP_CHKSUM_ALGORITHM to 1, 2 or 3.
+ * LWIP_CHKSUM_ALGORITHM to 1, 2, 3 or 4.
  */
 
 /*
@@ -68,6 +68,7 @@
 #include "lwip/def.h"
 #include "lwip/ip_addr.h"
 
+#include <stdint.h>
 #include <string.h>
 
 #ifndef LWIP_CHKSUM
@@ -82,6 +83,68 @@ u16_t lwip_standard_chksum(const void *dataptr, int len);
 #define LWIP_CHKSUM_ALGORITHM 0
 #endif
 
+#if (LWIP_CHKSUM_ALGORITHM == 4) || (LWIP_CHKSUM_COPY_ALGORITHM == 2)
+/* 32-bit word accumulator for version #4 and the single pass copy.
+ * ARM adds the carries back with add-with-carry instructions, other
+ * targets collect them in the upper half of a 64-bit accumulator.
+ */
+#if defined(__arm__) && (defined(__thumb2__) || !defined(__thumb__))
+typedef u32_t chksum_acc_t;
+
+static inline void chksum_add1(chksum_acc_t *acc, u32_t a)
+{
+	__asm__("adds %0, %0, %1\n\t"
+			"adc %0, %0, #0"
+			: "+r"(*acc)
+			: "r"(a)
+			: "cc");
+}
+
+static inline void chksum_add4(chksum_acc_t *acc, u32_t a, u32_t b, u32_t c, u32_t d)
+{
+	__asm__("adds %0, %0, %1\n\t"
+			"adcs %0, %0, %2\n\t"
+			"adcs %0, %0, %3\n\t"
+			"adcs %0, %0, %4\n\t"
+			"adc %0, %0, #0"
+			: "+r"(*acc)
+			: "r"(a), "r"(b), "r"(c), "r"(d)
+			: "cc");
+}
+
+/* Fold to 17 bits at most */
+static inline u32_t chksum_fold(chksum_acc_t acc)
+{
+	return FOLD_U32T(acc);
+}
+#else
+typedef uint64_t chksum_acc_t;
+
+static inline void chksum_add1(chksum_acc_t *acc, u32_t a)
+{
+	*acc += a;
+}
+
+static inline void chksum_add4(chksum_acc_t *acc, u32_t a, u32_t b, u32_t c, u32_t d)
+{
+	*acc += (chksum_acc_t)a + b + c + d;
+}
+
+/* Fold to 17 bits at most */
+static inline u32_t chksum_fold(chksum_acc_t acc)
+{
+	u32_t lo = (u32_t)acc;
+	u32_t hi = (u32_t)(acc >> 32);
+
+	lo += hi;
+	if (lo < hi) {
+		lo++;					/* add back carry */
+	}
+	return FOLD_U32T(lo);
+}
+#endif
+#endif							/* (LWIP_CHKSUM_ALGORITHM == 4) || (LWIP_CHKSUM_COPY_ALGORITHM == 2) */
+
 #if (LWIP_CHKSUM_ALGORITHM == 1)	/* Version #1 */
 /**
  * lwip checksum
@@ -269,6 +332,79 @@ u16_t lwip_standard_chksum(const void *dataptr, int len)
 }
 #endif
 
+#if (LWIP_CHKSUM_ALGORITHM == 4)	/* Alternative version #4 */
+/**
+ * Like version #3, but the inner loop adds 32 bytes per iteration without
+ * checking for carries after each word (see chksum_add4).
+ *
+ * @param dataptr points to start of data to be summed at any boundary
+ * @param len length of data to be summed
+ * @return host order (!) lwip checksum (non-inverted Internet sum)
+ */
+u16_t lwip_standard_chksum(const void *dataptr, int len)
+{
+	const u8_t *pb = (const u8_t *)dataptr;
+	const u32_t *pl;
+	u16_t t = 0;
+	chksum_acc_t acc = 0;
+	u32_t sum;
+	/* starts at odd byte address? */
+	int odd = ((mem_ptr_t) pb & 1);
+
+	if (odd && len > 0) {
+		((u8_t *)&t)[1] = *pb++;
+		len--;
+	}
+
+	if (((mem_ptr_t) pb & 2) && len > 1) {
+		acc += *(const u16_t *)(const void *)pb;
+		pb += 2;
+		len -= 2;
+	}
+
+	pl = (const u32_t *)(const void *)pb;
+
+	while (len >= 32) {
+		chksum_add4(&acc, pl[0], pl[1], pl[2], pl[3]);
+		chksum_add4(&acc, pl[4], pl[5], pl[6], pl[7]);
+		pl += 8;
+		len -= 32;
+	}
+
+	while (len >= 4) {
+		chksum_add1(&acc, *pl++);
+		len -= 4;
+	}
+
+	sum = chksum_fold(acc);
+
+	pb = (const u8_t *)pl;
+
+	/* 16-bit aligned word remaining? */
+	if (len > 1) {
+		sum += *(const u16_t *)(const void *)pb;
+		pb += 2;
+		len -= 2;
+	}
+
+	/* dangling tail byte remaining? */
+	if (len > 0) {
+		((u8_t *)&t)[0] = *pb;
+	}
+
+	sum += t;
+
+	sum = FOLD_U32T(sum);
+	sum = FOLD_U32T(sum);
+
+	if (odd) {
+		sum = SWAP_BYTES_IN_WORD(sum);
+	}
+
+	return (u16_t) sum;
+}
+#endif
+
 /** Parts of the pseudo checksum which are common to IPv4 and IPv6 */
 static u16_t inet_cksum_pseudo_base(struct pbuf *p, u8_t proto, u16_t proto_len, u32_t acc)
 {
@@ -601,3 +737,110 @@ u16_t lwip_chksum_copy(void *dst, const void *src, u16_t len)
 	return LWIP_CHKSUM(dst, len);
 }
 #endif							/* (LWIP_CHKSUM_COPY_ALGORITHM == 1) */
+
+#if (LWIP_CHKSUM_COPY_ALGORITHM == 2)	/* Version #2 */
+/** Single pass: the source is read once as aligned 32-bit words, which are
+ * added to the checksum and stored to the destination while still in
+ * registers. The destination may have any alignment.
+ */
+u16_t lwip_chksum_copy(void *dst, const void *src, u16_t len)
+{
+	const u8_t *ps = (const u8_t *)src;
+	u8_t *pd = (u8_t *)dst;
+	const u32_t *pl;
+	u32_t w[4];
+	u16_t t = 0;
+	u16_t h;
+	chksum_acc_t acc = 0;
+	u32_t sum;
+	int n = len;
+	/* starts at odd byte address? */
+	int odd = ((mem_ptr_t) ps & 1);
+
+	if (odd && n > 0) {
+		((u8_t *)&t)[1] = *ps;
+		*pd++ = *ps++;
+		n--;
+	}
+
+	if (((mem_ptr_t) ps & 2) && n > 1) {
+		h = *(const u16_t *)(const void *)ps;
+		acc += h;
+		SMEMCPY(pd, &h, 2);
+		ps += 2;
+		pd += 2;
+		n -= 2;
+	}
+
+	pl = (const u32_t *)(const void *)ps;
+
+	if (((mem_ptr_t) pd & 3) == 0) {
+		u32_t *dl = (u32_t *)(void *)pd;
+
+		while (n >= 16) {
+			w[0] = pl[0];
+			w[1] = pl[1];
+			w[2] = pl[2];
+			w[3] = pl[3];
+			dl[0] = w[0];
+			dl[1] = w[1];
+			dl[2] = w[2];
+			dl[3] = w[3];
+			chksum_add4(&acc, w[0], w[1], w[2], w[3]);
+			pl += 4;
+			dl += 4;
+			n -= 16;
+		}
+		pd = (u8_t *)dl;
+	} else {
+		while (n >= 16) {
+			w[0] = pl[0];
+			w[1] = pl[1];
+			w[2] = pl[2];
+			w[3] = pl[3];
+			SMEMCPY(pd, w, 16);
+			chksum_add4(&acc, w[0], w[1], w[2], w[3]);
+			pl += 4;
+			pd += 16;
+			n -= 16;
+		}
+	}
+
+	while (n >= 4) {
+		w[0] = *pl++;
+		SMEMCPY(pd, w, 4);
+		chksum_add1(&acc, w[0]);
+		pd += 4;
+		n -= 4;
+	}
+
+	sum = chksum_fold(acc);
+
+	ps = (const u8_t *)pl;
+
+	if (n > 1) {
+		h = *(const u16_t *)(const void *)ps;
+		sum += h;
+		SMEMCPY(pd, &h, 2);
+		ps += 2;
+		pd += 2;
+		n -= 2;
+	}
+
+	if (n > 0) {
+		((u8_t *)&t)[0] = *ps;
+		*pd = *ps;
+	}
+
+	sum += t;
+
+	sum = FOLD_U32T(sum);
+	sum = FOLD_U32T(sum);
+
+	if (odd) {
+		sum = SWAP_BYTES_IN_WORD(sum);
+	}
+
+	return (u16_t) sum;
+}
+#endif							/* (LWIP_CHKSUM_COPY_ALGORITHM == 2) */
@@ -303,7 +303,13 @@ PACK_STRUCT_END
 #ifdef LWIP_HOOK_MEMP_AVAILABLE
 #error "LWIP_HOOK_MEMP_AVAILABLE doesn't make sense with MEMP_MEM_MALLOC"
 #endif
+#if MEMP_MEM_GROW
+#error "MEMP_MEM_MALLOC and MEMP_MEM_GROW cannot be enabled at the same time"
+#endif
 #endif							/* MEMP_MEM_MALLOC */
+#if MEMP_MEM_GROW && MEM_USE_POOLS
+#error "MEMP_MEM_GROW needs a heap that does not come from the pools, disable MEM_USE_POOLS"
+#endif
 /* TCP sanity checks */
 #if !LWIP_DISABLE_TCP_SANITY_CHECKS
 #if LWIP_TCP
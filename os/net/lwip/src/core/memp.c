@@ -56,6 +56,7 @@
  */
 
 #include <netdb.h>
+#include <tinyara/arch.h>
 
 #include "lwip/opt.h"
 #include "lwip/debug.h"
@@ -222,6 +223,175 @@ static void memp_overflow_check_all(void)
 #endif							/* MEMP_OVERFLOW_CHECK >= 2 */
 #endif							/* MEMP_OVERFLOW_CHECK */
 
+#if MEMP_MEM_GROW
+/* Space taken by one element, the same as in the static pools */
+#define MEMP_ELEM_SIZE(desc) (MEMP_SIZE + MEMP_ALIGN_SIZE((desc)->size))
+#define MEMP_SLAB_HDR_SIZE   LWIP_MEM_ALIGN_SIZE(sizeof(struct memp_slab))
+
+/**
+ * Allocate and carve a new slab for a pool. Called without protection.
+ */
+static struct memp_slab *memp_slab_alloc(const struct memp_desc *desc)
+{
+	struct memp_slab *slab;
+	struct memp *memp;
+	u16_t i;
+
+	slab = (struct memp_slab *)mem_malloc(MEMP_SLAB_HDR_SIZE + MEMP_GROW_SLAB * MEMP_ELEM_SIZE(desc));
+	if (slab == NULL) {
+		return NULL;
+	}
+
+	slab->free = NULL;
+	memp = (struct memp *)(void *)((u8_t *)slab + MEMP_SLAB_HDR_SIZE);
+	for (i = 0; i < MEMP_GROW_SLAB; i++) {
+		memp->next = slab->free;
+		slab->free = memp;
+#if MEMP_OVERFLOW_CHECK
+		memp_overflow_init_element(memp, desc);
+#endif
+		memp = (struct memp *)(void *)((u8_t *)memp + MEMP_ELEM_SIZE(desc));
+	}
+	slab->nfree = MEMP_GROW_SLAB;
+
+	return slab;
+}
+
+/**
+ * Take an element from the slabs of a pool, preferring partly used slabs
+ * so that the empty ones can be released. Called with protection.
+ */
+static struct memp *memp_slab_take(const struct memp_desc *desc)
+{
+	struct memp_slab *slab;
+	struct memp_slab *empty = NULL;
+	struct memp *memp;
+
+	for (slab = desc->grow->slabs; slab != NULL; slab = slab->next) {
+		if (slab->nfree == MEMP_GROW_SLAB) {
+			if (empty == NULL) {
+				empty = slab;
+			}
+		} else if (slab->nfree > 0) {
+			break;
+		}
+	}
+	if (slab == NULL) {
+		slab = empty;
+		if (slab == NULL) {
+			return NULL;
+		}
+		desc->grow->nempty--;
+	}
+
+	memp = slab->free;
+	slab->free = memp->next;
+	slab->nfree--;
+
+	return memp;
+}
+
+/**
+ * Link a slab allocated by memp_slab_alloc() into its pool and take an
+ * element from the pool's slabs. slab is NULL if the heap was exhausted.
+ * Called with protection.
+ */
+static struct memp *memp_slab_add(const struct memp_desc *desc, struct memp_slab *slab)
+{
+	if (slab == NULL) {
+		desc->grow->nslabs--;
+		return NULL;
+	}
+
+	slab->next = desc->grow->slabs;
+	desc->grow->slabs = slab;
+	desc->grow->nempty++;
+#if MEMP_STATS
+	desc->stats->avail += MEMP_GROW_SLAB;
+#endif
+
+	return memp_slab_take(desc);
+}
+
+/**
+ * Check whether an element belongs to the static array of a pool, laid
+ * out as by memp_init_pool(). These go back to the pool list without
+ * looking at the slabs.
+ */
+static int memp_in_pool(const struct memp_desc *desc, struct memp *memp)
+{
+	u8_t *start = (u8_t *)LWIP_MEM_ALIGN(desc->base);
+	size_t size = MEMP_SIZE + desc->size
+#if MEMP_OVERFLOW_CHECK
+				  + MEMP_SANITY_REGION_AFTER_ALIGNED
+#endif
+				  ;
+
+	return (u8_t *)memp >= start && (u8_t *)memp < start + (size_t)desc->num * size;
+}
+
+/**
+ * Return an element to the slab it came from. A slab left unused is kept,
+ * memp_slab_trim() returns the surplus ones to the heap. Called with
+ * protection.
+ *
+ * @return 1 if memp came from a slab, 0 if it came from the static pool
+ */
+static int memp_slab_put(const struct memp_desc *desc, struct memp *memp)
+{
+	struct memp_slab *slab;
+	u8_t *start;
+
+	for (slab = desc->grow->slabs; slab != NULL; slab = slab->next) {
+		start = (u8_t *)slab + MEMP_SLAB_HDR_SIZE;
+		if ((u8_t *)memp >= start && (u8_t *)memp < start + MEMP_GROW_SLAB * MEMP_ELEM_SIZE(desc)) {
+			memp->next = slab->free;
+			slab->free = memp;
+			slab->nfree++;
+			if (slab->nfree == MEMP_GROW_SLAB) {
+				desc->grow->nempty++;
+			}
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Unlink an unused slab if the pool has more than one, keeping the other
+ * for the next burst. The caller frees it without protection, so this is
+ * skipped in interrupt context and the slab waits for the next call from a
+ * thread. Called with protection.
+ *
+ * @return the slab to free, or NULL
+ */
+static struct memp_slab *memp_slab_trim(const struct memp_desc *desc)
+{
+	struct memp_slab **link;
+	struct memp_slab *slab;
+
+	if (desc->grow->nempty < 2 || up_interrupt_context()) {
+		return NULL;
+	}
+
+	for (link = &desc->grow->slabs; *link != NULL; link = &(*link)->next) {
+		slab = *link;
+		if (slab->nfree == MEMP_GROW_SLAB) {
+			*link = slab->next;
+			desc->grow->nslabs--;
+			desc->grow->nempty--;
+#if MEMP_STATS
+			desc->stats->avail -= MEMP_GROW_SLAB;
+#endif
+			return slab;
+		}
+	}
+
+	return NULL;
+}
+#endif							/* MEMP_MEM_GROW */
+
 /**
  * Initialize custom memory pool.
  * Related functions: memp_malloc_pool, memp_free_pool
@@ -295,6 +465,9 @@ do_memp_malloc_pool_fn(const struct memp_desc *desc, const char *file, const int
 #endif
 {
 	struct memp *memp;
+#if !MEMP_MEM_MALLOC && MEMP_MEM_GROW
+	struct memp_slab *release;
+#endif
 	SYS_ARCH_DECL_PROTECT(old_level);
 
 #if MEMP_MEM_MALLOC
@@ -304,6 +477,26 @@ do_memp_malloc_pool_fn(const struct memp_desc *desc, const char *file, const int
 	SYS_ARCH_PROTECT(old_level);
 
 	memp = *desc->tab;
+	if (memp != NULL) {
+		*desc->tab = memp->next;
+	}
+#if MEMP_MEM_GROW
+	else {
+		memp = memp_slab_take(desc);
+		if (memp == NULL && desc->grow->nslabs < MEMP_GROW_MAXSLABS && !up_interrupt_context()) {
+			struct memp_slab *slab;
+
+			/* Count the slab before allocating it, so that concurrent
+			 * callers cannot grow the pool past its cap.
+			 */
+			desc->grow->nslabs++;
+			SYS_ARCH_UNPROTECT(old_level);
+			slab = memp_slab_alloc(desc);
+			SYS_ARCH_PROTECT(old_level);
+			memp = memp_slab_add(desc, slab);
+		}
+	}
+#endif							/* MEMP_MEM_GROW */
 #endif							/* MEMP_MEM_MALLOC */
 
 	if (memp != NULL) {
@@ -313,7 +506,6 @@ do_memp_malloc_pool_fn(const struct memp_desc *desc, const char *file, const int
 		memp_overflow_check_element_underflow(memp, desc);
 #endif							/* MEMP_OVERFLOW_CHECK */
 
-		*desc->tab = memp->next;
 #if MEMP_OVERFLOW_CHECK
 		memp->next = NULL;
 #endif							/* MEMP_OVERFLOW_CHECK */
@@ -331,8 +523,16 @@ do_memp_malloc_pool_fn(const struct memp_desc *desc, const char *file, const int
 		if (desc->stats->used > desc->stats->max) {
 			desc->stats->max = desc->stats->used;
 		}
+#endif
+#if !MEMP_MEM_MALLOC && MEMP_MEM_GROW
+		release = memp_slab_trim(desc);
 #endif
 		SYS_ARCH_UNPROTECT(old_level);
+#if !MEMP_MEM_MALLOC && MEMP_MEM_GROW
+		if (release != NULL) {
+			mem_free(release);
+		}
+#endif
 		/* cast through u8_t* to get rid of alignment warnings */
 		return ((u8_t *) memp + MEMP_SIZE);
 	} else {
@@ -404,6 +604,9 @@ memp_malloc_fn(memp_t type, const char *file, const int line)
 static void do_memp_free_pool(const struct memp_desc *desc, void *mem)
 {
 	struct memp *memp;
+#if !MEMP_MEM_MALLOC && MEMP_MEM_GROW
+	struct memp_slab *release;
+#endif
 	SYS_ARCH_DECL_PROTECT(old_level);
 
 	LWIP_ASSERT("memp_free: mem properly aligned", ((mem_ptr_t) mem % MEM_ALIGNMENT) == 0);
@@ -427,14 +630,27 @@ static void do_memp_free_pool(const struct memp_desc *desc, void *mem)
 	SYS_ARCH_UNPROTECT(old_level);
 	mem_free(memp);
 #else							/* MEMP_MEM_MALLOC */
-	memp->next = *desc->tab;
-	*desc->tab = memp;
+#if MEMP_MEM_GROW
+	if (desc->grow->slabs == NULL || memp_in_pool(desc, memp) || !memp_slab_put(desc, memp))
+#endif
+	{
+		memp->next = *desc->tab;
+		*desc->tab = memp;
+	}
 
 #if MEMP_SANITY_CHECK
 	LWIP_ASSERT("memp sanity", memp_sanity(desc));
 #endif							/* MEMP_SANITY_CHECK */
 
+#if MEMP_MEM_GROW
+	release = memp_slab_trim(desc);
+#endif
 	SYS_ARCH_UNPROTECT(old_level);
+#if MEMP_MEM_GROW
+	if (release != NULL) {
+		mem_free(release);
+	}
+#endif
 #endif							/* !MEMP_MEM_MALLOC */
 }
 
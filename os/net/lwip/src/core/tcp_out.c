@@ -284,6 +284,79 @@ static struct pbuf *tcp_pbuf_prealloc(pbuf_layer layer, u16_t length, u16_t max_
 #define tcp_pbuf_prealloc(layer, length, mx, os, pcb, api, fst) pbuf_alloc((layer), (length), PBUF_RAM)
 #endif							/* TCP_OVERSIZE */
 
+#if LWIP_TCP_ZEROCOPY
+/** A pbuf referencing data queued by tcp_write_zc() */
+struct tcp_zc_pbuf {
+	struct pbuf_custom pc;
+	struct tcp_zc *zc;
+};
+
+static void tcp_zc_pbuf_free(struct pbuf *p)
+{
+	struct tcp_zc_pbuf *zp = (struct tcp_zc_pbuf *)p;
+
+	tcp_zc_unref(zp->zc);
+	mem_free(zp);
+}
+
+/**
+ * Drop a reference to caller owned data, zc->done() is called when it was
+ * the last one.
+ */
+void tcp_zc_unref(struct tcp_zc *zc)
+{
+	u32_t refs;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	refs = --zc->refs;
+	SYS_ARCH_UNPROTECT(lev);
+
+	if (refs == 0) {
+		zc->done(zc);
+	}
+}
+#endif							/* LWIP_TCP_ZEROCOPY */
+
+/**
+ * Allocate a pbuf referencing data which is not copied. With zc, the pbuf
+ * holds a reference on zc until it is freed.
+ */
+static struct pbuf *tcp_ref_pbuf_alloc(pbuf_layer layer, const u8_t *data, u16_t len, struct tcp_zc *zc)
+{
+	struct pbuf *p;
+
+#if LWIP_TCP_ZEROCOPY
+	if (zc != NULL) {
+		struct tcp_zc_pbuf *zp;
+		SYS_ARCH_DECL_PROTECT(lev);
+
+		zp = (struct tcp_zc_pbuf *)mem_malloc(sizeof(struct tcp_zc_pbuf));
+		if (zp == NULL) {
+			return NULL;
+		}
+		zp->zc = zc;
+		zp->pc.custom_free_function = tcp_zc_pbuf_free;
+		p = pbuf_alloced_custom(PBUF_RAW, len, PBUF_REF, &zp->pc, NULL, len);
+		p->payload = (void *)data;
+
+		SYS_ARCH_PROTECT(lev);
+		zc->refs++;
+		SYS_ARCH_UNPROTECT(lev);
+		return p;
+	}
+#else
+	LWIP_UNUSED_ARG(zc);
+#endif							/* LWIP_TCP_ZEROCOPY */
+
+	p = pbuf_alloc(layer, len, PBUF_ROM);
+	if (p != NULL) {
+		/* reference the non-volatile payload data */
+		((struct pbuf_rom *)p)->payload = data;
+	}
+	return p;
+}
+
 #if TCP_CHECKSUM_ON_COPY
 /** Add a checksum of newly added data to the segment */
 static void tcp_seg_add_chksum(u16_t chksum, u16_t len, u16_t *seg_chksum, u8_t *seg_chksum_swapped)
@@ -359,6 +432,16 @@ static err_t tcp_write_checks(struct tcp_pcb *pcb, u16_t len)
  * @return ERR_OK if enqueued, another err_t on error
  */
 err_t tcp_write(struct tcp_pcb *pcb, const void *arg, u16_t len, u8_t apiflags)
+{
+	return tcp_write_zc(pcb, arg, len, apiflags, NULL);
+}
+
+/**
+ * Same as tcp_write. When the data is not copied and zc is not NULL, the
+ * pbufs referencing the data hold references on zc, so that the owner of
+ * the data learns when TCP is done with it.
+ */
+err_t tcp_write_zc(struct tcp_pcb *pcb, const void *arg, u16_t len, u8_t apiflags, struct tcp_zc *zc)
 {
 	struct pbuf *concat_p = NULL;
 	struct tcp_seg *last_unsent = NULL, *seg = NULL, *prev_seg = NULL, *queue = NULL;
@@ -506,16 +589,14 @@ err_t tcp_write(struct tcp_pcb *pcb, const void *arg, u16_t len, u8_t apiflags)
 				/* If the last unsent pbuf is of type PBUF_ROM, try to extend it. */
 				struct pbuf *p;
 				for (p = last_unsent->p; p->next != NULL; p = p->next) ;
-				if (p->type == PBUF_ROM && (const u8_t *)p->payload + p->len == (const u8_t *)arg) {
+				if (zc == NULL && p->type == PBUF_ROM && (const u8_t *)p->payload + p->len == (const u8_t *)arg) {
 					LWIP_ASSERT("tcp_write: ROM pbufs cannot be oversized", pos == 0);
 					extendlen = seglen;
 				} else {
-					if ((concat_p = pbuf_alloc(PBUF_RAW, seglen, PBUF_ROM)) == NULL) {
+					if ((concat_p = tcp_ref_pbuf_alloc(PBUF_RAW, (const u8_t *)arg + pos, seglen, zc)) == NULL) {
 						LWIP_DEBUGF(TCP_OUTPUT_DEBUG | LWIP_DBG_LEVEL_SERIOUS, ("tcp_write: could not allocate memory for zero-copy pbuf\n"));
 						goto memerr;
 					}
-					/* reference the non-volatile payload data */
-					((struct pbuf_rom *)concat_p)->payload = (const u8_t *)arg + pos;
 					queuelen += pbuf_clen(concat_p);
 				}
 #if TCP_CHECKSUM_ON_COPY
@@ -568,7 +649,7 @@ err_t tcp_write(struct tcp_pcb *pcb, const void *arg, u16_t len, u8_t apiflags)
 #if TCP_OVERSIZE
 			LWIP_ASSERT("oversize == 0", oversize == 0);
 #endif							/* TCP_OVERSIZE */
-			if ((p2 = pbuf_alloc(PBUF_TRANSPORT, seglen, PBUF_ROM)) == NULL) {
+			if ((p2 = tcp_ref_pbuf_alloc(PBUF_TRANSPORT, (const u8_t *)arg + pos, seglen, zc)) == NULL) {
 				LWIP_DEBUGF(TCP_OUTPUT_DEBUG | LWIP_DBG_LEVEL_SERIOUS, ("tcp_write: could not allocate memory for zero-copy pbuf\n"));
 				goto memerr;
 			}
@@ -580,8 +661,6 @@ err_t tcp_write(struct tcp_pcb *pcb, const void *arg, u16_t len, u8_t apiflags)
 				chksum = SWAP_BYTES_IN_WORD(chksum);
 			}
 #endif							/* TCP_CHECKSUM_ON_COPY */
-			/* reference the non-volatile payload data */
-			((struct pbuf_rom *)p2)->payload = (const u8_t *)arg + pos;
 
 			/* Second, allocate a pbuf for the headers. */
 			if ((p = pbuf_alloc(PBUF_TRANSPORT, optlen, PBUF_RAM)) == NULL) {
@@ -349,6 +349,10 @@ err_t netconn_recv_tcp_pbuf(struct netconn *conn, struct pbuf **new_buf);
 err_t netconn_sendto(struct netconn *conn, struct netbuf *buf, const ip_addr_t *addr, u16_t port);
 err_t netconn_send(struct netconn *conn, struct netbuf *buf);
 err_t netconn_write_partly(struct netconn *conn, const void *dataptr, size_t size, u8_t apiflags, size_t *bytes_written);
+#if LWIP_TCP_ZEROCOPY
+struct tcp_zc;
+err_t netconn_write_partly_zc(struct netconn *conn, const void *dataptr, size_t size, u8_t apiflags, size_t *bytes_written, struct tcp_zc *zc);
+#endif
 #define netconn_write(conn, dataptr, size, apiflags) \
 		netconn_write_partly(conn, dataptr, size, apiflags, NULL)
 err_t netconn_close(struct netconn *conn);
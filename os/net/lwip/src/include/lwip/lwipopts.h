@@ -236,6 +236,23 @@
 #endif
 /* ---------- VLAN options ---------- */
 
+/* ---------- Checksum options ---------- */
+#if defined(CONFIG_NET_LWIP_CHKSUM_HALFWORD)
+#define LWIP_CHKSUM_ALGORITHM           2
+#elif defined(CONFIG_NET_LWIP_CHKSUM_UNROLLED)
+#define LWIP_CHKSUM_ALGORITHM           3
+#elif defined(CONFIG_NET_LWIP_CHKSUM_WORD)
+#define LWIP_CHKSUM_ALGORITHM           4
+#endif
+
+#ifdef CONFIG_NET_LWIP_CHECKSUM_ON_COPY
+#define LWIP_CHECKSUM_ON_COPY           1
+#define LWIP_CHKSUM_COPY_ALGORITHM      2
+#else
+#define LWIP_CHECKSUM_ON_COPY           0
+#endif
+/* ---------- Checksum options ---------- */
+
 /* ---------- IP options ---------- */
 
 #ifdef CONFIG_NET_IP_FORWARD
@@ -519,6 +536,14 @@
 #define MEMP_OVERFLOW_CHECK	CONFIG_NET_MEMP_OVERFLOW_CHECK
 #endif
 
+#ifdef CONFIG_NET_MEMP_GROW
+#define MEMP_MEM_GROW	1
+#define MEMP_GROW_SLAB	CONFIG_NET_MEMP_GROW_SLAB
+#define MEMP_GROW_MAXSLABS	CONFIG_NET_MEMP_GROW_MAXSLABS
+#else
+#define MEMP_MEM_GROW	0
+#endif
+
 #ifdef CONFIG_NET_MEMP_SANITY_CHECK
 #define MEMP_SANITY_CHECK	CONFIG_NET_MEMP_SANITY_CHECK
 #endif
@@ -644,6 +669,34 @@
 #define LWIP_SOCKET	CONFIG_NET_SOCKET
 #endif
 
+#ifdef CONFIG_NET_EPOLL
+#define LWIP_EPOLL                      1
+#else
+#define LWIP_EPOLL                      0
+#endif
+
+#ifdef CONFIG_NET_ZEROCOPY
+#define LWIP_ZEROCOPY                   1
+#else
+#define LWIP_ZEROCOPY                   0
+#endif
+
+#ifdef CONFIG_NET_SENDFILE
+#define LWIP_SENDFILE                   1
+#else
+#define LWIP_SENDFILE                   0
+#endif
+
+/* send_zc() and sendfile() hand TCP custom pbufs which report when they
+ * are freed (tcp_write_zc)
+ */
+#if LWIP_ZEROCOPY || LWIP_SENDFILE
+#define LWIP_TCP_ZEROCOPY               1
+#define LWIP_SUPPORT_CUSTOM_PBUF        1
+#else
+#define LWIP_TCP_ZEROCOPY               0
+#endif
+
 #ifdef CONFIG_NET_SOCKET_OPTION_BROADCAST
 #define IP_SOF_BROADCAST                CONFIG_NET_SOCKET_OPTION_BROADCAST
 #endif
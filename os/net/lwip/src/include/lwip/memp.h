@@ -109,6 +109,8 @@ extern const struct memp_desc *const memp_pools[MEMP_MAX];
 	\
 	static struct memp *memp_tab_ ## name; \
 	\
+	LWIP_MEMPOOL_DECLARE_GROW_INSTANCE(memp_grow_ ## name) \
+	\
 	const struct memp_desc memp_ ## name = { \
 			DECLARE_LWIP_MEMPOOL_DESC(desc) \
 			LWIP_MEMPOOL_DECLARE_STATS_REFERENCE(memp_stats_ ## name) \
@@ -116,6 +118,7 @@ extern const struct memp_desc *const memp_pools[MEMP_MAX];
 			(num), \
 			memp_memory_ ## name ## _base, \
 			&memp_tab_ ## name \
+			LWIP_MEMPOOL_DECLARE_GROW_REFERENCE(memp_grow_ ## name) \
 	};
 
 #endif							/* MEMP_MEM_MALLOC */
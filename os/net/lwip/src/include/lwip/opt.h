@@ -231,6 +231,32 @@
 #define MEMP_MEM_MALLOC                 0
 #endif
 
+/**
+ * MEMP_MEM_GROW==1: Keep the static pools, but when one runs out, allocate
+ * MEMP_GROW_SLAB more elements for it with mem_malloc(), up to
+ * MEMP_GROW_MAXSLABS times. A slab is returned with mem_free() when all its
+ * elements are free and the pool already has an empty slab.
+ * Pools never grow or shrink in interrupt context, a slab emptied there is
+ * returned by the next allocation or free from a thread.
+ */
+#ifndef MEMP_MEM_GROW
+#define MEMP_MEM_GROW                   0
+#endif
+
+/**
+ * MEMP_GROW_SLAB: the number of elements a pool grows by at once.
+ */
+#ifndef MEMP_GROW_SLAB
+#define MEMP_GROW_SLAB                  4
+#endif
+
+/**
+ * MEMP_GROW_MAXSLABS: the most slabs a single pool grows by.
+ */
+#ifndef MEMP_GROW_MAXSLABS
+#define MEMP_GROW_MAXSLABS              8
+#endif
+
 /**
  * MEM_ALIGNMENT: should be set to the alignment of the CPU
  *    4 byte alignment -> \#define MEM_ALIGNMENT 4
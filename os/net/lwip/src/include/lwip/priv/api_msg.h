@@ -126,6 +126,9 @@ struct api_msg {
 #if LWIP_SO_SNDTIMEO
 			u32_t time_started;
 #endif							/* LWIP_SO_SNDTIMEO */
+#if LWIP_TCP_ZEROCOPY
+			struct tcp_zc *zc;
+#endif							/* LWIP_TCP_ZEROCOPY */
 		} w;
 		/** used for lwip_netconn_do_recv */
 		struct {
@@ -143,12 +143,32 @@ typedef enum {
 #define MEMP_POOL_LAST   ((memp_t) MEMP_POOL_HELPER_LAST)
 #endif							/* MEM_USE_POOLS && MEMP_USE_CUSTOM_POOLS */
 
+#if MEMP_MEM_GROW
+/** A block of MEMP_GROW_SLAB elements allocated when a pool ran out.
+ * The elements follow the header. */
+struct memp_slab {
+	struct memp_slab *next;
+	/** Free elements of this slab */
+	struct memp *free;
+	u16_t nfree;
+};
+
+/** Slabs a pool has grown by */
+struct memp_grow {
+	struct memp_slab *slabs;
+	/** Number of slabs, including those being allocated */
+	u8_t nslabs;
+	/** Number of slabs with all elements free */
+	u8_t nempty;
+};
+#endif							/* MEMP_MEM_GROW */
+
 /** Memory pool descriptor */
 struct memp_desc {
-#if defined(LWIP_DEBUG) || MEMP_OVERFLOW_CHECK || LWIP_STATS_DISPLAY
+#if defined(LWIP_DEBUG) || MEMP_OVERFLOW_CHECK || LWIP_STATS_DISPLAY || MEMP_STATS
 	/** Textual description */
 	const char *desc;
-#endif							/* LWIP_DEBUG || MEMP_OVERFLOW_CHECK || LWIP_STATS_DISPLAY */
+#endif							/* LWIP_DEBUG || MEMP_OVERFLOW_CHECK || LWIP_STATS_DISPLAY || MEMP_STATS */
 #if MEMP_STATS
 	/** Statistics */
 	struct stats_mem *stats;
@@ -166,10 +186,15 @@ struct memp_desc {
 
 	/** First free element of each pool. Elements form a linked list. */
 	struct memp **tab;
+
+#if MEMP_MEM_GROW
+	/** Elements allocated beyond num */
+	struct memp_grow *grow;
+#endif
 #endif							/* MEMP_MEM_MALLOC */
 };
 
-#if defined(LWIP_DEBUG) || MEMP_OVERFLOW_CHECK || LWIP_STATS_DISPLAY
+#if defined(LWIP_DEBUG) || MEMP_OVERFLOW_CHECK || LWIP_STATS_DISPLAY || MEMP_STATS
 #define DECLARE_LWIP_MEMPOOL_DESC(desc) (desc),
 #else
 #define DECLARE_LWIP_MEMPOOL_DESC(desc)
@@ -183,6 +208,14 @@ struct memp_desc {
 #define LWIP_MEMPOOL_DECLARE_STATS_REFERENCE(name)
 #endif
 
+#if MEMP_MEM_GROW
+#define LWIP_MEMPOOL_DECLARE_GROW_INSTANCE(name) static struct memp_grow name;
+#define LWIP_MEMPOOL_DECLARE_GROW_REFERENCE(name) , &name
+#else
+#define LWIP_MEMPOOL_DECLARE_GROW_INSTANCE(name)
+#define LWIP_MEMPOOL_DECLARE_GROW_REFERENCE(name)
+#endif
+
 void memp_init_pool(const struct memp_desc *desc);
 
 #if MEMP_OVERFLOW_CHECK
@@ -69,6 +69,9 @@
 
 #include <sys/select.h>
 #include <sys/uio.h>
+#if LWIP_EPOLL
+#include <sys/epoll.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -473,6 +476,19 @@ typedef struct ip_mreq {
 #define SELWAIT_T u8_t
 #endif
 
+#if LWIP_ZEROCOPY
+/** Received data handed out by recv_zc(), seg[] point into stack buffers
+ * which stay valid until recv_zc_release() */
+struct zc_rbuf {
+	void *priv;
+	int nseg;
+	struct iovec seg[CONFIG_NET_ZEROCOPY_MAXSEG];
+};
+
+/** Called by send_zc() once the stack does not reference buf anymore */
+typedef void (*zc_release_t)(void *buf, void *arg);
+#endif
+
 /** Contains all internal pointers and states used for a socket */
 struct lwip_sock {
 	/** sockets currently are built on netconns, each socket has one netconn */
@@ -493,6 +509,12 @@ struct lwip_sock {
 	u8_t err;
 	/** counter of how many threads are waiting for this socket using select */
 	SELWAIT_T select_waiting;
+#if LWIP_EPOLL
+	/** epoll registrations of this socket, updated by event_callback() */
+	struct lwip_epitem *epitems;
+	/** set when this descriptor is an epoll instance instead of a socket */
+	struct lwip_epoll *epoll;
+#endif
 };
 
 #define lwip_socket_init()		/* Compatibility define, no init needed. */
@@ -526,6 +548,20 @@ int lwip_ioctl(int s, long cmd, void *argp);
 int lwip_fcntl(int s, int cmd, int val);
 
 int lwip_poll(int fd, struct pollfd *fds, bool setup);
+#if LWIP_EPOLL
+int lwip_epoll_create(int flags);
+int lwip_epoll_ctl(int epfd, int op, int fd, struct epoll_event *event);
+int lwip_epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout);
+#endif
+#if LWIP_ZEROCOPY
+int lwip_recv_zc(int s, struct zc_rbuf *zb, size_t len, int flags);
+void lwip_recv_zc_release(struct zc_rbuf *zb);
+int lwip_send_zc(int s, const void *dataptr, size_t size, int flags, zc_release_t release, void *arg);
+#endif
+#if LWIP_SENDFILE
+struct file;
+int lwip_sendfile(int s, struct file *filep, off_t *offset, size_t count);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -410,6 +410,23 @@ err_t tcp_shutdown(struct tcp_pcb *pcb, int shut_rx, int shut_tx);
 
 err_t tcp_write(struct tcp_pcb *pcb, const void *dataptr, u16_t len, u8_t apiflags);
 
+#if LWIP_TCP_ZEROCOPY
+/** Caller owned data queued without TCP_WRITE_FLAG_COPY by tcp_write_zc().
+ *  Each pbuf referencing the data holds a reference, done() is called from
+ *  the thread dropping the last one, once TCP does not need the data any
+ *  more (acknowledged, or the connection was aborted).
+ */
+struct tcp_zc {
+	u32_t refs;
+	void (*done)(struct tcp_zc *zc);
+};
+
+void tcp_zc_unref(struct tcp_zc *zc);
+#else
+struct tcp_zc;
+#endif
+err_t tcp_write_zc(struct tcp_pcb *pcb, const void *dataptr, u16_t len, u8_t apiflags, struct tcp_zc *zc);
+
 void tcp_setprio(struct tcp_pcb *pcb, u8_t prio);
 
 #define TCP_PRIO_MIN    1
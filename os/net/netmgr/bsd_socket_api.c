@@ -28,6 +28,9 @@
 #include <tinyara/cancelpt.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#ifdef CONFIG_NET_EPOLL
+#include <sys/epoll.h>
+#endif
 #include <netinet/in.h>
 #include <net/if.h>
 #include <tinyara/lwnl/lwnl.h>
@@ -194,4 +197,58 @@ int socket(int domain, int type, int protocol)
 	NETSTACK_CALL(stk, socket, (domain, type, protocol));
 }
 
+#ifdef CONFIG_NET_EPOLL
+int epoll_create1(int flags)
+{
+	struct netstack *stk = get_netstack(TR_SOCKET);
+	NETSTACK_CALL(stk, epoll_create, (flags));
+}
+
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event)
+{
+	NETSTACK_CALL_BYFD(epfd, epoll_ctl, (epfd, op, fd, event));
+}
+
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout)
+{
+	/* Treat as a cancellation point */
+	(void)enter_cancellation_point();
+	int res = -1;
+	NETSTACK_CALL_BYFD_RET(epfd, epoll_wait, (epfd, events, maxevents, timeout), res);
+	leave_cancellation_point();
+	return res;
+}
+#endif
+
+#ifdef CONFIG_NET_ZEROCOPY
+ssize_t recv_zc(int sockfd, struct zc_rbuf *zb, size_t len, int flags)
+{
+	/* Treat as a cancellation point */
+	(void)enter_cancellation_point();
+	ssize_t res = -1;
+	NETSTACK_CALL_BYFD_RET(sockfd, recv_zc, (sockfd, zb, len, flags), res);
+	leave_cancellation_point();
+	return res;
+}
+
+void recv_zc_release(struct zc_rbuf *zb)
+{
+	/* Only the lwIP stack hands out zero-copy buffers */
+	struct netstack *stk = get_netstack(TR_SOCKET);
+	if (stk && stk->ops->recv_zc_release) {
+		stk->ops->recv_zc_release(zb);
+	}
+}
+
+ssize_t send_zc(int sockfd, const void *data, size_t size, int flags, zc_release_t release, void *arg)
+{
+	/* Treat as a cancellation point */
+	(void)enter_cancellation_point();
+	ssize_t res = -1;
+	NETSTACK_CALL_BYFD_RET(sockfd, send_zc, (sockfd, data, size, flags, release, arg), res);
+	leave_cancellation_point();
+	return res;
+}
+#endif
+
 #endif // CONFIG_NET
@@ -110,6 +110,38 @@ int net_close(int sd)
 	NETSTACK_CALL_BYFD(sd, close, (sd));
 }
 
+#ifdef CONFIG_NET_SENDFILE
+/****************************************************************************
+ * Function: net_sendfile
+ *
+ * Description:
+ *   Send count bytes of an open file on a socket, see sendfile().
+ *
+ * Parameters:
+ *   sd      Socket descriptor of socket
+ *   infile  The file to read from
+ *   offset  Where to start reading, or NULL for the file position
+ *   count   Number of bytes to send
+ *
+ * Returned Value:
+ *   The number of bytes sent; -1 on error with errno set appropriately.
+ *   ENOSYS if the stack of the socket does not support it.
+ *
+ ****************************************************************************/
+
+ssize_t net_sendfile(int sd, FAR struct file *infile, FAR off_t *offset, size_t count)
+{
+	struct netstack *stk = get_netstack_byfd(sd);
+
+	if (stk == NULL || stk->ops->sendfile == NULL) {
+		set_errno(ENOSYS);
+		return ERROR;
+	}
+
+	return stk->ops->sendfile(sd, infile, offset, count);
+}
+#endif
+
 /****************************************************************************
  * Function: net_poll
  *
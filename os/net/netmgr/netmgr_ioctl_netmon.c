@@ -18,12 +18,18 @@
 
 #include <tinyara/config.h>
 #include <errno.h>
+#include <string.h>
 #include <sys/types.h>
 #include <sys/ioctl.h>
 #include <net/if.h>
 #include <tinyara/netmgr/netdev_mgr.h>
 #include "netstack.h"
 #include "netdev_mgr_internal.h"
+#ifdef CONFIG_NET_MEMP_STATS
+#include "lwip/opt.h"
+#include "lwip/sys.h"
+#include "lwip/memp.h"
+#endif
 /****************************************************************************
  * Function: netdev_getstats
  *
@@ -58,6 +64,57 @@ static int _copy_socket(void *arg)
 
 #endif  //CONFIG_NET_NETMON & CONFIG_NET_STATS
 
+/****************************************************************************
+ * Function: _copy_memp
+ *
+ * Description:
+ *   Copy the usage of the lwIP memory pools, including the high-water mark
+ *   and the number of failed allocations of each
+ *
+ * Parameters:
+ *   memp  Where to copy the stats, see struct netmon_memp
+ *
+ * Returned Value:
+ *   0:Success; negated errno on failure
+ *
+ ****************************************************************************/
+#ifdef CONFIG_NET_MEMP_STATS
+static int _copy_memp(struct netmon_memp *memp)
+{
+	const struct memp_desc *desc;
+	struct netmon_memp_stats *stats;
+	int i;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	if (!memp || (memp->npools > 0 && !memp->pools)) {
+		return -EINVAL;
+	}
+
+	for (i = 0; i < MEMP_MAX && i < memp->npools; i++) {
+		desc = memp_pools[i];
+		stats = &memp->pools[i];
+
+		strncpy(stats->name, desc->desc, NETMON_MEMP_NAMELEN - 1);
+		stats->name[NETMON_MEMP_NAMELEN - 1] = '\0';
+		stats->size = desc->size;
+		stats->limit = desc->num;
+#if MEMP_MEM_GROW
+		stats->limit += (u32_t)MEMP_GROW_SLAB * MEMP_GROW_MAXSLABS;
+#endif
+
+		SYS_ARCH_PROTECT(lev);
+		stats->avail = desc->stats->avail;
+		stats->used = desc->stats->used;
+		stats->max = desc->stats->max;
+		stats->err = desc->stats->err;
+		SYS_ARCH_UNPROTECT(lev);
+	}
+	memp->npools = MEMP_MAX;
+
+	return OK;
+}
+#endif  //CONFIG_NET_MEMP_STATS
+
 /****************************************************************************
  * Name: netdev_nmioctl
  *
@@ -96,6 +153,11 @@ int netdev_nmioctl(FAR struct socket *sock, int cmd, void  *arg)
 		}
 		ret = ((struct netdev_ops *)(dev->ops))->get_stats(dev, stats);
 	}
+#endif
+#ifdef CONFIG_NET_MEMP_STATS
+	else if (cmd == SIOCGMEMPSTATS) {
+		ret = _copy_memp((struct netmon_memp *)arg);
+	}
 #endif
 	else {
 		ret = -ENOTTY;
@@ -20,6 +20,15 @@
 #define _NETMGR_NETSTACK_H__
 
 #include <net/if.h>
+#ifdef CONFIG_NET_EPOLL
+#include <sys/epoll.h>
+#endif
+#ifdef CONFIG_NET_ZEROCOPY
+#include <sys/socket.h>
+#endif
+#ifdef CONFIG_NET_SENDFILE
+struct file;
+#endif
 
 #define NETSTACK_CALL(stk, method, arg)			\
 	do {										\
@@ -81,6 +90,19 @@ struct netstack_ops {
 	int (*getpeername)(int s, struct sockaddr *name, socklen_t *namelen);
 	int (*setsockopt)(int s, int level, int optname, const void *optval, socklen_t optlen);
 	int (*getsockopt)(int s, int level, int optname, void *optval, socklen_t *optlen);
+#ifdef CONFIG_NET_EPOLL
+	int (*epoll_create)(int flags);
+	int (*epoll_ctl)(int epfd, int op, int fd, struct epoll_event *event);
+	int (*epoll_wait)(int epfd, struct epoll_event *events, int maxevents, int timeout);
+#endif
+#ifdef CONFIG_NET_ZEROCOPY
+	ssize_t (*recv_zc)(int s, struct zc_rbuf *zb, size_t len, int flags);
+	void (*recv_zc_release)(struct zc_rbuf *zb);
+	ssize_t (*send_zc)(int s, const void *data, size_t size, int flags, zc_release_t release, void *arg);
+#endif
+#ifdef CONFIG_NET_SENDFILE
+	ssize_t (*sendfile)(int s, struct file *filep, off_t *offset, size_t count);
+#endif
 
 	// etc
 #ifdef CONFIG_NET_ROUTE
@@ -298,6 +298,51 @@ static int lwip_ns_getsockopt(int s, int level, int optname, void *optval, sockl
 	return lwip_getsockopt(s, level, optname, optval, optlen);
 }
 
+#ifdef CONFIG_NET_EPOLL
+static int lwip_ns_epoll_create(int flags)
+{
+	return lwip_epoll_create(flags);
+}
+
+
+static int lwip_ns_epoll_ctl(int epfd, int op, int fd, struct epoll_event *event)
+{
+	return lwip_epoll_ctl(epfd, op, fd, event);
+}
+
+
+static int lwip_ns_epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout)
+{
+	return lwip_epoll_wait(epfd, events, maxevents, timeout);
+}
+#endif
+
+#ifdef CONFIG_NET_ZEROCOPY
+static ssize_t lwip_ns_recv_zc(int s, struct zc_rbuf *zb, size_t len, int flags)
+{
+	return lwip_recv_zc(s, zb, len, flags);
+}
+
+
+static void lwip_ns_recv_zc_release(struct zc_rbuf *zb)
+{
+	lwip_recv_zc_release(zb);
+}
+
+
+static ssize_t lwip_ns_send_zc(int s, const void *data, size_t size, int flags, zc_release_t release, void *arg)
+{
+	return lwip_send_zc(s, data, size, flags, release, arg);
+}
+#endif
+
+#ifdef CONFIG_NET_SENDFILE
+static ssize_t lwip_ns_sendfile(int s, struct file *filep, off_t *offset, size_t count)
+{
+	return lwip_sendfile(s, filep, offset, count);
+}
+#endif
+
 
 static ssize_t lwip_ns_recvmsg(int sockfd, struct msghdr *msg, int flags)
 {
@@ -507,6 +552,19 @@ struct netstack_ops g_lwip_stack_ops = {
 	lwip_ns_getpeername,
 	lwip_ns_setsockopt,
 	lwip_ns_getsockopt,
+#ifdef CONFIG_NET_EPOLL
+	lwip_ns_epoll_create,
+	lwip_ns_epoll_ctl,
+	lwip_ns_epoll_wait,
+#endif
+#ifdef CONFIG_NET_ZEROCOPY
+	lwip_ns_recv_zc,
+	lwip_ns_recv_zc_release,
+	lwip_ns_send_zc,
+#endif
+#ifdef CONFIG_NET_SENDFILE
+	lwip_ns_sendfile,
+#endif
 #ifdef CONFIG_NET_ROUTE
 	lwip_ns_addroute,
 	lwip_ns_delroute,
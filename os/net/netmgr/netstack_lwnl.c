@@ -75,6 +75,19 @@ struct netstack_ops g_netlink_stack_ops = {
 	NULL,
 	NULL,
 	NULL,
+#ifdef CONFIG_NET_EPOLL
+	NULL,
+	NULL,
+	NULL,
+#endif
+#ifdef CONFIG_NET_ZEROCOPY
+	NULL,
+	NULL,
+	NULL,
+#endif
+#ifdef CONFIG_NET_SENDFILE
+	NULL,
+#endif
 #ifdef CONFIG_NET_ROUTE
 	NULL,
 	NULL,
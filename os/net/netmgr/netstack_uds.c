@@ -56,6 +56,19 @@ struct netstack_ops g_uds_stack_ops = {
 	uds_getpeername,
 	NULL,
 	NULL,
+#ifdef CONFIG_NET_EPOLL
+	NULL,
+	NULL,
+	NULL,
+#endif
+#ifdef CONFIG_NET_ZEROCOPY
+	NULL,
+	NULL,
+	NULL,
+#endif
+#ifdef CONFIG_NET_SENDFILE
+	NULL,
+#endif
 #ifdef CONFIG_NET_ROUTE
 	NULL,
 	NULL,
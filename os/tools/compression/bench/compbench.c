@@ -0,0 +1,580 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <tinyara/binfmt/compression/compression.h>
+
+#include "compbench.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MAX_BLOCK_SIZE 8192
+#define MAX_BLOCK_SIZES 16
+
+/* Number of random unaligned reads checked per image */
+
+#define NSPANS 1000
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct result_s {
+	size_t imgsize;				/* Size of the compressed image */
+	int overflow;				/* Blocks larger than the reader buffer */
+	double seq_mbps;			/* Sequential decode throughput */
+	double blk_avg_us;			/* Average latency of one block read */
+	double blk_max_us;			/* Worst latency of one block read */
+	size_t ram;					/* Memory held by the reader */
+	int errors;					/* Reads which returned wrong data */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct compbench_codec_s *g_codecs[] = {
+	&lzma_codec,
+	&miniz_codec,
+};
+
+static int g_iterations = 3;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void show_usage(const char *progname)
+{
+	fprintf(stderr, "USAGE: %s [-b block size]... [-t lzma|miniz]... [-n iterations] <uncompressed file>...\n", progname);
+	fprintf(stderr, "       %s -i <compressed file> [-n iterations] <uncompressed file>\n", progname);
+	fprintf(stderr, "  Default block sizes are 512 1024 2048 4096 8192, default types are lzma and miniz\n");
+	fprintf(stderr, "  -i checks a file made by mkcompressimg against its uncompressed file\n");
+	exit(1);
+}
+
+static double now_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000.0 + ts.tv_nsec / 1000.0;
+}
+
+static unsigned char *load_file(const char *path, size_t *len)
+{
+	FILE *fp;
+	struct stat st;
+	unsigned char *data;
+
+	if (stat(path, &st) < 0 || st.st_size == 0) {
+		fprintf(stderr, "Cannot use %s\n", path);
+		return NULL;
+	}
+
+	fp = fopen(path, "rb");
+	if (!fp) {
+		fprintf(stderr, "Failed to open %s: %d\n", path, errno);
+		return NULL;
+	}
+
+	data = malloc(st.st_size);
+	if (!data || fread(data, 1, st.st_size, fp) != (size_t)st.st_size) {
+		fprintf(stderr, "Failed to read %s\n", path);
+		free(data);
+		data = NULL;
+	}
+
+	fclose(fp);
+	*len = st.st_size;
+	return data;
+}
+
+/* compress_read() returns the number of bytes read or a negative error */
+
+static int read_ok(const struct compbench_codec_s *codec, struct compress_ctx_s *ctx, unsigned char *buf, size_t size, off_t offset)
+{
+	int ret = codec->read(ctx, buf, size, offset);
+
+	return ret >= 0 && (size_t)ret == size;
+}
+
+/****************************************************************************
+ * Name: make_image
+ *
+ * Description:
+ *   Write 'data' compressed with 'codec' into a temporary file, in the
+ *   format written by mkcompressimg.  Blocks which do not fit in the read
+ *   buffer of compress_read.c are counted in res->overflow.
+ *
+ ****************************************************************************/
+
+static FILE *make_image(const struct compbench_codec_s *codec, const unsigned char *data, size_t len, size_t blocksize, struct result_s *res)
+{
+	FILE *fp;
+	struct s_header *phdr;
+	unsigned char *out;
+	size_t outlen;
+	size_t hdrsize;
+	size_t sections;
+	size_t index;
+	int size;
+
+	sections = (len + blocksize - 1) / blocksize + 1;
+	hdrsize = sizeof(struct s_header) + sections * sizeof(int);
+	outlen = 2 * blocksize + 64 + codec->props;
+
+	phdr = calloc(1, hdrsize);
+	out = malloc(outlen);
+	fp = tmpfile();
+	if (!phdr || !out || !fp) {
+		fprintf(stderr, "Failed to prepare image\n");
+		goto errout;
+	}
+
+	phdr->size_header = hdrsize;
+	phdr->compression_format = codec->type;
+	phdr->blocksize = blocksize;
+	phdr->sections = sections;
+	phdr->binary_size = len;
+	phdr->secoff[0] = 0;
+
+	fseek(fp, hdrsize, SEEK_SET);
+	for (index = 0; index < sections - 1; index++) {
+		size_t inlen = len - (size_t)index * blocksize;
+
+		if (inlen > blocksize) {
+			inlen = blocksize;
+		}
+
+		size = codec->encode(out, outlen, data + (size_t)index * blocksize, inlen);
+		if (size < 0) {
+			fprintf(stderr, "%s: failed to compress block %zu\n", codec->name, index);
+			goto errout;
+		}
+
+		if ((size_t)size > blocksize + codec->props) {
+			res->overflow++;
+		}
+
+		fwrite(out, 1, size, fp);
+		phdr->secoff[index + 1] = phdr->secoff[index] + size;
+	}
+
+	fseek(fp, 0, SEEK_SET);
+	fwrite(phdr, 1, hdrsize, fp);
+	fflush(fp);
+
+	res->imgsize = hdrsize + phdr->secoff[sections - 1];
+	res->ram = hdrsize + 2 * blocksize + codec->props;
+
+	free(phdr);
+	free(out);
+	return fp;
+
+errout:
+	if (fp) {
+		fclose(fp);
+	}
+	free(phdr);
+	free(out);
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: run_one
+ *
+ * Description:
+ *   Measure the reader on the image 'fp' of 'data':
+ *   - sequential throughput, reading block by block as libelf does,
+ *   - latency of single block reads in random order, the worst case of
+ *     random access since no block is reused from the previous read,
+ *   - correctness of the single block reads and of random unaligned spans.
+ *
+ ****************************************************************************/
+
+static int run_one(const struct compbench_codec_s *codec, FILE *fp, const unsigned char *data, size_t len, size_t blocksize, struct result_s *res)
+{
+	struct compress_ctx_s *ctx = NULL;
+	unsigned char *buf;
+	size_t *order;
+	off_t filelen;
+	size_t nblocks;
+	size_t i;
+	int iter;
+	int span;
+	double t0;
+	double dt;
+	double total;
+
+	nblocks = (len + blocksize - 1) / blocksize;
+	buf = malloc(2 * blocksize);
+	order = malloc(nblocks * sizeof(size_t));
+	if (!buf || !order) {
+		goto errout;
+	}
+
+	if (res->overflow) {
+		/* compress_read would overrun its read buffer */
+
+		goto errout;
+	}
+
+	if (codec->init(fileno(fp), 0, &filelen, &ctx) != 0 || (size_t)filelen != len) {
+		fprintf(stderr, "%s: compress_init failed\n", codec->name);
+		goto errout;
+	}
+
+	/* Sequential reads */
+
+	total = 0;
+	for (iter = 0; iter < g_iterations; iter++) {
+		t0 = now_us();
+		for (i = 0; i < nblocks; i++) {
+			size_t size = len - (size_t)i * blocksize;
+
+			if (size > blocksize) {
+				size = blocksize;
+			}
+
+			if (!read_ok(codec, ctx, buf, size, (off_t)(i * blocksize))) {
+				res->errors++;
+			}
+		}
+
+		total += now_us() - t0;
+	}
+
+	res->seq_mbps = (double)len * g_iterations / total;
+
+	/* Single blocks in random order.  Consecutive reads never hit the same
+	 * block, so each one is decompressed.
+	 */
+
+	for (i = 0; i < nblocks; i++) {
+		order[i] = i;
+	}
+
+	total = 0;
+	for (iter = 0; iter < g_iterations; iter++) {
+		for (i = nblocks - 1; i > 0; i--) {
+			size_t j = rand() % (i + 1);
+			size_t tmp = order[i];
+
+			order[i] = order[j];
+			order[j] = tmp;
+		}
+
+		for (i = 0; i < nblocks; i++) {
+			size_t off = order[i] * blocksize;
+			size_t size = len - off;
+
+			if (size > blocksize) {
+				size = blocksize;
+			}
+
+			t0 = now_us();
+			if (!read_ok(codec, ctx, buf, size, off)) {
+				res->errors++;
+				continue;
+			}
+
+			dt = now_us() - t0;
+			total += dt;
+			if (dt > res->blk_max_us) {
+				res->blk_max_us = dt;
+			}
+
+			if (memcmp(buf, data + off, size) != 0) {
+				res->errors++;
+			}
+		}
+	}
+
+	res->blk_avg_us = total / ((double)nblocks * g_iterations);
+
+	/* Random unaligned spans, possibly crossing a block boundary */
+
+	for (span = 0; span < NSPANS; span++) {
+		size_t off = rand() % len;
+		size_t size = 1 + rand() % (2 * blocksize);
+
+		if (size > len - off) {
+			size = len - off;
+		}
+
+		if (!read_ok(codec, ctx, buf, size, off) || memcmp(buf, data + off, size) != 0) {
+			res->errors++;
+		}
+	}
+
+	codec->uninit(ctx);
+	free(order);
+	free(buf);
+	return 0;
+
+errout:
+	if (ctx) {
+		codec->uninit(ctx);
+	}
+	free(order);
+	free(buf);
+	return -1;
+}
+
+static const struct compbench_codec_s *find_codec(const char *name, int type)
+{
+	size_t i;
+
+	for (i = 0; i < sizeof(g_codecs) / sizeof(g_codecs[0]); i++) {
+		if ((name && strcmp(g_codecs[i]->name, name) == 0) || g_codecs[i]->type == type) {
+			return g_codecs[i];
+		}
+	}
+
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: open_image
+ *
+ * Description:
+ *   Open an image written by mkcompressimg and check that each block fits
+ *   in the read buffer of compress_read.c.
+ *
+ ****************************************************************************/
+
+static FILE *open_image(const char *path, const struct compbench_codec_s **codec, size_t *blocksize, struct result_s *res)
+{
+	struct s_header hdr;
+	struct s_header *phdr;
+	FILE *fp;
+	int index;
+
+	fp = fopen(path, "rb");
+	if (!fp) {
+		fprintf(stderr, "Failed to open %s: %d\n", path, errno);
+		return NULL;
+	}
+
+	if (fread(&hdr, 1, sizeof(hdr), fp) != sizeof(hdr) || hdr.size_header < (int)sizeof(hdr) || hdr.blocksize < 1 || hdr.sections < 1) {
+		fprintf(stderr, "%s: bad compression header\n", path);
+		goto errout;
+	}
+
+	*codec = find_codec(NULL, hdr.compression_format);
+	if (!*codec) {
+		fprintf(stderr, "%s: compression type %d not supported\n", path, hdr.compression_format);
+		goto errout;
+	}
+
+	phdr = malloc(hdr.size_header);
+	if (!phdr) {
+		goto errout;
+	}
+
+	fseek(fp, 0, SEEK_SET);
+	if (fread(phdr, 1, hdr.size_header, fp) != (size_t)hdr.size_header) {
+		fprintf(stderr, "%s: bad compression header\n", path);
+		free(phdr);
+		goto errout;
+	}
+
+	for (index = 0; index < phdr->sections - 1; index++) {
+		if (phdr->secoff[index + 1] - phdr->secoff[index] > phdr->blocksize + (*codec)->props) {
+			res->overflow++;
+		}
+	}
+
+	*blocksize = phdr->blocksize;
+	res->imgsize = phdr->size_header + phdr->secoff[phdr->sections - 1];
+	res->ram = phdr->size_header + 2 * phdr->blocksize + (*codec)->props;
+	free(phdr);
+	return fp;
+
+errout:
+	fclose(fp);
+	return NULL;
+}
+
+static int report(const struct compbench_codec_s *codec, size_t blocksize, size_t len, int ret, struct result_s *res)
+{
+	if (res->overflow) {
+		printf("%-6s %6zu %6.1f%% not loadable (%d blocks larger than the read buffer)\n", codec->name, blocksize, 100.0 * res->imgsize / len, res->overflow);
+		return 1;
+	}
+
+	if (ret < 0) {
+		printf("%-6s %6zu failed\n", codec->name, blocksize);
+		return 1;
+	}
+
+	printf("%-6s %6zu %6.1f%% %9.2f %11.1f %11.1f %8zu %s\n", codec->name, blocksize, 100.0 * res->imgsize / len, res->seq_mbps, res->blk_avg_us, res->blk_max_us, res->ram, res->errors ? "FAIL" : "ok");
+	return res->errors ? 1 : 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	static const size_t default_sizes[] = { 512, 1024, 2048, 4096, 8192 };
+	const struct compbench_codec_s *codecs[sizeof(g_codecs) / sizeof(g_codecs[0])];
+	size_t sizes[MAX_BLOCK_SIZES];
+	size_t ncodecs = 0;
+	size_t nsizes = 0;
+	const char *image = NULL;
+	int failed = 0;
+	int blksize;
+	int opt;
+	size_t c;
+	size_t s;
+
+	while ((opt = getopt(argc, argv, "b:t:n:i:h")) != -1) {
+		switch (opt) {
+		case 'b':
+			if (nsizes == MAX_BLOCK_SIZES) {
+				show_usage(argv[0]);
+			}
+
+			blksize = atoi(optarg);
+			if (blksize < 512 || blksize > MAX_BLOCK_SIZE) {
+				fprintf(stderr, "Block size should be between 512 and %d\n", MAX_BLOCK_SIZE);
+				exit(2);
+			}
+
+			sizes[nsizes++] = blksize;
+			break;
+
+		case 't':
+			if (ncodecs == sizeof(codecs) / sizeof(codecs[0])) {
+				show_usage(argv[0]);
+			}
+
+			codecs[ncodecs] = find_codec(optarg, -1);
+			if (!codecs[ncodecs]) {
+				fprintf(stderr, "Compression type %s not supported\n", optarg);
+				exit(3);
+			}
+
+			ncodecs++;
+			break;
+
+		case 'i':
+			image = optarg;
+			break;
+
+		case 'n':
+			g_iterations = atoi(optarg);
+			if (g_iterations < 1) {
+				show_usage(argv[0]);
+			}
+			break;
+
+		default:
+			show_usage(argv[0]);
+		}
+	}
+
+	if (optind >= argc || (image && optind != argc - 1)) {
+		show_usage(argv[0]);
+	}
+
+	if (nsizes == 0) {
+		for (nsizes = 0; nsizes < sizeof(default_sizes) / sizeof(default_sizes[0]); nsizes++) {
+			sizes[nsizes] = default_sizes[nsizes];
+		}
+	}
+
+	if (ncodecs == 0) {
+		for (ncodecs = 0; ncodecs < sizeof(g_codecs) / sizeof(g_codecs[0]); ncodecs++) {
+			codecs[ncodecs] = g_codecs[ncodecs];
+		}
+	}
+
+	srand(1);
+
+	for (; optind < argc; optind++) {
+		unsigned char *data;
+		size_t len;
+
+		data = load_file(argv[optind], &len);
+		if (!data) {
+			failed = 1;
+			continue;
+		}
+
+		printf("%s: %zu bytes\n", argv[optind], len);
+		printf("%-6s %6s %7s %9s %11s %11s %8s %s\n", "type", "block", "ratio", "seq MB/s", "blk avg us", "blk max us", "RAM", "check");
+
+		if (image) {
+			/* Check an image made by mkcompressimg from this file */
+
+			const struct compbench_codec_s *codec;
+			struct result_s res;
+			size_t blocksize;
+			FILE *fp;
+
+			memset(&res, 0, sizeof(res));
+			fp = open_image(image, &codec, &blocksize, &res);
+			if (!fp) {
+				free(data);
+				return 1;
+			}
+
+			failed |= report(codec, blocksize, len, run_one(codec, fp, data, len, blocksize, &res), &res);
+			fclose(fp);
+		}
+
+		for (c = 0; c < ncodecs && !image; c++) {
+			for (s = 0; s < nsizes; s++) {
+				struct result_s res;
+				int ret = -1;
+				FILE *fp;
+
+				memset(&res, 0, sizeof(res));
+				fp = make_image(codecs[c], data, len, sizes[s], &res);
+				if (fp) {
+					ret = run_one(codecs[c], fp, data, len, sizes[s], &res);
+					fclose(fp);
+				}
+
+				failed |= report(codecs[c], sizes[s], len, ret, &res);
+			}
+		}
+
+		printf("\n");
+		free(data);
+	}
+
+	return failed;
+}
@@ -0,0 +1,62 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __COMPBENCH_H
+#define __COMPBENCH_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <sys/types.h>
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct compress_ctx_s;
+
+/* One build of os/compression/compress_read.c together with the block
+ * encoder of mkcompressimg for the same compression type.
+ */
+
+struct compbench_codec_s {
+	const char *name;
+	int type;					/* enum compression_formats */
+	int props;					/* Bytes stored in front of each block */
+
+	/* Compress 'len' bytes of 'in' into 'out' of 'outlen' bytes, the same
+	 * way as mkcompressimg.  Returns the size of the block or -1.
+	 */
+
+	int (*encode)(unsigned char *out, size_t outlen, const unsigned char *in, size_t len);
+
+	int (*init)(int filfd, uint16_t offset, off_t *filelen, struct compress_ctx_s **ctx);
+	int (*read)(struct compress_ctx_s *ctx, uint8_t *buffer, size_t readsize, off_t offset);
+	void (*uninit)(struct compress_ctx_s *ctx);
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+extern const struct compbench_codec_s lzma_codec;
+extern const struct compbench_codec_s miniz_codec;
+
+#endif							/* __COMPBENCH_H */
@@ -0,0 +1,78 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* Built once per compression type.  The Makefile renames the compress_read
+ * interface and COMPBENCH_CODEC so that both builds can be linked together.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <tinyara/binfmt/compression/compress_read.h>
+
+#if CONFIG_COMPRESSION_TYPE == LZMA
+#include <tinyara/lzma/LzmaLib.h>
+#elif CONFIG_COMPRESSION_TYPE == MINIZ
+#include <tinyara/miniz/miniz.h>
+#endif
+
+#include "compbench.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#if CONFIG_COMPRESSION_TYPE == LZMA
+/* Same parameters as mkcompressimg: level 0, 8KB dictionary */
+
+static int encode(unsigned char *out, size_t outlen, const unsigned char *in, size_t len)
+{
+	size_t writesize = outlen - LZMA_PROPS_SIZE;
+	size_t propsSize = LZMA_PROPS_SIZE;
+
+	if (LzmaCompress(&out[LZMA_PROPS_SIZE], &writesize, in, len, out, &propsSize, 0, 1 << 13, -1, -1, -1, -1, 1) != SZ_OK) {
+		return -1;
+	}
+
+	return writesize + LZMA_PROPS_SIZE;
+}
+
+const struct compbench_codec_s COMPBENCH_CODEC = {
+	"lzma", COMPRESSION_TYPE_LZMA, LZMA_PROPS_SIZE, encode,
+	compress_init, compress_read, compress_uninit
+};
+#elif CONFIG_COMPRESSION_TYPE == MINIZ
+static int encode(unsigned char *out, size_t outlen, const unsigned char *in, size_t len)
+{
+	mz_ulong writesize = outlen;
+
+	if (mz_compress(out, &writesize, in, len) != Z_OK) {
+		return -1;
+	}
+
+	return writesize;
+}
+
+const struct compbench_codec_s COMPBENCH_CODEC = {
+	"miniz", COMPRESSION_TYPE_MINIZ, 0, encode,
+	compress_init, compress_read, compress_uninit
+};
+#endif
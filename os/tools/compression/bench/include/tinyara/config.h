@@ -0,0 +1,36 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* Host build of os/compression/compress_read.c for compbench.
+ * CONFIG_COMPRESSION_TYPE is given on the command line, once per codec.
+ */
+
+#ifndef __COMPBENCH_INCLUDE_TINYARA_CONFIG_H
+#define __COMPBENCH_INCLUDE_TINYARA_CONFIG_H
+
+#include <errno.h>
+
+#define CONFIG_COMPRESSED_BINARY 1
+
+#define FAR
+#define OK 0
+#define ERROR -1
+
+#define get_errno() errno
+
+#endif							/* __COMPBENCH_INCLUDE_TINYARA_CONFIG_H */
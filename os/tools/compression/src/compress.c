@@ -47,7 +47,7 @@ static void show_usage(const char *progname)
 	exit(1);
 }
 
-static void compress_file(int block_size, int type, char *in_file, char *out_file)
+static int compress_file(int block_size, int type, char *in_file, char *out_file)
 {
 	unsigned int sections;
 	long unsigned int size;
@@ -56,6 +56,7 @@ static void compress_file(int block_size, int type, char *in_file, char *out_fil
 	int index;
 	int nbytes;
 	int ret;
+	int result = 1;
 	struct stat buf;
 	unsigned int rpos;
 	unsigned long int readsize = block_size;
@@ -164,15 +165,21 @@ static void compress_file(int block_size, int type, char *in_file, char *out_fil
 		ret = LzmaCompress(&out_buf[LZMA_PROPS_SIZE], &writesize, read_buf, (block_size - readsize), out_buf, &propsSize, 0, 1<<13 , -1, -1, -1, -1, 1);
 		if (ret != SZ_OK) {
 			printf("LZMA Compress failed, ret = %d\n", ret);
+			goto error;
 		}
 
+		/* The block is stored with its LZMA properties in front */
+		writesize += LZMA_PROPS_SIZE;
+
 		printf("==> lzma_compress %d writesize %lu\n", index, writesize);
 #elif CONFIG_COMPRESSION_TYPE == MINIZ
 		/* Miniz Compression for data in read_buf into out_buf */
-		writesize = compressBound(block_size - readsize);
+		/* The block has to fit in the read buffer of compress_read.c */
+		writesize = block_size;
 		ret = mz_compress(out_buf, &writesize, read_buf, (block_size - readsize));
 		if (ret != Z_OK) {
 			printf("Miniz Compress failed, ret = %d\n", ret);
+			goto error;
 		}
 		printf("==> miniz_compress %d writesize %lu\n", index, writesize);
 #else
@@ -230,6 +237,8 @@ static void compress_file(int block_size, int type, char *in_file, char *out_fil
 		}
 	}
 
+	result = 0;
+
 error:
 	if (phdr) {
 		free(phdr);
@@ -246,6 +255,8 @@ error:
 	if (out_fd > 0) {
 		close(out_fd);
 	}
+
+	return result;
 }
 
 /****************************************************************************
@@ -283,7 +294,5 @@ int main(int argc, char *argv[])	//Main defined
 		exit(4);
 	}
 
-	compress_file(block_size, comp_format, argv[3], argv[4]);
-
-	return 0;
+	return compress_file(block_size, comp_format, argv[3], argv[4]);
 }
@@ -0,0 +1,252 @@
+#!/usr/bin/env python3
+###########################################################################
+#
+# Copyright 2026 Samsung Electronics All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+# either express or implied. See the License for the specific
+# language governing permissions and limitations under the License.
+#
+###########################################################################
+# File : logm_decoder.py
+# Description:
+# Decode the binary logm buffer (CONFIG_LOGM_BINARY) printed by "logm -d"
+# or read from a ramdump.  Format strings are read from the ELF file of
+# the image, so the decoder needs the tinyara ELF of the same build.
+
+from __future__ import print_function
+import argparse
+import re
+import struct
+import sys
+
+LOGM_BIN_RESERVED = 0x5a
+LOGM_BIN_COMMITTED = 0xa5
+LOGM_BIN_PAD = 0xc3
+
+LOGM_BIN_FMTCOPY = 0x01
+LOGM_BIN_TRUNCATED = 0x02
+
+HDR_SIZE = 12
+HDR_FORMAT = '<BBHII'
+
+CONV_RE = re.compile(r'%([-+ #0]*)(\*|[0-9]*)(?:\.(\*|[0-9]*))?([hljztL]*)(.|$)')
+
+
+def align4(n):
+	return (n + 3) & ~3
+
+
+class ElfImage:
+	"""Read the allocated sections of a 32 bit little endian ELF file"""
+
+	def __init__(self, path):
+		self.sections = []
+		with open(path, 'rb') as f:
+			data = f.read()
+		if data[:4] != b'\x7fELF' or data[4] != 1 or data[5] != 1:
+			raise ValueError('%s is not a 32 bit little endian ELF file' % path)
+		shoff, = struct.unpack_from('<I', data, 0x20)
+		shentsize, shnum = struct.unpack_from('<HH', data, 0x2e)
+		for i in range(shnum):
+			_, shtype, flags, addr, offset, size = struct.unpack_from('<IIIIII', data, shoff + i * shentsize)
+			# SHT_PROGBITS sections with SHF_ALLOC
+			if shtype == 1 and flags & 0x2 and size > 0:
+				self.sections.append((addr, data[offset:offset + size]))
+
+	def string(self, addr):
+		for start, content in self.sections:
+			if start <= addr < start + len(content):
+				end = content.find(b'\0', addr - start)
+				if end < 0:
+					end = len(content)
+				return content[addr - start:end].decode('latin-1')
+		return None
+
+
+def read_dump(path):
+	"""Parse the output of "logm -d" and return (buffer, head, tail, usec_per_tick)"""
+	info = None
+	hexdata = []
+	with open(path, 'r', errors='replace') as f:
+		for line in f:
+			line = line.strip()
+			if line.startswith('LOGM DUMP END'):
+				break
+			m = re.search(r'LOGM DUMP size=(\d+) head=(\d+) tail=(\d+)(?: ticks=\d+ usec_per_tick=(\d+))?', line)
+			if m:
+				info = m
+				hexdata = []
+			elif info and re.match(r'^[0-9a-fA-F]+$', line):
+				hexdata.append(line)
+	if info is None:
+		raise ValueError('no "LOGM DUMP" found in %s' % path)
+	buf = bytes.fromhex(''.join(hexdata))
+	usec = int(info.group(4)) if info.group(4) else None
+	return buf[:int(info.group(1))], int(info.group(2)), int(info.group(3)), usec
+
+
+def records(buf, head, tail):
+	"""Yield (offset, header, body) for the committed records from head to tail"""
+	pos = head
+	while pos != tail:
+		if pos + HDR_SIZE > len(buf):
+			pos = 0
+			continue
+		state, flags, size, ticks, fmt = struct.unpack_from(HDR_FORMAT, buf, pos)
+		if state == LOGM_BIN_PAD:
+			pos = 0
+			continue
+		if state != LOGM_BIN_COMMITTED or size < HDR_SIZE or pos + size > len(buf):
+			break
+		yield pos, (flags, size, ticks, fmt), buf[pos + HDR_SIZE:pos + size]
+		pos = (pos + size) % len(buf)
+
+
+def scan_all(buf, tail):
+	"""Yield every record that looks valid, oldest first, including the ones
+	which were already printed.  Used for ramdumps where head may be stale.
+	"""
+	order = list(range(align4(tail), len(buf), 4)) + list(range(0, align4(tail), 4))
+	skip_to = None
+	for pos in order:
+		if skip_to is not None and pos != skip_to:
+			continue
+		skip_to = None
+		if pos + HDR_SIZE > len(buf):
+			continue
+		state, flags, size, ticks, fmt = struct.unpack_from(HDR_FORMAT, buf, pos)
+		if state != LOGM_BIN_COMMITTED or size < HDR_SIZE or size % 4 or pos + size > len(buf):
+			continue
+		yield pos, (flags, size, ticks, fmt), buf[pos + HDR_SIZE:pos + size]
+		skip_to = pos + size
+
+
+def cstring(data, pos):
+	end = data.find(b'\0', pos)
+	if end < 0:
+		end = len(data)
+	return data[pos:end].decode('latin-1'), align4(end - pos + 1)
+
+
+def format_record(elf, flags, size, fmtaddr, body):
+	"""Format a record the same way as logm_bin_print() in os/logm/logm_binary.c"""
+	pos = 0
+	if flags & LOGM_BIN_FMTCOPY:
+		fmt, used = cstring(body, 0)
+		pos = used
+	else:
+		fmt = elf.string(fmtaddr) if elf else None
+		if fmt is None:
+			return '<unknown format 0x%08x>\n' % fmtaddr
+
+	out = []
+	idx = 0
+	while True:
+		m = CONV_RE.search(fmt, idx)
+		if m is None:
+			break
+		out.append(fmt[idx:m.start()])
+		flag, width, prec, length, conv = m.groups()
+		if conv == '%':
+			out.append('%')
+			idx = m.end()
+			continue
+
+		nlong = length.count('l') + (2 if 'j' in length else 0)
+		if conv == '' or 'L' in length:
+			idx = m.start()
+			break
+		elif conv in 'diuxXoc':
+			argsize = 8 if nlong > 1 else 4
+		elif conv in 'fFeEgG' and 'L' not in length:
+			argsize = 8
+		elif conv in 'ps':
+			argsize = 4
+		else:
+			# Not supported by the encoder, the rest is printed as is
+			idx = m.start()
+			break
+
+		nstar = (width == '*') + (prec == '*')
+		need = 4 * nstar + (1 if conv == 's' else argsize)
+		if len(body) - pos < need:
+			out.append('...\n')
+			return ''.join(out)
+
+		stars = list(struct.unpack_from('<%di' % nstar, body, pos))
+		pos += 4 * nstar
+		spec = '%' + flag + width + ('.' + prec if prec is not None else '')
+		if conv == 's':
+			value, used = cstring(body, pos)
+			pos += used
+		elif conv in 'fFeEgG':
+			value, = struct.unpack_from('<d', body, pos)
+		elif conv in 'di':
+			value, = struct.unpack_from('<q' if argsize == 8 else '<i', body, pos)
+		else:
+			value, = struct.unpack_from('<Q' if argsize == 8 else '<I', body, pos)
+		if conv != 's':
+			pos += argsize
+
+		if conv == 'p':
+			out.append('0x%x' % value)
+		elif conv == 'c':
+			out.append((spec + 'c') % tuple(stars + [chr(value & 0xff)]))
+		else:
+			out.append((spec + ('d' if conv == 'u' else conv)) % tuple(stars + [value]))
+
+		idx = m.end()
+		if conv == 's' and pos >= len(body) and flags & LOGM_BIN_TRUNCATED:
+			out.append('...\n')
+			return ''.join(out)
+
+	out.append(fmt[idx:])
+	if flags & LOGM_BIN_TRUNCATED:
+		out.append('...\n')
+	return ''.join(out)
+
+
+def main():
+	parser = argparse.ArgumentParser(description='Decode the binary logm buffer')
+	parser.add_argument('input', help='output of "logm -d", or the raw buffer with --raw')
+	parser.add_argument('-e', '--elf', help='tinyara ELF file of the same build')
+	parser.add_argument('--raw', action='store_true', help='input is the raw buffer, for example from a ramdump')
+	parser.add_argument('--head', type=int, default=0, help='g_logm_head, for --raw')
+	parser.add_argument('--tail', type=int, default=0, help='g_logm_tail, for --raw')
+	parser.add_argument('--all', action='store_true', help='also decode the records which were already printed')
+	parser.add_argument('--tick-us', type=int, help='microseconds per tick (default: from the dump, else 10000)')
+	parser.add_argument('--no-timestamp', action='store_true', help='do not print the timestamps')
+	args = parser.parse_args()
+
+	if args.raw:
+		with open(args.input, 'rb') as f:
+			buf = f.read()
+		head, tail, usec = args.head, args.tail, None
+	else:
+		buf, head, tail, usec = read_dump(args.input)
+	if args.tick_us:
+		usec = args.tick_us
+	elif usec is None:
+		usec = 10000
+
+	elf = ElfImage(args.elf) if args.elf else None
+	recs = scan_all(buf, tail) if args.all else records(buf, head, tail)
+	for _, (flags, size, ticks, fmtaddr), body in recs:
+		line = format_record(elf, flags, size, fmtaddr, body)
+		if not args.no_timestamp:
+			msec = ticks * usec // 1000
+			line = '[%4d.%4d] ' % (msec // 1000, (msec % 1000) * 10) + line
+		sys.stdout.write(line)
+
+
+if __name__ == '__main__':
+	main()
@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+###########################################################################
+#
+# Copyright 2026 Samsung Electronics All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+# either express or implied. See the License for the specific
+# language governing permissions and limitations under the License.
+#
+###########################################################################
+# File : ttrace_export.py
+# Description:
+# Convert a compact T-trace dump (CONFIG_TTRACE_COMPACT) to the Chrome
+# trace event JSON format, which chrome://tracing and Perfetto can open.
+# The dump is either the raw content of /dev/ttrace or the output of
+# "ttrace -x" saved from the console.
+
+from __future__ import print_function
+import argparse
+import json
+import re
+import struct
+import sys
+
+DUMP_MAGIC = b'TTRC'
+DUMP_HDR = '<4sBBH'
+
+REC_PAD = 0
+REC_TIME = 1
+REC_BEGIN = 2
+REC_BEGIN_UID = 3
+REC_END = 4
+REC_SCHED = 5
+REC_STR = 6
+
+STRID_NONE = 0xffff
+
+# Process ids used in the JSON output
+PID_TRACE = 1
+PID_CPU = 2
+
+
+def align4(n):
+	return (n + 3) & ~3
+
+
+def read_input(path):
+	"""Return the raw dump from a binary file or from "ttrace -x" output"""
+	with open(path, 'rb') as f:
+		data = f.read()
+	if data.startswith(DUMP_MAGIC):
+		return data
+	text = data.decode('latin-1')
+	m = re.search(r'TTRACE DUMP size=(\d+)(.*?)TTRACE DUMP END', text, re.S)
+	if m is None:
+		raise ValueError('%s is neither a T-trace dump nor "ttrace -x" output' % path)
+	hexdata = ''.join(re.findall(r'^\s*([0-9a-fA-F]+)\s*$', m.group(2), re.M))
+	return bytes.fromhex(hexdata)[:int(m.group(1))]
+
+
+def check_header(data):
+	magic, version, overwritten, dropped = struct.unpack_from(DUMP_HDR, data, 0)
+	if magic != DUMP_MAGIC or version != 1:
+		raise ValueError('unsupported dump, magic %r version %d' % (magic, version))
+	if overwritten:
+		print('older records were overwritten', file=sys.stderr)
+	if dropped:
+		print('%d records were dropped because the buffer was full' % dropped, file=sys.stderr)
+
+
+def parse(data):
+	"""Yield (type, delta, fields) for each record of the dump"""
+	pos = struct.calcsize(DUMP_HDR)
+	while pos + 8 <= len(data):
+		delta, rtype, extra, a, b = struct.unpack_from('<HBBhH', data, pos)
+		if rtype == REC_STR:
+			s = data[pos + 8:pos + 8 + extra].decode('latin-1')
+			yield rtype, 0, {'pid': a, 'id': b, 'str': s}
+			pos += 8 + align4(extra + 1)
+		elif rtype == REC_SCHED:
+			prev_pid, next_pid, prev_prio, next_prio = struct.unpack_from('<hhBB', data, pos + 4)
+			yield rtype, delta, {'prev_state': extra, 'prev_pid': prev_pid, 'next_pid': next_pid,
+					'prev_prio': prev_prio, 'next_prio': next_prio}
+			pos += 12
+		elif rtype == REC_TIME:
+			usec, = struct.unpack_from('<I', data, pos + 4)
+			yield rtype, delta, {'usec': usec, 'gap': extra}
+			pos += 8
+		elif rtype in (REC_BEGIN, REC_BEGIN_UID, REC_END):
+			yield rtype, delta, {'uid': extra, 'pid': a, 'strid': b}
+			pos += 8
+		else:
+			raise ValueError('bad record type %d at offset %d' % (rtype, pos))
+
+
+def timestamps(records):
+	"""Yield (usec, type, fields) with absolute times.  Records before the
+	first time record are placed from it; they are dropped if the time
+	between them and the time record is not known.
+	"""
+	pending = []
+	acc = 0
+	base = None
+	high = 0
+	last_low = None
+	for rtype, delta, rec in records:
+		acc += delta
+		if rtype == REC_STR:
+			continue
+		elif rtype == REC_TIME:
+			if last_low is not None and rec['usec'] < last_low:
+				high += 1 << 32
+			last_low = rec['usec']
+			now = high + rec['usec']
+			if base is None:
+				if rec['gap'] == 0:
+					for pacc, ptype, prec in pending:
+						yield now - (acc - pacc), ptype, prec
+				elif pending:
+					print('%d records before the first time stamp are skipped' % len(pending), file=sys.stderr)
+				pending = []
+			base = now - acc
+		elif base is None:
+			pending.append((acc, rtype, rec))
+		else:
+			yield base + acc, rtype, rec
+	if pending:
+		print('%d records without time stamp are skipped' % len(pending), file=sys.stderr)
+
+
+def export(data):
+	names = {}
+	tasks = {}
+	events = []
+	running = None
+
+	check_header(data)
+	for rtype, delta, rec in parse(data):
+		if rtype == REC_STR:
+			if rec['pid'] < 0:
+				names[rec['id']] = rec['str']
+			else:
+				tasks[rec['pid']] = rec['str']
+
+	for ts, rtype, rec in timestamps(parse(data)):
+		if rtype == REC_BEGIN:
+			name = names.get(rec['strid'], '<unknown>')
+			events.append({'name': name, 'ph': 'B', 'ts': ts, 'pid': PID_TRACE, 'tid': rec['pid']})
+		elif rtype == REC_BEGIN_UID:
+			events.append({'name': 'uid %d' % rec['uid'], 'ph': 'B', 'ts': ts, 'pid': PID_TRACE, 'tid': rec['pid']})
+		elif rtype == REC_END:
+			events.append({'ph': 'E', 'ts': ts, 'pid': PID_TRACE, 'tid': rec['pid']})
+		elif rtype == REC_SCHED:
+			if running is not None:
+				events.append({'ph': 'E', 'ts': ts, 'pid': PID_CPU, 'tid': 0})
+			nxt = rec['next_pid']
+			events.append({'name': tasks.get(nxt, 'pid %d' % nxt), 'ph': 'B', 'ts': ts, 'pid': PID_CPU, 'tid': 0,
+				'args': {'pid': nxt, 'prio': rec['next_prio'], 'prev_pid': rec['prev_pid'],
+					'prev_prio': rec['prev_prio'], 'prev_state': rec['prev_state']}})
+			running = nxt
+
+	meta = [{'name': 'process_name', 'ph': 'M', 'pid': PID_TRACE, 'args': {'name': 'Trace points'}},
+		{'name': 'process_name', 'ph': 'M', 'pid': PID_CPU, 'args': {'name': 'CPU'}},
+		{'name': 'thread_name', 'ph': 'M', 'pid': PID_CPU, 'tid': 0, 'args': {'name': 'running'}}]
+	for pid, name in sorted(tasks.items()):
+		meta.append({'name': 'thread_name', 'ph': 'M', 'pid': PID_TRACE, 'tid': pid, 'args': {'name': '%s (%d)' % (name, pid)}})
+
+	return {'traceEvents': meta + events, 'displayTimeUnit': 'ms'}
+
+
+def main():
+	parser = argparse.ArgumentParser(description='Convert a compact T-trace dump to Chrome trace JSON')
+	parser.add_argument('input', help='raw dump of /dev/ttrace or saved output of "ttrace -x"')
+	parser.add_argument('-o', '--output', help='JSON file to write (default: stdout)')
+	args = parser.parse_args()
+
+	trace = export(read_input(args.input))
+	if args.output:
+		with open(args.output, 'w') as f:
+			json.dump(trace, f)
+	else:
+		json.dump(trace, sys.stdout)
+		print()
+
+
+if __name__ == '__main__':
+	main()